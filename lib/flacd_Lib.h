@@ -19,6 +19,7 @@ typedef unsigned char					ACMW_UINT8;
 typedef unsigned short					ACMW_UINT16;
 typedef unsigned int					ACMW_UINT32;
 typedef signed short					ACMW_BOOL;
+typedef float							ACMW_FLOAT32;
 
 #endif	/* ACMW_COMM_STDTYPES_H */
 
@@ -38,7 +39,9 @@ typedef signed short					ACMW_BOOL;
 #define FLACD_ERR_POINTER				((ACMW_UINT32)(0x00000010u))
 #define FLACD_ERR_PARAMETER				((ACMW_UINT32)(0x00000020u))
 #define FLACD_ERR_SEQUENCE				((ACMW_UINT32)(0x00000040u))
+#define FLACD_ERR_SCRATCH_EXHAUSTED		((ACMW_UINT32)(0x00000080u))
 #define FLACD_ERR_SHORT_INPUT_DATA		((ACMW_UINT32)(0x00000100u))
+#define FLACD_ERR_SCRATCH_PINNED		((ACMW_UINT32)(0x00000200u))
 #define FLACD_ERR_NOT_SUPPORTED_DATA	((ACMW_UINT32)(0x00001000u))
 #define FLACD_ERR_LOST_SYNC				((ACMW_UINT32)(0x00010000u))
 #define FLACD_ERR_CHANGE_FRAME_HEADER	((ACMW_UINT32)(0x00020000u))
@@ -53,12 +56,25 @@ typedef signed short					ACMW_BOOL;
 /*   GetMemorySize Config Information Structure                             */
 /*                                                                          */
 /* [Note]                                                                   */
-/*   non                                                                    */
+/*   Clear the structure to 0 before setting its members: a member left     */
+/*   at 0 keeps the behaviour of version 2 (see flacd_GetVersion).          */
+/*   nMaxBlockSize, nBitsPerSample and nChannels describe the largest       */
+/*   stream to be decoded; the scratch memory and the input buffer are      */
+/*   sized to it. 0 selects the worst case of nInputChannel.                */
+/*   nDecodeChannels is the largest number of channels decoded per frame    */
+/*   (see flacd_SetChannelMask); the scratch memory holds a sample array    */
+/*   for each. 0 selects all channels, else 2 or more.                      */
 /*==========================================================================*/
 typedef struct {
 	ACMW_UINT16 nInputChannel;
 	ACMW_UINT16 nOutputChannel;
 	ACMW_UINT16 nOutBitsPerSample;
+	ACMW_UINT16 nOutSampleFormat;
+	ACMW_UINT16 nOutLayout;
+	ACMW_UINT16 nMaxBlockSize;
+	ACMW_UINT16 nBitsPerSample;
+	ACMW_UINT16 nChannels;
+	ACMW_UINT16 nDecodeChannels;
 } flacd_getMemorySizeConfigInfo;
 
 
@@ -87,7 +103,10 @@ typedef struct {
 /*   Work Memory Information Structure                                      */
 /*                                                                          */
 /* [Note]                                                                   */
-/*   non                                                                    */
+/*   pStatic belongs to one decoder instance. pScratch is only used during  */
+/*   a flacd_Decode call and may differ from call to call, except that an   */
+/*   instance with remaining samples (nRemainSamples) must be given the     */
+/*   same pScratch until they are output.                                   */
 /*==========================================================================*/
 typedef struct {
 	void * pStatic;
@@ -102,12 +121,29 @@ typedef struct {
 /*   Initialize Config Information Structure                                */
 /*                                                                          */
 /* [Note]                                                                   */
-/*   non                                                                    */
+/*   Clear the structure to 0 before setting its members: a member left     */
+/*   at 0 keeps the behaviour of version 2 (see flacd_GetVersion).          */
+/*   nOutSampleFormat selects integer PCM (nOutBitsPerSample) or float32.   */
+/*   nOutLayout selects planar or interleaved output. For interleaved       */
+/*   output only pOutBuffStart[0] is used and nOutBuffSize covers all       */
+/*   channels. On NEON targets only planar output is vectorized;            */
+/*   interleaved output of any format is stored one sample at a time.       */
+/*   nOutGainMode : 0 unity gain, 1 fOutGain is the linear gain applied in  */
+/*   float32 output (0.0 : mute).                                           */
+/*   nMaxBlockSize, nChannels and nDecodeChannels must match the values     */
+/*   given to flacd_GetMemorySize. Frames beyond them are not supported.    */
 /*==========================================================================*/
 typedef struct {
 	ACMW_UINT16 nInputChannel;
 	ACMW_UINT16 nOutputChannel;
 	ACMW_UINT16 nOutBitsPerSample;
+	ACMW_UINT16 nOutSampleFormat;
+	ACMW_UINT16 nOutLayout;
+	ACMW_UINT16 nOutGainMode;
+	ACMW_FLOAT32 fOutGain;
+	ACMW_UINT16 nMaxBlockSize;
+	ACMW_UINT16 nChannels;
+	ACMW_UINT16 nDecodeChannels;
 } flacd_initConfigInfo;
 
 
@@ -132,23 +168,72 @@ typedef struct {
 
 
 /*==========================================================================*/
-/*      Define Struct flacd_decStatusInfo                                  */
+/*      Define Struct flacd_decStatusInfo                                   */
 /*==========================================================================*/
 /* [Description]                                                            */
 /*   Decode Status Information Structure                                    */
 /*                                                                          */
 /* [Note]                                                                   */
-/*   non                                                                    */
+/*   nDecodedSamples is the number of samples output by the call.           */
+/*   nRemainSamples is the number of samples of the current frame that did  */
+/*   not fit in the output buffer. They are output by the next calls        */
+/*   without reading input, from the scratch memory the frame was decoded   */
+/*   into, or from the carry buffer once flacd_ReleaseScratch has moved     */
+/*   them there (see flacd_carryConfigInfo).                                */
+/*   nSamplePosition is the position in the stream of the first sample      */
+/*   output by the call.                                                    */
+/*   nSilentChannels has bit n set when output channel n is digital         */
+/*   silence in all the samples output by the call: a constant zero         */
+/*   subframe, a channel not in the frame or masked, or mute data. The      */
+/*   output is written all the same.                                        */
+/*   nFormatChange has a FLACD_FORMAT_* bit set for each of nSampleRate,    */
+/*   nChannels and nBitsPerSample that differs from the samples output      */
+/*   before (see flacd_SetFormatChange); 0 for the first samples output     */
+/*   after flacd_Init.                                                      */
 /*==========================================================================*/
+#define FLACD_FORMAT_SAMPLE_RATE		0x0001u
+#define FLACD_FORMAT_CHANNELS			0x0002u
+#define FLACD_FORMAT_BITS_PER_SAMPLE	0x0004u
+
 typedef struct {
 	ACMW_UINT32 nSampleRate;
 	ACMW_UINT32 nDecodedSamples;
 	ACMW_UINT16 nChannels;
 	ACMW_UINT16 nChannelInfo;
 	ACMW_UINT16 nBitsPerSample;
+	ACMW_UINT32 nRemainSamples;
+	ACMW_UINT32 nSamplePosition;
+	ACMW_UINT16 nSilentChannels;
+	ACMW_UINT16 nFormatChange;
 } flacd_decStatusInfo;
 
 
+/*==========================================================================*/
+/*      Define Struct flacd_outputRingInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Output Ring Buffer Information Structure                               */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Describes an output area such as an audio device mmap ring. Units are  */
+/*   frames (one sample of every channel).                                  */
+/*   nStride      : distance in samples between two frames of a channel.    */
+/*                  0 selects 1 (planar) or the output channels             */
+/*                  (interleaved).                                          */
+/*   nRingFrames  : ring length. Writes past the end wrap to the base.      */
+/*                  0 means no wrap.                                        */
+/*   nWritePos    : frame where the decoded block is written.               */
+/*   nAvailFrames : writable frames from nWritePos.                         */
+/*   The next write position is (nWritePos + nDecodedSamples) % nRingFrames.*/
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nStride;
+	ACMW_UINT32	nRingFrames;
+	ACMW_UINT32	nWritePos;
+	ACMW_UINT32	nAvailFrames;
+} flacd_outputRingInfo;
+
+
 /*==========================================================================*/
 /*      Define Struct flacd_ioBufferCoufigInfo                             */
 /*==========================================================================*/
@@ -156,7 +241,8 @@ typedef struct {
 /*   Buffer Information Structure                                           */
 /*                                                                          */
 /* [Note]                                                                   */
-/*   non                                                                    */
+/*   flacd_DecodeRing : pOutBuffStart are the bases of the output area      */
+/*   described by its flacd_outputRingInfo, nOutBuffSize is not used.       */
 /*==========================================================================*/
 typedef struct {
 	ACMW_UINT8	*pInBuffStart;
@@ -183,6 +269,709 @@ typedef struct {
 } flacd_ioBufferStatusInfo;
 
 
+/*==========================================================================*/
+/*      Define Struct flacd_spanInfo                                       */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Input / Output Span Structure for flacd_DecodeSpan                     */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pOutBuff and nOutSize are used as pOutBuffStart and nOutBuffSize of    */
+/*   flacd_ioBufferConfigInfo, with the ring buffer of the session.         */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT8	*pInBuff;
+	ACMW_UINT32	nInSize;
+	void		**pOutBuff;
+	ACMW_UINT32	nOutSize;
+} flacd_spanInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_headerConfigInfo                               */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Header Parse Config Information Structure                              */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pInBuffStart holds nInBuffSetDataSize bytes of the stream from byte    */
+/*   nInBuffOffset. The bytes are only read during the call.                */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	ACMW_UINT32	nInBuffOffset;
+} flacd_headerConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_headerStatusInfo                               */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Header Parse Status Information Structure                              */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Clear to 0 before the first flacd_ParseHeader call of a stream.        */
+/*   sDecConfig is filled from STREAMINFO and can be given to flacd_Decode  */
+/*   as is. nTotalSamples is 0 when unknown. Sample positions are 32 bit:   */
+/*   a stream of 2^32 samples or more is rejected.                          */
+/*   nAudioOffset is the offset of the first frame. nSeekTableOffset and    */
+/*   nSeekPoints locate the SEEKTABLE points (nSeekPoints == 0 : none).     */
+/*   nNextOffset and nNeedSize tell the bytes the next call must be given   */
+/*   when more input is needed. Offsets are from the start of the stream.   */
+/*==========================================================================*/
+typedef struct {
+	flacd_decConfigInfo	sDecConfig;
+	ACMW_UINT32	nTotalSamples;
+	ACMW_UINT8	nMD5Signature[16];
+	ACMW_UINT32	nAudioOffset;
+	ACMW_UINT32	nSeekTableOffset;
+	ACMW_UINT32	nSeekPoints;
+	ACMW_UINT32	nNextOffset;
+	ACMW_UINT32	nNeedSize;
+	ACMW_UINT32	nParseState;
+} flacd_headerStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_streamConfigInfo                                */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Stream Decode Config Information Structure                             */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pInBuffStart holds a whole stream of nInBuffSetDataSize bytes, from    */
+/*   its "fLaC" marker (or ID3v2 tag) or from its first frame.              */
+/*   pDecConfigInfo is only used for a stream that starts with a frame      */
+/*   (NULL otherwise).                                                      */
+/*   pOutBuffStart and nOutBuffSize are as in flacd_ioBufferConfigInfo; all */
+/*   the samples are written one frame after the other from the start.      */
+/*   pOutBuffStart == NULL only gets nOutBuffNeedSize.                      */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	const flacd_decConfigInfo	*pDecConfigInfo;
+	void		**pOutBuffStart;
+	ACMW_UINT32	nOutBuffSize;
+} flacd_streamConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_streamStatusInfo                                */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Stream Decode Status Information Structure                             */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   sDecConfig is the stream configuration used and nTotalSamples the      */
+/*   total samples of STREAMINFO (0 : unknown, or no STREAMINFO).           */
+/*   nOutBuffNeedSize is the output size per buffer for nTotalSamples       */
+/*   samples; when they are unknown the stream is decoded until             */
+/*   nOutBuffSize is full.                                                  */
+/*   nDecodedSamples is the number of samples output.                       */
+/*==========================================================================*/
+typedef struct {
+	flacd_decConfigInfo	sDecConfig;
+	ACMW_UINT32	nTotalSamples;
+	ACMW_UINT32	nDecodedSamples;
+	ACMW_UINT32	nOutBuffNeedSize;
+	ACMW_UINT32	nOutBuffUsedDataSize;
+	ACMW_UINT32	nInBuffUsedDataSize;
+} flacd_streamStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_seekConfigInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Seek Config Information Structure                                      */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pSeekTable holds the nSeekPoints SEEKTABLE points read from            */
+/*   nSeekTableOffset (see flacd_headerStatusInfo). It is only read during  */
+/*   the call. nSeekPoints == 0 seeks from nAudioOffset.                    */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nTargetSample;
+	ACMW_UINT8	*pSeekTable;
+	ACMW_UINT32	nSeekPoints;
+	ACMW_UINT32	nAudioOffset;
+} flacd_seekConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_seekStatusInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Seek Status Information Structure                                      */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nInBuffOffset is the stream offset to give flacd_Decode input from.    */
+/*   The frame there starts at sample nSeekSample.                          */
+/*   nNeedSize != 0 (flacd_SeekBisect) : the seek is not finished; give the */
+/*   next call nNeedSize bytes from nInBuffOffset.                          */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nInBuffOffset;
+	ACMW_UINT32	nSeekSample;
+	ACMW_UINT32	nNeedSize;
+} flacd_seekStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_bisectConfigInfo                               */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Bisection Seek Config Information Structure                            */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pHeaderInfo is the result of flacd_ParseHeader for the stream and      */
+/*   nStreamSize the size of the whole stream in bytes.                     */
+/*   pInBuffStart holds the bytes requested by the previous call            */
+/*   (nNeedSize bytes from nInBuffOffset, fewer at the end of the stream).  */
+/*   It is NULL on the first call of a seek.                                */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nTargetSample;
+	const flacd_headerStatusInfo	*pHeaderInfo;
+	ACMW_UINT32	nStreamSize;
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+} flacd_bisectConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_indexBuildConfigInfo                           */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Index Build Config Information Structure                         */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pInBuffStart holds nInBuffSetDataSize bytes of the stream from byte    */
+/*   nInBuffOffset, which must not be after nNextOffset of the status.      */
+/*   pHeaderInfo is the result of flacd_ParseHeader for the stream.         */
+/*   nInterval is the minimum distance in samples between two entries       */
+/*   (0 : every frame).                                                     */
+/*   pIndex receives the index. It needs FLACD_INDEX_HEADER_SIZE bytes and  */
+/*   FLACD_INDEX_ENTRY_SIZE bytes per entry; at most one entry is made per  */
+/*   frame and per nInterval samples.                                       */
+/*==========================================================================*/
+#define FLACD_INDEX_HEADER_SIZE			48
+#define FLACD_INDEX_ENTRY_SIZE			8
+
+typedef struct {
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	ACMW_UINT32	nInBuffOffset;
+	const flacd_headerStatusInfo	*pHeaderInfo;
+	ACMW_UINT32	nStreamSize;
+	ACMW_UINT32	nInterval;
+	ACMW_UINT8	*pIndex;
+	ACMW_UINT32	nIndexSize;
+} flacd_indexBuildConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_indexBuildStatusInfo                           */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Index Build Status Information Structure                         */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Clear to 0 before the first flacd_IndexBuild call of a stream.         */
+/*   nNextOffset is where the input of the next call must start.            */
+/*   nIndexUsedSize is the size of the finished index.                      */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nNextOffset;
+	ACMW_UINT32	nNextSample;
+	ACMW_UINT32	nLastEntrySample;
+	ACMW_UINT32	nEntries;
+	ACMW_UINT32	nIndexUsedSize;
+	ACMW_UINT32	nBuildState;
+} flacd_indexBuildStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_indexSeekConfigInfo                            */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Index Seek Config Information Structure                          */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pIndex is an index made by flacd_IndexBuild, e.g. a read-only mapping  */
+/*   of its file. It is only read during the call.                          */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nTargetSample;
+	const ACMW_UINT8	*pIndex;
+	ACMW_UINT32	nIndexSize;
+} flacd_indexSeekConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_rangeConfigInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Range Read Config Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pIndex is an index made by flacd_IndexBuild for the stream and         */
+/*   pDecConfigInfo its configuration. pInBuffStart holds                   */
+/*   nInBuffSetDataSize bytes of the stream from byte nInBuffOffset, at     */
+/*   least nNeedSize bytes from nNeedOffset (see flacd_rangeStatusInfo),    */
+/*   e.g. a read-only mapping of the file. pInBuffStart == NULL only gets   */
+/*   nNeedOffset and nNeedSize.                                             */
+/*   pOutBuffStart and nOutBuffSize are as in flacd_ioBufferConfigInfo and  */
+/*   hold nEndSample - nStartSample samples.                                */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nStartSample;
+	ACMW_UINT32	nEndSample;
+	const ACMW_UINT8	*pIndex;
+	ACMW_UINT32	nIndexSize;
+	const flacd_decConfigInfo	*pDecConfigInfo;
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	ACMW_UINT32	nInBuffOffset;
+	void		**pOutBuffStart;
+	ACMW_UINT32	nOutBuffSize;
+} flacd_rangeConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_rangeStatusInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Range Read Status Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nNeedOffset and nNeedSize are the stream bytes of the frames covering  */
+/*   the range. nDecodedSamples is the number of samples output.            */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nNeedOffset;
+	ACMW_UINT32	nNeedSize;
+	ACMW_UINT32	nDecodedSamples;
+	ACMW_UINT32	nOutBuffUsedDataSize;
+} flacd_rangeStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_skipConfigInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Skip Config Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nMaxFrames is the largest number of frames to skip (0 : as many as the */
+/*   input holds).                                                          */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	ACMW_UINT32	nMaxFrames;
+} flacd_skipConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_skipStatusInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Skip Status Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nInBuffUsedDataSize is the offset in the input of the first frame not  */
+/*   skipped, and nSamplePosition its first sample.                         */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nInBuffUsedDataSize;
+	ACMW_UINT32	nSkippedFrames;
+	ACMW_UINT32	nSkippedSamples;
+	ACMW_UINT32	nSamplePosition;
+} flacd_skipStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_channelMixConfigInfo                           */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Channel Mix Config Information Structure                               */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nMixMode : 0 off, 1 matrix, 2 remap, 3 preset 5.1->2.0,                */
+/*              4 preset 4.0->2.0.                                          */
+/*   Matrix : output channel j = sum of fMatrix[j][i] * input channel i.    */
+/*            Applied to frames with nInChannels channels only, other       */
+/*            frames are output unmixed. PCM output is saturated.           */
+/*   Remap  : output channel j = input channel nRemap[j], -1 is silence.    */
+/*   Output channels from nOutChannels up to the initialized number of      */
+/*   output channels are silence. Presets ignore the other members.         */
+/*==========================================================================*/
+#define FLACD_MIX_MAX_CHANNELS			6
+
+typedef struct {
+	ACMW_UINT16		nMixMode;
+	ACMW_UINT16		nInChannels;
+	ACMW_UINT16		nOutChannels;
+	ACMW_INT16		nRemap[FLACD_MIX_MAX_CHANNELS];
+	ACMW_FLOAT32	fMatrix[FLACD_MIX_MAX_CHANNELS][FLACD_MIX_MAX_CHANNELS];
+} flacd_channelMixConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_frameCacheConfigInfo                            */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Cache Config Information Structure                               */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nCacheMode : 0 off, 1 on, 2 bypass (the cache is kept but neither      */
+/*                looked up nor filled, for streams that do not repeat).    */
+/*   pCache holds nCacheSize bytes: FLACD_FRAMECACHE_HEADER_SIZE bytes and  */
+/*   one slot per decoded frame kept. Clear it to 0 before its first use.   */
+/*   Memory that already holds a cache with the same slots is used as it    */
+/*   is, so a cache can be kept over flacd_Init and used by several         */
+/*   instances in turn; it is not locked by the FLACD SW.IP.                */
+/*   nMaxBlockSize and nMaxFrameSize size the slots, as in                  */
+/*   flacd_decConfigInfo (0 : the largest block size of the instance, the   */
+/*   largest frame of such blocks). A slot takes                            */
+/*   FLACD_FRAMECACHE_ENTRY_SIZE bytes, nMaxFrameSize bytes rounded up to   */
+/*   a multiple of 8 and nMaxBlockSize * 4 bytes per decoded channel        */
+/*   (nSlotSize of flacd_frameCacheStatusInfo). Frames larger than a slot   */
+/*   are decoded but not kept.                                              */
+/*==========================================================================*/
+#define FLACD_FRAMECACHE_HEADER_SIZE	32
+#define FLACD_FRAMECACHE_ENTRY_SIZE		72
+
+typedef struct {
+	void		*pCache;
+	ACMW_UINT32	nCacheSize;
+	ACMW_UINT16	nCacheMode;
+	ACMW_UINT16	nMaxBlockSize;
+	ACMW_UINT32	nMaxFrameSize;
+} flacd_frameCacheConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_frameCacheStatusInfo                            */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Cache Status Information Structure                               */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nSlotSize is the size of the slots of the cache set by                 */
+/*   flacd_SetFrameCache, else of a slot for the largest frame of the       */
+/*   instance. The other members describe the cache set (0 : none). nHits   */
+/*   and nMisses count the frames looked up, nEvictions the least recently  */
+/*   used entries replaced.                                                 */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nSlotSize;
+	ACMW_UINT32	nSlots;
+	ACMW_UINT32	nEntries;
+	ACMW_UINT32	nHits;
+	ACMW_UINT32	nMisses;
+	ACMW_UINT32	nEvictions;
+} flacd_frameCacheStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_overviewBucket                                  */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Waveform Overview Bucket Structure                                     */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Per channel of the stream (FLAC channel order, before the channel mix  */
+/*   and the output gain): nMin and nMax are the decoded sample values at   */
+/*   the bits per sample of the stream, fSumSquares the sum of the squares  */
+/*   of the samples scaled to full scale 1.0 (RMS = sqrt(fSumSquares /      */
+/*   nSamples)). Channels that are not decoded and frames with a CRC error  */
+/*   count as silence, as they are output. nSamples is the number of        */
+/*   sample periods counted.                                                */
+/*==========================================================================*/
+#define FLACD_OVERVIEW_MAX_CHANNELS		6
+
+typedef struct {
+	ACMW_INT32		nMin[FLACD_OVERVIEW_MAX_CHANNELS];
+	ACMW_INT32		nMax[FLACD_OVERVIEW_MAX_CHANNELS];
+	ACMW_FLOAT32	fSumSquares[FLACD_OVERVIEW_MAX_CHANNELS];
+	ACMW_UINT32		nSamples;
+} flacd_overviewBucket;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_overviewConfigInfo                              */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Waveform Overview Config Information Structure                         */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nOverviewMode : 0 off, 1 on, 2 on without PCM output (the output       */
+/*                   buffers are neither written nor checked for room).     */
+/*   The decoded samples of stream position p go to pBuckets[p /            */
+/*   nBucketSamples]; positions from nBuckets * nBucketSamples on are not   */
+/*   counted. A bucket is started when its nSamples is 0, so clear the      */
+/*   buckets to 0 before the decode. Samples decoded again after a seek are */
+/*   counted again.                                                         */
+/*==========================================================================*/
+typedef struct {
+	flacd_overviewBucket	*pBuckets;
+	ACMW_UINT32	nBuckets;
+	ACMW_UINT32	nBucketSamples;
+	ACMW_UINT16	nOverviewMode;
+} flacd_overviewConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_frameTestInfo                                   */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Test Result Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   One frame checked by the frame test (flacd_SetVerify mode 2).          */
+/*   nFrameResult : FLACD_FRAMETEST_*. A frame that fails before its        */
+/*   CRC-16 (header CRC-8, unparseable subframe) is given the sample after  */
+/*   the last frame checked and nBlockSize 0. The sync patterns met while   */
+/*   the decoder searches for the next frame are not counted again.         */
+/*==========================================================================*/
+#define FLACD_FRAMETEST_PASS			0x0000u
+#define FLACD_FRAMETEST_CRC				0x0001u
+#define FLACD_FRAMETEST_HEADER			0x0002u
+#define FLACD_FRAMETEST_UNPARSEABLE		0x0003u
+
+typedef struct {
+	ACMW_UINT32	nFirstSample;
+	ACMW_UINT16	nBlockSize;
+	ACMW_UINT16	nFrameResult;
+} flacd_frameTestInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_verifyConfigInfo                                */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Verify Config Information Structure                                    */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nVerifyMode : 0 off, 1 MD5 of the decoded samples, 2 frame test.       */
+/*   pHeaderInfo is the result of flacd_ParseHeader for the stream; its     */
+/*   nMD5Signature and nTotalSamples are copied. The signature is computed  */
+/*   as STREAMINFO defines it: the samples of all channels interleaved,     */
+/*   each in (bits per sample + 7) / 8 bytes little-endian. It is restarted */
+/*   whenever sample 0 is decoded.                                          */
+/*   The frame test only parses each frame and checks its CRC-8 and CRC-16; */
+/*   no sample is reconstructed or output. pHeaderInfo is not used; the     */
+/*   result of each frame is stored in pFrames[] until nFrames are stored   */
+/*   (pFrames == NULL : counts only).                                       */
+/*==========================================================================*/
+typedef struct {
+	const flacd_headerStatusInfo	*pHeaderInfo;
+	ACMW_UINT16	nVerifyMode;
+	flacd_frameTestInfo	*pFrames;
+	ACMW_UINT32	nFrames;
+} flacd_verifyConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_verifyStatusInfo                                */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Verify Status Information Structure                                    */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nVerifyResult : FLACD_VERIFY_*. The signature is compared when         */
+/*   nTotalSamples samples have been verified, or at each call when the     */
+/*   total is unknown. A seek, a channel that is not decoded (channel mask, */
+/*   fewer decoded channels) or a 4 channel stream output to 3 channels     */
+/*   make the rest of the stream unverifiable (INCOMPLETE) until sample 0   */
+/*   is decoded again. Frames with a CRC error are verified as the mute     */
+/*   data they are output as. nMD5Signature is the signature of the         */
+/*   nVerifiedSamples samples verified.                                     */
+/*   In the frame test nVerifiedSamples counts the samples of the frames    */
+/*   checked, and nVerifyResult is MATCH while no frame failed (PENDING     */
+/*   before the first), else MISMATCH. nTestedFrames and nFailedFrames      */
+/*   count the frames checked and failed; both are 0 in the MD5 mode. A     */
+/*   frame that does not start at the sample after the last frame checked   */
+/*   fails, unless the loss of the frames between was counted already.      */
+/*==========================================================================*/
+#define FLACD_VERIFY_OFF				0x0000u
+#define FLACD_VERIFY_PENDING			0x0001u
+#define FLACD_VERIFY_MATCH				0x0002u
+#define FLACD_VERIFY_MISMATCH			0x0003u
+#define FLACD_VERIFY_INCOMPLETE			0x0004u
+#define FLACD_VERIFY_NO_SIGNATURE		0x0005u
+
+typedef struct {
+	ACMW_UINT32	nVerifiedSamples;
+	ACMW_UINT16	nVerifyResult;
+	ACMW_UINT8	nMD5Signature[16];
+	ACMW_UINT32	nTestedFrames;
+	ACMW_UINT32	nFailedFrames;
+} flacd_verifyStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_voiceConfigInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Mix Voice Config Information Structure                                 */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   One stream added by flacd_DecodeMix. pWorkMemInfo is its initialized   */
+/*   instance; pDecConfigInfo, pInBuffStart and nInBuffSetDataSize are as   */
+/*   for flacd_Decode. fGain scales the voice (1.0 : as decoded, 0.0 : the  */
+/*   voice is decoded but adds nothing).                                    */
+/*==========================================================================*/
+typedef struct {
+	const flacd_workMemoryInfo	*pWorkMemInfo;
+	const flacd_decConfigInfo	*pDecConfigInfo;
+	ACMW_UINT8	*pInBuffStart;
+	ACMW_UINT32	nInBuffSetDataSize;
+	ACMW_FLOAT32	fGain;
+} flacd_voiceConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_voiceStatusInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Mix Voice Status Information Structure                                 */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nResult is the Error Code of the voice, its Error Factor is got with   */
+/*   flacd_GetErrorFactor. nDecodedSamples samples were added from the      */
+/*   start of the output; a voice that ran out of input added nothing to    */
+/*   the rest. nRemainSamples samples of its last frame did not fit and     */
+/*   are added first by the next call.                                      */
+/*==========================================================================*/
+typedef struct {
+	ACMW_INT32	nResult;
+	ACMW_UINT32	nDecodedSamples;
+	ACMW_UINT32	nRemainSamples;
+	ACMW_UINT32	nInBuffUsedDataSize;
+} flacd_voiceStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_mixConfigInfo                                   */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Mix Decode Config Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pVoices holds nVoices voices, each with its own instance. All of them  */
+/*   are initialized with the same output format, layout and number of      */
+/*   output channels; the channel mask and channel mix are per voice.       */
+/*   pOutBuffStart and nOutBuffSize are as in flacd_ioBufferConfigInfo;     */
+/*   nOutBuffSize / (size of one sample period) samples are mixed.          */
+/*   nOutMode : 0 clear the output first, 1 add to the samples it holds.    */
+/*   Each voice is added in turn; PCM output saturates at each addition.    */
+/*==========================================================================*/
+#define FLACD_MIXOUT_CLEAR				0x0000u
+#define FLACD_MIXOUT_ADD				0x0001u
+
+typedef struct {
+	const flacd_voiceConfigInfo	*pVoices;
+	ACMW_UINT32	nVoices;
+	void		**pOutBuffStart;
+	ACMW_UINT32	nOutBuffSize;
+	ACMW_UINT16	nOutMode;
+} flacd_mixConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_mixStatusInfo                                   */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Mix Decode Status Information Structure                                */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pVoices has nVoices entries, set for each voice. nMixedSamples is the  */
+/*   number of samples mixed, nOutBuffUsedDataSize their size per buffer.   */
+/*==========================================================================*/
+typedef struct {
+	flacd_voiceStatusInfo	*pVoices;
+	ACMW_UINT32	nMixedSamples;
+	ACMW_UINT32	nOutBuffUsedDataSize;
+} flacd_mixStatusInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_scratchPoolInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Scratch Pool Information Structure                                     */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pMemory holds nBlocks scratch blocks of nBlockSize bytes. nBlockSize   */
+/*   is at least the largest nScratchSize of the instances served and a     */
+/*   multiple of 8. pOwner has nBlocks entries, all NULL before first use.  */
+/*   The pool is not locked by the FLACD SW.IP; keep one pool per worker    */
+/*   thread or serialize the calls on a shared pool.                        */
+/*   A block lent to an instance that stops in the middle of a frame is     */
+/*   freed at once when the rest of the frame fits in the carry buffer of   */
+/*   the instance (see flacd_carryConfigInfo), else it stays pinned to the  */
+/*   instance until the frame is output.                                    */
+/*==========================================================================*/
+typedef struct {
+	void		*pMemory;
+	const void	**pOwner;
+	ACMW_UINT32	nBlockSize;
+	ACMW_UINT32	nBlocks;
+} flacd_scratchPoolInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_carryConfigInfo                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Scratch Carry Config Information Structure                             */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pCarry holds nCarrySize bytes of the instance, 4 byte aligned. When    */
+/*   flacd_ReleaseScratch is called with samples of the frame remaining,    */
+/*   they are finished and moved there, 4 bytes per sample for each         */
+/*   decoded channel: (frame size - output buffer size in samples) x        */
+/*   nDecodeChannels x 4 bytes covers every frame. pCarry == NULL: none.    */
+/*==========================================================================*/
+typedef struct {
+	void		*pCarry;
+	ACMW_UINT32	nCarrySize;
+} flacd_carryConfigInfo;
+
+
+/*==========================================================================*/
+/*      Define Struct flacd_slabPoolInfo                                   */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Slab Pool Information Structure                                        */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Managed by the flacd_Slab* functions only. Each slab added to the pool */
+/*   is carved into fixed-size static memory slots, at most 4096 per slab;  */
+/*   an instance is named by a flacd_handle. Handles of destroyed instances */
+/*   are detected as stale until the slot has been reused 65535 times. The  */
+/*   pool is not locked by the FLACD SW.IP.                                 */
+/*==========================================================================*/
+#define FLACD_SLAB_MAX_SLABS			16
+#define FLACD_INVALID_HANDLE			((flacd_handle)0u)
+
+typedef ACMW_UINT32 flacd_handle;
+
+typedef struct {
+	ACMW_UINT8	*pSlab[FLACD_SLAB_MAX_SLABS];
+	ACMW_UINT32	nSlabSlots[FLACD_SLAB_MAX_SLABS];
+	ACMW_UINT32	nSlabs;
+	ACMW_UINT32	nSlotSize;
+	ACMW_UINT32	nFreeHead;
+	ACMW_UINT32	nFreeSlots;
+} flacd_slabPoolInfo;
+
+
 /*==========================================================================*/
 /*      API Function Prototype                                              */
 /*==========================================================================*/
@@ -198,6 +987,108 @@ extern ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo* const pWorkMemInfo,
                     flacd_decStatusInfo* const pDecStatusInfo,
                     flacd_ioBufferStatusInfo* const pBuffStatusInfo);
 
+extern ACMW_INT32 flacd_DecodeRing(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_decConfigInfo* const pDecConfigInfo,
+                    const flacd_ioBufferConfigInfo* const pBuffConfigInfo,
+                    const flacd_outputRingInfo* const pOutRing,
+                    flacd_decStatusInfo* const pDecStatusInfo,
+                    flacd_ioBufferStatusInfo* const pBuffStatusInfo);
+
+extern ACMW_INT32 flacd_OpenSession(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_decConfigInfo* const pDecConfigInfo,
+                    const flacd_outputRingInfo* const pOutRing);
+
+extern ACMW_INT32 flacd_DecodeSpan(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_spanInfo* const pSpanInfo,
+                    flacd_decStatusInfo* const pDecStatusInfo,
+                    flacd_ioBufferStatusInfo* const pBuffStatusInfo);
+
+extern ACMW_INT32 flacd_DecodeStream(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_streamConfigInfo* const pStreamConfigInfo,
+                    flacd_streamStatusInfo* const pStreamStatusInfo);
+
+extern ACMW_INT32 flacd_DecodeMix(const flacd_mixConfigInfo* const pMixConfigInfo,
+                    flacd_mixStatusInfo* const pMixStatusInfo);
+
+extern ACMW_INT32 flacd_ParseHeader(const flacd_headerConfigInfo* const pHeaderConfigInfo,
+                    flacd_headerStatusInfo* const pHeaderStatusInfo);
+
+extern ACMW_INT32 flacd_Seek(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_seekConfigInfo* const pSeekConfigInfo,
+                    flacd_seekStatusInfo* const pSeekStatusInfo);
+
+extern ACMW_INT32 flacd_SeekBisect(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_bisectConfigInfo* const pBisectConfigInfo,
+                    flacd_seekStatusInfo* const pSeekStatusInfo);
+
+extern ACMW_INT32 flacd_IndexBuild(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_indexBuildConfigInfo* const pIndexBuildConfigInfo,
+                    flacd_indexBuildStatusInfo* const pIndexBuildStatusInfo);
+
+extern ACMW_INT32 flacd_IndexCheck(const ACMW_UINT8* const pIndex, const ACMW_UINT32 nIndexSize,
+                    const flacd_headerStatusInfo* const pHeaderInfo, const ACMW_UINT32 nStreamSize,
+                    const ACMW_BOOL bVerifyChecksum);
+
+extern ACMW_INT32 flacd_SeekIndex(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_indexSeekConfigInfo* const pIndexSeekConfigInfo,
+                    flacd_seekStatusInfo* const pSeekStatusInfo);
+
+extern ACMW_INT32 flacd_ReadRange(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_rangeConfigInfo* const pRangeConfigInfo,
+                    flacd_rangeStatusInfo* const pRangeStatusInfo);
+
+extern ACMW_INT32 flacd_Skip(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_decConfigInfo* const pDecConfigInfo,
+                    const flacd_skipConfigInfo* const pSkipConfigInfo,
+                    flacd_skipStatusInfo* const pSkipStatusInfo);
+
+extern ACMW_INT32 flacd_SetChannelMask(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const ACMW_UINT32 nChannelMask);
+
+extern ACMW_INT32 flacd_SetChannelMix(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_channelMixConfigInfo* const pMixConfigInfo);
+
+extern ACMW_INT32 flacd_SetFormatChange(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const ACMW_UINT16 nFormatChangeMode);
+
+extern ACMW_INT32 flacd_SetFrameCache(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_frameCacheConfigInfo* const pCacheConfigInfo);
+
+extern ACMW_INT32 flacd_GetFrameCacheStatus(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    flacd_frameCacheStatusInfo* const pCacheStatusInfo);
+
+extern ACMW_INT32 flacd_SetOverview(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_overviewConfigInfo* const pOverviewConfigInfo);
+
+extern ACMW_INT32 flacd_SetVerify(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_verifyConfigInfo* const pVerifyConfigInfo);
+
+extern ACMW_INT32 flacd_GetVerifyStatus(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    flacd_verifyStatusInfo* const pVerifyStatusInfo);
+
+extern ACMW_INT32 flacd_AcquireScratch(flacd_workMemoryInfo* const pWorkMemInfo,
+                    flacd_scratchPoolInfo* const pScratchPoolInfo);
+
+extern ACMW_INT32 flacd_ReleaseScratch(flacd_workMemoryInfo* const pWorkMemInfo,
+                    flacd_scratchPoolInfo* const pScratchPoolInfo);
+
+extern ACMW_INT32 flacd_SetScratchCarry(const flacd_workMemoryInfo* const pWorkMemInfo,
+                    const flacd_carryConfigInfo* const pCarryConfigInfo);
+
+extern ACMW_INT32 flacd_SlabInit(flacd_slabPoolInfo* const pSlabPoolInfo);
+
+extern ACMW_INT32 flacd_SlabAddMemory(flacd_slabPoolInfo* const pSlabPoolInfo,
+                    void* const pMemory, const ACMW_UINT32 nMemorySize);
+
+extern ACMW_INT32 flacd_SlabCreate(flacd_slabPoolInfo* const pSlabPoolInfo,
+                    flacd_handle* const pHandle);
+
+extern ACMW_INT32 flacd_SlabDestroy(flacd_slabPoolInfo* const pSlabPoolInfo,
+                    const flacd_handle nHandle);
+
+extern void* flacd_SlabGetStatic(const flacd_slabPoolInfo* const pSlabPoolInfo,
+                    const flacd_handle nHandle);
+
 extern ACMW_UINT32 flacd_GetErrorFactor(const flacd_workMemoryInfo* const pWorkMemInfo);
 
 extern ACMW_UINT32 flacd_GetVersion(void);
@@ -533,13 +533,23 @@ FLAC_API FLAC__bool FLAC__stream_decoder_reset(FLAC__StreamDecoder *decoder);
 
 #if 1
 FLAC_API void FLAC__stream_decoder_set_supported_channels(FLAC__StreamDecoder* const decoder, unsigned const input_channels, unsigned const output_channels);
+FLAC_API void FLAC__stream_decoder_set_supported_blocksize(FLAC__StreamDecoder* const decoder, unsigned const max_blocksize);
 FLAC_API void FLAC__stream_decoder_set_streaminfo(FLAC__StreamDecoder* const decoder, const flacd_decConfigInfo* const pDecConfigInfo);
 FLAC_API FLAC__StreamDecoderErrorStatus FLAC__stream_decoder_get_error_state(const FLAC__StreamDecoder* const decoder);
 FLAC_API void FLAC__stream_decoder_allocate_rice_contents(FLAC__StreamDecoder* const decoder, unsigned ** const pParameters, unsigned ** const pRaw_bits);
 FLAC_API void FLAC__stream_decoder_allocate_residual(FLAC__StreamDecoder* const decoder, FLAC__int32** const pResidual);
+FLAC_API void FLAC__stream_decoder_allocate_frame(FLAC__StreamDecoder* const decoder, FLAC__Frame* const pFrame);
 FLAC_API void FLAC__stream_decoder_allocate_output(FLAC__StreamDecoder* const decoder, FLAC__int32** const pOutput);
 FLAC_API FLAC__bool FLAC__stream_decoder_process_frame_sync(FLAC__StreamDecoder* const decoder);
 FLAC_API FLAC__bool FLAC__stream_decoder_process_read_frame(FLAC__StreamDecoder* const decoder, FLAC__bool* const got_a_frame);
+FLAC_API void FLAC__stream_decoder_finish_block(FLAC__StreamDecoder* const decoder, unsigned const offset, unsigned const length);
+FLAC_API FLAC__bool FLAC__stream_decoder_process_frame_header(FLAC__StreamDecoder* const decoder, FLAC__bool* const got_a_header);
+FLAC_API FLAC__uint64 FLAC__stream_decoder_get_sample_number(const FLAC__StreamDecoder* const decoder);
+FLAC_API unsigned FLAC__stream_decoder_get_frame_blocksize(const FLAC__StreamDecoder* const decoder);
+FLAC_API void FLAC__stream_decoder_set_channel_mask(FLAC__StreamDecoder* const decoder, FLAC__uint32 const mask);
+FLAC_API void FLAC__stream_decoder_set_format_change(FLAC__StreamDecoder* const decoder, FLAC__bool const accept);
+FLAC_API FLAC__int32 *FLAC__stream_decoder_get_channel_data(const FLAC__StreamDecoder* const decoder, unsigned const channel);
+FLAC_API FLAC__bool FLAC__stream_decoder_get_channel_constant(const FLAC__StreamDecoder* const decoder, unsigned const channel, FLAC__int32* const value);
 #endif
 /* \} */
 
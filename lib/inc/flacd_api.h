@@ -16,10 +16,11 @@
 #include "private/stream_decoder.h"
 #include "private/bitreader.h"
 #include "flacd_Lib.h"
+#include "flacd_memory.h"
 
 #define FLACD_CUSTOMERID			((ACMW_UINT32)0x00000000U)
 #define FLACD_RELEASEID				((ACMW_UINT32)0x00000000U)
-#define FLACD_MAJOR					((ACMW_UINT32)0x00000002U)
+#define FLACD_MAJOR					((ACMW_UINT32)0x00000003U)
 #define FLACD_MINOR					((ACMW_UINT32)0x00000000U)
 
 #define FLACD_IDSTRINGS_LENGTH		200
@@ -27,7 +28,7 @@
 #define FLACD_ID_STRINGS	"FLAC Decode Software " \
 							"Copyright(C) 2014 Renesas Electronics Corporation."
 #else	/* other */
-#define FLACD_ID_STRINGS			"IDStrings : FLAC Decoder Version 2.00"
+#define FLACD_ID_STRINGS			"IDStrings : FLAC Decoder Version 3.00"
 #endif
 
 typedef signed long					COMM_ADR_SIZE;
@@ -44,6 +45,33 @@ typedef signed long					COMM_ADR_SIZE;
 #define FLACD_INITCFG_2CHOUT		((ACMW_UINT32)0x00000000U)
 #define FLACD_INITCFG_3CHOUT		((ACMW_UINT32)0x00000001U)
 #define FLACD_INITCFG_6CHOUT		((ACMW_UINT32)0x00000002U)
+#define FLACD_INITCFG_OUTFMT_PCM	((ACMW_UINT32)0x00000000U)
+#define FLACD_INITCFG_OUTFMT_FLOAT32	((ACMW_UINT32)0x00000001U)
+#define FLACD_INITCFG_PLANAR		((ACMW_UINT32)0x00000000U)
+#define FLACD_INITCFG_INTERLEAVED	((ACMW_UINT32)0x00000001U)
+#define FLACD_INITCFG_GAIN_UNITY	((ACMW_UINT32)0x00000000U)
+#define FLACD_INITCFG_GAIN_LINEAR	((ACMW_UINT32)0x00000001U)
+
+#define FLACD_MIXCFG_OFF			((ACMW_UINT32)0x00000000U)
+#define FLACD_MIXCFG_MATRIX			((ACMW_UINT32)0x00000001U)
+#define FLACD_MIXCFG_REMAP			((ACMW_UINT32)0x00000002U)
+#define FLACD_MIXCFG_5_1_TO_2_0		((ACMW_UINT32)0x00000003U)
+#define FLACD_MIXCFG_4_0_TO_2_0		((ACMW_UINT32)0x00000004U)
+
+#define FLACD_CACHECFG_OFF			((ACMW_UINT32)0x00000000U)
+#define FLACD_CACHECFG_ON			((ACMW_UINT32)0x00000001U)
+#define FLACD_CACHECFG_BYPASS		((ACMW_UINT32)0x00000002U)
+
+#define FLACD_OVERVIEWCFG_OFF		((ACMW_UINT32)0x00000000U)
+#define FLACD_OVERVIEWCFG_ON		((ACMW_UINT32)0x00000001U)
+#define FLACD_OVERVIEWCFG_NO_OUTPUT	((ACMW_UINT32)0x00000002U)
+
+#define FLACD_VERIFYCFG_OFF			((ACMW_UINT32)0x00000000U)
+#define FLACD_VERIFYCFG_MD5			((ACMW_UINT32)0x00000001U)
+#define FLACD_VERIFYCFG_FRAMES		((ACMW_UINT32)0x00000002U)
+
+#define FLACD_FORMATCFG_REJECT		((ACMW_UINT32)0x00000000U)
+#define FLACD_FORMATCFG_ACCEPT		((ACMW_UINT32)0x00000001U)
 
 #define FLACD_2CHIN					((ACMW_UINT32)0x00000002U)
 #define FLACD_6CHIN					((ACMW_UINT32)0x00000006U)
@@ -70,9 +98,10 @@ typedef signed long					COMM_ADR_SIZE;
 
 #define FLACD_MIN_INBUFF_SIZE		((ACMW_UINT32)0x00000002U)
 
-#define FLACD_INBUFF_DATA_SIZE		((ACMW_UINT32)(FLAC__SPEC_MAX_BLOCK_SIZE * (FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE >> 3)))		/* RCG3AFLDL4001ZDO P-00016 */
 #define FLACD_INBUFF_HEADER_SIZE	((ACMW_UINT32)1024U)
 
+#define FLACD_TILE_SIZE				((ACMW_UINT32)1024U)		/* samples per channel processed at a time (see FLACD_OUTPUT_TILE_SIZE) */
+
 #define FLACD_STACK_SIZE			((ACMW_UINT32)0x2000U)
 
 #define FLACD_SYNC_CODE_BYTE		2U
@@ -83,20 +112,135 @@ typedef signed long					COMM_ADR_SIZE;
 
 #define FLACD_ERROR_FACTOR_ENABLE	0x0001U
 
+typedef struct {
+	ACMW_UINT16						nMode;			/* FLACD_MIXCFG_OFF / MATRIX / REMAP */
+	ACMW_UINT16						nInChannels;
+	ACMW_UINT16						nOutChannels;
+	ACMW_INT16						nRemap[FLACD_MIX_MAX_CHANNELS];
+	ACMW_FLOAT32					fMatrix[FLACD_MIX_MAX_CHANNELS][FLACD_MIX_MAX_CHANNELS];
+} flacd_ChannelMix;
+
+typedef struct {
+	ACMW_UINT32						nRemainSamples;		/* samples of the frame not output yet */
+	ACMW_UINT32						nOffset;			/* first sample not output yet */
+	ACMW_UINT32						nFirstSample;		/* stream position of the first sample of the frame */
+	ACMW_UINT32						nSampleRate;
+	ACMW_UINT16						nChannels;			/* channels reported in the status */
+	ACMW_UINT16						nFrameChannels;		/* channels decoded in the frame */
+	ACMW_UINT16						nChannelInfo;
+	ACMW_UINT16						nBitsPerSample;
+	ACMW_BOOL						bMute;				/* CRC error : output mute data */
+	ACMW_UINT32						nConstantMask;		/* channels held as one value, bit 0 = channel 0 */
+	ACMW_INT32						nConstant[FLAC__MAX_CHANNELS];	/* their value */
+	FLAC__int32						*pSource[FLAC__MAX_CHANNELS];	/* samples of each channel (NULL : silence) */
+	ACMW_BOOL						bFinished;			/* all samples finished : taken from or stored to the frame cache */
+	ACMW_BOOL						bChannelDropped;	/* a decoded channel is output as silence */
+	const void						*pScratch;			/* scratch holding the samples (NULL : carry buffer) */
+} flacd_PendingOutput;
+
+#define FLACD_SEEK_CACHE_SIZE		16
+
+typedef struct {
+	ACMW_UINT32						nOffset;			/* stream offset of a frame */
+	ACMW_UINT32						nSample;			/* its first sample */
+} flacd_SeekProbe;
+
+typedef struct {
+	ACMW_BOOL						bActive;			/* a bisection seek is in progress */
+	ACMW_UINT32						nTarget;
+	flacd_SeekProbe					sLow;				/* frame at or before nTarget */
+	flacd_SeekProbe					sHigh;				/* frame (or stream end) after nTarget */
+	ACMW_UINT32						nScanOffset;		/* start of the bytes requested */
+	ACMW_UINT32						nScanStart;			/* start of the scan for a frame */
+	ACMW_UINT32						nScanSize;			/* bytes requested */
+	flacd_SeekProbe					sCache[FLACD_SEEK_CACHE_SIZE];	/* frames found by earlier probes */
+	ACMW_UINT32						nCacheCount;
+	ACMW_UINT32						nCacheNext;
+} flacd_BisectState;
+
+typedef struct {
+	ACMW_UINT16						nMode;				/* FLACD_OVERVIEWCFG_OFF / ON / NO_OUTPUT */
+	ACMW_UINT32						nBucketSamples;
+	ACMW_UINT32						nBuckets;
+	flacd_overviewBucket			*pBuckets;
+} flacd_Overview;
+
+#define FLACD_MD5_BLOCK_SIZE		64
+#define FLACD_MD5_DIGEST_SIZE		16
+
+typedef struct {
+	ACMW_UINT32						nState[4];
+	ACMW_UINT32						nBytes[2];			/* bytes hashed : low / high word */
+	ACMW_UINT8						nBuffer[FLACD_MD5_BLOCK_SIZE];	/* bytes of the block not full yet */
+} flacd_Md5Context;
+
+typedef struct {
+	ACMW_UINT16						nMode;				/* FLACD_VERIFYCFG_OFF / MD5 / FRAMES */
+	ACMW_UINT16						nResult;			/* FLACD_VERIFY_* */
+	ACMW_BOOL						bSignature;			/* STREAMINFO holds a signature (not all 0) */
+	ACMW_UINT32						nNextSample;		/* stream position verified up to */
+	ACMW_UINT32						nTotalSamples;		/* 0 : unknown */
+	ACMW_UINT8						nExpected[FLACD_MD5_DIGEST_SIZE];
+	flacd_Md5Context				sMd5;
+	flacd_frameTestInfo				*pFrames;			/* frame test results (NULL : counts only) */
+	ACMW_UINT32						nFrames;
+	ACMW_UINT32						nTestedFrames;
+	ACMW_UINT32						nFailedFrames;
+	ACMW_UINT32						nTestedSamples;
+	ACMW_BOOL						bLostSync;			/* a header failed : no other until the next frame */
+} flacd_Verify;
+
 typedef struct {
 	ACMW_UINT32						nErrorFactor;
 	ACMW_UINT16						nEnableErrorFactor;
 	ACMW_UINT16						nInputChannel;
 	ACMW_UINT16						nOutputChannel;
 	ACMW_UINT16						nOutBitsPerSample;
+	ACMW_UINT16						nOutFormat;
+	ACMW_UINT16						nOutLayout;
+	ACMW_FLOAT32					fOutGain;
+	ACMW_BOOL						bAccumulate;		/* flacd_DecodeMix : add the output to the buffer */
+	ACMW_FLOAT32					fVoiceGain;			/* gain of the voice added */
+	flacd_ChannelMix				sChannelMix;
+	flacd_PendingOutput				sPending;
+	ACMW_BOOL						bSeekPending;		/* discard the samples before nSeekTarget */
+	ACMW_UINT32						nSeekTarget;
+	flacd_BisectState				sBisect;
+	flacd_ScratchLayout				sScratchLayout;
+	const void						*pBoundScratch;		/* scratch the decoder points into */
+	void							*pCarry;			/* remaining samples moved out of the scratch (NULL : none) */
+	ACMW_UINT32						nCarrySize;
+	ACMW_BOOL						bSessionOpen;
+	const flacd_outputRingInfo		*pSessionRing;
+	void							*pFrameCache;		/* flacd_FrameCacheHeader (NULL : no frame cache) */
+	ACMW_UINT16						nFrameCacheMode;
+	flacd_Overview					sOverview;
+	flacd_Verify					sVerify;
+	ACMW_UINT16						nFormatChangeMode;	/* FLACD_FORMATCFG_REJECT / ACCEPT */
+	ACMW_UINT32						nLastSampleRate;	/* format of the samples output last (0 : none yet) */
+	ACMW_UINT16						nLastChannels;
+	ACMW_UINT16						nLastBitsPerSample;
 	FLAC__StreamDecoder				pStreamDecoder;
 	FLAC__StreamDecoderProtected	pStreamDecoderProtected;
 	FLAC__StreamDecoderPrivate		pStreamDecoderPrivate;
 	FLAC__BitReader					pBitReader;
 } flacd_StaticArea;
 
-typedef struct {
-	FLAC__int32						Residual[FLAC__SPEC_MAX_BLOCK_SIZE];	/* RCG3AFLDL4001ZDO P-00016 */
-} flacd_ScratchArea;
+ACMW_INT32 flacd_DecodeBuffer(const flacd_workMemoryInfo* const pWorkMemInfo, const flacd_decConfigInfo* const pDecConfigInfo,
+							  const flacd_ioBufferConfigInfo* const pBuffConfigInfo, const flacd_outputRingInfo* const pRing,
+							  flacd_decStatusInfo* const pDecStatusInfo, flacd_ioBufferStatusInfo* const pBuffStatusInfo);
+ACMW_INT32 flacd_DecodeFrame(flacd_StaticArea* const pStaticStructure, void* const pScratch, const flacd_ioBufferConfigInfo* const pBuffConfigInfo,
+							 const flacd_outputRingInfo* const pRing, flacd_decStatusInfo* const pDecStatusInfo,
+							 flacd_ioBufferStatusInfo* const pBuffStatusInfo);
+ACMW_UINT32 flacd_DecodeCheckConfig(const flacd_StaticArea* const pStaticStructure, const flacd_decConfigInfo* const pDecConfigInfo);
+ACMW_BOOL flacd_DecodeCheckRing(const flacd_StaticArea* const pStaticStructure, const flacd_outputRingInfo* const pRing);
+void flacd_DecodeBindScratch(flacd_StaticArea* const pStaticStructure, void* const pScratch);
+void flacd_DecodeRestart(flacd_StaticArea* const pStaticStructure, const ACMW_UINT32 nSeekTarget);
+ACMW_BOOL flacd_DecodeCarryPending(flacd_StaticArea* const pStaticStructure);
+ACMW_INT32 flacd_DecodeRun(flacd_StaticArea* const pStaticStructure, void* const pScratch, ACMW_UINT8* const pInBuff, const ACMW_UINT32 nInSize,
+						   void** const pOutBuffStart, const ACMW_UINT32 nOutSamples, ACMW_UINT32* const pInUsed, ACMW_UINT32* const pOutDone);
+ACMW_BOOL flacd_DecodeCheckOutput(const flacd_StaticArea* const pStaticStructure, void* const * const pOutBuffStart);
+ACMW_UINT32 flacd_DecodeFrameSize(const flacd_StaticArea* const pStaticStructure);
+void flacd_DecodeSetChannels(flacd_StaticArea* const pStaticStructure);
 
 #endif /* FLACD_API_H */
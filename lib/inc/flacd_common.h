@@ -46,6 +46,7 @@
 #define FLAC__bitreader_read_raw_int32				flacd_bitreader_read_raw_int32
 #define FLAC__bitreader_read_unary_unsigned			flacd_bitreader_read_unary_unsigned
 #define FLAC__bitreader_read_rice_signed_block		flacd_bitreader_read_rice_signed_block
+#define FLAC__bitreader_skip_rice_signed_block		flacd_bitreader_skip_rice_signed_block
 #define FLAC__bitreader_read_utf8_uint32			flacd_bitreader_read_utf8_uint32
 #define FLAC__bitreader_read_utf8_uint64			flacd_bitreader_read_utf8_uint64
 #define FLAC__stream_decoder_new					flacd_stream_decoder_new
@@ -57,13 +58,22 @@
 #define FLAC__stream_decoder_get_bits_per_sample	flacd_stream_decoder_get_bits_per_sample
 #define FLAC__stream_decoder_get_sample_rate		flacd_stream_decoder_get_sample_rate
 #define FLAC__stream_decoder_get_blocksize			flacd_stream_decoder_get_blocksize
+#define FLAC__stream_decoder_get_sample_number		flacd_stream_decoder_get_sample_number
+#define FLAC__stream_decoder_get_frame_blocksize	flacd_stream_decoder_get_frame_blocksize
+#define FLAC__stream_decoder_set_channel_mask		flacd_stream_decoder_set_channel_mask
+#define FLAC__stream_decoder_get_channel_data		flacd_stream_decoder_get_channel_data
+#define FLAC__stream_decoder_get_channel_constant	flacd_stream_decoder_get_channel_constant
 #define FLAC__stream_decoder_set_supported_channels	flacd_stream_decoder_set_supported_channels
+#define FLAC__stream_decoder_set_supported_blocksize	flacd_stream_decoder_set_supported_blocksize
 #define FLAC__stream_decoder_set_streaminfo			flacd_stream_decoder_set_streaminfo
 #define FLAC__stream_decoder_get_error_state		flacd_stream_decoder_get_error_state
 #define FLAC__stream_decoder_allocate_residual		flacd_stream_decoder_allocate_residual
+#define FLAC__stream_decoder_allocate_frame		flacd_stream_decoder_allocate_frame
 #define FLAC__stream_decoder_allocate_output		flacd_stream_decoder_allocate_output
 #define FLAC__stream_decoder_process_frame_sync		flacd_stream_decoder_process_frame_sync
 #define FLAC__stream_decoder_process_read_frame		flacd_stream_decoder_process_read_frame
+#define FLAC__stream_decoder_process_frame_header	flacd_stream_decoder_process_frame_header
+#define FLAC__stream_decoder_finish_block			flacd_stream_decoder_finish_block
 #define FLAC__crc8									flacd_crc8
 #define FLAC__fixed_restore_signal					flacd_fixed_restore_signal
 #define FLAC__lpc_restore_signal					flacd_lpc_restore_signal
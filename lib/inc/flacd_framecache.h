@@ -0,0 +1,88 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_framecache.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for the decoded frame cache
+******************************************************************************/
+#ifndef FLACD_FRAMECACHE_H
+#define FLACD_FRAMECACHE_H
+
+#include "flacd_api.h"
+
+#define FLACD_FRAMECACHE_MAGIC		((ACMW_UINT32)0x464C4643U)		/* "FLFC" */
+
+/*==========================================================================*/
+/*      Define Struct flacd_FrameCacheHeader                                */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Cache Header Structure                                           */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Placed at the start of the cache memory, followed by nSlots slots of   */
+/*   nSlotSize bytes. It lives in the cache memory so that the cache and    */
+/*   its counters are kept over flacd_Init and can be used by several       */
+/*   instances in turn. nTick counts the uses of the slots for the LRU.     */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32		nMagic;
+	ACMW_UINT32		nSlotSize;
+	ACMW_UINT32		nSlots;
+	ACMW_UINT32		nTick;
+	ACMW_UINT32		nEntries;
+	ACMW_UINT32		nHits;
+	ACMW_UINT32		nMisses;
+	ACMW_UINT32		nEvictions;
+} flacd_FrameCacheHeader;
+
+/*==========================================================================*/
+/*      Define Struct flacd_FrameCacheEntry                                 */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Frame Cache Entry Structure                                            */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   Head of a slot. The nFrameSize bytes of the compressed frame follow,   */
+/*   then, 8 byte aligned, the finished samples of the channels of          */
+/*   nRowMask in channel order, nBlockSize samples each. A frame is found   */
+/*   by the CRC-16 of its footer and its size, and taken when all its       */
+/*   bytes match too. nDecodeMask and nDecodeChannels are the               */
+/*   channel mask and the decoded output channels the frame was decoded     */
+/*   with; the entry is only used with the same ones. nTick 0 : empty.      */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32		nTick;
+	ACMW_UINT32		nFrameSize;
+	ACMW_UINT16		nCrc16;
+	ACMW_UINT16		nChannels;
+	ACMW_UINT16		nBitsPerSample;
+	ACMW_UINT16		nDecodeChannels;
+	ACMW_UINT32		nDecodeMask;
+	ACMW_UINT32		nFirstSample;
+	ACMW_UINT32		nBlockSize;
+	ACMW_UINT32		nSampleRate;
+	ACMW_UINT32		nRowMask;
+	ACMW_UINT32		nConstantMask;
+	ACMW_INT32		nConstant[FLAC__MAX_CHANNELS];
+} flacd_FrameCacheEntry;
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+ACMW_UINT32 flacd_FrameCacheSlotSize(const flacd_StaticArea* const pStaticStructure, const ACMW_UINT32 nMaxBlockSize,
+									 const ACMW_UINT32 nMaxFrameSize);
+void flacd_FrameCacheAttach(flacd_FrameCacheHeader* const pCache, const ACMW_UINT32 nCacheSize, const ACMW_UINT32 nSlotSize);
+const flacd_FrameCacheEntry* flacd_FrameCacheLookup(const flacd_StaticArea* const pStaticStructure, const ACMW_UINT8* const pFrame,
+													const ACMW_UINT32 nAvailSize);
+const ACMW_INT32* flacd_FrameCacheRow(const flacd_FrameCacheEntry* const pEntry, const ACMW_UINT32 nRow);
+void flacd_FrameCacheStore(const flacd_StaticArea* const pStaticStructure, FLAC__int32* const * const pSrcBuff,
+						   const ACMW_UINT32 nBlockSize, const ACMW_UINT8* const pFrame, const ACMW_UINT32 nFrameSize);
+
+#endif	/* FLACD_FRAMECACHE_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
@@ -0,0 +1,74 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_memory.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for work memory layout
+******************************************************************************/
+#ifndef FLACD_MEMORY_H
+#define FLACD_MEMORY_H
+
+#include "flacd_Lib.h"
+
+/*==========================================================================*/
+/*      Define Struct flacd_ScratchLayout                                   */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Scratch Memory Layout Structure                                        */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   The scratch memory holds one sample array of nBlockSize samples per    */
+/*   channel, nChannelStride bytes apart, followed from nFrameOffset by the */
+/*   frame being decoded.                                                   */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32		nBlockSize;
+	ACMW_UINT32		nChannels;
+	ACMW_UINT32		nChannelStride;
+	ACMW_UINT32		nFrameOffset;
+	ACMW_UINT32		nScratchSize;
+} flacd_ScratchLayout;
+
+/*==========================================================================*/
+/*      Define Struct flacd_SlabSlot                                        */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Slab Slot Trailer Structure                                            */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   A slot holds the static memory of one instance followed by this        */
+/*   trailer. nNext links the free slots. nGeneration is the generation of  */
+/*   the handle valid for the slot (0 : free) and nLastGeneration the one   */
+/*   given out last.                                                        */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32		nNext;
+	ACMW_UINT32		nGeneration;
+	ACMW_UINT32		nLastGeneration;
+} flacd_SlabSlot;
+
+#define FLACD_SLAB_SLOT_ALIGN		((ACMW_UINT32)64U)			/* slots start on a cache line */
+#define FLACD_SLAB_INDEX_BITS		((ACMW_UINT32)16U)			/* slab (4 bits) and slot (12 bits), the generation above */
+#define FLACD_SLAB_SLOT_BITS		((ACMW_UINT32)12U)
+#define FLACD_SLAB_MAX_GENERATION	((ACMW_UINT32)0xFFFFU)
+#define FLACD_SLAB_MAX_SLOTS		((ACMW_UINT32)1U << FLACD_SLAB_SLOT_BITS)
+#define FLACD_SLAB_NO_SLOT			((ACMW_UINT32)0xFFFFFFFFU)
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+void flacd_SetScratchLayout(flacd_ScratchLayout* const pLayout, const ACMW_UINT32 nMaxBlockSize, const ACMW_UINT32 nChannels);
+void* flacd_ScratchFrame(const flacd_ScratchLayout* const pLayout, void* const pScratch);
+ACMW_INT32* flacd_ScratchChannel(const flacd_ScratchLayout* const pLayout, void* const pScratch, const ACMW_UINT32 nChannel);
+ACMW_UINT32 flacd_SlabSlotSize(void);
+flacd_SlabSlot* flacd_SlabGetSlot(const flacd_slabPoolInfo* const pSlabPoolInfo, const ACMW_UINT32 nIndex);
+ACMW_UINT32 flacd_InputBufferSize(const ACMW_UINT32 nMaxBlockSize, const ACMW_UINT32 nBitsPerSample, const ACMW_UINT32 nChannels);
+
+#endif	/* FLACD_MEMORY_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
@@ -0,0 +1,68 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_metadata.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for metadata parsing
+******************************************************************************/
+#ifndef FLACD_METADATA_H
+#define FLACD_METADATA_H
+
+#include "flacd_Lib.h"
+
+#define FLACD_META_MARKER_SIZE			((ACMW_UINT32)4U)			/* "fLaC" */
+#define FLACD_META_ID3_HEADER_SIZE		((ACMW_UINT32)10U)
+#define FLACD_META_BLOCK_HEADER_SIZE	((ACMW_UINT32)4U)
+#define FLACD_META_STREAMINFO_SIZE		((ACMW_UINT32)34U)
+#define FLACD_META_SEEKPOINT_SIZE		((ACMW_UINT32)18U)
+
+#define FLACD_META_TYPE_STREAMINFO		((ACMW_UINT32)0U)
+#define FLACD_META_TYPE_SEEKTABLE		((ACMW_UINT32)3U)
+#define FLACD_META_TYPE_INVALID			((ACMW_UINT32)127U)
+
+#define FLACD_META_STATE_MARKER			((ACMW_UINT32)0U)			/* before "fLaC" (or an ID3v2 tag) */
+#define FLACD_META_STATE_STREAMINFO		((ACMW_UINT32)1U)			/* first metadata block */
+#define FLACD_META_STATE_BLOCK			((ACMW_UINT32)2U)			/* other metadata blocks */
+#define FLACD_META_STATE_DONE			((ACMW_UINT32)3U)			/* audio offset found */
+
+/* frame index : header (big-endian) */
+#define FLACD_INDEX_MAGIC				((ACMW_UINT32)0x464C4958U)	/* "FLIX" */
+#define FLACD_INDEX_VERSION				((ACMW_UINT32)1U)
+#define FLACD_INDEX_POS_MAGIC			((ACMW_UINT32)0U)			/* 4 */
+#define FLACD_INDEX_POS_VERSION			((ACMW_UINT32)4U)			/* 2 */
+#define FLACD_INDEX_POS_HEADER_SIZE		((ACMW_UINT32)6U)			/* 2 */
+#define FLACD_INDEX_POS_ENTRIES			((ACMW_UINT32)8U)			/* 4 */
+#define FLACD_INDEX_POS_INTERVAL		((ACMW_UINT32)12U)			/* 4 */
+#define FLACD_INDEX_POS_TOTAL_SAMPLES	((ACMW_UINT32)16U)			/* 4 : source */
+#define FLACD_INDEX_POS_STREAM_SIZE		((ACMW_UINT32)20U)			/* 4 : source */
+#define FLACD_INDEX_POS_AUDIO_OFFSET	((ACMW_UINT32)24U)			/* 4 : source */
+#define FLACD_INDEX_POS_MD5				((ACMW_UINT32)28U)			/* 16 : source */
+#define FLACD_INDEX_POS_CRC				((ACMW_UINT32)44U)			/* 2 : header before it and entries */
+/* frame index : entry = first sample(4) stream offset(4) of a frame, ascending */
+
+#define FLACD_INDEX_STATE_START			((ACMW_UINT32)0U)
+#define FLACD_INDEX_STATE_SCAN			((ACMW_UINT32)1U)
+#define FLACD_INDEX_STATE_DONE			((ACMW_UINT32)2U)
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+ACMW_UINT32 flacd_MetaReadBE(const ACMW_UINT8* const pData, const ACMW_UINT32 nBytes);
+void flacd_MetaWriteBE(ACMW_UINT8* const pData, const ACMW_UINT32 nValue, const ACMW_UINT32 nBytes);
+ACMW_UINT32 flacd_MetaCrc16(const ACMW_UINT8* const pData, const ACMW_UINT32 nSize, const ACMW_UINT32 nCrc);
+ACMW_BOOL flacd_MetaParseStreamInfo(const ACMW_UINT8* const pData, flacd_headerStatusInfo* const pHeaderStatusInfo);
+ACMW_BOOL flacd_MetaFindSeekPoint(const ACMW_UINT8* const pSeekTable, const ACMW_UINT32 nSeekPoints, const ACMW_UINT32 nTargetSample,
+								  ACMW_UINT32* const pSample, ACMW_UINT32* const pOffset);
+ACMW_BOOL flacd_MetaFindIndexEntry(const ACMW_UINT8* const pEntries, const ACMW_UINT32 nEntries, const ACMW_UINT32 nTargetSample,
+								   ACMW_UINT32* const pSample, ACMW_UINT32* const pOffset);
+ACMW_BOOL flacd_MetaFindIndexEnd(const ACMW_UINT8* const pEntries, const ACMW_UINT32 nEntries, const ACMW_UINT32 nEndSample,
+								 ACMW_UINT32* const pOffset);
+
+#endif	/* FLACD_METADATA_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
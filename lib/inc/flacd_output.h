@@ -0,0 +1,62 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_output.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for output conversion
+******************************************************************************/
+#ifndef FLACD_OUTPUT_H
+#define FLACD_OUTPUT_H
+
+#include "flacd_Lib.h"
+
+#define FLACD_OUTFMT_PCM16			((ACMW_UINT16)0x0000U)
+#define FLACD_OUTFMT_PCM24			((ACMW_UINT16)0x0001U)
+#define FLACD_OUTFMT_FLOAT32		((ACMW_UINT16)0x0002U)
+
+/* Samples mixed at a time by flacd_OutputMix. Its float accumulator is on */
+/* the stack: a quarter of FLACD_TILE_SIZE keeps it at 1 KB, well inside   */
+/* FLACD_STACK_SIZE. A tile of the decoder is mixed in four parts.         */
+#define FLACD_OUTPUT_TILE_SIZE		((ACMW_UINT32)256U)
+
+/*==========================================================================*/
+/*      Define Struct flacd_OutputFormat                                    */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Output Conversion Parameter Structure                                  */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   nShiftBits is used for PCM formats. fScale maps a decoded sample to    */
+/*   the output full scale; it is used for FLOAT32 and for channel mixing.  */
+/*   With bAccumulate the samples are added to the output (saturated on     */
+/*   PCM) instead of stored, and fScale includes the gain of the voice.     */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT16		nFormat;
+	ACMW_INT32		nShiftBits;
+	ACMW_FLOAT32	fScale;
+	ACMW_BOOL		bAccumulate;
+} flacd_OutputFormat;
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+void flacd_OutputSetFormat(flacd_OutputFormat* const pFormat, const ACMW_UINT16 nFormat, const ACMW_UINT32 nBitsPerSample, const ACMW_FLOAT32 fGain);
+void flacd_OutputSetAccumulate(flacd_OutputFormat* const pFormat, const ACMW_FLOAT32 fGain);
+ACMW_UINT32 flacd_OutputSampleSize(const ACMW_UINT16 nFormat);
+void flacd_OutputSamples(const flacd_OutputFormat* const pFormat, void* const pDstBuff, const ACMW_UINT32 nStride,
+						 const ACMW_INT32* const pSrcBuff, const ACMW_UINT32 block_length);
+void flacd_OutputConstant(const flacd_OutputFormat* const pFormat, void* const pDstBuff, const ACMW_UINT32 nStride,
+						  const ACMW_INT32 nValue, const ACMW_UINT32 block_length);
+void flacd_OutputMix(const flacd_OutputFormat* const pFormat, void* const pDstBuff, const ACMW_UINT32 nStride,
+					 ACMW_INT32* const * const ppSrcBuff, const ACMW_FLOAT32* const pCoef, const ACMW_UINT32 nSrcChannels,
+					 const ACMW_UINT32 block_length);
+
+#endif	/* FLACD_OUTPUT_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
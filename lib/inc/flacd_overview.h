@@ -0,0 +1,26 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_overview.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for the waveform overview
+******************************************************************************/
+#ifndef FLACD_OVERVIEW_H
+#define FLACD_OVERVIEW_H
+
+#include "flacd_api.h"
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+void flacd_OverviewUpdate(const flacd_Overview* const pOverview, const flacd_PendingOutput* const pPending,
+						  FLAC__int32* const * const pSrcBuff, const ACMW_UINT32 nPosition, const ACMW_UINT32 nLength);
+
+#endif	/* FLACD_OVERVIEW_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
@@ -0,0 +1,31 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_verify.h
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description  : Header file for the MD5 verification and the frame test
+******************************************************************************/
+#ifndef FLACD_VERIFY_H
+#define FLACD_VERIFY_H
+
+#include "flacd_api.h"
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+void flacd_VerifyStart(flacd_Verify* const pVerify);
+void flacd_VerifyUpdate(flacd_Verify* const pVerify, const flacd_PendingOutput* const pPending,
+						FLAC__int32* const * const pSrcBuff, const ACMW_UINT32 nPosition, const ACMW_UINT32 nLength);
+void flacd_VerifyDigest(const flacd_Verify* const pVerify, ACMW_UINT8* const pDigest);
+ACMW_UINT16 flacd_VerifyCompare(const flacd_Verify* const pVerify, const ACMW_UINT8* const pDigest);
+void flacd_VerifyFrame(flacd_Verify* const pVerify, const ACMW_UINT32 nFirstSample, const ACMW_UINT32 nBlockSize,
+					   const ACMW_UINT16 nFrameResult);
+
+#endif	/* FLACD_VERIFY_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
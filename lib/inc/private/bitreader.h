@@ -172,6 +172,9 @@ FLAC__bool FLAC__bitreader_read_byte_block_aligned_no_crc(FLAC__BitReader *br, F
 FLAC__bool FLAC__bitreader_read_unary_unsigned(FLAC__BitReader *br, unsigned *val);
 FLAC__bool FLAC__bitreader_read_rice_signed(FLAC__BitReader *br, int *val, unsigned parameter);
 FLAC__bool FLAC__bitreader_read_rice_signed_block(FLAC__BitReader *br, int vals[], unsigned nvals, unsigned parameter);
+#if 1
+FLAC__bool FLAC__bitreader_skip_rice_signed_block(FLAC__BitReader *br, unsigned nvals, unsigned parameter);
+#endif
 
 /* Reference Program : FLAC 1.3.1 (25-Nov-2014) ... FLAC__NO_ASM delete.(lpc.h) */ /* RCG3AFLDL4001ZDO P-00015 */
 
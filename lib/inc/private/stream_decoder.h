@@ -49,6 +49,7 @@
 #include "private/bitreader.h"
 
 typedef struct FLAC__StreamDecoderPrivate {
+#if 0	/* LPC restore is called directly */
 	/* generic 32-bit datapath: */
 	void (*local_lpc_restore_signal)(const FLAC__int32 residual[], unsigned data_len, const FLAC__int32 qlp_coeff[], unsigned order, int lp_quantization, FLAC__int32 data[]);
 	/* generic 64-bit datapath: */
@@ -59,17 +60,29 @@ typedef struct FLAC__StreamDecoderPrivate {
 	/* for use when the signal is <= 16 bits-per-sample, or <= 15 bits-per-sample on a side channel (which requires 1 extra bit), AND order <= 8: */
 	void (*local_lpc_restore_signal_16bit_order8)(const FLAC__int32 residual[], unsigned data_len, const FLAC__int32 qlp_coeff[], unsigned order, int lp_quantization, FLAC__int32 data[]);
 #endif	/* <- Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00004 end */
+#endif
 #if 0	/* -> Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00005 start */
 	FLAC__bool (*local_bitreader_read_rice_signed_block)(FLAC__BitReader *br, int vals[], unsigned nvals, unsigned parameter);
 #endif	/* <- Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00005 end */
 	FLAC__BitReader *input;
 	FLAC__int32 *output[FLAC__MAX_CHANNELS];
 	FLAC__int32 *residual[FLAC__MAX_CHANNELS]; /* WATCHOUT: these are the aligned pointers; the real pointers that should be free()'d are residual_unaligned[] below */
+#if 0	/* rice parameters are not kept */
 	FLAC__EntropyCodingMethod_PartitionedRiceContents partitioned_rice_contents[FLAC__MAX_CHANNELS];
+#endif
 	FLAC__uint32 fixed_block_size, next_fixed_block_size;
 	FLAC__bool has_stream_info;
+#if 0
 	FLAC__StreamMetadata stream_info;
 	FLAC__Frame frame;
+#else
+	struct {
+		FLAC__uint32 min_blocksize, max_blocksize;
+		FLAC__uint32 sample_rate;
+		FLAC__uint32 bits_per_sample;
+	} stream_info;	/* STREAMINFO fields used by the frame header check */
+	FLAC__Frame *frame;	/* frame being decoded, placed in the scratch memory */
+#endif
 	FLAC__bool cached; /* true if there is a byte in lookahead */
 	FLAC__byte header_warmup[2]; /* contains the sync code and reserved bits */
 	FLAC__byte lookahead; /* temp storage when we need to look ahead one byte in the stream */
@@ -77,6 +90,12 @@ typedef struct FLAC__StreamDecoderPrivate {
 #if 1
 	FLAC__uint32 supported_input_channels;
 	FLAC__uint32 supported_output_channels;
+	FLAC__uint32 supported_max_blocksize;
+	FLAC__uint32 channel_mask;	/* channels decoded, bit 0 = channel 0 (0 : all) */
+	FLAC__bool accept_format_change;	/* frames may change channels, sample size and sample rate */
+	FLAC__int32 *row[FLAC__MAX_CHANNELS];	/* scratch rows, given to the decoded channels of each frame */
+	FLAC__uint32 constant_mask;	/* channels of the last frame held as one value, not in their rows */
+	FLAC__int32 constant_value[FLAC__MAX_CHANNELS];	/* their finished value (wasted bits and channel coding undone) */
 #endif
 } FLAC__StreamDecoderPrivate;
 
@@ -0,0 +1,133 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_AcquireScratch.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_AcquireScratch
+
+ [Description]
+   Lend a scratch block of a pool to a decoder instance for the following
+   flacd_Decode call. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_AcquireScratch(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_scratchPoolInfo *pScratchPoolInfo)
+
+ [Argument]
+   flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+           (pScratch is set to the lent block)
+   flacd_scratchPoolInfo *       pScratchPoolInfo
+           Pointer to Scratch Pool Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   An instance that still holds remaining samples in a block gets back
+   that block. Otherwise the first free block is lent. Call
+   flacd_ReleaseScratch after flacd_Decode.
+   When no block is free, FLACD_ERR_SCRATCH_PINNED tells that some are
+   pinned to instances holding the rest of a frame (give them a carry
+   buffer, see flacd_SetScratchCarry), FLACD_ERR_SCRATCH_EXHAUSTED that
+   all are lent for calls.
+==========================================================================*/
+ACMW_INT32	flacd_AcquireScratch( flacd_workMemoryInfo*		const pWorkMemInfo,
+								  flacd_scratchPoolInfo*	const pScratchPoolInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	const flacd_StaticArea *pOwner;
+	ACMW_UINT32	i, nBlock;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pScratchPoolInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pScratchPoolInfo->pOwner == NULL) ||
+		(pScratchPoolInfo->pMemory == NULL) || ((((ACMW_UINT32)(pScratchPoolInfo->pMemory)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check PoolConfig Value */
+	if ( ( pScratchPoolInfo->nBlockSize < pStaticStructure->sScratchLayout.nScratchSize ) ||
+		 ( ( pScratchPoolInfo->nBlockSize & FLACD_ALIGNMENT8 ) != (ACMW_UINT32)0U ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Search the block of the instance, else the first free block */
+	nBlock = pScratchPoolInfo->nBlocks;
+	for ( i = 0; i < pScratchPoolInfo->nBlocks; i++ ) {
+		if ( pScratchPoolInfo->pOwner[i] == pWorkMemInfo->pStatic ) {
+			nBlock = i;
+			break;
+		} else if ( ( pScratchPoolInfo->pOwner[i] == NULL ) && ( nBlock == pScratchPoolInfo->nBlocks ) ) {
+			nBlock = i;
+		} else {
+			/* owned by another instance */
+		} /* end if */
+	} /* end for */
+	if ( nBlock == pScratchPoolInfo->nBlocks ) {
+		/* blocks pinned by the remaining samples of their instance */
+		pStaticStructure->nErrorFactor = FLACD_ERR_SCRATCH_EXHAUSTED;
+		for ( i = 0; i < pScratchPoolInfo->nBlocks; i++ ) {
+			pOwner = (const flacd_StaticArea*)pScratchPoolInfo->pOwner[i];
+			if ( ( pOwner->sPending.nRemainSamples != (ACMW_UINT32)0U ) &&
+				 ( pOwner->sPending.pScratch == (const void*)( (ACMW_UINT8*)pScratchPoolInfo->pMemory + ( pScratchPoolInfo->nBlockSize * i ) ) ) ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_SCRATCH_PINNED;
+			} /* end if */
+		} /* end for */
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Remaining samples are held in a block of another pool */
+	if ( ( pStaticStructure->sPending.nRemainSamples != (ACMW_UINT32)0U ) &&
+		 ( pStaticStructure->sPending.pScratch != NULL ) &&
+		 ( pScratchPoolInfo->pOwner[nBlock] != pWorkMemInfo->pStatic ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pScratchPoolInfo->pOwner[nBlock] = pWorkMemInfo->pStatic;
+	pWorkMemInfo->pScratch = (ACMW_UINT8*)pScratchPoolInfo->pMemory + ( pScratchPoolInfo->nBlockSize * nBlock );
+
+	return FLACD_RESULT_OK;
+}
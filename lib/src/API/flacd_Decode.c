@@ -14,15 +14,46 @@
 #include "FLAC/stream_decoder.h"
 #include "flacd_Lib.h"
 #include "flacd_api.h"
+#include "flacd_output.h"
+#include "flacd_memory.h"
+#include "flacd_framecache.h"
+#include "flacd_overview.h"
+#include "flacd_verify.h"
 
-static void output16pcm( ACMW_INT16*		const pDstBuff,
-						 const FLAC__int32*	const pSrcBuff,
-						 const ACMW_UINT32	block_length,
-						 const ACMW_INT32	nShiftBits );
-static void output24pcm( ACMW_INT32*		const pDstBuff,
-						 const FLAC__int32*	const pSrcBuff,
-						 const ACMW_UINT32	block_length,
-						 const ACMW_INT32	nShiftBits );
+static void output_frame( flacd_StaticArea*					const pStaticStructure,
+						  const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+						  const flacd_outputRingInfo*		const pRing,
+						  flacd_ioBufferStatusInfo*			const pBuffStatusInfo,
+						  FLAC__int32*						const * const pSrcBuff,
+						  const ACMW_UINT32					nSrcOffset,
+						  const ACMW_UINT32					block_length,
+						  const ACMW_UINT32					nBitsPerSample,
+						  const ACMW_UINT32					nFrameChannels );
+static ACMW_BOOL output_pending( flacd_StaticArea*					const pStaticStructure,
+								 const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+								 const flacd_outputRingInfo*		const pRing,
+								 flacd_decStatusInfo*				const pDecStatusInfo,
+								 flacd_ioBufferStatusInfo*			const pBuffStatusInfo,
+								 FLAC__int32*						const * const pSrcBuff );
+static void output_segment( const flacd_StaticArea*			const pStaticStructure,
+							const flacd_OutputFormat*		const pFormat,
+							const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+							const ACMW_UINT32				nStride,
+							const ACMW_UINT32				nPos,
+							FLAC__int32*					const * const pSrcBuff,
+							const ACMW_UINT32				nLength,
+							const ACMW_BOOL					bMix,
+							const ACMW_UINT32				nFrameChannels );
+static void output_source( const flacd_StaticArea*		const pStaticStructure,
+						   const flacd_OutputFormat*	const pFormat,
+						   void*						const pDst,
+						   const ACMW_UINT32			nStride,
+						   FLAC__int32*					const * const pSrcBuff,
+						   const ACMW_INT32				nSrc,
+						   const ACMW_UINT32			nLength,
+						   const ACMW_UINT32			nFrameChannels );
+static ACMW_BOOL mix_applies( const flacd_StaticArea* const pStaticStructure, const ACMW_UINT32 nFrameChannels );
+static ACMW_UINT16 silent_channels( const flacd_StaticArea* const pStaticStructure, FLAC__int32* const * const pSrcBuff );
 
 /*==========================================================================
  [Function Name]
@@ -59,21 +90,58 @@ static void output24pcm( ACMW_INT32*		const pDstBuff,
            FLACD_RESULT_FATAL   : Error (none Error Factor)
 
  [Note]
-   None
+   The scratch memory is only used during the call. While samples of a
+   frame remain (nRemainSamples), the following calls must be given the
+   scratch memory the frame was decoded into, unless flacd_ReleaseScratch
+   has moved them to the carry buffer (see flacd_SetScratchCarry).
+   Sample positions are 32 bit: a frame with samples from 2^32 on is
+   read but not output (FLACD_ERR_NOT_SUPPORTED_DATA).
 ==========================================================================*/
 ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 						 const flacd_decConfigInfo*			const pDecConfigInfo,
 						 const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
 						 flacd_decStatusInfo*				const pDecStatusInfo,
 						 flacd_ioBufferStatusInfo*			const pBuffStatusInfo )
+{
+	return flacd_DecodeBuffer( pWorkMemInfo, pDecConfigInfo, pBuffConfigInfo, NULL, pDecStatusInfo, pBuffStatusInfo );
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeBuffer
+*
+* ARGUMENT
+* 		const flacd_workMemoryInfo*		const pWorkMemInfo
+*		const flacd_decConfigInfo*		const pDecConfigInfo
+*		const flacd_ioBufferConfigInfo*	const pBuffConfigInfo
+*		const flacd_outputRingInfo*		const pRing
+*		flacd_decStatusInfo*			const pDecStatusInfo
+*		flacd_ioBufferStatusInfo*		const pBuffStatusInfo
+*
+* RETURN VALUE
+* 		ACMW_INT32						Error Code of flacd_Decode
+*
+* OVERVIEW
+* 		Check the arguments of flacd_Decode and flacd_DecodeRing and
+* 		decode one frame. pRing == NULL outputs to linear buffers of
+* 		nOutBuffSize.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_INT32 flacd_DecodeBuffer( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							   const flacd_decConfigInfo*		const pDecConfigInfo,
+							   const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+							   const flacd_outputRingInfo*		const pRing,
+							   flacd_decStatusInfo*				const pDecStatusInfo,
+							   flacd_ioBufferStatusInfo*		const pBuffStatusInfo )
 {
 	flacd_StaticArea *pStaticStructure;
-	flacd_ScratchArea *pScratchStructure[FLAC__MAX_CHANNELS];
-	FLAC__int32 *pResidual[FLAC__MAX_CHANNELS];
-	FLAC__bool	ret, got_a_frame;
 	FLAC__StreamDecoderState get_state;
 	FLAC__uint32	i;
-	FLAC__uint32	frameStartUsedDataSize = 0;
+	ACMW_UINT32		nOutChanAlignment, nOutCheckChannel;
 	
 	/* Argument Check */
 	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
@@ -121,77 +189,113 @@ ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 		return FLACD_RESULT_NG;
 	} /* end if */
 	
-	if ((pBuffConfigInfo->pInBuffStart  == NULL) ||
-		(pBuffConfigInfo->pOutBuffStart == NULL) ||		/* [2015.09.04] -> Alignment do not check */
-		(pBuffStatusInfo->pOutBuffLast  == NULL) ) {	/* [2015.09.04] -> Alignment do not check */
+	if (pBuffConfigInfo->pInBuffStart  == NULL) {
 		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
 		return FLACD_RESULT_NG;
 	} /* end if */
 	
-	if ( pStaticStructure->nOutBitsPerSample == 0x0000u ) {
-		for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
-			if ((((ACMW_UINT32)(pBuffConfigInfo->pOutBuffStart[i])) & FLACD_ALIGNMENT2) != (ACMW_UINT32)0U) {
-				pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
-				return FLACD_RESULT_NG;
-			} /* end if */
-		}
-	}
-	else {
-		for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
-			if ((((ACMW_UINT32)(pBuffConfigInfo->pOutBuffStart[i])) & FLACD_ALIGNMENT4) != (ACMW_UINT32)0U) {
+	/* The frame test writes no output */
+	if ( pStaticStructure->sVerify.nMode != (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) {
+		if ((pBuffConfigInfo->pOutBuffStart == NULL) ||		/* [2015.09.04] -> Alignment do not check */
+			(pBuffStatusInfo->pOutBuffLast  == NULL) ) {	/* [2015.09.04] -> Alignment do not check */
+			pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		
+		nOutChanAlignment = ( flacd_OutputSampleSize(pStaticStructure->nOutFormat) == (ACMW_UINT32)sizeof(ACMW_INT16) ) ? FLACD_ALIGNMENT2 : FLACD_ALIGNMENT4;
+		nOutCheckChannel = ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) ? (ACMW_UINT32)1U : (ACMW_UINT32)pStaticStructure->nOutputChannel;
+		for (i = 0; i < nOutCheckChannel; i++) {
+			if ((((ACMW_UINT32)(pBuffConfigInfo->pOutBuffStart[i])) & nOutChanAlignment) != (ACMW_UINT32)0U) {
 				pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
 				return FLACD_RESULT_NG;
 			} /* end if */
 		}
+		if ( ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) && ( pBuffConfigInfo->pOutBuffStart[0] == NULL ) ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+			return FLACD_RESULT_NG;
+		} /* end if */
 	} /* end if */
 	
 	/* Check BuffConfig Value */
-	if (pBuffConfigInfo->nInBuffSetDataSize < FLACD_MIN_INBUFF_SIZE) {
-		pStaticStructure->nErrorFactor = FLACD_ERR_SHORT_INPUT_DATA;
+	if ( flacd_DecodeCheckRing( pStaticStructure, pRing ) == (ACMW_BOOL)0 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
 		return FLACD_RESULT_NG;
 	} /* end if */
 
-	/* Check DecConfig Value */
-	if ((uint32_t)pDecConfigInfo->nMaxBlockSize > FLAC__SPEC_MAX_BLOCK_SIZE) {	/* RCG3AFLDL4001ZDO P-00016 */
-		pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
-		return FLACD_RESULT_NG;
-	} /* end if */
-	
-	if ((pDecConfigInfo->nSampleRate > FLACD_MAX_SAMPLE_RATE) || (pDecConfigInfo->nSampleRate < FLACD_MIN_SAMPLE_RATE)) {
-		pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
-		return FLACD_RESULT_NG;
+	/* Check DecConfig Value and Set DecConfig Value (not needed for the rest of a frame) */
+	if ( pStaticStructure->sPending.nRemainSamples == (ACMW_UINT32)0U ) {
+		pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, pDecConfigInfo );
+		if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+			return FLACD_RESULT_NG;
+		} /* end if */
+		FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pDecConfigInfo );
 	} /* end if */
-	
-	if ((uint32_t)pDecConfigInfo->nChannels > (uint32_t)pStaticStructure->nInputChannel) {
-		pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
-		return FLACD_RESULT_NG;
+
+	return flacd_DecodeFrame( pStaticStructure, pWorkMemInfo->pScratch, pBuffConfigInfo, pRing, pDecStatusInfo, pBuffStatusInfo );
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeFrame
+*
+* ARGUMENT
+* 		flacd_StaticArea*				const pStaticStructure
+*		void*							const pScratch
+*		const flacd_ioBufferConfigInfo*	const pBuffConfigInfo
+*		const flacd_outputRingInfo*		const pRing
+*		flacd_decStatusInfo*			const pDecStatusInfo
+*		flacd_ioBufferStatusInfo*		const pBuffStatusInfo
+*
+* RETURN VALUE
+* 		ACMW_INT32						Error Code of flacd_Decode
+*
+* OVERVIEW
+* 		Decode one frame, or output the rest of the previous frame.
+* 		The arguments and the stream configuration are already checked.
+* 		pRing != NULL writes the output to the area it describes.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_INT32 flacd_DecodeFrame( flacd_StaticArea*					const pStaticStructure,
+							  void*								const pScratch,
+							  const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+							  const flacd_outputRingInfo*		const pRing,
+							  flacd_decStatusInfo*				const pDecStatusInfo,
+							  flacd_ioBufferStatusInfo*			const pBuffStatusInfo )
+{
+	FLAC__bool	ret, got_a_frame;
+	FLAC__uint32	i, nRow, nConstRow;
+	FLAC__uint32	frameStartUsedDataSize = 0;
+	const flacd_FrameCacheEntry*	pEntry = NULL;
+	const ACMW_BOOL	bTest = ( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+	const ACMW_BOOL	bCacheOn = ( ( pStaticStructure->pFrameCache != NULL ) && ( pStaticStructure->nFrameCacheMode == (ACMW_UINT16)FLACD_CACHECFG_ON ) &&
+								 ( bTest == (ACMW_BOOL)0 ) ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+	ACMW_UINT16	nFrameResult = (ACMW_UINT16)FLACD_FRAMETEST_PASS;
+
+	/* Output the rest of the previous frame without reading input */
+	if ( pStaticStructure->sPending.nRemainSamples != (ACMW_UINT32)0U ) {
+		if ( ( pStaticStructure->sPending.pScratch != NULL ) && ( pStaticStructure->sPending.pScratch != pScratch ) ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		if ( output_pending( pStaticStructure, pBuffConfigInfo, pRing, pDecStatusInfo, pBuffStatusInfo, pStaticStructure->sPending.pSource ) == (ACMW_BOOL)0 ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		return FLACD_RESULT_OK;
 	} /* end if */
-	
-	if (((uint32_t)pDecConfigInfo->nBitsPerSample > FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE) ||
-		((uint32_t)pDecConfigInfo->nBitsPerSample < FLAC__MIN_BITS_PER_SAMPLE)) {
-		pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
+
+	if (pBuffConfigInfo->nInBuffSetDataSize < FLACD_MIN_INBUFF_SIZE) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SHORT_INPUT_DATA;
 		return FLACD_RESULT_NG;
 	} /* end if */
-	
-	for( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
-		if ( i < pStaticStructure->nInputChannel ) {
-			pScratchStructure[i] = (flacd_ScratchArea*)((ACMW_UINT8 *)pWorkMemInfo->pScratch + (sizeof(flacd_ScratchArea) * i));
-			pResidual[i] = &(pScratchStructure[i]->Residual[0]);
-			flacd_MemSet((void*)pResidual[i], 0u, (ACMW_INT32)(pDecConfigInfo->nMaxBlockSize * sizeof(FLAC__int32)));
-		}
-		else {
-			pScratchStructure[i] = NULL;
-			pResidual[i] = NULL;
-		}
-	}
-	
-	/* Set DecConfig Value */
-	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pDecConfigInfo );
-	
+
 	/* Set BuffConfig Value */
 	FLAC__bitreader_init(&(pStaticStructure->pBitReader), pBuffConfigInfo);
-	FLAC__stream_decoder_allocate_residual( &(pStaticStructure->pStreamDecoder), pResidual);
-	FLAC__stream_decoder_allocate_output( &(pStaticStructure->pStreamDecoder), pResidual);
+	flacd_DecodeBindScratch( pStaticStructure, pScratch );
 
 	/* Check Header Sync */
 	ret = FLAC__stream_decoder_process_frame_sync( &(pStaticStructure->pStreamDecoder) );
@@ -209,15 +313,26 @@ ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 		pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
 		return FLACD_RESULT_NG;
 	}
-	/* Decode Frame */
-	got_a_frame = false;
-	ret = FLAC__stream_decoder_process_read_frame( &(pStaticStructure->pStreamDecoder), &got_a_frame );
-	/* Update Input Buffer Infomation */
-	pBuffStatusInfo->nInBuffUsedDataSize = FLACD__bitreader_get_input_bytes_consumed(&(pStaticStructure->pBitReader));
+	/* Take the frame from the frame cache when it holds the same bytes */
+	if ( bCacheOn == (ACMW_BOOL)1 ) {
+		pEntry = flacd_FrameCacheLookup( pStaticStructure, pBuffConfigInfo->pInBuffStart + frameStartUsedDataSize,
+										 pBuffConfigInfo->nInBuffSetDataSize - frameStartUsedDataSize );
+	} /* end if */
+	if ( pEntry != NULL ) {
+		FLAC__stream_decoder_flush( &(pStaticStructure->pStreamDecoder) );
+		got_a_frame = true;
+		pBuffStatusInfo->nInBuffUsedDataSize = frameStartUsedDataSize + pEntry->nFrameSize;
+	}
+	else {
+		/* Decode Frame */
+		got_a_frame = false;
+		ret = FLAC__stream_decoder_process_read_frame( &(pStaticStructure->pStreamDecoder), &got_a_frame );
+		/* Update Input Buffer Infomation */
+		pBuffStatusInfo->nInBuffUsedDataSize = FLACD__bitreader_get_input_bytes_consumed(&(pStaticStructure->pBitReader));
+	} /* end if */
 	pBuffStatusInfo->pInBuffLast = pBuffConfigInfo->pInBuffStart + pBuffStatusInfo->nInBuffUsedDataSize;
 	if( got_a_frame == true ){
-		/* Check Output Buffer Parameter */
-		ACMW_UINT32	nOutputSize;
+		flacd_PendingOutput* const pPending = &(pStaticStructure->sPending);
 		const ACMW_UINT16 sChannelInfo[FLACD_6CHOUT] = {
 			(ACMW_UINT16)FLACD_CHINFO_1CH,
 			(ACMW_UINT16)FLACD_CHINFO_2CH,
@@ -227,73 +342,125 @@ ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 			(ACMW_UINT16)FLACD_CHINFO_6CH
 		};
 
-		if ( pStaticStructure->nOutBitsPerSample == 0x0000u ) {
-			nOutputSize = (ACMW_UINT32)(FLAC__stream_decoder_get_blocksize(&(pStaticStructure->pStreamDecoder)) * sizeof(ACMW_INT16));
-		} else {
-			nOutputSize = (ACMW_UINT32)(FLAC__stream_decoder_get_blocksize(&(pStaticStructure->pStreamDecoder)) * sizeof(ACMW_INT32));
-		} /* end if */
-		if ( pBuffConfigInfo->nOutBuffSize < nOutputSize ) {
-			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
-			return FLACD_RESULT_NG;
-		} /* end if */
+		if ( pEntry != NULL ) {
+			/* The samples are finished in the cache; constant channels get a scratch row for the matrix mix */
+			nRow = 0;
+			nConstRow = 0;
+			for( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+				pPending->pSource[i] = NULL;
+				if ( ( ( pEntry->nRowMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) {
+					pPending->pSource[i] = (FLAC__int32*)flacd_FrameCacheRow( pEntry, nRow );	/* only read */
+					nRow++;
+				} else if ( ( ( pEntry->nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) {
+					pPending->pSource[i] = flacd_ScratchChannel( &(pStaticStructure->sScratchLayout), pScratch, nConstRow );
+					nConstRow++;
+				} else {
+					/* not decoded */
+				} /* end if */
+				pPending->nConstant[i] = pEntry->nConstant[i];
+			}
+			pPending->nConstantMask = pEntry->nConstantMask;
+			pPending->nRemainSamples = pEntry->nBlockSize;
+			pPending->nFirstSample = pEntry->nFirstSample;
+			pPending->nSampleRate = pEntry->nSampleRate;
+			pPending->nFrameChannels = pEntry->nChannels;
+			pPending->nBitsPerSample = pEntry->nBitsPerSample;
+			pPending->bFinished = (ACMW_BOOL)1;
+			pPending->bMute = (ACMW_BOOL)0;
+		}
+		else {
+			for( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+				pPending->pSource[i] = FLAC__stream_decoder_get_channel_data( &(pStaticStructure->pStreamDecoder), i );
+			}
 
-		/* Set to Decoder Status Information Structure */
-		pDecStatusInfo->nSampleRate = FLAC__stream_decoder_get_sample_rate(&(pStaticStructure->pStreamDecoder));
-		pDecStatusInfo->nDecodedSamples = FLAC__stream_decoder_get_blocksize(&(pStaticStructure->pStreamDecoder));
-		pDecStatusInfo->nChannels = (ACMW_UINT16)FLAC__stream_decoder_get_channels(&(pStaticStructure->pStreamDecoder));
-		pDecStatusInfo->nBitsPerSample = (ACMW_UINT16)FLAC__stream_decoder_get_bits_per_sample(&(pStaticStructure->pStreamDecoder));
-		pBuffStatusInfo->nOutBuffUsedDataSize = nOutputSize ;
+			/* Channels of constant subframes are not in their rows but kept as one value */
+			pPending->nConstantMask = (ACMW_UINT32)0U;
+			for( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+				if ( FLAC__stream_decoder_get_channel_constant( &(pStaticStructure->pStreamDecoder), i, &pPending->nConstant[i] ) == true ) {
+					pPending->nConstantMask |= (ACMW_UINT32)1U << i;
+				} /* end if */
+			}
 
-		ret = FLAC__stream_decoder_get_error_state(&(pStaticStructure->pStreamDecoder));
-		if ( ret == FLAC__STREAM_DECODER_ERROR_STATUS_FRAME_CRC_MISMATCH ) {
-			/* Set to Status Infomation about Channel Infomation */
-			pDecStatusInfo->nChannelInfo = sChannelInfo[(ACMW_UINT32)pDecStatusInfo->nChannels-(ACMW_UINT32)1U];
+			pPending->nRemainSamples = FLAC__stream_decoder_get_blocksize(&(pStaticStructure->pStreamDecoder));
+			/* Sample positions are 32 bit : a frame ending beyond them is not supported */
+			if ( ( FLAC__stream_decoder_get_sample_number(&(pStaticStructure->pStreamDecoder)) + (FLAC__uint64)pPending->nRemainSamples ) >
+				 (FLAC__uint64)0xFFFFFFFFU ) {
+				pPending->nRemainSamples = (ACMW_UINT32)0U;
+				pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			pPending->nFirstSample = (ACMW_UINT32)FLAC__stream_decoder_get_sample_number(&(pStaticStructure->pStreamDecoder));
+			pPending->nSampleRate = FLAC__stream_decoder_get_sample_rate(&(pStaticStructure->pStreamDecoder));
+			pPending->nFrameChannels = (ACMW_UINT16)FLAC__stream_decoder_get_channels(&(pStaticStructure->pStreamDecoder));
+			pPending->nBitsPerSample = (ACMW_UINT16)FLAC__stream_decoder_get_bits_per_sample(&(pStaticStructure->pStreamDecoder));
+			pPending->bFinished = (ACMW_BOOL)0;
 
+			ret = FLAC__stream_decoder_get_error_state(&(pStaticStructure->pStreamDecoder));
 			/* Set Output Mute Data */
-			for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
-				if( pBuffConfigInfo->pOutBuffStart[i] != NULL ){
-					if ( pStaticStructure->nOutBitsPerSample == 0x0000u ) {
-						flacd_MemSet(pBuffConfigInfo->pOutBuffStart[i], 0u, (ACMW_INT32)(pDecStatusInfo->nDecodedSamples * sizeof(ACMW_INT16)));
-					} else {
-						flacd_MemSet(pBuffConfigInfo->pOutBuffStart[i], 0u, (ACMW_INT32)(pDecStatusInfo->nDecodedSamples * sizeof(ACMW_INT32)));
-					} /* end if */
-					pBuffStatusInfo->pOutBuffLast[i] = (void*)((ACMW_UINT8 *)pBuffConfigInfo->pOutBuffStart[i] + pBuffStatusInfo->nOutBuffUsedDataSize);
-				}
-				else{
-					pBuffStatusInfo->pOutBuffLast[i] = NULL;
+			pPending->bMute = ( ret == FLAC__STREAM_DECODER_ERROR_STATUS_FRAME_CRC_MISMATCH ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+			if ( bTest == (ACMW_BOOL)1 ) {
+				flacd_VerifyFrame( &(pStaticStructure->sVerify), pPending->nFirstSample, pPending->nRemainSamples,
+								   ( pPending->bMute == (ACMW_BOOL)1 ) ? (ACMW_UINT16)FLACD_FRAMETEST_CRC : (ACMW_UINT16)FLACD_FRAMETEST_PASS );
+			} /* end if */
+		} /* end if */
+
+		/* Keep the frame until all of it is output */
+		pPending->nOffset = (ACMW_UINT32)0U;
+		pPending->pScratch = pScratch;
+		pPending->nChannels = pPending->nFrameChannels;
+		pPending->bChannelDropped = (ACMW_BOOL)0;
+
+		if ( pPending->bMute == (ACMW_BOOL)0 ) {
+			if ( pStaticStructure->sChannelMix.nMode != (ACMW_UINT16)FLACD_MIXCFG_OFF ) {
+				/* channels after mix / remap */
+				if ( mix_applies( pStaticStructure, (ACMW_UINT32)pPending->nFrameChannels ) == (ACMW_BOOL)1 ) {
+					pPending->nChannels = pStaticStructure->sChannelMix.nOutChannels;
 				} /* end if */
-			} /* end for */
+			}
+			/* if the number of input channels is 4 and The number of output channels is 3, only the left and the right output */
+			else if( ( (ACMW_UINT32)pPending->nFrameChannels == FLACD_4CHOUT ) && ( (ACMW_UINT32)pStaticStructure->nOutputChannel == FLACD_3CHOUT ) ) {
+				/* the third channel is output as a constant zero */
+				pPending->nConstantMask |= (ACMW_UINT32)1U << (FLACD_3CHOUT-(ACMW_UINT32)1U);
+				pPending->nConstant[FLACD_3CHOUT-(ACMW_UINT32)1U] = 0;
+				pPending->nChannels = (ACMW_UINT16)FLACD_2CHOUT;
+				pPending->bChannelDropped = (ACMW_BOOL)1;
+			} /* end if */
+		} /* end if */
+		/* Set to Status Infomation about Channel Infomation */
+		pPending->nChannelInfo = sChannelInfo[(ACMW_UINT32)pPending->nChannels-(ACMW_UINT32)1U];
+
+		/* Finish a decoded frame at once and store it in the frame cache, also when it is output only in part */
+		if ( ( bCacheOn == (ACMW_BOOL)1 ) && ( pPending->bFinished == (ACMW_BOOL)0 ) && ( pPending->bMute == (ACMW_BOOL)0 ) &&
+			 ( pBuffStatusInfo->nInBuffUsedDataSize >= ( frameStartUsedDataSize + (ACMW_UINT32)FLACD_SYNC_CODE_BYTE ) ) ) {
+			FLAC__stream_decoder_finish_block( &(pStaticStructure->pStreamDecoder), (ACMW_UINT32)0U, pPending->nRemainSamples );
+			pPending->bFinished = (ACMW_BOOL)1;
+			flacd_FrameCacheStore( pStaticStructure, pPending->pSource, pPending->nRemainSamples,
+								   pBuffConfigInfo->pInBuffStart + frameStartUsedDataSize,
+								   pBuffStatusInfo->nInBuffUsedDataSize - frameStartUsedDataSize );
+		} /* end if */
+
+		/* Discard the samples before the seek target */
+		if ( pStaticStructure->bSeekPending == (ACMW_BOOL)1 ) {
+			if ( ( pPending->nFirstSample + pPending->nRemainSamples ) <= pStaticStructure->nSeekTarget ) {
+				pPending->nRemainSamples = (ACMW_UINT32)0U;
+				return FLACD_RESULT_OK;
+			} /* end if */
+			if ( pStaticStructure->nSeekTarget > pPending->nFirstSample ) {
+				pPending->nOffset = pStaticStructure->nSeekTarget - pPending->nFirstSample;
+				pPending->nRemainSamples -= pPending->nOffset;
+			} /* end if */
+			pStaticStructure->bSeekPending = (ACMW_BOOL)0;
+		} /* end if */
 
+		/* Set Output Data */
+		if ( output_pending( pStaticStructure, pBuffConfigInfo, pRing, pDecStatusInfo, pBuffStatusInfo, pPending->pSource ) == (ACMW_BOOL)0 ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		if ( pPending->bMute == (ACMW_BOOL)1 ) {
 			pStaticStructure->nErrorFactor = FLACD_ERR_CRC;
 			return FLACD_RESULT_WARNING;
 		} /* end if */
-		else {
-			/* if the number of input channels is 4 and The number of output channels is 3, only the left and the right output */
-			if( ( (ACMW_UINT32)pDecStatusInfo->nChannels == FLACD_4CHOUT ) && ( (ACMW_UINT32)pStaticStructure->nOutputChannel == FLACD_3CHOUT ) ) {
-				flacd_MemSet( pResidual[FLACD_3CHOUT-(ACMW_UINT32)1U], 0u, (ACMW_INT32)(pDecStatusInfo->nDecodedSamples * sizeof(FLAC__int32)) );
-				pDecStatusInfo->nChannels = (ACMW_UINT16)FLACD_2CHOUT;
-			} /* end if */
-					
-			/* Set to Status Infomation about Channel Infomation */
-			pDecStatusInfo->nChannelInfo = sChannelInfo[(ACMW_UINT32)pDecStatusInfo->nChannels-(ACMW_UINT32)1U];
-
-			/* Set Output Data */
-			for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
-				if( pBuffConfigInfo->pOutBuffStart[i] != NULL ){
-					if ( pStaticStructure->nOutBitsPerSample == 0x0000u ) {
-						const ACMW_INT32 nShiftBits = (ACMW_INT32)16 - (ACMW_INT32)pDecStatusInfo->nBitsPerSample;
-						output16pcm( (ACMW_INT16*)pBuffConfigInfo->pOutBuffStart[i], pResidual[i], pDecStatusInfo->nDecodedSamples, nShiftBits );
-					} else {
-						const ACMW_INT32 nShiftBits = (ACMW_INT32)32 - (ACMW_INT32)pDecStatusInfo->nBitsPerSample;
-						output24pcm( (ACMW_INT32*)pBuffConfigInfo->pOutBuffStart[i], pResidual[i], pDecStatusInfo->nDecodedSamples, nShiftBits );
-					} /* end if */
-					pBuffStatusInfo->pOutBuffLast[i] = (void*)((ACMW_UINT8 *)pBuffConfigInfo->pOutBuffStart[i] + pBuffStatusInfo->nOutBuffUsedDataSize);
-				}
-				else{
-					pBuffStatusInfo->pOutBuffLast[i] = NULL;
-				} /* end if */
-			} /* end for */
-		}
 	}
 	else {
 		/* Set Error Factor */
@@ -302,6 +469,7 @@ ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 			if ( ( FLAC__stream_decoder_get_error_state(&(pStaticStructure->pStreamDecoder)) == FLAC__STREAM_DECODER_ERROR_STATUS_LOST_SYNC ) &&
 				 ( FLAC__stream_decoder_get_state(&(pStaticStructure->pStreamDecoder)) == FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) ) {
 				pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
+				nFrameResult = (ACMW_UINT16)FLACD_FRAMETEST_UNPARSEABLE;
 			}
 			else {	/* RCG3AFLDL4001ZDO P-00006 end */
 				FLAC__stream_decoder_flush(&(pStaticStructure->pStreamDecoder));
@@ -320,68 +488,380 @@ ACMW_INT32 flacd_Decode( const flacd_workMemoryInfo*		const pWorkMemInfo,
 				case FLAC__STREAM_DECODER_ERROR_STATUS_CHANGE_HEADER :
 					pStaticStructure->nErrorFactor = FLACD_ERR_CHANGE_FRAME_HEADER;
 					break;
-				case FLAC__STREAM_DECODER_ERROR_STATUS_LOST_SYNC : 
 				case FLAC__STREAM_DECODER_ERROR_STATUS_BAD_HEADER : 
+					pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
+					nFrameResult = (ACMW_UINT16)FLACD_FRAMETEST_HEADER;
+					break;
 				case FLAC__STREAM_DECODER_ERROR_STATUS_UNPARSEABLE_STREAM : 
+					pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
+					nFrameResult = (ACMW_UINT16)FLACD_FRAMETEST_UNPARSEABLE;
+					break;
+				case FLAC__STREAM_DECODER_ERROR_STATUS_LOST_SYNC : 
 				default :
 					pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
 					break;
 			} /* end switch */
 		} /* end if */
+		if ( ( bTest == (ACMW_BOOL)1 ) && ( nFrameResult != (ACMW_UINT16)FLACD_FRAMETEST_PASS ) ) {
+			flacd_VerifyFrame( &(pStaticStructure->sVerify), (ACMW_UINT32)0U, (ACMW_UINT32)0U, nFrameResult );
+		} /* end if */
 		return FLACD_RESULT_NG;
 	} /* end if */
 	
 	/* Set to Buffer Status Information Structure */
 	return FLACD_RESULT_OK;
 }
+/*------------------------------------------------------------------------------*/
+
 /*==============================================================================*/
 /*
 *
 * FUNCTION NAME
-* 		output16pcm
+* 		flacd_DecodeBindScratch
 *
 * ARGUMENT
-* 		ACMW_INT16*			const pDstBuff
-*		const FLAC__int32*	const pSrcBuff
-*		const ACMW_UINT32	block_length
-*		const int32_t		nShiftBits
+* 		flacd_StaticArea*	const pStaticStructure
+*		void*				const pScratch
 *
 * RETURN VALUE
 * 		void
 *
 * OVERVIEW
-* 		Output PCM Data(16bit)
+* 		Point the decoder into the scratch memory given to the call,
+* 		unless it already points there
 *
 * DIVERSION ORIGIN
 * 		Original.
 *
 */
-static void output16pcm( ACMW_INT16*		const pDstBuff,
-						 const FLAC__int32*	const pSrcBuff,
-						 const ACMW_UINT32	block_length,
-						 const ACMW_INT32	nShiftBits
-						 )
+void flacd_DecodeBindScratch( flacd_StaticArea*	const pStaticStructure,
+							  void*				const pScratch )
 {
-	ACMW_UINT32	i;
-	if (pSrcBuff == NULL) {
-		for ( i = 0; i < block_length ; i++ ) {
-		  pDstBuff[i] = 0;
+	FLAC__int32 *pResidual[FLAC__MAX_CHANNELS];
+	FLAC__uint32	i;
+
+	if ( pStaticStructure->pBoundScratch != pScratch ) {
+		for( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+			pResidual[i] = flacd_ScratchChannel( &(pStaticStructure->sScratchLayout), pScratch, i );
 		} /* end for */
+		FLAC__stream_decoder_allocate_frame( &(pStaticStructure->pStreamDecoder), (FLAC__Frame*)flacd_ScratchFrame( &(pStaticStructure->sScratchLayout), pScratch ) );
+		FLAC__stream_decoder_allocate_residual( &(pStaticStructure->pStreamDecoder), pResidual);
+		FLAC__stream_decoder_allocate_output( &(pStaticStructure->pStreamDecoder), pResidual);
+		pStaticStructure->pBoundScratch = pScratch;
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeRestart
+*
+* ARGUMENT
+* 		flacd_StaticArea*	const pStaticStructure
+*		const ACMW_UINT32	nSeekTarget
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Drop the pending samples and restart from the next frame sync.
+* 		The samples before nSeekTarget are not output.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_DecodeRestart( flacd_StaticArea*	const pStaticStructure,
+						  const ACMW_UINT32	nSeekTarget )
+{
+	pStaticStructure->sPending.nRemainSamples = (ACMW_UINT32)0U;
+	FLAC__stream_decoder_flush( &(pStaticStructure->pStreamDecoder) );
+	pStaticStructure->nSeekTarget = nSeekTarget;
+	pStaticStructure->bSeekPending = (ACMW_BOOL)1;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeCarryPending
+*
+* ARGUMENT
+* 		flacd_StaticArea*	const pStaticStructure
+*
+* RETURN VALUE
+* 		ACMW_BOOL			1 : no samples are held in the scratch memory
+*
+* OVERVIEW
+* 		Finish the remaining samples of the pending frame and move them
+* 		from the scratch memory to the carry buffer, so that the scratch
+* 		memory can be given to another instance. Nothing is moved when
+* 		they do not fit in the carry buffer.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_DecodeCarryPending( flacd_StaticArea* const pStaticStructure )
+{
+	flacd_PendingOutput* const pPending = &(pStaticStructure->sPending);
+	FLAC__int32*	pCarry = (FLAC__int32*)pStaticStructure->pCarry;
+	ACMW_UINT32	i, nRows;
+	const ACMW_UINT32	nRemain = pPending->nRemainSamples;
+	const ACMW_UINT32	nFrameChannels = (ACMW_UINT32)pPending->nFrameChannels;
+
+	if ( ( nRemain == (ACMW_UINT32)0U ) || ( pPending->pScratch == NULL ) ) {
+		return (ACMW_BOOL)1;
+	} /* end if */
+
+	/* mute data has no samples to keep */
+	if ( pPending->bMute == (ACMW_BOOL)0 ) {
+		nRows = 0;
+		for ( i = 0; i < nFrameChannels; i++ ) {
+			if ( pPending->pSource[i] != NULL ) {
+				nRows++;
+			} /* end if */
+		} /* end for */
+		if ( ( pCarry == NULL ) || ( nRows > ( ( pStaticStructure->nCarrySize / (ACMW_UINT32)sizeof(FLAC__int32) ) / nRemain ) ) ) {
+			return (ACMW_BOOL)0;
+		} /* end if */
+
+		if ( pPending->bFinished == (ACMW_BOOL)0 ) {
+			FLAC__stream_decoder_finish_block( &(pStaticStructure->pStreamDecoder), pPending->nOffset, nRemain );
+			pPending->bFinished = (ACMW_BOOL)1;
+		} /* end if */
+		for ( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+			if ( ( i < nFrameChannels ) && ( pPending->pSource[i] != NULL ) ) {
+				flacd_MemCpy( pCarry, pPending->pSource[i] + pPending->nOffset, (ACMW_INT32)( sizeof(FLAC__int32) * nRemain ) );
+				pPending->pSource[i] = pCarry;
+				pCarry += nRemain;
+			} else {
+				pPending->pSource[i] = NULL;
+			} /* end if */
+		} /* end for */
+	} /* end if */
+
+	/* the carry buffer starts at the first sample not output yet */
+	pPending->nFirstSample += pPending->nOffset;
+	pPending->nOffset = (ACMW_UINT32)0U;
+	pPending->pScratch = NULL;
+	return (ACMW_BOOL)1;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeRun
+*
+* ARGUMENT
+* 		flacd_StaticArea*	const pStaticStructure
+*		void*				const pScratch
+*		ACMW_UINT8*			const pInBuff
+*		const ACMW_UINT32	nInSize
+*		void**				const pOutBuffStart
+*		const ACMW_UINT32	nOutSamples
+*		ACMW_UINT32*		const pInUsed
+*		ACMW_UINT32*		const pOutDone
+*
+* RETURN VALUE
+* 		ACMW_INT32			Error Code of flacd_Decode
+*
+* OVERVIEW
+* 		Decode the frames of the input one after the other into the
+* 		output buffers until nOutSamples samples are output or the input
+* 		ends. The output is written as a ring that does not wrap, so each
+* 		frame goes straight to its place. The samples left pending by an
+* 		earlier call are output first. Lost sync is skipped as with
+* 		flacd_Decode, a CRC error gives FLACD_RESULT_WARNING at the end.
+* 		The samples of the last frame that did not fit are left pending.
+* 		The output is one format: a frame that changes it stops the run
+* 		with FLACD_ERR_CHANGE_FRAME_HEADER also in the accept mode of
+* 		flacd_SetFormatChange.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_INT32 flacd_DecodeRun( flacd_StaticArea*	const pStaticStructure,
+							void*				const pScratch,
+							ACMW_UINT8*			const pInBuff,
+							const ACMW_UINT32	nInSize,
+							void**				const pOutBuffStart,
+							const ACMW_UINT32	nOutSamples,
+							ACMW_UINT32*		const pInUsed,
+							ACMW_UINT32*		const pOutDone )
+{
+	flacd_outputRingInfo sRing;
+	flacd_ioBufferConfigInfo sBuffConfigInfo;
+	flacd_ioBufferStatusInfo sBuffStatusInfo;
+	flacd_decStatusInfo sDecStatusInfo;
+	void *pOutBuffLast[FLACD_6CHOUT];
+	ACMW_INT32 nResult = FLACD_RESULT_OK;
+	ACMW_UINT32 nUsed = (ACMW_UINT32)0U;
+	ACMW_UINT32 nDone = (ACMW_UINT32)0U;
+
+	sRing.nStride = (ACMW_UINT32)0U;
+	sRing.nRingFrames = (ACMW_UINT32)0U;
+	sBuffConfigInfo.pOutBuffStart = pOutBuffStart;
+	sBuffConfigInfo.nOutBuffSize = (ACMW_UINT32)0U;
+	sBuffStatusInfo.pOutBuffLast = pOutBuffLast;
+	FLAC__stream_decoder_set_format_change( &(pStaticStructure->pStreamDecoder), false );
+
+	while ( ( nDone < nOutSamples ) &&
+			( ( pStaticStructure->sPending.nRemainSamples != (ACMW_UINT32)0U ) || ( ( nInSize - nUsed ) >= FLACD_MIN_INBUFF_SIZE ) ) ) {
+		sRing.nWritePos = nDone;
+		sRing.nAvailFrames = nOutSamples - nDone;
+		sBuffConfigInfo.pInBuffStart = pInBuff + nUsed;
+		sBuffConfigInfo.nInBuffSetDataSize = nInSize - nUsed;
+		sBuffStatusInfo.nInBuffUsedDataSize = (ACMW_UINT32)0U;
+		flacd_MemSet(&sDecStatusInfo, 0, sizeof(flacd_decStatusInfo));
+
+		switch ( flacd_DecodeFrame( pStaticStructure, pScratch, &sBuffConfigInfo, &sRing, &sDecStatusInfo, &sBuffStatusInfo ) ) {
+			case FLACD_RESULT_OK :
+				break;
+			case FLACD_RESULT_WARNING :
+				nResult = FLACD_RESULT_WARNING;
+				break;
+			default :
+				/* the sync is searched again from the next byte, as with flacd_Decode */
+				if ( ( pStaticStructure->nErrorFactor != FLACD_ERR_LOST_SYNC ) || ( sBuffStatusInfo.nInBuffUsedDataSize == (ACMW_UINT32)0U ) ) {
+					nResult = FLACD_RESULT_NG;
+				} /* end if */
+				break;
+		} /* end switch */
+		nUsed += sBuffStatusInfo.nInBuffUsedDataSize;
+		nDone += sDecStatusInfo.nDecodedSamples;
+		if ( nResult == FLACD_RESULT_NG ) {
+			break;
+		} /* end if */
+	} /* end while */
+	FLAC__stream_decoder_set_format_change( &(pStaticStructure->pStreamDecoder),
+		( pStaticStructure->nFormatChangeMode == (ACMW_UINT16)FLACD_FORMATCFG_ACCEPT ) ? true : false );
+
+	if ( nResult == FLACD_RESULT_WARNING ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_CRC;
+	} else if ( nResult == FLACD_RESULT_OK ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
 	} else {
-		if ( nShiftBits > (ACMW_INT32)0 ) {
-			for ( i = 0; i < block_length ; i++ ) {
-				pDstBuff[i] = (ACMW_INT16)( pSrcBuff[i] << nShiftBits );
-			} /* end for */
-		} else if (nShiftBits < (ACMW_INT32)0) {
-			for ( i = 0; i < block_length ; i++ ) {
-				pDstBuff[i] = (ACMW_INT16)( pSrcBuff[i] >> (-nShiftBits) );
-			} /* end for */
-		} else {
-			for ( i = 0; i < block_length ; i++ ) {
-				pDstBuff[i] = (ACMW_INT16)pSrcBuff[i];
-			} /* end for */
+		/* error factor of the frame */
+	} /* end if */
+
+	*pInUsed = nUsed;
+	*pOutDone = nDone;
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeCheckOutput
+*
+* ARGUMENT
+* 		const flacd_StaticArea*	const pStaticStructure
+*		void* const *			pOutBuffStart
+*
+* RETURN VALUE
+* 		ACMW_BOOL				1 : valid / 0 : invalid
+*
+* OVERVIEW
+* 		Check the output buffer pointers against the output format and
+* 		layout as flacd_Decode does
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_DecodeCheckOutput( const flacd_StaticArea*	const pStaticStructure,
+								   void*					const * const pOutBuffStart )
+{
+	ACMW_UINT32 i, nOutChanAlignment, nOutCheckChannel;
+	ACMW_BOOL bValid = (ACMW_BOOL)1;
+
+	nOutChanAlignment = ( flacd_OutputSampleSize(pStaticStructure->nOutFormat) == (ACMW_UINT32)sizeof(ACMW_INT16) ) ? FLACD_ALIGNMENT2 : FLACD_ALIGNMENT4;
+	nOutCheckChannel = ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) ? (ACMW_UINT32)1U : (ACMW_UINT32)pStaticStructure->nOutputChannel;
+	for (i = 0; i < nOutCheckChannel; i++) {
+		if ((((ACMW_UINT32)(pOutBuffStart[i])) & nOutChanAlignment) != (ACMW_UINT32)0U) {
+			bValid = (ACMW_BOOL)0;
 		} /* end if */
+	} /* end for */
+	if ( ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) && ( pOutBuffStart[0] == NULL ) ) {
+		bValid = (ACMW_BOOL)0;
+	} /* end if */
+	return bValid;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeFrameSize
+*
+* ARGUMENT
+* 		const flacd_StaticArea*	const pStaticStructure
+*
+* RETURN VALUE
+* 		ACMW_UINT32				Bytes per output buffer for one sample period
+*
+* OVERVIEW
+* 		Get the output size of one sample of all channels in a buffer
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_DecodeFrameSize( const flacd_StaticArea* const pStaticStructure )
+{
+	ACMW_UINT32 nFrameSize = flacd_OutputSampleSize(pStaticStructure->nOutFormat);
+
+	if ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) {
+		nFrameSize *= (ACMW_UINT32)pStaticStructure->nOutputChannel;
+	} /* end if */
+	return nFrameSize;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeCheckConfig
+*
+* ARGUMENT
+* 		const flacd_StaticArea*		const pStaticStructure
+*		const flacd_decConfigInfo*	const pDecConfigInfo
+*
+* RETURN VALUE
+* 		ACMW_UINT32					Error Factor (FLACD_ERR_NONE : supported)
+*
+* OVERVIEW
+* 		Check the stream configuration against the initialized budget
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_DecodeCheckConfig( const flacd_StaticArea*		const pStaticStructure,
+									 const flacd_decConfigInfo*		const pDecConfigInfo )
+{
+	ACMW_UINT32 nErrorFactor = FLACD_ERR_NONE;
+
+	if (((uint32_t)pDecConfigInfo->nMaxBlockSize > pStaticStructure->sScratchLayout.nBlockSize) ||	/* RCG3AFLDL4001ZDO P-00016 */
+		(pDecConfigInfo->nSampleRate > FLACD_MAX_SAMPLE_RATE) || (pDecConfigInfo->nSampleRate < FLACD_MIN_SAMPLE_RATE) ||
+		((uint32_t)pDecConfigInfo->nChannels > (uint32_t)pStaticStructure->nInputChannel) ||
+		((uint32_t)pDecConfigInfo->nBitsPerSample > FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE) ||
+		((uint32_t)pDecConfigInfo->nBitsPerSample < FLAC__MIN_BITS_PER_SAMPLE)) {
+		nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
 	} /* end if */
+
+	return nErrorFactor;
 }
 /*------------------------------------------------------------------------------*/
 
@@ -389,38 +869,503 @@ static void output16pcm( ACMW_INT16*		const pDstBuff,
 /*
 *
 * FUNCTION NAME
-* 		output24pcm
+* 		flacd_DecodeCheckRing
 *
 * ARGUMENT
-* 		ACMW_INT32*			const pDstBuff
-*		const FLAC__int32*	const pSrcBuff
-*		const ACMW_UINT32	block_length
+* 		const flacd_StaticArea*		const pStaticStructure
+*		const flacd_outputRingInfo*	const pRing
+*
+* RETURN VALUE
+* 		ACMW_BOOL					1 : valid (or no ring buffer) / 0 : invalid
+*
+* OVERVIEW
+* 		Check the output ring buffer against the output layout
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_DecodeCheckRing( const flacd_StaticArea*		const pStaticStructure,
+								 const flacd_outputRingInfo*	const pRing )
+{
+	ACMW_BOOL bValid = (ACMW_BOOL)1;
+
+	if ( pRing != NULL ) {
+		if ( ( ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) &&
+			   ( pRing->nStride != (ACMW_UINT32)0U ) && ( pRing->nStride < (ACMW_UINT32)pStaticStructure->nOutputChannel ) ) ||
+			 ( ( pRing->nRingFrames != (ACMW_UINT32)0U ) &&
+			   ( ( pRing->nWritePos >= pRing->nRingFrames ) || ( pRing->nAvailFrames > pRing->nRingFrames ) ) ) ) {
+			bValid = (ACMW_BOOL)0;
+		} /* end if */
+	} /* end if */
+	return bValid;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_DecodeSetChannels
+*
+* ARGUMENT
+* 		flacd_StaticArea*	const pStaticStructure
 *
 * RETURN VALUE
 * 		void
 *
 * OVERVIEW
-* 		Output PCM Data(24bit)
+* 		Set the channels decoded: none in the frame test, which only parses
+* 		them, every input channel while a channel mix or the verification
+* 		is set, because all of them are needed, else the output channels
+* 		only
 *
 * DIVERSION ORIGIN
 * 		Original.
 *
 */
-static void output24pcm( ACMW_INT32*		const pDstBuff,
-						 const FLAC__int32*	const pSrcBuff,
-						 const ACMW_UINT32	block_length,
-						 const ACMW_INT32	nShiftBits
-						 )
+void flacd_DecodeSetChannels( flacd_StaticArea* const pStaticStructure )
+{
+	if ( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) {
+		FLAC__stream_decoder_set_supported_channels( &(pStaticStructure->pStreamDecoder), pStaticStructure->nInputChannel, (ACMW_UINT16)0U );
+	} else if ( ( pStaticStructure->sChannelMix.nMode == (ACMW_UINT16)FLACD_MIXCFG_OFF ) &&
+				( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_OFF ) ) {
+		FLAC__stream_decoder_set_supported_channels( &(pStaticStructure->pStreamDecoder), pStaticStructure->nInputChannel, pStaticStructure->nOutputChannel );
+	} else {
+		FLAC__stream_decoder_set_supported_channels( &(pStaticStructure->pStreamDecoder), pStaticStructure->nInputChannel, pStaticStructure->nInputChannel );
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output_frame
+*
+* ARGUMENT
+* 		flacd_StaticArea*				const pStaticStructure
+*		const flacd_ioBufferConfigInfo*	const pBuffConfigInfo
+*		const flacd_outputRingInfo*		const pRing
+*		flacd_ioBufferStatusInfo*		const pBuffStatusInfo
+*		FLAC__int32* const *			pSrcBuff
+*		const ACMW_UINT32				nSrcOffset
+*		const ACMW_UINT32				block_length
+*		const ACMW_UINT32				nBitsPerSample
+*		const ACMW_UINT32				nFrameChannels
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output block_length samples of all channels from sample nSrcOffset
+* 		of the frame in the configured format and layout,
+* 		through the channel mix when it is set. With an output ring the frame
+* 		is written in two segments when it wraps.
+* 		The samples are finished (wasted bits, channel decorrelation) and
+* 		output in tiles of FLACD_TILE_SIZE, so that the output conversion
+* 		the waveform overview and the verification read each tile from
+* 		the cache.
+* 		pSrcBuff == NULL outputs mute data.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void output_frame( flacd_StaticArea*					const pStaticStructure,
+						  const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+						  const flacd_outputRingInfo*		const pRing,
+						  flacd_ioBufferStatusInfo*			const pBuffStatusInfo,
+						  FLAC__int32*						const * const pSrcBuff,
+						  const ACMW_UINT32					nSrcOffset,
+						  const ACMW_UINT32					block_length,
+						  const ACMW_UINT32					nBitsPerSample,
+						  const ACMW_UINT32					nFrameChannels )
 {
 	ACMW_UINT32	i;
-	if (pSrcBuff == NULL) {
-		for ( i = 0; i < block_length ; i++ ) {
-		  pDstBuff[i] = 0;
+	ACMW_UINT32	nStride, nPos, nRing, nLen, nDone, nFill;
+	FLAC__int32*	pSegment[FLAC__MAX_CHANNELS];
+	flacd_OutputFormat	sFormat;
+	const ACMW_UINT32	nSampleSize = flacd_OutputSampleSize(pStaticStructure->nOutFormat);
+	const ACMW_BOOL		bMix = ( pSrcBuff != NULL ) ? mix_applies( pStaticStructure, nFrameChannels ) : (ACMW_BOOL)0;
+	const ACMW_BOOL		bOutput = ( pStaticStructure->sOverview.nMode != (ACMW_UINT16)FLACD_OVERVIEWCFG_NO_OUTPUT ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+
+	flacd_OutputSetFormat( &sFormat, pStaticStructure->nOutFormat, nBitsPerSample, pStaticStructure->fOutGain );
+	if ( pStaticStructure->bAccumulate == (ACMW_BOOL)1 ) {
+		flacd_OutputSetAccumulate( &sFormat, pStaticStructure->fVoiceGain );
+	} /* end if */
+
+	nStride = ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) ? (ACMW_UINT32)pStaticStructure->nOutputChannel : (ACMW_UINT32)1U;
+	nPos = 0;
+	nRing = 0;
+	if ( pRing != NULL ) {
+		if ( pRing->nStride != (ACMW_UINT32)0U ) {
+			nStride = pRing->nStride;
+		} /* end if */
+		nPos = pRing->nWritePos;
+		nRing = pRing->nRingFrames;
+	} /* end if */
+
+	for ( nDone = 0; nDone < block_length; nDone += nLen ) {
+		nLen = block_length - nDone;
+		if ( nLen > FLACD_TILE_SIZE ) {
+			nLen = FLACD_TILE_SIZE;
+		} /* end if */
+		if ( ( bOutput == (ACMW_BOOL)1 ) && ( nRing != (ACMW_UINT32)0U ) && ( nLen > ( nRing - nPos ) ) ) {
+			nLen = nRing - nPos;
+		} /* end if */
+		/* channels not in the frame are output as silence */
+		for (i = 0; i < FLAC__MAX_CHANNELS; i++) {
+			pSegment[i] = ( ( pSrcBuff != NULL ) && ( pSrcBuff[i] != NULL ) && ( i < nFrameChannels ) ) ? ( pSrcBuff[i] + nSrcOffset + nDone ) : NULL;
 		} /* end for */
+		if ( pSrcBuff != NULL ) {
+			if ( pStaticStructure->sPending.bFinished == (ACMW_BOOL)0 ) {
+				FLAC__stream_decoder_finish_block( &(pStaticStructure->pStreamDecoder), nSrcOffset + nDone, nLen );
+			} /* end if */
+			/* the matrix mix reads every sample : fill the tile of the constant channels */
+			if ( ( bMix == (ACMW_BOOL)1 ) && ( pStaticStructure->sChannelMix.nMode == (ACMW_UINT16)FLACD_MIXCFG_MATRIX ) ) {
+				for (i = 0; i < nFrameChannels; i++) {
+					if ( ( pSegment[i] != NULL ) && ( ( ( pStaticStructure->sPending.nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) ) {
+						for (nFill = 0; nFill < nLen; nFill++) {
+							pSegment[i][nFill] = pStaticStructure->sPending.nConstant[i];
+						} /* end for */
+					} /* end if */
+				} /* end for */
+			} /* end if */
+		} /* end if */
+		if ( pStaticStructure->sOverview.nMode != (ACMW_UINT16)FLACD_OVERVIEWCFG_OFF ) {
+			flacd_OverviewUpdate( &(pStaticStructure->sOverview), &(pStaticStructure->sPending), ( pSrcBuff != NULL ) ? pSegment : NULL,
+								  pStaticStructure->sPending.nFirstSample + nSrcOffset + nDone, nLen );
+		} /* end if */
+		if ( pStaticStructure->sVerify.nMode != (ACMW_UINT16)FLACD_VERIFYCFG_OFF ) {
+			flacd_VerifyUpdate( &(pStaticStructure->sVerify), &(pStaticStructure->sPending), ( pSrcBuff != NULL ) ? pSegment : NULL,
+								pStaticStructure->sPending.nFirstSample + nSrcOffset + nDone, nLen );
+		} /* end if */
+		if ( bOutput == (ACMW_BOOL)1 ) {
+			output_segment( pStaticStructure, &sFormat, pBuffConfigInfo, nStride, nPos,
+							( pSrcBuff != NULL ) ? pSegment : NULL, nLen, bMix, nFrameChannels );
+			nPos += nLen;
+			if ( nPos == nRing ) {
+				nPos = 0;
+			} /* end if */
+		} /* end if */
+	} /* end for */
+
+	for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
+		if ( ( ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) && ( i != (ACMW_UINT32)0U ) ) ||
+			 ( pBuffConfigInfo->pOutBuffStart[i] == NULL ) ) {
+			pBuffStatusInfo->pOutBuffLast[i] = NULL;
+		} else {
+			pBuffStatusInfo->pOutBuffLast[i] = (void*)((ACMW_UINT8 *)pBuffConfigInfo->pOutBuffStart[i] + (nPos * nStride * nSampleSize));
+		} /* end if */
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output_segment
+*
+* ARGUMENT
+* 		const flacd_StaticArea*			const pStaticStructure
+*		const flacd_OutputFormat*		const pFormat
+*		const flacd_ioBufferConfigInfo*	const pBuffConfigInfo
+*		const ACMW_UINT32				nStride
+*		const ACMW_UINT32				nPos
+*		FLAC__int32* const *			pSrcBuff
+*		const ACMW_UINT32				nLength
+*		const ACMW_BOOL					bMix
+*		const ACMW_UINT32				nFrameChannels
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output nLength frames of all channels to output frame position nPos
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void output_segment( const flacd_StaticArea*			const pStaticStructure,
+							const flacd_OutputFormat*		const pFormat,
+							const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+							const ACMW_UINT32				nStride,
+							const ACMW_UINT32				nPos,
+							FLAC__int32*					const * const pSrcBuff,
+							const ACMW_UINT32				nLength,
+							const ACMW_BOOL					bMix,
+							const ACMW_UINT32				nFrameChannels )
+{
+	ACMW_UINT32	i;
+	ACMW_UINT8*	pDst;
+	const flacd_ChannelMix* const pMix = &pStaticStructure->sChannelMix;
+	const ACMW_UINT32	nSampleSize = flacd_OutputSampleSize(pFormat->nFormat);
+
+	for (i = 0; i < (uint32_t)pStaticStructure->nOutputChannel; i++) {
+		if ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) {
+			pDst = (ACMW_UINT8*)pBuffConfigInfo->pOutBuffStart[0] + (nSampleSize * i);
+		} else {
+			pDst = (ACMW_UINT8*)pBuffConfigInfo->pOutBuffStart[i];
+			if ( pDst == NULL ) {
+				continue;
+			} /* end if */
+		} /* end if */
+		pDst += nPos * nStride * nSampleSize;
+
+		if ( bMix == (ACMW_BOOL)0 ) {
+			output_source( pStaticStructure, pFormat, (void*)pDst, nStride, pSrcBuff, (ACMW_INT32)i, nLength, nFrameChannels );
+		} else if ( i >= (ACMW_UINT32)pMix->nOutChannels ) {
+			flacd_OutputSamples( pFormat, (void*)pDst, nStride, NULL, nLength );
+		} else if ( pMix->nMode == (ACMW_UINT16)FLACD_MIXCFG_REMAP ) {
+			output_source( pStaticStructure, pFormat, (void*)pDst, nStride, pSrcBuff, (ACMW_INT32)pMix->nRemap[i], nLength, nFrameChannels );
+		} else {
+			flacd_OutputMix( pFormat, (void*)pDst, nStride, pSrcBuff, &pMix->fMatrix[i][0], (ACMW_UINT32)pMix->nInChannels, nLength );
+		} /* end if */
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output_source
+*
+* ARGUMENT
+* 		const flacd_StaticArea*			const pStaticStructure
+*		const flacd_OutputFormat*		const pFormat
+*		void*							const pDst
+*		const ACMW_UINT32				nStride
+*		FLAC__int32* const *			pSrcBuff
+*		const ACMW_INT32				nSrc
+*		const ACMW_UINT32				nLength
+*		const ACMW_UINT32				nFrameChannels
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output nLength samples of frame channel nSrc to one output channel:
+* 		silence when the channel is not decoded (nSrc < 0 : none), one fill
+* 		when it is a constant subframe, else a conversion of its samples.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void output_source( const flacd_StaticArea*		const pStaticStructure,
+						   const flacd_OutputFormat*	const pFormat,
+						   void*						const pDst,
+						   const ACMW_UINT32			nStride,
+						   FLAC__int32*					const * const pSrcBuff,
+						   const ACMW_INT32				nSrc,
+						   const ACMW_UINT32			nLength,
+						   const ACMW_UINT32			nFrameChannels )
+{
+	if ( ( pSrcBuff == NULL ) || ( nSrc < 0 ) || ( (ACMW_UINT32)nSrc >= nFrameChannels ) || ( pSrcBuff[nSrc] == NULL ) ) {
+		flacd_OutputSamples( pFormat, pDst, nStride, NULL, nLength );
+	} else if ( ( ( pStaticStructure->sPending.nConstantMask >> (ACMW_UINT32)nSrc ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) {
+		flacd_OutputConstant( pFormat, pDst, nStride, pStaticStructure->sPending.nConstant[nSrc], nLength );
 	} else {
-		for ( i = 0; i < block_length ; i++ ) {
-			pDstBuff[i] = (ACMW_INT32)( pSrcBuff[i] << nShiftBits );
-		} /* end for */
+		flacd_OutputSamples( pFormat, pDst, nStride, pSrcBuff[nSrc], nLength );
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		mix_applies
+*
+* ARGUMENT
+* 		const flacd_StaticArea*	const pStaticStructure
+*		const ACMW_UINT32		nFrameChannels
+*
+* RETURN VALUE
+* 		ACMW_BOOL				1 : the channel mix is applied to the frame
+*
+* OVERVIEW
+* 		A remap is applied to every frame, a matrix only to frames that
+* 		have the number of channels it was set for.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL mix_applies( const flacd_StaticArea* const pStaticStructure, const ACMW_UINT32 nFrameChannels )
+{
+	ACMW_BOOL bApply = (ACMW_BOOL)0;
+
+	if ( pStaticStructure->sChannelMix.nMode == (ACMW_UINT16)FLACD_MIXCFG_REMAP ) {
+		bApply = (ACMW_BOOL)1;
+	} else if ( ( pStaticStructure->sChannelMix.nMode == (ACMW_UINT16)FLACD_MIXCFG_MATRIX ) &&
+				( (ACMW_UINT32)pStaticStructure->sChannelMix.nInChannels == nFrameChannels ) ) {
+		bApply = (ACMW_BOOL)1;
+	} else {
+		/* not applied */
 	} /* end if */
+	return bApply;
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output_pending
+*
+* ARGUMENT
+* 		flacd_StaticArea*				const pStaticStructure
+*		const flacd_ioBufferConfigInfo*	const pBuffConfigInfo
+*		const flacd_outputRingInfo*		const pRing
+*		flacd_decStatusInfo*			const pDecStatusInfo
+*		flacd_ioBufferStatusInfo*		const pBuffStatusInfo
+*		FLAC__int32* const *			pSrcBuff
+*
+* RETURN VALUE
+* 		ACMW_BOOL						0 : no room in the output buffer
+*
+* OVERVIEW
+* 		Output as much of the pending frame as fits in the output buffer
+* 		and set the status of the output samples. Without PCM output the
+* 		whole frame is counted in the waveform overview; in the frame test
+* 		the whole frame is passed over.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL output_pending( flacd_StaticArea*					const pStaticStructure,
+								 const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+								 const flacd_outputRingInfo*		const pRing,
+								 flacd_decStatusInfo*				const pDecStatusInfo,
+								 flacd_ioBufferStatusInfo*			const pBuffStatusInfo,
+								 FLAC__int32*						const * const pSrcBuff )
+{
+	flacd_PendingOutput* const pPending = &(pStaticStructure->sPending);
+	ACMW_UINT32	nFrameSize;
+	ACMW_UINT32	nSamples;
+	ACMW_UINT16	nFormatChange = (ACMW_UINT16)0U;
+
+	/* output size of one sample period */
+	nFrameSize = flacd_OutputSampleSize(pStaticStructure->nOutFormat);
+	if ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) {
+		nFrameSize *= (ACMW_UINT32)pStaticStructure->nOutputChannel;
+	} /* end if */
+
+	if ( ( pStaticStructure->sOverview.nMode == (ACMW_UINT16)FLACD_OVERVIEWCFG_NO_OUTPUT ) ||
+		 ( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) ) {
+		nSamples = pPending->nRemainSamples;
+		nFrameSize = (ACMW_UINT32)0U;
+	} else if ( pRing != NULL ) {
+		nSamples = pRing->nAvailFrames;
+	} else {
+		nSamples = pBuffConfigInfo->nOutBuffSize / nFrameSize;
+	} /* end if */
+	if ( nSamples == (ACMW_UINT32)0U ) {
+		return (ACMW_BOOL)0;
+	} /* end if */
+	if ( nSamples > pPending->nRemainSamples ) {
+		nSamples = pPending->nRemainSamples;
+	} /* end if */
+
+	/* Set to Decoder Status Information Structure */
+	pDecStatusInfo->nSampleRate = pPending->nSampleRate;
+	pDecStatusInfo->nDecodedSamples = nSamples;
+	pDecStatusInfo->nChannels = pPending->nChannels;
+	pDecStatusInfo->nChannelInfo = pPending->nChannelInfo;
+	pDecStatusInfo->nBitsPerSample = pPending->nBitsPerSample;
+	pDecStatusInfo->nRemainSamples = pPending->nRemainSamples - nSamples;
+	pDecStatusInfo->nSamplePosition = pPending->nFirstSample + pPending->nOffset;
+	pDecStatusInfo->nSilentChannels = silent_channels( pStaticStructure, ( pPending->bMute == (ACMW_BOOL)1 ) ? NULL : pSrcBuff );
+	pBuffStatusInfo->nOutBuffUsedDataSize = nSamples * nFrameSize;
+
+	/* Format change against the samples output before */
+	if ( pStaticStructure->nLastSampleRate != (ACMW_UINT32)0U ) {
+		if ( pStaticStructure->nLastSampleRate != pPending->nSampleRate ) {
+			nFormatChange |= (ACMW_UINT16)FLACD_FORMAT_SAMPLE_RATE;
+		} /* end if */
+		if ( pStaticStructure->nLastChannels != pPending->nChannels ) {
+			nFormatChange |= (ACMW_UINT16)FLACD_FORMAT_CHANNELS;
+		} /* end if */
+		if ( pStaticStructure->nLastBitsPerSample != pPending->nBitsPerSample ) {
+			nFormatChange |= (ACMW_UINT16)FLACD_FORMAT_BITS_PER_SAMPLE;
+		} /* end if */
+	} /* end if */
+	pStaticStructure->nLastSampleRate = pPending->nSampleRate;
+	pStaticStructure->nLastChannels = pPending->nChannels;
+	pStaticStructure->nLastBitsPerSample = pPending->nBitsPerSample;
+	pDecStatusInfo->nFormatChange = nFormatChange;
+
+	/* the frame test has only parsed the frame : nothing to finish or output */
+	if ( pStaticStructure->sVerify.nMode != (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) {
+		output_frame( pStaticStructure, pBuffConfigInfo, pRing, pBuffStatusInfo, ( pPending->bMute == (ACMW_BOOL)1 ) ? NULL : pSrcBuff,
+					  pPending->nOffset, nSamples, (ACMW_UINT32)pPending->nBitsPerSample, (ACMW_UINT32)pPending->nFrameChannels );
+	} /* end if */
+
+	pPending->nOffset += nSamples;
+	pPending->nRemainSamples -= nSamples;
+	return (ACMW_BOOL)1;
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		silent_channels
+*
+* ARGUMENT
+* 		const flacd_StaticArea*	const pStaticStructure
+*		FLAC__int32* const *	pSrcBuff
+*
+* RETURN VALUE
+* 		ACMW_UINT16				output channels that are silent, bit 0 = channel 0
+*
+* OVERVIEW
+* 		Find the output channels of the pending frame that are digital
+* 		silence: the frame channels that are not decoded or are a constant
+* 		zero, followed through the channel mix. pSrcBuff == NULL is mute.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_UINT16 silent_channels( const flacd_StaticArea* const pStaticStructure, FLAC__int32* const * const pSrcBuff )
+{
+	const flacd_PendingOutput* const pPending = &(pStaticStructure->sPending);
+	const flacd_ChannelMix* const pMix = &pStaticStructure->sChannelMix;
+	const ACMW_UINT32	nFrameChannels = (ACMW_UINT32)pPending->nFrameChannels;
+	ACMW_UINT32	nInSilent = (ACMW_UINT32)0U;
+	ACMW_UINT32	nOutSilent = (ACMW_UINT32)0U;
+	ACMW_UINT32	i, j;
+	ACMW_INT32	nSrc;
+
+	for (i = 0; i < FLAC__MAX_CHANNELS; i++) {
+		if ( ( pSrcBuff == NULL ) || ( i >= nFrameChannels ) || ( pSrcBuff[i] == NULL ) ||
+			 ( ( ( ( pPending->nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) && ( pPending->nConstant[i] == 0 ) ) ) {
+			nInSilent |= (ACMW_UINT32)1U << i;
+		} /* end if */
+	} /* end for */
+
+	for (i = 0; i < (ACMW_UINT32)pStaticStructure->nOutputChannel; i++) {
+		if ( ( pSrcBuff == NULL ) || ( mix_applies( pStaticStructure, nFrameChannels ) == (ACMW_BOOL)0 ) ) {
+			nOutSilent |= nInSilent & ( (ACMW_UINT32)1U << i );
+		} else if ( i >= (ACMW_UINT32)pMix->nOutChannels ) {
+			nOutSilent |= (ACMW_UINT32)1U << i;
+		} else if ( pMix->nMode == (ACMW_UINT16)FLACD_MIXCFG_REMAP ) {
+			nSrc = (ACMW_INT32)pMix->nRemap[i];
+			if ( ( nSrc < 0 ) || ( ( ( nInSilent >> (ACMW_UINT32)nSrc ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) ) {
+				nOutSilent |= (ACMW_UINT32)1U << i;
+			} /* end if */
+		} else {
+			nOutSilent |= (ACMW_UINT32)1U << i;
+			for (j = 0; j < (ACMW_UINT32)pMix->nInChannels; j++) {
+				if ( ( pMix->fMatrix[i][j] != (ACMW_FLOAT32)0.0f ) && ( ( ( nInSilent >> j ) & (ACMW_UINT32)1U ) == (ACMW_UINT32)0U ) ) {
+					nOutSilent &= ~( (ACMW_UINT32)1U << i );
+				} /* end if */
+			} /* end for */
+		} /* end if */
+	} /* end for */
+	return (ACMW_UINT16)nOutSilent;
 }
 /*------------------------------------------------------------------------------*/
@@ -0,0 +1,276 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_DecodeMix.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+static ACMW_INT32 mix_voice( const flacd_StaticArea*		const pFirst,
+							 const flacd_voiceConfigInfo*	const pVoice,
+							 void**							const pOutBuffStart,
+							 const ACMW_UINT32				nSamples,
+							 flacd_voiceStatusInfo*			const pVoiceStatus );
+static void mix_clear( const flacd_StaticArea*	const pStaticStructure,
+					   void*					const * const pOutBuffStart,
+					   const ACMW_UINT32		nSamples );
+
+/*==========================================================================
+ [Function Name]
+   flacd_DecodeMix
+
+ [Description]
+   Decode several streams (voices) and add them, each with its gain,
+   into one output buffer. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_DecodeMix(
+           flacd_mixConfigInfo *pMixConfigInfo,
+           flacd_mixStatusInfo *pMixStatusInfo)
+
+ [Argument]
+   const flacd_mixConfigInfo *    pMixConfigInfo
+           Pointer to Mix Decode Config Information Structure
+   flacd_mixStatusInfo *          pMixStatusInfo
+           Pointer to Mix Decode Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : Warning Error (a voice had frames with
+                                  a CRC error, which add nothing)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init of every voice. The frames of each voice are
+   decoded one after the other as with flacd_Decode, and each tile of
+   decoded samples is scaled, converted and added to the output in the
+   output stage: no output of a single voice is written. The Error
+   Factor of an error of the output buffer is set to the first voice; a
+   voice with an error (NG) does not stop the others.
+==========================================================================*/
+ACMW_INT32	flacd_DecodeMix( const flacd_mixConfigInfo*	const pMixConfigInfo,
+							 flacd_mixStatusInfo*		const pMixStatusInfo )
+{
+	const flacd_workMemoryInfo *pWorkMemInfo;
+	flacd_StaticArea *pFirst;
+	flacd_voiceStatusInfo *pVoiceStatus;
+	ACMW_INT32 nResult = FLACD_RESULT_OK;
+	ACMW_UINT32 v, nFrameSize, nSamples;
+
+	/* Argument Check */
+	if ((pMixConfigInfo == NULL) ||		/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pMixStatusInfo == NULL) ||		/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pMixConfigInfo->pVoices == NULL) ||
+		(pMixStatusInfo->pVoices == NULL) ||
+		(pMixConfigInfo->nVoices == (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pWorkMemInfo = pMixConfigInfo->pVoices[0].pWorkMemInfo;
+	if ((pWorkMemInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pFirst = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pFirst->nErrorFactor = FLACD_ERR_NONE;
+
+	/* Fill Status Info */
+	pMixStatusInfo->nMixedSamples = (ACMW_UINT32)0U;
+	pMixStatusInfo->nOutBuffUsedDataSize = (ACMW_UINT32)0U;
+
+	/* The output is checked against the first voice */
+	if (pMixConfigInfo->pOutBuffStart == NULL) {
+		pFirst->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	if ( flacd_DecodeCheckOutput( pFirst, pMixConfigInfo->pOutBuffStart ) == (ACMW_BOOL)0 ) {
+		pFirst->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	nFrameSize = flacd_DecodeFrameSize( pFirst );
+	nSamples = pMixConfigInfo->nOutBuffSize / nFrameSize;
+	if ( ( pMixConfigInfo->nOutMode > (ACMW_UINT16)FLACD_MIXOUT_ADD ) || ( nSamples == (ACMW_UINT32)0U ) ) {
+		pFirst->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( pMixConfigInfo->nOutMode == (ACMW_UINT16)FLACD_MIXOUT_CLEAR ) {
+		mix_clear( pFirst, pMixConfigInfo->pOutBuffStart, nSamples );
+	} /* end if */
+
+	/* Add the voices one after the other */
+	for ( v = 0; v < pMixConfigInfo->nVoices; v++ ) {
+		pVoiceStatus = &pMixStatusInfo->pVoices[v];
+		flacd_MemSet(pVoiceStatus, 0, sizeof(flacd_voiceStatusInfo));
+		pVoiceStatus->nResult = mix_voice( pFirst, &pMixConfigInfo->pVoices[v], pMixConfigInfo->pOutBuffStart, nSamples, pVoiceStatus );
+		if ( ( pVoiceStatus->nResult == FLACD_RESULT_NG ) || ( pVoiceStatus->nResult == FLACD_RESULT_FATAL ) ) {
+			nResult = FLACD_RESULT_NG;
+		} else if ( ( pVoiceStatus->nResult == FLACD_RESULT_WARNING ) && ( nResult == FLACD_RESULT_OK ) ) {
+			nResult = FLACD_RESULT_WARNING;
+		} else {
+			/* no change */
+		} /* end if */
+	} /* end for */
+
+	/* Set Status Info */
+	pMixStatusInfo->nMixedSamples = nSamples;
+	pMixStatusInfo->nOutBuffUsedDataSize = nSamples * nFrameSize;
+
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		mix_voice
+*
+* ARGUMENT
+* 		const flacd_StaticArea*			const pFirst
+*		const flacd_voiceConfigInfo*	const pVoice
+*		void**							const pOutBuffStart
+*		const ACMW_UINT32				nSamples
+*		flacd_voiceStatusInfo*			const pVoiceStatus
+*
+* RETURN VALUE
+* 		ACMW_INT32						Error Code of the voice
+*
+* OVERVIEW
+* 		Check one voice against the first and add up to nSamples samples
+* 		of it to the output. The Error Factor is set to the voice.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_INT32 mix_voice( const flacd_StaticArea*		const pFirst,
+							 const flacd_voiceConfigInfo*	const pVoice,
+							 void**							const pOutBuffStart,
+							 const ACMW_UINT32				nSamples,
+							 flacd_voiceStatusInfo*			const pVoiceStatus )
+{
+	const flacd_workMemoryInfo* const pWorkMemInfo = pVoice->pWorkMemInfo;
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	ACMW_INT32 nResult;
+	ACMW_UINT32 nInUsed, nDone;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pVoice->pDecConfigInfo == NULL) ||		/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pVoice->pInBuffStart == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value : the voices share the output, and each writes to it */
+	if ( ( pStaticStructure->nOutFormat != pFirst->nOutFormat ) ||
+		 ( pStaticStructure->nOutLayout != pFirst->nOutLayout ) ||
+		 ( pStaticStructure->nOutputChannel != pFirst->nOutputChannel ) ||
+		 ( pStaticStructure->sOverview.nMode == (ACMW_UINT16)FLACD_OVERVIEWCFG_NO_OUTPUT ) ||
+		 ( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) ||
+		 ( pVoice->fGain != pVoice->fGain ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check DecConfig Value and Set DecConfig Value (not needed for the rest of a frame) */
+	if ( pStaticStructure->sPending.nRemainSamples == (ACMW_UINT32)0U ) {
+		pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, pVoice->pDecConfigInfo );
+		if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+			return FLACD_RESULT_NG;
+		} /* end if */
+		FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pVoice->pDecConfigInfo );
+	} /* end if */
+
+	/* The output stage adds the voice to the output */
+	pStaticStructure->bAccumulate = (ACMW_BOOL)1;
+	pStaticStructure->fVoiceGain = pVoice->fGain;
+	nResult = flacd_DecodeRun( pStaticStructure, pWorkMemInfo->pScratch, pVoice->pInBuffStart, pVoice->nInBuffSetDataSize,
+							   pOutBuffStart, nSamples, &nInUsed, &nDone );
+	pStaticStructure->bAccumulate = (ACMW_BOOL)0;
+
+	/* Set Status Info */
+	pVoiceStatus->nDecodedSamples = nDone;
+	pVoiceStatus->nRemainSamples = pStaticStructure->sPending.nRemainSamples;
+	pVoiceStatus->nInBuffUsedDataSize = nInUsed;
+
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		mix_clear
+*
+* ARGUMENT
+* 		const flacd_StaticArea*	const pStaticStructure
+*		void* const *			pOutBuffStart
+*		const ACMW_UINT32		nSamples
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Clear nSamples samples of every output buffer to silence
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void mix_clear( const flacd_StaticArea*	const pStaticStructure,
+					   void*					const * const pOutBuffStart,
+					   const ACMW_UINT32		nSamples )
+{
+	ACMW_UINT32 i;
+	const ACMW_UINT32 nSize = nSamples * flacd_DecodeFrameSize( pStaticStructure );
+
+	if ( pStaticStructure->nOutLayout == FLACD_INITCFG_INTERLEAVED ) {
+		flacd_MemSet( pOutBuffStart[0], 0, (ACMW_INT32)nSize );
+	} else {
+		for ( i = 0; i < (ACMW_UINT32)pStaticStructure->nOutputChannel; i++ ) {
+			if ( pOutBuffStart[i] != NULL ) {
+				flacd_MemSet( pOutBuffStart[i], 0, (ACMW_INT32)nSize );
+			} /* end if */
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,80 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_DecodeRing.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_DecodeRing
+
+ [Description]
+   Decode one frame into an output ring buffer. This is a top level
+   wrapper.
+
+ [Prototype]
+   INT32  flacd_DecodeRing(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_decConfigInfo *pDecConfigInfo,
+           flacd_ioBufferConfigInfo *pBuffConfigInfo,
+           flacd_outputRingInfo *pOutRing,
+           flacd_decStatusInfo *pDecStatusInfo,
+           flacd_ioBufferStatusInfo *pBuffStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *       pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_decConfigInfo *        pDecConfigInfo
+           Pointer to Decoder Configuration Information Structure
+   const flacd_ioBufferConfigInfo *   pBuffConfigInfo
+           Pointer to Buffer Configuration Information Structure
+   const flacd_outputRingInfo *       pOutRing
+           Pointer to Output Ring Buffer Information Structure
+   const flacd_decStatusInfo *        pDecStatusInfo
+           Pointer to Decoder Status Information Structure
+   const flacd_ioBufferStatusInfo *   pBuffStatusInfo
+           Pointer to Buffer Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : Warning Error
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Same as flacd_Decode, except that the output is written to the area
+   described by pOutRing from the bases pOutBuffStart, and at most
+   nAvailFrames samples are output. nOutBuffSize is not used. pOutRing
+   is only read during the call.
+==========================================================================*/
+ACMW_INT32	flacd_DecodeRing( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							  const flacd_decConfigInfo*		const pDecConfigInfo,
+							  const flacd_ioBufferConfigInfo*	const pBuffConfigInfo,
+							  const flacd_outputRingInfo*		const pOutRing,
+							  flacd_decStatusInfo*				const pDecStatusInfo,
+							  flacd_ioBufferStatusInfo*			const pBuffStatusInfo )
+{
+	/* Argument Check */
+	if ((pWorkMemInfo == NULL) || (pWorkMemInfo->pStatic == NULL)) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if (pOutRing == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		((flacd_StaticArea*)pWorkMemInfo->pStatic)->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	return flacd_DecodeBuffer( pWorkMemInfo, pDecConfigInfo, pBuffConfigInfo, pOutRing, pDecStatusInfo, pBuffStatusInfo );
+}
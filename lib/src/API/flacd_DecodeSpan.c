@@ -0,0 +1,100 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_DecodeSpan.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_DecodeSpan
+
+ [Description]
+   Decode one frame of a session opened by flacd_OpenSession.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_DecodeSpan(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_spanInfo *pSpanInfo,
+           flacd_decStatusInfo *pDecStatusInfo,
+           flacd_ioBufferStatusInfo *pBuffStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *       pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_spanInfo *             pSpanInfo
+           Pointer to Input / Output Span Structure
+   const flacd_decStatusInfo *        pDecStatusInfo
+           Pointer to Decoder Status Information Structure
+   const flacd_ioBufferStatusInfo *   pBuffStatusInfo
+           Pointer to Buffer Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : Warning Error
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Same results as flacd_Decode with the bound configuration. Only the
+   pointers are checked for NULL; the alignment rules of flacd_Decode
+   apply to the spans. The decoder is pointed into the scratch memory
+   again only when pScratch changes.
+==========================================================================*/
+ACMW_INT32	flacd_DecodeSpan( const flacd_workMemoryInfo*	const pWorkMemInfo,
+							  const flacd_spanInfo*			const pSpanInfo,
+							  flacd_decStatusInfo*			const pDecStatusInfo,
+							  flacd_ioBufferStatusInfo*		const pBuffStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	flacd_ioBufferConfigInfo sBuffConfigInfo;
+
+	/* Argument Check */
+	if ((pWorkMemInfo == NULL) || (pWorkMemInfo->pStatic == NULL)) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pBuffStatusInfo == NULL) || (pBuffStatusInfo->pOutBuffLast == NULL) || (pDecStatusInfo == NULL) ||
+		(pSpanInfo == NULL) || (pSpanInfo->pInBuff == NULL) || (pSpanInfo->pOutBuff == NULL) ||
+		(pWorkMemInfo->pScratch == NULL)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pBuffStatusInfo->nInBuffUsedDataSize = (ACMW_UINT32)0U;
+	pBuffStatusInfo->nOutBuffUsedDataSize = (ACMW_UINT32)0U;
+	pBuffStatusInfo->pInBuffLast = pSpanInfo->pInBuff;
+
+	/* Check Sequence */
+	if ( pStaticStructure->bSessionOpen != (ACMW_BOOL)1 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Fill Status Info */
+	flacd_MemSet(pDecStatusInfo, 0, sizeof(flacd_decStatusInfo));
+
+	sBuffConfigInfo.pInBuffStart = pSpanInfo->pInBuff;
+	sBuffConfigInfo.nInBuffSetDataSize = pSpanInfo->nInSize;
+	sBuffConfigInfo.pOutBuffStart = pSpanInfo->pOutBuff;
+	sBuffConfigInfo.nOutBuffSize = pSpanInfo->nOutSize;
+
+	return flacd_DecodeFrame( pStaticStructure, pWorkMemInfo->pScratch, &sBuffConfigInfo, pStaticStructure->pSessionRing,
+							  pDecStatusInfo, pBuffStatusInfo );
+}
@@ -0,0 +1,188 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_DecodeStream.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+#define STREAM_FRAME_SYNC_BYTE		((ACMW_UINT8)0xFFU)
+
+/*==========================================================================
+ [Function Name]
+   flacd_DecodeStream
+
+ [Description]
+   Decode a whole stream held in memory into one output buffer.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_DecodeStream(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_streamConfigInfo *pStreamConfigInfo,
+           flacd_streamStatusInfo *pStreamStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *       pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_streamConfigInfo *     pStreamConfigInfo
+           Pointer to Stream Decode Config Information Structure
+   flacd_streamStatusInfo *           pStreamStatusInfo
+           Pointer to Stream Decode Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : Warning Error (mute data output for
+                                  frames with a CRC error)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. The decoder is restarted at the first frame of
+   the input, dropping any samples not yet output. Frames that lose sync
+   are skipped as flacd_Decode does. On an error the status tells the
+   samples output before it. In the frame test (flacd_SetVerify) the
+   frames are only checked: no output buffer is needed and
+   nOutBuffNeedSize is 0.
+==========================================================================*/
+ACMW_INT32	flacd_DecodeStream( const flacd_workMemoryInfo*		const pWorkMemInfo,
+								const flacd_streamConfigInfo*	const pStreamConfigInfo,
+								flacd_streamStatusInfo*			const pStreamStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	flacd_headerConfigInfo sHeaderConfigInfo;
+	flacd_headerStatusInfo sHeaderStatusInfo;
+	ACMW_INT32 nResult;
+	ACMW_UINT32 nFrameSize, nCapacity, nUsed, nInUsed, nDone;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pStreamConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pStreamStatusInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pStreamConfigInfo->pInBuffStart == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Fill Status Info */
+	flacd_MemSet(pStreamStatusInfo, 0, sizeof(flacd_streamStatusInfo));
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Stream configuration : STREAMINFO, or the given one for bare frames */
+	nUsed = (ACMW_UINT32)0U;
+	if ( ( pStreamConfigInfo->nInBuffSetDataSize != (ACMW_UINT32)0U ) && ( pStreamConfigInfo->pInBuffStart[0] != STREAM_FRAME_SYNC_BYTE ) ) {
+		flacd_MemSet(&sHeaderStatusInfo, 0, sizeof(flacd_headerStatusInfo));
+		sHeaderConfigInfo.pInBuffStart = pStreamConfigInfo->pInBuffStart;
+		sHeaderConfigInfo.nInBuffSetDataSize = pStreamConfigInfo->nInBuffSetDataSize;
+		sHeaderConfigInfo.nInBuffOffset = (ACMW_UINT32)0U;
+		nResult = flacd_ParseHeader( &sHeaderConfigInfo, &sHeaderStatusInfo );
+		if ( nResult == FLACD_RESULT_WARNING ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_SHORT_INPUT_DATA;
+			return FLACD_RESULT_NG;
+		} else if ( nResult != FLACD_RESULT_OK ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
+			return FLACD_RESULT_NG;
+		} else {
+			pStreamStatusInfo->sDecConfig = sHeaderStatusInfo.sDecConfig;
+			pStreamStatusInfo->nTotalSamples = sHeaderStatusInfo.nTotalSamples;
+			nUsed = sHeaderStatusInfo.nAudioOffset;
+		} /* end if */
+	}
+	else {
+		if ( pStreamConfigInfo->pDecConfigInfo == NULL ) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+			pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		pStreamStatusInfo->sDecConfig = *(pStreamConfigInfo->pDecConfigInfo);
+	} /* end if */
+
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, &(pStreamStatusInfo->sDecConfig) );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Output size from the total samples (the buffer size when unknown) */
+	nFrameSize = flacd_DecodeFrameSize( pStaticStructure );
+	if ( pStreamStatusInfo->nTotalSamples > ( (ACMW_UINT32)0xFFFFFFFFU / nFrameSize ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_NOT_SUPPORTED_DATA;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	if ( pStaticStructure->sVerify.nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) {
+		/* The frame test writes no output : check all the frames */
+		nFrameSize = (ACMW_UINT32)0U;
+		nCapacity = ( pStreamStatusInfo->nTotalSamples != (ACMW_UINT32)0U ) ? pStreamStatusInfo->nTotalSamples : (ACMW_UINT32)0xFFFFFFFFU;
+	}
+	else {
+		pStreamStatusInfo->nOutBuffNeedSize = pStreamStatusInfo->nTotalSamples * nFrameSize;
+
+		/* No output buffer : tell the size only */
+		if ( pStreamConfigInfo->pOutBuffStart == NULL ) {
+			return FLACD_RESULT_OK;
+		} /* end if */
+
+		if ( flacd_DecodeCheckOutput( pStaticStructure, pStreamConfigInfo->pOutBuffStart ) == (ACMW_BOOL)0 ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+
+		nCapacity = pStreamConfigInfo->nOutBuffSize / nFrameSize;
+		if ( nCapacity < pStreamStatusInfo->nTotalSamples ) {
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+		} /* end if */
+		if ( pStreamStatusInfo->nTotalSamples != (ACMW_UINT32)0U ) {
+			nCapacity = pStreamStatusInfo->nTotalSamples;
+		} /* end if */
+	} /* end if */
+
+	/* Set Config Value */
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), &(pStreamStatusInfo->sDecConfig) );
+	flacd_DecodeRestart( pStaticStructure, (ACMW_UINT32)0U );
+
+	nResult = flacd_DecodeRun( pStaticStructure, pWorkMemInfo->pScratch, pStreamConfigInfo->pInBuffStart + nUsed,
+							   pStreamConfigInfo->nInBuffSetDataSize - nUsed, pStreamConfigInfo->pOutBuffStart, nCapacity, &nInUsed, &nDone );
+	/* a frame that did not fit in the rest of the buffer */
+	if ( ( nResult != FLACD_RESULT_NG ) && ( pStaticStructure->sPending.nRemainSamples != (ACMW_UINT32)0U ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		nResult = FLACD_RESULT_NG;
+	} /* end if */
+	pStaticStructure->sPending.nRemainSamples = (ACMW_UINT32)0U;
+
+	/* Set Status Info */
+	pStreamStatusInfo->nDecodedSamples = nDone;
+	pStreamStatusInfo->nInBuffUsedDataSize = nUsed + nInUsed;
+	pStreamStatusInfo->nOutBuffUsedDataSize = nDone * nFrameSize;
+
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
@@ -37,7 +37,9 @@
              FLACD_ERR_POINTER             : Pointer is incorrect.
              FLACD_ERR_PARAMETER           : Parameter is incorrect.
              FLACD_ERR_SEQUENCE            : Sequence is incorrect.
+             FLACD_ERR_SCRATCH_EXHAUSTED   : No scratch block is free in the pool.
              FLACD_ERR_SHORT_INPUT_DATA    : An error of input data shortage has occurred.
+             FLACD_ERR_SCRATCH_PINNED      : A scratch block stays pinned to an instance.
              FLACD_ERR_NOT_SUPPORTED_DATA  : It isn't supported.
              FLACD_ERR_LOST_SYNC           : Syncword isn't found.
              FLACD_ERR_CHANGE_FRAME_HEADER : Sampling Frequency is changed.
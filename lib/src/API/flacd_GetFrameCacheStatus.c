@@ -0,0 +1,92 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_GetFrameCacheStatus.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_framecache.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_GetFrameCacheStatus
+
+ [Description]
+   Get the slot size and the counters of the decoded frame cache.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_GetFrameCacheStatus(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_frameCacheStatusInfo *pCacheStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   flacd_frameCacheStatusInfo *        pCacheStatusInfo
+           Pointer to Frame Cache Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. Before flacd_SetFrameCache, nSlotSize may be
+   used to size the cache memory for the largest frames of the instance.
+==========================================================================*/
+ACMW_INT32	flacd_GetFrameCacheStatus( const flacd_workMemoryInfo*	const pWorkMemInfo,
+									   flacd_frameCacheStatusInfo*	const pCacheStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	const flacd_FrameCacheHeader *pCache;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pCacheStatusInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pCache = (const flacd_FrameCacheHeader*)pStaticStructure->pFrameCache;
+	if ( pCache != NULL ) {
+		pCacheStatusInfo->nSlotSize = pCache->nSlotSize;
+		pCacheStatusInfo->nSlots = pCache->nSlots;
+		pCacheStatusInfo->nEntries = pCache->nEntries;
+		pCacheStatusInfo->nHits = pCache->nHits;
+		pCacheStatusInfo->nMisses = pCache->nMisses;
+		pCacheStatusInfo->nEvictions = pCache->nEvictions;
+	}
+	else {
+		pCacheStatusInfo->nSlotSize = flacd_FrameCacheSlotSize( pStaticStructure, (ACMW_UINT32)0U, (ACMW_UINT32)0U );
+		pCacheStatusInfo->nSlots = (ACMW_UINT32)0U;
+		pCacheStatusInfo->nEntries = (ACMW_UINT32)0U;
+		pCacheStatusInfo->nHits = (ACMW_UINT32)0U;
+		pCacheStatusInfo->nMisses = (ACMW_UINT32)0U;
+		pCacheStatusInfo->nEvictions = (ACMW_UINT32)0U;
+	} /* end if */
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
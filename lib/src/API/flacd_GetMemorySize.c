@@ -13,6 +13,8 @@
 #include "flacd_Lib.h"
 #include "flacd_api.h"
 #include "flacd_common.h"
+#include "flacd_output.h"
+#include "flacd_memory.h"
 
 /*==========================================================================
  [Function Name]
@@ -39,12 +41,18 @@
                                  : static region could not be established.
 
  [Note]
-   None
+   The scratch memory and the input buffer are sized to nMaxBlockSize,
+   nBitsPerSample and nChannels. Each 0 selects the worst case.
+   The scratch memory holds nDecodeChannels channels only.
+   The scratch memory is only used during flacd_Decode and can be shared
+   between instances through a scratch pool.
 ==========================================================================*/
 ACMW_INT32	flacd_GetMemorySize(const flacd_getMemorySizeConfigInfo* const pGetMemorySizeConfigInfo,
 								flacd_getMemorySizeStatusInfo* const pGetMemorySizeStatusInfo)
 {
-	ACMW_UINT32 nInputChan, nOutputChan;
+	ACMW_UINT32 nInputChan, nOutputChan, nDecodeChan, nSampleSize;
+	ACMW_UINT32 nMaxBlockSize, nBitsPerSample;
+	flacd_ScratchLayout sLayout;
 
 	/* Argument Check */
 	if (pGetMemorySizeConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
@@ -76,15 +84,46 @@ ACMW_INT32	flacd_GetMemorySize(const flacd_getMemorySizeConfigInfo* const pGetMe
 		default :
 			return FLACD_RESULT_FATAL;
 	} /* end switch */
+	if ( (ACMW_UINT32)pGetMemorySizeConfigInfo->nChannels > nInputChan ) {
+		return FLACD_RESULT_FATAL;
+	} else if ( pGetMemorySizeConfigInfo->nChannels != 0x0000u ) {
+		nInputChan = (ACMW_UINT32)pGetMemorySizeConfigInfo->nChannels;
+	} else {
+		/* worst case of nInputChannel */
+	} /* end if */
+	nMaxBlockSize = ( pGetMemorySizeConfigInfo->nMaxBlockSize == 0x0000u ) ? FLAC__SPEC_MAX_BLOCK_SIZE : (ACMW_UINT32)pGetMemorySizeConfigInfo->nMaxBlockSize;
+	if ( nMaxBlockSize > FLAC__SPEC_MAX_BLOCK_SIZE ) {	/* RCG3AFLDL4001ZDO P-00016 */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+	nBitsPerSample = ( pGetMemorySizeConfigInfo->nBitsPerSample == 0x0000u ) ? FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE : (ACMW_UINT32)pGetMemorySizeConfigInfo->nBitsPerSample;
+	if ( ( nBitsPerSample > FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE ) || ( nBitsPerSample < FLAC__MIN_BITS_PER_SAMPLE ) ) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+	if ( (ACMW_UINT32)pGetMemorySizeConfigInfo->nDecodeChannels > nInputChan ) {
+		return FLACD_RESULT_FATAL;
+	} else if ( pGetMemorySizeConfigInfo->nDecodeChannels == (ACMW_UINT16)1U ) {	/* a stereo pair is decoded together */
+		return FLACD_RESULT_FATAL;
+	} else if ( pGetMemorySizeConfigInfo->nDecodeChannels != 0x0000u ) {
+		nDecodeChan = (ACMW_UINT32)pGetMemorySizeConfigInfo->nDecodeChannels;
+	} else {
+		nDecodeChan = nInputChan;
+	} /* end if */
+	flacd_SetScratchLayout( &sLayout, nMaxBlockSize, nDecodeChan );
 
 	/* Set to Memory Size Status Information Structure */
 	pGetMemorySizeStatusInfo->nStaticSize = sizeof(flacd_StaticArea);
-	pGetMemorySizeStatusInfo->nScratchSize = (ACMW_UINT32)(sizeof(flacd_ScratchArea) * nInputChan);
-	pGetMemorySizeStatusInfo->nInputBufferSize = (FLACD_INBUFF_DATA_SIZE * nInputChan) + FLACD_INBUFF_HEADER_SIZE;
-	if ( pGetMemorySizeConfigInfo->nOutBitsPerSample == 0x0000u ) {
-		pGetMemorySizeStatusInfo->nOutputBufferSize = FLAC__SPEC_MAX_BLOCK_SIZE * sizeof(ACMW_INT16);	/* RCG3AFLDL4001ZDO P-00016 */
+	pGetMemorySizeStatusInfo->nScratchSize = sLayout.nScratchSize;
+	pGetMemorySizeStatusInfo->nInputBufferSize = flacd_InputBufferSize( nMaxBlockSize, nBitsPerSample, nInputChan );
+	if ( pGetMemorySizeConfigInfo->nOutSampleFormat == FLACD_INITCFG_OUTFMT_FLOAT32 ) {
+		nSampleSize = flacd_OutputSampleSize(FLACD_OUTFMT_FLOAT32);
+	} else if ( pGetMemorySizeConfigInfo->nOutBitsPerSample == 0x0000u ) {
+		nSampleSize = flacd_OutputSampleSize(FLACD_OUTFMT_PCM16);
 	} else {
-		pGetMemorySizeStatusInfo->nOutputBufferSize = FLAC__SPEC_MAX_BLOCK_SIZE * sizeof(ACMW_INT32);	/* RCG3AFLDL4001ZDO P-00016 */
+		nSampleSize = flacd_OutputSampleSize(FLACD_OUTFMT_PCM24);
+	}
+	pGetMemorySizeStatusInfo->nOutputBufferSize = nMaxBlockSize * nSampleSize;	/* RCG3AFLDL4001ZDO P-00016 */
+	if ( pGetMemorySizeConfigInfo->nOutLayout == FLACD_INITCFG_INTERLEAVED ) {
+		pGetMemorySizeStatusInfo->nOutputBufferSize *= nOutputChan;
 	}
 	pGetMemorySizeStatusInfo->nStackSize = FLACD_STACK_SIZE;
 	
@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_GetVerifyStatus.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_verify.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_GetVerifyStatus
+
+ [Description]
+   Get the result of the verification of the decoded samples.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_GetVerifyStatus(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_verifyStatusInfo *pVerifyStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *      pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   flacd_verifyStatusInfo *          pVerifyStatusInfo
+           Pointer to Verify Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, between any two flacd_Decode calls. The
+   verification goes on after the call.
+==========================================================================*/
+ACMW_INT32	flacd_GetVerifyStatus( const flacd_workMemoryInfo*	const pWorkMemInfo,
+								   flacd_verifyStatusInfo*		const pVerifyStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	const flacd_Verify *pVerify;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pVerifyStatusInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Fill Status Info */
+	flacd_MemSet(pVerifyStatusInfo, 0, sizeof(flacd_verifyStatusInfo));
+
+	pVerify = &(pStaticStructure->sVerify);
+	if ( pVerify->nMode == (ACMW_UINT16)FLACD_VERIFYCFG_OFF ) {
+		pVerifyStatusInfo->nVerifyResult = (ACMW_UINT16)FLACD_VERIFY_OFF;
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if ( pVerify->nMode == (ACMW_UINT16)FLACD_VERIFYCFG_FRAMES ) {
+		pVerifyStatusInfo->nVerifiedSamples = pVerify->nTestedSamples;
+		pVerifyStatusInfo->nVerifyResult = pVerify->nResult;
+		pVerifyStatusInfo->nTestedFrames = pVerify->nTestedFrames;
+		pVerifyStatusInfo->nFailedFrames = pVerify->nFailedFrames;
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	pVerifyStatusInfo->nVerifiedSamples = pVerify->nNextSample;
+	pVerifyStatusInfo->nVerifyResult = pVerify->nResult;
+	flacd_VerifyDigest( pVerify, pVerifyStatusInfo->nMD5Signature );
+
+	/* Total unknown : compare the samples decoded so far */
+	if ( ( pVerify->nResult == (ACMW_UINT16)FLACD_VERIFY_PENDING ) && ( pVerify->nTotalSamples == (ACMW_UINT32)0U ) &&
+		 ( pVerify->nNextSample != (ACMW_UINT32)0U ) ) {
+		pVerifyStatusInfo->nVerifyResult = flacd_VerifyCompare( pVerify, pVerifyStatusInfo->nMD5Signature );
+	} /* end if */
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,286 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_IndexBuild.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+#define INDEX_HEADER_OVERLAP		((ACMW_UINT32)16U)			/* largest frame header */
+
+static ACMW_BOOL index_scan( flacd_StaticArea* const pStaticStructure, const flacd_indexBuildConfigInfo* const pIndexBuildConfigInfo,
+							 flacd_indexBuildStatusInfo* const pIndexBuildStatusInfo );
+static void index_finish( const flacd_indexBuildConfigInfo* const pIndexBuildConfigInfo,
+						  flacd_indexBuildStatusInfo* const pIndexBuildStatusInfo );
+
+/*==========================================================================
+ [Function Name]
+   flacd_IndexBuild
+
+ [Description]
+   Build the frame index of a stream from its frame headers.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_IndexBuild(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_indexBuildConfigInfo *pIndexBuildConfigInfo,
+           flacd_indexBuildStatusInfo *pIndexBuildStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *          pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_indexBuildConfigInfo *    pIndexBuildConfigInfo
+           Pointer to Index Build Configuration Information Structure
+   flacd_indexBuildStatusInfo *          pIndexBuildStatusInfo
+           Pointer to Index Build Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal (index finished)
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : More input needed (from nNextOffset)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, then again with the stream from nNextOffset
+   until the result is not FLACD_RESULT_WARNING. Only the frame headers
+   are read, and a frame is indexed only when its sample number follows
+   the previous frame, so a sync pattern inside audio data is skipped.
+   The index is big-endian and position independent; store it as is
+   (e.g. next to the stream) and give it to flacd_SeekIndex later.
+   The scratch memory is used during the call, and the decoder restarts
+   as for flacd_Seek to sample 0.
+==========================================================================*/
+ACMW_INT32	flacd_IndexBuild( const flacd_workMemoryInfo*			const pWorkMemInfo,
+							  const flacd_indexBuildConfigInfo*		const pIndexBuildConfigInfo,
+							  flacd_indexBuildStatusInfo*			const pIndexBuildStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	const flacd_headerStatusInfo *pHeaderInfo;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32 nEnd;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pIndexBuildConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pIndexBuildStatusInfo == NULL) ||
+		(pIndexBuildConfigInfo->pInBuffStart == NULL) ||
+		(pIndexBuildConfigInfo->pHeaderInfo == NULL) ||
+		(pIndexBuildConfigInfo->pIndex == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	pHeaderInfo = pIndexBuildConfigInfo->pHeaderInfo;
+	if ( ( pHeaderInfo->nParseState != FLACD_META_STATE_DONE ) ||
+		 ( pIndexBuildConfigInfo->nStreamSize <= pHeaderInfo->nAudioOffset ) ||
+		 ( pIndexBuildConfigInfo->nIndexSize < (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) ||
+		 ( pIndexBuildStatusInfo->nBuildState > FLACD_INDEX_STATE_SCAN ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, &pHeaderInfo->sDecConfig );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( pIndexBuildStatusInfo->nBuildState == FLACD_INDEX_STATE_START ) {
+		pIndexBuildStatusInfo->nNextOffset = pHeaderInfo->nAudioOffset;
+		pIndexBuildStatusInfo->nNextSample = (ACMW_UINT32)0U;
+		pIndexBuildStatusInfo->nLastEntrySample = (ACMW_UINT32)0U;
+		pIndexBuildStatusInfo->nEntries = (ACMW_UINT32)0U;
+		pIndexBuildStatusInfo->nIndexUsedSize = (ACMW_UINT32)0U;
+		pIndexBuildStatusInfo->nBuildState = FLACD_INDEX_STATE_SCAN;
+	} /* end if */
+
+	/* The input must hold nNextOffset */
+	nEnd = pIndexBuildConfigInfo->nInBuffOffset + pIndexBuildConfigInfo->nInBuffSetDataSize;
+	if ( ( pIndexBuildConfigInfo->nInBuffOffset > pIndexBuildStatusInfo->nNextOffset ) ||
+		 ( nEnd <= pIndexBuildStatusInfo->nNextOffset ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), &pHeaderInfo->sDecConfig );
+	flacd_DecodeBindScratch( pStaticStructure, pWorkMemInfo->pScratch );
+	flacd_DecodeRestart( pStaticStructure, (ACMW_UINT32)0U );
+
+	if ( index_scan( pStaticStructure, pIndexBuildConfigInfo, pIndexBuildStatusInfo ) == (ACMW_BOOL)0 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	FLAC__stream_decoder_flush( &(pStaticStructure->pStreamDecoder) );
+
+	/* Finished at the stream end or after the last sample */
+	if ( ( nEnd >= pIndexBuildConfigInfo->nStreamSize ) ||
+		 ( ( pHeaderInfo->nTotalSamples != (ACMW_UINT32)0U ) && ( pIndexBuildStatusInfo->nNextSample >= pHeaderInfo->nTotalSamples ) ) ) {
+		index_finish( pIndexBuildConfigInfo, pIndexBuildStatusInfo );
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	/* Rescan the bytes that may hold a header cut at the input end */
+	if ( ( nEnd - INDEX_HEADER_OVERLAP ) > pIndexBuildStatusInfo->nNextOffset ) {
+		pIndexBuildStatusInfo->nNextOffset = nEnd - INDEX_HEADER_OVERLAP;
+	} else if ( nEnd > pIndexBuildStatusInfo->nNextOffset + (ACMW_UINT32)1U ) {
+		pIndexBuildStatusInfo->nNextOffset++;
+	} else {
+		/* input too short to move on : give more from the same offset */
+	} /* end if */
+	return FLACD_RESULT_WARNING;
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		index_scan
+*
+* ARGUMENT
+* 		flacd_StaticArea*					const pStaticStructure
+*		const flacd_indexBuildConfigInfo*	const pIndexBuildConfigInfo
+*		flacd_indexBuildStatusInfo*			const pIndexBuildStatusInfo
+*
+* RETURN VALUE
+* 		ACMW_BOOL							1 : OK / 0 : index buffer full
+*
+* OVERVIEW
+* 		Read the frame headers of the input from nNextOffset and add an
+* 		entry for each frame that follows the previous one and is at
+* 		least nInterval samples after the last entry
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL index_scan( flacd_StaticArea*					const pStaticStructure,
+							 const flacd_indexBuildConfigInfo*	const pIndexBuildConfigInfo,
+							 flacd_indexBuildStatusInfo*		const pIndexBuildStatusInfo )
+{
+	flacd_ioBufferConfigInfo sBuffConfigInfo;
+	FLAC__bool got_a_header;
+	ACMW_UINT8 *pEntry;
+	ACMW_UINT32 nBase, nStart, nSample, nMaxEntries;
+
+	nBase = pIndexBuildStatusInfo->nNextOffset;
+	nMaxEntries = ( pIndexBuildConfigInfo->nIndexSize - (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) / (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE;
+
+	sBuffConfigInfo.pInBuffStart = pIndexBuildConfigInfo->pInBuffStart + ( nBase - pIndexBuildConfigInfo->nInBuffOffset );
+	sBuffConfigInfo.nInBuffSetDataSize = pIndexBuildConfigInfo->nInBuffSetDataSize - ( nBase - pIndexBuildConfigInfo->nInBuffOffset );
+	sBuffConfigInfo.pOutBuffStart = NULL;
+	sBuffConfigInfo.nOutBuffSize = (ACMW_UINT32)0U;
+	FLAC__bitreader_init( &(pStaticStructure->pBitReader), &sBuffConfigInfo );
+
+	while ( FLAC__stream_decoder_process_frame_sync( &(pStaticStructure->pStreamDecoder) ) == true ) {
+		nStart = nBase + FLACD__bitreader_get_input_bytes_consumed( &(pStaticStructure->pBitReader) ) - FLACD_SYNC_CODE_BYTE;
+		if ( nStart >= pIndexBuildConfigInfo->nStreamSize ) {
+			break;
+		} /* end if */
+		if ( FLAC__stream_decoder_process_frame_header( &(pStaticStructure->pStreamDecoder), &got_a_header ) == false ) {
+			break;
+		} /* end if */
+		/* frames beyond the 32 bit sample positions are not supported (see flacd_Decode) */
+		if ( ( got_a_header == true ) &&
+			 ( FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) ) <= (FLAC__uint64)0xFFFFFFFFU ) ) {
+			nSample = (ACMW_UINT32)FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) );
+			/* a sync pattern inside audio data or a frame seen before gives another sample number */
+			if ( nSample == pIndexBuildStatusInfo->nNextSample ) {
+				if ( ( pIndexBuildStatusInfo->nEntries == (ACMW_UINT32)0U ) ||
+					 ( ( nSample - pIndexBuildStatusInfo->nLastEntrySample ) >= pIndexBuildConfigInfo->nInterval ) ) {
+					if ( pIndexBuildStatusInfo->nEntries >= nMaxEntries ) {
+						return (ACMW_BOOL)0;
+					} /* end if */
+					pEntry = &pIndexBuildConfigInfo->pIndex[(ACMW_UINT32)FLACD_INDEX_HEADER_SIZE +
+															 ( pIndexBuildStatusInfo->nEntries * (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE )];
+					flacd_MetaWriteBE( &pEntry[0], nSample, 4 );
+					flacd_MetaWriteBE( &pEntry[4], nStart, 4 );
+					pIndexBuildStatusInfo->nEntries++;
+					pIndexBuildStatusInfo->nLastEntrySample = nSample;
+				} /* end if */
+				pIndexBuildStatusInfo->nNextSample = nSample + FLAC__stream_decoder_get_frame_blocksize( &(pStaticStructure->pStreamDecoder) );
+				pIndexBuildStatusInfo->nNextOffset = nStart + (ACMW_UINT32)1U;
+			} /* end if */
+		} /* end if */
+	} /* end while */
+	return (ACMW_BOOL)1;
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		index_finish
+*
+* ARGUMENT
+* 		const flacd_indexBuildConfigInfo*	const pIndexBuildConfigInfo
+*		flacd_indexBuildStatusInfo*			const pIndexBuildStatusInfo
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Write the index header: the source identity and the CRC-16 of
+* 		the header and the entries
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void index_finish( const flacd_indexBuildConfigInfo*		const pIndexBuildConfigInfo,
+						  flacd_indexBuildStatusInfo*			const pIndexBuildStatusInfo )
+{
+	const flacd_headerStatusInfo* const pHeaderInfo = pIndexBuildConfigInfo->pHeaderInfo;
+	ACMW_UINT8* const pIndex = pIndexBuildConfigInfo->pIndex;
+	ACMW_UINT32 nEntrySize, nCrc, i;
+
+	nEntrySize = pIndexBuildStatusInfo->nEntries * (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE;
+	flacd_MemSet( pIndex, 0, (ACMW_INT32)FLACD_INDEX_HEADER_SIZE );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_MAGIC], FLACD_INDEX_MAGIC, 4 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_VERSION], FLACD_INDEX_VERSION, 2 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_HEADER_SIZE], (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE, 2 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_ENTRIES], pIndexBuildStatusInfo->nEntries, 4 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_INTERVAL], pIndexBuildConfigInfo->nInterval, 4 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_TOTAL_SAMPLES], pHeaderInfo->nTotalSamples, 4 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_STREAM_SIZE], pIndexBuildConfigInfo->nStreamSize, 4 );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_AUDIO_OFFSET], pHeaderInfo->nAudioOffset, 4 );
+	for ( i = 0; i < (ACMW_UINT32)sizeof(pHeaderInfo->nMD5Signature); i++ ) {
+		pIndex[FLACD_INDEX_POS_MD5 + i] = pHeaderInfo->nMD5Signature[i];
+	} /* end for */
+	nCrc = flacd_MetaCrc16( pIndex, FLACD_INDEX_POS_CRC, (ACMW_UINT32)0U );
+	nCrc = flacd_MetaCrc16( &pIndex[FLACD_INDEX_HEADER_SIZE], nEntrySize, nCrc );
+	flacd_MetaWriteBE( &pIndex[FLACD_INDEX_POS_CRC], nCrc, 2 );
+
+	pIndexBuildStatusInfo->nIndexUsedSize = (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE + nEntrySize;
+	pIndexBuildStatusInfo->nBuildState = FLACD_INDEX_STATE_DONE;
+}
+/*------------------------------------------------------------------------------*/
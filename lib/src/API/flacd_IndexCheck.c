@@ -0,0 +1,108 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_IndexCheck.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_IndexCheck
+
+ [Description]
+   Check that a frame index belongs to a stream.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_IndexCheck(
+           UINT8 *pIndex,
+           UINT32 nIndexSize,
+           flacd_headerStatusInfo *pHeaderInfo,
+           UINT32 nStreamSize,
+           BOOL bVerifyChecksum)
+
+ [Argument]
+   const UINT8 *                   pIndex
+           Pointer to Frame Index
+   const UINT32                    nIndexSize
+           Size of Frame Index
+   const flacd_headerStatusInfo *  pHeaderInfo
+           Pointer to Header Status Information Structure of the stream
+   const UINT32                    nStreamSize
+           Size of the stream
+   const BOOL                      bVerifyChecksum
+           1 : check the CRC-16 of the whole index also
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal (index usable)
+           FLACD_RESULT_NG      : Index of another stream, another
+                                  version or corrupted
+           FLACD_RESULT_FATAL   : Error (argument)
+
+ [Note]
+   Can be called at any time; no work memory is used. The header of the
+   index is compared with the size, the audio offset, the total samples
+   and the MD5 signature of the stream. Without bVerifyChecksum only the
+   header is read, so a mapped index is not paged in as a whole.
+==========================================================================*/
+ACMW_INT32	flacd_IndexCheck( const ACMW_UINT8*				const pIndex,
+							  const ACMW_UINT32				nIndexSize,
+							  const flacd_headerStatusInfo*	const pHeaderInfo,
+							  const ACMW_UINT32				nStreamSize,
+							  const ACMW_BOOL				bVerifyChecksum )
+{
+	ACMW_UINT32 nEntries, nCrc, i;
+
+	/* Argument Check */
+	if ((pIndex == NULL) || (pHeaderInfo == NULL)) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	/* Format */
+	if ( ( nIndexSize < (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_MAGIC], 4 ) != FLACD_INDEX_MAGIC ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_VERSION], 2 ) != FLACD_INDEX_VERSION ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_HEADER_SIZE], 2 ) != (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nEntries = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_ENTRIES], 4 );
+	if ( nEntries > ( ( nIndexSize - (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) / (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE ) ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Source stream */
+	if ( ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_TOTAL_SAMPLES], 4 ) != pHeaderInfo->nTotalSamples ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_STREAM_SIZE], 4 ) != nStreamSize ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_AUDIO_OFFSET], 4 ) != pHeaderInfo->nAudioOffset ) ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+	for ( i = 0; i < (ACMW_UINT32)sizeof(pHeaderInfo->nMD5Signature); i++ ) {
+		if ( pIndex[FLACD_INDEX_POS_MD5 + i] != pHeaderInfo->nMD5Signature[i] ) {
+			return FLACD_RESULT_NG;
+		} /* end if */
+	} /* end for */
+
+	/* Checksum */
+	if ( bVerifyChecksum == (ACMW_BOOL)1 ) {
+		nCrc = flacd_MetaCrc16( pIndex, FLACD_INDEX_POS_CRC, (ACMW_UINT32)0U );
+		nCrc = flacd_MetaCrc16( &pIndex[FLACD_INDEX_HEADER_SIZE], nEntries * (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE, nCrc );
+		if ( nCrc != flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_CRC], 2 ) ) {
+			return FLACD_RESULT_NG;
+		} /* end if */
+	} /* end if */
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
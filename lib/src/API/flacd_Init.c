@@ -14,6 +14,8 @@
 #include "FLAC/stream_decoder.h"
 #include "flacd_Lib.h"
 #include "flacd_api.h"
+#include "flacd_output.h"
+#include "flacd_memory.h"
 
 /*==========================================================================
  [Function Name]
@@ -41,13 +43,16 @@
 
 
  [Note]
-   None
+   The scratch memory is laid out for nMaxBlockSize samples of
+   nDecodeChannels channels. Each 0 selects the worst case. pScratch is
+   not used here and may be NULL; it is given to each flacd_Decode call.
 ==========================================================================*/
 ACMW_INT32	flacd_Init( const flacd_workMemoryInfo* const pWorkMemInfo,
 						const flacd_initConfigInfo* const pInitConfigInfo )
 {
 	flacd_StaticArea *pStaticStructure;
 	FLAC__StreamDecoder *decoder;
+	ACMW_UINT32 nMaxBlockSize, nDecodeChannels;
 	
 	/* Argument Check */
 	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
@@ -67,11 +72,6 @@ ACMW_INT32	flacd_Init( const flacd_workMemoryInfo* const pWorkMemInfo,
 	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
 	pStaticStructure->nEnableErrorFactor = FLACD_ERROR_FACTOR_ENABLE;
 
-	if ((pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
-		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
-		return FLACD_RESULT_NG;
-	} /* end if */
-	
 	if (pInitConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
 		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
 		return FLACD_RESULT_NG;
@@ -86,6 +86,19 @@ ACMW_INT32	flacd_Init( const flacd_workMemoryInfo* const pWorkMemInfo,
 			pStaticStructure->nInputChannel = (ACMW_UINT16)FLACD_6CHIN;
 			break;
 	} /* end switch */
+	if ( pInitConfigInfo->nChannels > pStaticStructure->nInputChannel ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} else if ( pInitConfigInfo->nChannels != 0x0000u ) {
+		pStaticStructure->nInputChannel = pInitConfigInfo->nChannels;
+	} else {
+		/* worst case of nInputChannel */
+	} /* end if */
+	nMaxBlockSize = ( pInitConfigInfo->nMaxBlockSize == 0x0000u ) ? FLAC__SPEC_MAX_BLOCK_SIZE : (ACMW_UINT32)pInitConfigInfo->nMaxBlockSize;
+	if ( nMaxBlockSize > FLAC__SPEC_MAX_BLOCK_SIZE ) {	/* RCG3AFLDL4001ZDO P-00016 */
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
 	switch ((ACMW_INT32)pInitConfigInfo->nOutputChannel) {
 		case FLACD_INITCFG_2CHOUT :
 			pStaticStructure->nOutputChannel = (ACMW_UINT16)FLACD_2CHOUT;
@@ -101,14 +114,58 @@ ACMW_INT32	flacd_Init( const flacd_workMemoryInfo* const pWorkMemInfo,
 			return FLACD_RESULT_NG;
 	} /* end switch */
 	pStaticStructure->nOutBitsPerSample = pInitConfigInfo->nOutBitsPerSample;
+	switch ((ACMW_INT32)pInitConfigInfo->nOutSampleFormat) {
+		case FLACD_INITCFG_OUTFMT_PCM :
+			pStaticStructure->nOutFormat = ( pInitConfigInfo->nOutBitsPerSample == 0x0000u ) ? FLACD_OUTFMT_PCM16 : FLACD_OUTFMT_PCM24;
+			break;
+		case FLACD_INITCFG_OUTFMT_FLOAT32 :
+			pStaticStructure->nOutFormat = FLACD_OUTFMT_FLOAT32;
+			break;
+		default :
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+	} /* end switch */
+	switch ((ACMW_INT32)pInitConfigInfo->nOutLayout) {
+		case FLACD_INITCFG_PLANAR :
+		case FLACD_INITCFG_INTERLEAVED :
+			pStaticStructure->nOutLayout = pInitConfigInfo->nOutLayout;
+			break;
+		default :
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+	} /* end switch */
+	switch ((ACMW_INT32)pInitConfigInfo->nOutGainMode) {
+		case FLACD_INITCFG_GAIN_UNITY :
+			pStaticStructure->fOutGain = (ACMW_FLOAT32)1.0f;
+			break;
+		case FLACD_INITCFG_GAIN_LINEAR :
+			/* NaN and negative gain are rejected, 0 mutes */
+			if ( ( pInitConfigInfo->fOutGain != pInitConfigInfo->fOutGain ) || ( pInitConfigInfo->fOutGain < (ACMW_FLOAT32)0.0f ) ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			pStaticStructure->fOutGain = pInitConfigInfo->fOutGain;
+			break;
+		default :
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+	} /* end switch */
+
+	if ( ( pInitConfigInfo->nDecodeChannels > pStaticStructure->nInputChannel ) ||
+		 ( pInitConfigInfo->nDecodeChannels == (ACMW_UINT16)1U ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nDecodeChannels = ( pInitConfigInfo->nDecodeChannels == 0x0000u ) ? (ACMW_UINT32)pStaticStructure->nInputChannel : (ACMW_UINT32)pInitConfigInfo->nDecodeChannels;
 
-	/* Fill Scratch Work Memory */
-	flacd_MemSet(pWorkMemInfo->pScratch, 0, (ACMW_INT32)(sizeof(flacd_ScratchArea)*(ACMW_UINT32)pStaticStructure->nInputChannel));
+	/* Lay out Scratch Work Memory (one sample array per decoded channel) */
+	flacd_SetScratchLayout( &(pStaticStructure->sScratchLayout), nMaxBlockSize, nDecodeChannels );
 	
 	/* Initialize */
 	decoder = FLAC__stream_decoder_new( pWorkMemInfo );
 	FLAC__stream_decoder_init_stream( decoder );
 	FLAC__stream_decoder_set_supported_channels( decoder, pStaticStructure->nInputChannel, pStaticStructure->nOutputChannel );
+	FLAC__stream_decoder_set_supported_blocksize( decoder, nMaxBlockSize );
 	
 	return FLACD_RESULT_OK;
 }
@@ -0,0 +1,103 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_OpenSession.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_OpenSession
+
+ [Description]
+   Bind the stream configuration and the output ring buffer to a decoder
+   instance for flacd_DecodeSpan. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_OpenSession(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_decConfigInfo *pDecConfigInfo,
+           flacd_outputRingInfo *pOutRing)
+
+ [Argument]
+   const flacd_workMemoryInfo *       pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_decConfigInfo *        pDecConfigInfo
+           Pointer to Decoder Configuration Information Structure
+   const flacd_outputRingInfo *       pOutRing
+           Pointer to Output Ring Buffer Information Structure
+           (NULL : linear output buffer)
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. The configuration is checked here once.
+   pOutRing is referenced, not copied; the caller updates its write
+   position and free space between calls as for flacd_Decode.
+   Calling again rebinds the session; flacd_Init closes it.
+==========================================================================*/
+ACMW_INT32	flacd_OpenSession( const flacd_workMemoryInfo*	const pWorkMemInfo,
+							   const flacd_decConfigInfo*	const pDecConfigInfo,
+							   const flacd_outputRingInfo*	const pOutRing )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pDecConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	if ( flacd_DecodeCheckRing( pStaticStructure, pOutRing ) == (ACMW_BOOL)0 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, pDecConfigInfo );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		pStaticStructure->bSessionOpen = (ACMW_BOOL)0;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Set Config Value */
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pDecConfigInfo );
+	pStaticStructure->pSessionRing = pOutRing;
+	pStaticStructure->bSessionOpen = (ACMW_BOOL)1;
+
+	return FLACD_RESULT_OK;
+}
@@ -0,0 +1,144 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_ParseHeader.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_ParseHeader
+
+ [Description]
+   Parse the "fLaC" marker and the metadata blocks of a stream.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_ParseHeader(
+           flacd_headerConfigInfo *pHeaderConfigInfo,
+           flacd_headerStatusInfo *pHeaderStatusInfo)
+
+ [Argument]
+   const flacd_headerConfigInfo *  pHeaderConfigInfo
+           Pointer to Header Parse Configuration Information Structure
+   flacd_headerStatusInfo *        pHeaderStatusInfo
+           Pointer to Header Parse Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal (nAudioOffset is set)
+           FLACD_RESULT_NG      : Not a FLAC stream, broken metadata or
+                                  2^32 samples or more (not supported)
+           FLACD_RESULT_WARNING : More input needed
+                                  (nNeedSize bytes from nNextOffset)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   No work memory is needed. The input must start at or before
+   nNextOffset. Only the block headers and STREAMINFO are read; the other
+   blocks (PADDING, PICTURE, ...) are skipped by their length, so they
+   need not be in the input. A leading ID3v2 tag is skipped.
+==========================================================================*/
+ACMW_INT32	flacd_ParseHeader( const flacd_headerConfigInfo*	const pHeaderConfigInfo,
+							   flacd_headerStatusInfo*			const pHeaderStatusInfo )
+{
+	const ACMW_UINT8 *pData;
+	ACMW_UINT32 nPos, nEnd, nAvail, nNeed;
+	ACMW_UINT32 nType, nLength;
+
+	/* Argument Check */
+	if ((pHeaderConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pHeaderStatusInfo == NULL) ||
+		(pHeaderConfigInfo->pInBuffStart == NULL)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	nPos = pHeaderStatusInfo->nNextOffset;
+	if ( ( pHeaderStatusInfo->nParseState > FLACD_META_STATE_DONE ) || ( nPos < pHeaderConfigInfo->nInBuffOffset ) ) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+	nEnd = pHeaderConfigInfo->nInBuffOffset + pHeaderConfigInfo->nInBuffSetDataSize;
+	pHeaderStatusInfo->nNeedSize = (ACMW_UINT32)0U;
+	nNeed = (ACMW_UINT32)0U;
+
+	while ( pHeaderStatusInfo->nParseState != FLACD_META_STATE_DONE ) {
+		nAvail = ( nEnd > nPos ) ? ( nEnd - nPos ) : (ACMW_UINT32)0U;
+		pData = ( nAvail != (ACMW_UINT32)0U ) ? &pHeaderConfigInfo->pInBuffStart[nPos - pHeaderConfigInfo->nInBuffOffset] : NULL;
+
+		if ( pHeaderStatusInfo->nParseState == FLACD_META_STATE_MARKER ) {
+			nNeed = FLACD_META_ID3_HEADER_SIZE;
+			if ( nAvail < nNeed ) {
+				break;
+			} /* end if */
+			if ( ( pData[0] == (ACMW_UINT8)'f' ) && ( pData[1] == (ACMW_UINT8)'L' ) &&
+				 ( pData[2] == (ACMW_UINT8)'a' ) && ( pData[3] == (ACMW_UINT8)'C' ) ) {
+				nPos += FLACD_META_MARKER_SIZE;
+				pHeaderStatusInfo->nParseState = FLACD_META_STATE_STREAMINFO;
+			} else if ( ( pData[0] == (ACMW_UINT8)'I' ) && ( pData[1] == (ACMW_UINT8)'D' ) && ( pData[2] == (ACMW_UINT8)'3' ) ) {
+				/* ID3v2 : size is 4 x 7 bits, the footer flag adds a copy of the header */
+				nLength = ( ( (ACMW_UINT32)pData[6] & 0x7FU ) << 21 ) | ( ( (ACMW_UINT32)pData[7] & 0x7FU ) << 14 ) |
+						  ( ( (ACMW_UINT32)pData[8] & 0x7FU ) << 7 ) | ( (ACMW_UINT32)pData[9] & 0x7FU );
+				if ( ( pData[5] & (ACMW_UINT8)0x10U ) != (ACMW_UINT8)0U ) {
+					nLength += FLACD_META_ID3_HEADER_SIZE;
+				} /* end if */
+				nPos += FLACD_META_ID3_HEADER_SIZE + nLength;
+			} else {
+				return FLACD_RESULT_NG;
+			} /* end if */
+		} else {
+			nNeed = FLACD_META_BLOCK_HEADER_SIZE;
+			if ( nAvail < nNeed ) {
+				break;
+			} /* end if */
+			nType = (ACMW_UINT32)pData[0] & (ACMW_UINT32)0x7FU;
+			nLength = flacd_MetaReadBE( &pData[1], 3 );
+			if ( pHeaderStatusInfo->nParseState == FLACD_META_STATE_STREAMINFO ) {
+				/* STREAMINFO must be the first block */
+				if ( ( nType != FLACD_META_TYPE_STREAMINFO ) || ( nLength != FLACD_META_STREAMINFO_SIZE ) ) {
+					return FLACD_RESULT_NG;
+				} /* end if */
+				nNeed = FLACD_META_BLOCK_HEADER_SIZE + FLACD_META_STREAMINFO_SIZE;
+				if ( nAvail < nNeed ) {
+					break;
+				} /* end if */
+				if ( flacd_MetaParseStreamInfo( &pData[FLACD_META_BLOCK_HEADER_SIZE], pHeaderStatusInfo ) == (ACMW_BOOL)0 ) {
+					return FLACD_RESULT_NG;
+				} /* end if */
+				pHeaderStatusInfo->nParseState = FLACD_META_STATE_BLOCK;
+			} else if ( ( nType == FLACD_META_TYPE_STREAMINFO ) || ( nType == FLACD_META_TYPE_INVALID ) ) {
+				return FLACD_RESULT_NG;
+			} else if ( nType == FLACD_META_TYPE_SEEKTABLE ) {
+				pHeaderStatusInfo->nSeekTableOffset = nPos + FLACD_META_BLOCK_HEADER_SIZE;
+				pHeaderStatusInfo->nSeekPoints = nLength / FLACD_META_SEEKPOINT_SIZE;
+			} else {
+				/* PADDING, APPLICATION, VORBIS_COMMENT, CUESHEET, PICTURE : skipped */
+			} /* end if */
+			nPos += FLACD_META_BLOCK_HEADER_SIZE + nLength;
+			if ( ( pData[0] & (ACMW_UINT8)0x80U ) != (ACMW_UINT8)0U ) {
+				/* last metadata block */
+				pHeaderStatusInfo->nAudioOffset = nPos;
+				pHeaderStatusInfo->nParseState = FLACD_META_STATE_DONE;
+			} /* end if */
+		} /* end if */
+		pHeaderStatusInfo->nNextOffset = nPos;
+	} /* end while */
+
+	if ( pHeaderStatusInfo->nParseState != FLACD_META_STATE_DONE ) {
+		pHeaderStatusInfo->nNextOffset = nPos;
+		pHeaderStatusInfo->nNeedSize = nNeed;
+		return FLACD_RESULT_WARNING;
+	} /* end if */
+
+	return FLACD_RESULT_OK;
+}
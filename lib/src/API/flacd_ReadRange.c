@@ -0,0 +1,189 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_ReadRange.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_ReadRange
+
+ [Description]
+   Decode the samples [nStartSample, nEndSample) of the stream through a
+   frame index. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_ReadRange(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_rangeConfigInfo *pRangeConfigInfo,
+           flacd_rangeStatusInfo *pRangeStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_rangeConfigInfo *   pRangeConfigInfo
+           Pointer to Range Read Configuration Information Structure
+   flacd_rangeStatusInfo *         pRangeStatusInfo
+           Pointer to Range Read Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : Warning Error (mute data output for
+                                  frames with a CRC error)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. Check the index once with flacd_IndexCheck
+   before; here only its format is checked. Only the frames from the
+   index entry at or before nStartSample to the end of the range are
+   decoded, and with a frame cache (flacd_SetFrameCache) the frames read
+   before are taken from it. The samples outside the range are not
+   output. The decoder restarts as for flacd_Seek, and the samples of
+   the last frame after the range are dropped.
+==========================================================================*/
+ACMW_INT32	flacd_ReadRange( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							 const flacd_rangeConfigInfo*		const pRangeConfigInfo,
+							 flacd_rangeStatusInfo*				const pRangeStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	const ACMW_UINT8 *pIndex;
+	ACMW_INT32 nResult;
+	ACMW_UINT32 nEntries, nSample, nOffset, nEndOffset, nSamples, nFrameSize, nSkip, nInUsed, nDone;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pRangeConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pRangeStatusInfo == NULL) ||
+		(pRangeConfigInfo->pIndex == NULL) ||
+		(pRangeConfigInfo->pDecConfigInfo == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Fill Status Info */
+	flacd_MemSet(pRangeStatusInfo, 0, sizeof(flacd_rangeStatusInfo));
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Index Format */
+	pIndex = pRangeConfigInfo->pIndex;
+	if ( ( pRangeConfigInfo->nIndexSize < (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_MAGIC], 4 ) != FLACD_INDEX_MAGIC ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_VERSION], 2 ) != FLACD_INDEX_VERSION ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nEntries = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_ENTRIES], 4 );
+	if ( nEntries > ( ( pRangeConfigInfo->nIndexSize - (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) / (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Range Value */
+	nSample = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_TOTAL_SAMPLES], 4 );
+	if ( ( pRangeConfigInfo->nStartSample >= pRangeConfigInfo->nEndSample ) ||
+		 ( ( nSample != (ACMW_UINT32)0U ) && ( pRangeConfigInfo->nEndSample > nSample ) ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check DecConfig Value */
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, pRangeConfigInfo->pDecConfigInfo );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Covering frames : from the nearest frame at or before the start to the first frame at or after the end */
+	if ( flacd_MetaFindIndexEntry( &pIndex[FLACD_INDEX_HEADER_SIZE], nEntries,
+								   pRangeConfigInfo->nStartSample, &nSample, &nOffset ) == (ACMW_BOOL)0 ) {
+		nOffset = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_AUDIO_OFFSET], 4 );
+	} /* end if */
+	if ( flacd_MetaFindIndexEnd( &pIndex[FLACD_INDEX_HEADER_SIZE], nEntries,
+								 pRangeConfigInfo->nEndSample, &nEndOffset ) == (ACMW_BOOL)0 ) {
+		nEndOffset = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_STREAM_SIZE], 4 );
+	} /* end if */
+	if ( nEndOffset < nOffset ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	pRangeStatusInfo->nNeedOffset = nOffset;
+	pRangeStatusInfo->nNeedSize = nEndOffset - nOffset;
+
+	/* No input : tell the bytes needed only */
+	if ( pRangeConfigInfo->pInBuffStart == NULL ) {
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if ( pRangeConfigInfo->pOutBuffStart == NULL ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	if ( flacd_DecodeCheckOutput( pStaticStructure, pRangeConfigInfo->pOutBuffStart ) == (ACMW_BOOL)0 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* The input must start at or before the first covering frame, the output hold the range */
+	nSamples = pRangeConfigInfo->nEndSample - pRangeConfigInfo->nStartSample;
+	nFrameSize = flacd_DecodeFrameSize( pStaticStructure );
+	if ( ( pRangeConfigInfo->nInBuffOffset > nOffset ) ||
+		 ( ( nOffset - pRangeConfigInfo->nInBuffOffset ) >= pRangeConfigInfo->nInBuffSetDataSize ) ||
+		 ( ( pRangeConfigInfo->nOutBuffSize / nFrameSize ) < nSamples ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nSkip = nOffset - pRangeConfigInfo->nInBuffOffset;
+
+	/* Set Config Value */
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pRangeConfigInfo->pDecConfigInfo );
+	flacd_DecodeRestart( pStaticStructure, pRangeConfigInfo->nStartSample );
+
+	nResult = flacd_DecodeRun( pStaticStructure, pWorkMemInfo->pScratch, pRangeConfigInfo->pInBuffStart + nSkip,
+							   pRangeConfigInfo->nInBuffSetDataSize - nSkip, pRangeConfigInfo->pOutBuffStart, nSamples, &nInUsed, &nDone );
+	if ( ( nResult != FLACD_RESULT_NG ) && ( nDone < nSamples ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SHORT_INPUT_DATA;
+		nResult = FLACD_RESULT_NG;
+	} /* end if */
+	/* the rest of the last frame is after the range */
+	pStaticStructure->sPending.nRemainSamples = (ACMW_UINT32)0U;
+
+	/* Set Status Info */
+	pRangeStatusInfo->nDecodedSamples = nDone;
+	pRangeStatusInfo->nOutBuffUsedDataSize = nDone * nFrameSize;
+
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
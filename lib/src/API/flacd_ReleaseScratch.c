@@ -0,0 +1,88 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_ReleaseScratch.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_ReleaseScratch
+
+ [Description]
+   Return the scratch block lent by flacd_AcquireScratch to the pool.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_ReleaseScratch(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_scratchPoolInfo *pScratchPoolInfo)
+
+ [Argument]
+   flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+           (pScratch is set to NULL)
+   flacd_scratchPoolInfo *       pScratchPoolInfo
+           Pointer to Scratch Pool Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : The block stays pinned (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Remaining samples of a frame are moved to the carry buffer of the
+   instance (see flacd_SetScratchCarry) and the block is freed. When
+   they do not fit, the block stays pinned to the instance until the
+   release after they are output (FLACD_ERR_SCRATCH_PINNED).
+==========================================================================*/
+ACMW_INT32	flacd_ReleaseScratch( flacd_workMemoryInfo*		const pWorkMemInfo,
+								  flacd_scratchPoolInfo*	const pScratchPoolInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	ACMW_UINT32	i;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pScratchPoolInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pScratchPoolInfo->pOwner == NULL)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pWorkMemInfo->pScratch = NULL;
+	if ( flacd_DecodeCarryPending( pStaticStructure ) == (ACMW_BOOL)0 ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SCRATCH_PINNED;
+		return FLACD_RESULT_WARNING;
+	} /* end if */
+
+	for ( i = 0; i < pScratchPoolInfo->nBlocks; i++ ) {
+		if ( pScratchPoolInfo->pOwner[i] == pWorkMemInfo->pStatic ) {
+			pScratchPoolInfo->pOwner[i] = NULL;
+		} /* end if */
+	} /* end for */
+
+	return FLACD_RESULT_OK;
+}
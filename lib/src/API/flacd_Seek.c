@@ -0,0 +1,106 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_Seek.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_Seek
+
+ [Description]
+   Seek to a sample of the stream through the SEEKTABLE.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_Seek(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_seekConfigInfo *pSeekConfigInfo,
+           flacd_seekStatusInfo *pSeekStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_seekConfigInfo *    pSeekConfigInfo
+           Pointer to Seek Configuration Information Structure
+   flacd_seekStatusInfo *          pSeekStatusInfo
+           Pointer to Seek Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. The samples of the current frame not output
+   yet are dropped. Give flacd_Decode input from nInBuffOffset; the
+   frames and samples before nTargetSample are decoded but not output,
+   so the first sample output is nTargetSample (nSamplePosition).
+==========================================================================*/
+ACMW_INT32	flacd_Seek( const flacd_workMemoryInfo*		const pWorkMemInfo,
+						const flacd_seekConfigInfo*		const pSeekConfigInfo,
+						flacd_seekStatusInfo*			const pSeekStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32 nSample, nOffset;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pSeekConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pSeekStatusInfo == NULL) ||
+		((pSeekConfigInfo->pSeekTable == NULL) && (pSeekConfigInfo->nSeekPoints != (ACMW_UINT32)0U))) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Nearest seek point at or before the target */
+	nSample = (ACMW_UINT32)0U;
+	nOffset = (ACMW_UINT32)0U;
+	if ( flacd_MetaFindSeekPoint( pSeekConfigInfo->pSeekTable, pSeekConfigInfo->nSeekPoints,
+								  pSeekConfigInfo->nTargetSample, &nSample, &nOffset ) == (ACMW_BOOL)0 ) {
+		nSample = (ACMW_UINT32)0U;
+		nOffset = (ACMW_UINT32)0U;
+	} /* end if */
+	pSeekStatusInfo->nInBuffOffset = pSeekConfigInfo->nAudioOffset + nOffset;
+	pSeekStatusInfo->nSeekSample = nSample;
+
+	pSeekStatusInfo->nNeedSize = (ACMW_UINT32)0U;
+
+	/* Restart from the next frame sync */
+	flacd_DecodeRestart( pStaticStructure, pSeekConfigInfo->nTargetSample );
+
+	return FLACD_RESULT_OK;
+}
@@ -0,0 +1,334 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SeekBisect.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+#define BISECT_PROBE_SIZE			((ACMW_UINT32)4096U)		/* bytes read by one probe */
+#define BISECT_HEADER_SIZE			((ACMW_UINT32)16U)			/* largest frame header */
+#define BISECT_UNKNOWN_SAMPLE		((ACMW_UINT32)0xFFFFFFFFU)
+
+static void bisect_start( flacd_BisectState* const pBisect, const flacd_headerStatusInfo* const pHeaderInfo,
+						  const ACMW_UINT32 nStreamSize, const ACMW_UINT32 nTargetSample );
+static ACMW_BOOL bisect_scan( flacd_StaticArea* const pStaticStructure, const flacd_bisectConfigInfo* const pBisectConfigInfo,
+							  flacd_SeekProbe* const pFound );
+static void bisect_cache( flacd_BisectState* const pBisect, const flacd_SeekProbe* const pProbe );
+
+/*==========================================================================
+ [Function Name]
+   flacd_SeekBisect
+
+ [Description]
+   Seek to a sample of a stream without SEEKTABLE by bisection.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SeekBisect(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_bisectConfigInfo *pBisectConfigInfo,
+           flacd_seekStatusInfo *pSeekStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_bisectConfigInfo *  pBisectConfigInfo
+           Pointer to Bisection Seek Configuration Information Structure
+   flacd_seekStatusInfo *          pSeekStatusInfo
+           Pointer to Seek Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal (seek finished)
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_WARNING : More input needed
+                                  (nNeedSize bytes from nInBuffOffset)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, then again with the requested bytes until the
+   result is not FLACD_RESULT_WARNING. Each probe interpolates a stream
+   offset from the samples and offsets of the frames around the target,
+   finds the next frame header there and reads its sample number.
+   The frames found are kept in the static memory, so a later seek in
+   the same stream starts from the closest of them. The scratch memory
+   is used during the call. On FLACD_RESULT_OK the decoder restarts as
+   for flacd_Seek.
+==========================================================================*/
+ACMW_INT32	flacd_SeekBisect( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							  const flacd_bisectConfigInfo*		const pBisectConfigInfo,
+							  flacd_seekStatusInfo*				const pSeekStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	flacd_BisectState *pBisect;
+	const flacd_headerStatusInfo *pHeaderInfo;
+	FLAC__StreamDecoderState get_state;
+	flacd_SeekProbe sFound;
+	ACMW_UINT32 nTarget, nAim, nProbe, nSpan;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pBisectConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pSeekStatusInfo == NULL) ||
+		(pBisectConfigInfo->pHeaderInfo == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	pHeaderInfo = pBisectConfigInfo->pHeaderInfo;
+	nTarget = pBisectConfigInfo->nTargetSample;
+	if ( ( pHeaderInfo->nParseState != FLACD_META_STATE_DONE ) ||
+		 ( pBisectConfigInfo->nStreamSize <= pHeaderInfo->nAudioOffset ) ||
+		 ( ( pHeaderInfo->nTotalSamples != (ACMW_UINT32)0U ) && ( nTarget >= pHeaderInfo->nTotalSamples ) ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, &pHeaderInfo->sDecConfig );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), &pHeaderInfo->sDecConfig );
+	flacd_DecodeBindScratch( pStaticStructure, pWorkMemInfo->pScratch );
+
+	pBisect = &pStaticStructure->sBisect;
+	if ( ( pBisectConfigInfo->pInBuffStart == NULL ) || ( pBisect->bActive != (ACMW_BOOL)1 ) || ( pBisect->nTarget != nTarget ) ) {
+		/* New seek : bracket the target with the stream ends and the frames found before */
+		flacd_DecodeRestart( pStaticStructure, nTarget );
+		bisect_start( pBisect, pHeaderInfo, pBisectConfigInfo->nStreamSize, nTarget );
+	} else if ( bisect_scan( pStaticStructure, pBisectConfigInfo, &sFound ) == (ACMW_BOOL)1 ) {
+		bisect_cache( pBisect, &sFound );
+		if ( sFound.nSample <= nTarget ) {
+			pBisect->sLow = sFound;
+		} else {
+			pBisect->sHigh = sFound;
+		} /* end if */
+	} else if ( ( pBisectConfigInfo->nInBuffSetDataSize > BISECT_HEADER_SIZE ) &&
+				( ( pBisect->nScanOffset + pBisectConfigInfo->nInBuffSetDataSize ) < pBisect->sHigh.nOffset ) ) {
+		/* No frame yet : scan the following bytes, twice as many up to the largest frame */
+		pBisect->nScanOffset += pBisectConfigInfo->nInBuffSetDataSize - BISECT_HEADER_SIZE;
+		if ( pBisect->nScanSize < pHeaderInfo->sDecConfig.nMaxFrameSize ) {
+			pBisect->nScanSize <<= 1;
+		} /* end if */
+		pSeekStatusInfo->nInBuffOffset = pBisect->nScanOffset;
+		pSeekStatusInfo->nSeekSample = (ACMW_UINT32)0U;
+		pSeekStatusInfo->nNeedSize = pBisect->nScanSize;
+		return FLACD_RESULT_WARNING;
+	} else {
+		/* No frame from nScanStart up to sHigh */
+		pBisect->sHigh.nOffset = pBisect->nScanStart;
+	} /* end if */
+
+	/* Finished when the target is in the frame at sLow or the next one */
+	nSpan = pBisect->sHigh.nOffset - pBisect->sLow.nOffset;
+	if ( ( ( nTarget - pBisect->sLow.nSample ) < (ACMW_UINT32)pHeaderInfo->sDecConfig.nMaxBlockSize ) || ( nSpan <= (ACMW_UINT32)1U ) ) {
+		pBisect->bActive = (ACMW_BOOL)0;
+		flacd_DecodeRestart( pStaticStructure, nTarget );
+		pSeekStatusInfo->nInBuffOffset = pBisect->sLow.nOffset;
+		pSeekStatusInfo->nSeekSample = pBisect->sLow.nSample;
+		pSeekStatusInfo->nNeedSize = (ACMW_UINT32)0U;
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	/* Next probe : interpolate the offset of half a block before the target */
+	if ( pBisect->sHigh.nSample == BISECT_UNKNOWN_SAMPLE ) {
+		nProbe = pBisect->sLow.nOffset + ( nSpan >> 1 );
+	} else {
+		nAim = nTarget - ( (ACMW_UINT32)pHeaderInfo->sDecConfig.nMaxBlockSize >> 1 );
+		nProbe = pBisect->sLow.nOffset + (ACMW_UINT32)( ( (FLAC__uint64)( nAim - pBisect->sLow.nSample ) * (FLAC__uint64)nSpan ) /
+														(FLAC__uint64)( pBisect->sHigh.nSample - pBisect->sLow.nSample ) );
+	} /* end if */
+	if ( nProbe <= pBisect->sLow.nOffset ) {
+		nProbe = pBisect->sLow.nOffset + (ACMW_UINT32)1U;
+	} /* end if */
+	if ( nProbe >= pBisect->sHigh.nOffset ) {
+		nProbe = pBisect->sHigh.nOffset - (ACMW_UINT32)1U;
+	} /* end if */
+	pBisect->nScanStart = nProbe;
+	pBisect->nScanOffset = nProbe;
+	pBisect->nScanSize = BISECT_PROBE_SIZE;
+
+	pSeekStatusInfo->nInBuffOffset = nProbe;
+	pSeekStatusInfo->nSeekSample = (ACMW_UINT32)0U;
+	pSeekStatusInfo->nNeedSize = BISECT_PROBE_SIZE;
+	return FLACD_RESULT_WARNING;
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bisect_start
+*
+* ARGUMENT
+* 		flacd_BisectState*				const pBisect
+*		const flacd_headerStatusInfo*	const pHeaderInfo
+*		const ACMW_UINT32				nStreamSize
+*		const ACMW_UINT32				nTargetSample
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Bracket the target with the first frame and the stream end,
+* 		narrowed by the frames found by earlier probes
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void bisect_start( flacd_BisectState*			const pBisect,
+						  const flacd_headerStatusInfo*	const pHeaderInfo,
+						  const ACMW_UINT32				nStreamSize,
+						  const ACMW_UINT32				nTargetSample )
+{
+	ACMW_UINT32 i;
+
+	pBisect->bActive = (ACMW_BOOL)1;
+	pBisect->nTarget = nTargetSample;
+	pBisect->sLow.nOffset = pHeaderInfo->nAudioOffset;
+	pBisect->sLow.nSample = (ACMW_UINT32)0U;
+	pBisect->sHigh.nOffset = nStreamSize;
+	pBisect->sHigh.nSample = ( pHeaderInfo->nTotalSamples != (ACMW_UINT32)0U ) ? pHeaderInfo->nTotalSamples : BISECT_UNKNOWN_SAMPLE;
+
+	for ( i = 0; i < pBisect->nCacheCount; i++ ) {
+		const flacd_SeekProbe* const pProbe = &pBisect->sCache[i];
+		if ( ( pProbe->nSample <= nTargetSample ) && ( pProbe->nOffset > pBisect->sLow.nOffset ) ) {
+			pBisect->sLow = *pProbe;
+		} else if ( ( pProbe->nSample > nTargetSample ) && ( pProbe->nOffset < pBisect->sHigh.nOffset ) ) {
+			pBisect->sHigh = *pProbe;
+		} else {
+			/* outside the bracket */
+		} /* end if */
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bisect_scan
+*
+* ARGUMENT
+* 		flacd_StaticArea*				const pStaticStructure
+*		const flacd_bisectConfigInfo*	const pBisectConfigInfo
+*		flacd_SeekProbe*				const pFound
+*
+* RETURN VALUE
+* 		ACMW_BOOL						1 : frame found / 0 : not found
+*
+* OVERVIEW
+* 		Find the first frame header in the input that starts before sHigh
+* 		and whose sample number is inside the bracket. Only the frame
+* 		headers are read.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL bisect_scan( flacd_StaticArea*					const pStaticStructure,
+							  const flacd_bisectConfigInfo*		const pBisectConfigInfo,
+							  flacd_SeekProbe*					const pFound )
+{
+	const flacd_BisectState* const pBisect = &pStaticStructure->sBisect;
+	flacd_ioBufferConfigInfo sBuffConfigInfo;
+	FLAC__bool got_a_header;
+	ACMW_UINT32 nStart, nSample;
+
+	sBuffConfigInfo.pInBuffStart = pBisectConfigInfo->pInBuffStart;
+	sBuffConfigInfo.nInBuffSetDataSize = pBisectConfigInfo->nInBuffSetDataSize;
+	sBuffConfigInfo.pOutBuffStart = NULL;
+	sBuffConfigInfo.nOutBuffSize = (ACMW_UINT32)0U;
+	FLAC__bitreader_init( &(pStaticStructure->pBitReader), &sBuffConfigInfo );
+	FLAC__stream_decoder_flush( &(pStaticStructure->pStreamDecoder) );
+
+	while ( FLAC__stream_decoder_process_frame_sync( &(pStaticStructure->pStreamDecoder) ) == true ) {
+		nStart = pBisect->nScanOffset + FLACD__bitreader_get_input_bytes_consumed( &(pStaticStructure->pBitReader) ) - FLACD_SYNC_CODE_BYTE;
+		if ( nStart >= pBisect->sHigh.nOffset ) {
+			break;
+		} /* end if */
+		if ( FLAC__stream_decoder_process_frame_header( &(pStaticStructure->pStreamDecoder), &got_a_header ) == false ) {
+			break;
+		} /* end if */
+		/* frames beyond the 32 bit sample positions are not supported (see flacd_Decode) */
+		if ( ( got_a_header == true ) &&
+			 ( FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) ) <= (FLAC__uint64)0xFFFFFFFFU ) ) {
+			nSample = (ACMW_UINT32)FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) );
+			/* a sync pattern inside audio data gives a sample number out of the bracket */
+			if ( ( nSample >= pBisect->sLow.nSample ) && ( nSample < pBisect->sHigh.nSample ) && ( nStart > pBisect->sLow.nOffset ) ) {
+				pFound->nOffset = nStart;
+				pFound->nSample = nSample;
+				return (ACMW_BOOL)1;
+			} /* end if */
+		} /* end if */
+	} /* end while */
+	return (ACMW_BOOL)0;
+}
+/*------------------------------------------------------------------------------*/
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bisect_cache
+*
+* ARGUMENT
+* 		flacd_BisectState*		const pBisect
+*		const flacd_SeekProbe*	const pProbe
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Keep a frame found by a probe, replacing the oldest one
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void bisect_cache( flacd_BisectState*		const pBisect,
+						  const flacd_SeekProbe*	const pProbe )
+{
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < pBisect->nCacheCount; i++ ) {
+		if ( pBisect->sCache[i].nOffset == pProbe->nOffset ) {
+			return;
+		} /* end if */
+	} /* end for */
+	pBisect->sCache[pBisect->nCacheNext] = *pProbe;
+	pBisect->nCacheNext = ( pBisect->nCacheNext + (ACMW_UINT32)1U ) % (ACMW_UINT32)FLACD_SEEK_CACHE_SIZE;
+	if ( pBisect->nCacheCount < (ACMW_UINT32)FLACD_SEEK_CACHE_SIZE ) {
+		pBisect->nCacheCount++;
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,120 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SeekIndex.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SeekIndex
+
+ [Description]
+   Seek to a sample of the stream through a frame index.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SeekIndex(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_indexSeekConfigInfo *pIndexSeekConfigInfo,
+           flacd_seekStatusInfo *pSeekStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_indexSeekConfigInfo *   pIndexSeekConfigInfo
+           Pointer to Index Seek Configuration Information Structure
+   flacd_seekStatusInfo *              pSeekStatusInfo
+           Pointer to Seek Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. Check the index once with flacd_IndexCheck
+   before; here only its format is checked. One binary search of the
+   entries finds the frame at or before nTargetSample, so only the
+   entries on the search path are read. The decoder restarts as for
+   flacd_Seek.
+==========================================================================*/
+ACMW_INT32	flacd_SeekIndex( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							 const flacd_indexSeekConfigInfo*	const pIndexSeekConfigInfo,
+							 flacd_seekStatusInfo*				const pSeekStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	const ACMW_UINT8 *pIndex;
+	ACMW_UINT32 nEntries, nSample, nOffset;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pIndexSeekConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pSeekStatusInfo == NULL) ||
+		(pIndexSeekConfigInfo->pIndex == NULL)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Index Format */
+	pIndex = pIndexSeekConfigInfo->pIndex;
+	if ( ( pIndexSeekConfigInfo->nIndexSize < (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_MAGIC], 4 ) != FLACD_INDEX_MAGIC ) ||
+		 ( flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_VERSION], 2 ) != FLACD_INDEX_VERSION ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nEntries = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_ENTRIES], 4 );
+	if ( nEntries > ( ( pIndexSeekConfigInfo->nIndexSize - (ACMW_UINT32)FLACD_INDEX_HEADER_SIZE ) / (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Nearest frame at or before the target, else the first frame */
+	if ( flacd_MetaFindIndexEntry( &pIndex[FLACD_INDEX_HEADER_SIZE], nEntries,
+								   pIndexSeekConfigInfo->nTargetSample, &nSample, &nOffset ) == (ACMW_BOOL)0 ) {
+		nSample = (ACMW_UINT32)0U;
+		nOffset = flacd_MetaReadBE( &pIndex[FLACD_INDEX_POS_AUDIO_OFFSET], 4 );
+	} /* end if */
+	pSeekStatusInfo->nInBuffOffset = nOffset;
+	pSeekStatusInfo->nSeekSample = nSample;
+	pSeekStatusInfo->nNeedSize = (ACMW_UINT32)0U;
+
+	/* Restart from the next frame sync */
+	flacd_DecodeRestart( pStaticStructure, pIndexSeekConfigInfo->nTargetSample );
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
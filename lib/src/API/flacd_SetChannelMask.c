@@ -0,0 +1,99 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetChannelMask.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetChannelMask
+
+ [Description]
+   Select the input channels decoded by the next flacd_Decode calls.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetChannelMask(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           UINT32 nChannelMask)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const UINT32                    nChannelMask
+           Channels to decode, bit 0 = channel 0 in the FLAC channel
+           order (0 : all channels)
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, between any two flacd_Decode calls; it applies
+   from the next frame read. The residuals of a masked channel are only
+   skipped in the bit stream: nothing is stored and no scratch memory is
+   used for it, and it is output as silence. Both channels of a stereo
+   frame with side channel coding are decoded when either is selected.
+   At most nDecodeChannels channels may be selected; a frame that needs
+   more is not decoded (FLACD_ERR_NOT_SUPPORTED_DATA).
+==========================================================================*/
+ACMW_INT32	flacd_SetChannelMask( const flacd_workMemoryInfo*	const pWorkMemInfo,
+								  const ACMW_UINT32				nChannelMask )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32 nMask, nCount;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Mask Value : input channels only, no more than the scratch rows */
+	if ( ( nChannelMask >> (ACMW_UINT32)pStaticStructure->nInputChannel ) != (ACMW_UINT32)0U ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	nCount = (ACMW_UINT32)0U;
+	for ( nMask = nChannelMask; nMask != (ACMW_UINT32)0U; nMask &= nMask - (ACMW_UINT32)1U ) {
+		nCount++;
+	} /* end for */
+	if ( nCount > pStaticStructure->sScratchLayout.nChannels ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	FLAC__stream_decoder_set_channel_mask( &(pStaticStructure->pStreamDecoder), (FLAC__uint32)nChannelMask );
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
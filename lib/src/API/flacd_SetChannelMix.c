@@ -0,0 +1,220 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetChannelMix.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+#define MIX_COEF_3DB				((ACMW_FLOAT32)0.70710678f)
+
+static void set_preset( flacd_ChannelMix* const pMix, const ACMW_UINT32 nPreset );
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetChannelMix
+
+ [Description]
+   Set the downmix matrix or channel remap table applied in the output
+   stage of the FLACD SW.IP. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetChannelMix(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_channelMixConfigInfo *pMixConfigInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_channelMixConfigInfo *  pMixConfigInfo
+           Pointer to Channel Mix Configuration Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. While a mix is set all input channels are
+   decoded, because any of them may contribute to an output channel.
+   The presets use the FLAC channel order and are normalized so that
+   full scale input on every channel does not clip.
+==========================================================================*/
+ACMW_INT32	flacd_SetChannelMix( const flacd_workMemoryInfo*		const pWorkMemInfo,
+								 const flacd_channelMixConfigInfo*	const pMixConfigInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	flacd_ChannelMix *pMix;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32	i, j;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pMixConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pMix = &pStaticStructure->sChannelMix;
+
+	/* Check MixConfig Value */
+	switch ((ACMW_INT32)pMixConfigInfo->nMixMode) {
+		case FLACD_MIXCFG_OFF :
+			break;
+		case FLACD_MIXCFG_MATRIX :
+			if ( ( pMixConfigInfo->nInChannels == 0u ) || ( pMixConfigInfo->nInChannels > pStaticStructure->nInputChannel ) ||
+				 ( pMixConfigInfo->nOutChannels == 0u ) || ( pMixConfigInfo->nOutChannels > pStaticStructure->nOutputChannel ) ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			for ( j = 0; j < (ACMW_UINT32)pMixConfigInfo->nOutChannels; j++ ) {
+				for ( i = 0; i < (ACMW_UINT32)pMixConfigInfo->nInChannels; i++ ) {
+					const ACMW_FLOAT32 fCoef = pMixConfigInfo->fMatrix[j][i];
+					/* NaN and infinity are rejected */
+					if ( ( fCoef != fCoef ) || ( ( fCoef - fCoef ) != (ACMW_FLOAT32)0.0f ) ) {
+						pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+						return FLACD_RESULT_NG;
+					} /* end if */
+				} /* end for */
+			} /* end for */
+			break;
+		case FLACD_MIXCFG_REMAP :
+			if ( ( pMixConfigInfo->nOutChannels == 0u ) || ( pMixConfigInfo->nOutChannels > pStaticStructure->nOutputChannel ) ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			for ( j = 0; j < (ACMW_UINT32)pMixConfigInfo->nOutChannels; j++ ) {
+				if ( ( pMixConfigInfo->nRemap[j] < (ACMW_INT16)-1 ) ||
+					 ( pMixConfigInfo->nRemap[j] >= (ACMW_INT16)pStaticStructure->nInputChannel ) ) {
+					pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+					return FLACD_RESULT_NG;
+				} /* end if */
+			} /* end for */
+			break;
+		case FLACD_MIXCFG_5_1_TO_2_0 :
+			if ( (ACMW_UINT32)pStaticStructure->nInputChannel < FLACD_6CHIN ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			break;
+		case FLACD_MIXCFG_4_0_TO_2_0 :
+			if ( (ACMW_UINT32)pStaticStructure->nInputChannel < FLACD_4CHOUT ) {
+				pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+				return FLACD_RESULT_NG;
+			} /* end if */
+			break;
+		default :
+			pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+			return FLACD_RESULT_NG;
+	} /* end switch */
+
+	/* Copy Config Value */
+	flacd_MemSet(pMix, 0, sizeof(flacd_ChannelMix));
+	switch ((ACMW_INT32)pMixConfigInfo->nMixMode) {
+		case FLACD_MIXCFG_MATRIX :
+			pMix->nMode = (ACMW_UINT16)FLACD_MIXCFG_MATRIX;
+			pMix->nInChannels = pMixConfigInfo->nInChannels;
+			pMix->nOutChannels = pMixConfigInfo->nOutChannels;
+			for ( j = 0; j < (ACMW_UINT32)pMix->nOutChannels; j++ ) {
+				for ( i = 0; i < (ACMW_UINT32)pMix->nInChannels; i++ ) {
+					pMix->fMatrix[j][i] = pMixConfigInfo->fMatrix[j][i];
+				} /* end for */
+			} /* end for */
+			break;
+		case FLACD_MIXCFG_REMAP :
+			pMix->nMode = (ACMW_UINT16)FLACD_MIXCFG_REMAP;
+			pMix->nOutChannels = pMixConfigInfo->nOutChannels;
+			for ( j = 0; j < (ACMW_UINT32)pMix->nOutChannels; j++ ) {
+				pMix->nRemap[j] = pMixConfigInfo->nRemap[j];
+			} /* end for */
+			break;
+		case FLACD_MIXCFG_5_1_TO_2_0 :
+		case FLACD_MIXCFG_4_0_TO_2_0 :
+			set_preset( pMix, (ACMW_UINT32)pMixConfigInfo->nMixMode );
+			break;
+		default :
+			pMix->nMode = (ACMW_UINT16)FLACD_MIXCFG_OFF;
+			break;
+	} /* end switch */
+
+	/* Decode every input channel while mixing */
+	flacd_DecodeSetChannels( pStaticStructure );
+
+	return FLACD_RESULT_OK;
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		set_preset
+*
+* ARGUMENT
+* 		flacd_ChannelMix*	const pMix
+*		const ACMW_UINT32	nPreset
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Set the matrix of a downmix preset (ITU-R BS.775 coefficients,
+* 		LFE dropped, normalized to the sum of a row).
+* 		5.1 : L R C LFE Ls Rs / 4.0 : L R Ls Rs
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void set_preset( flacd_ChannelMix* const pMix, const ACMW_UINT32 nPreset )
+{
+	ACMW_FLOAT32 fNorm;
+
+	pMix->nMode = (ACMW_UINT16)FLACD_MIXCFG_MATRIX;
+	pMix->nOutChannels = (ACMW_UINT16)FLACD_2CHOUT;
+	if ( nPreset == FLACD_MIXCFG_5_1_TO_2_0 ) {
+		fNorm = (ACMW_FLOAT32)1.0f / ( (ACMW_FLOAT32)1.0f + MIX_COEF_3DB + MIX_COEF_3DB );
+		pMix->nInChannels = (ACMW_UINT16)FLACD_6CHIN;
+		pMix->fMatrix[0][0] = fNorm;					/* L  */
+		pMix->fMatrix[0][2] = fNorm * MIX_COEF_3DB;		/* C  */
+		pMix->fMatrix[0][4] = fNorm * MIX_COEF_3DB;		/* Ls */
+		pMix->fMatrix[1][1] = fNorm;					/* R  */
+		pMix->fMatrix[1][2] = fNorm * MIX_COEF_3DB;		/* C  */
+		pMix->fMatrix[1][5] = fNorm * MIX_COEF_3DB;		/* Rs */
+	} else {
+		fNorm = (ACMW_FLOAT32)1.0f / ( (ACMW_FLOAT32)1.0f + MIX_COEF_3DB );
+		pMix->nInChannels = (ACMW_UINT16)FLACD_4CHOUT;
+		pMix->fMatrix[0][0] = fNorm;					/* L  */
+		pMix->fMatrix[0][2] = fNorm * MIX_COEF_3DB;		/* Ls */
+		pMix->fMatrix[1][1] = fNorm;					/* R  */
+		pMix->fMatrix[1][3] = fNorm * MIX_COEF_3DB;		/* Rs */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,98 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetFormatChange.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetFormatChange
+
+ [Description]
+   Select whether a frame may change the sample rate, the number of
+   channels or the sample size of the stream.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetFormatChange(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           UINT16 nFormatChangeMode)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const UINT16                    nFormatChangeMode
+           FLACD_FORMATCFG_REJECT : a frame that changes the format is not
+                                    decoded (FLACD_ERR_CHANGE_FRAME_HEADER)
+           FLACD_FORMATCFG_ACCEPT : the frame is decoded in its format
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, between any two flacd_Decode calls; it applies
+   from the next frame read. The default is FLACD_FORMATCFG_REJECT.
+   For chained or concatenated streams: the new format must still be
+   within what flacd_Init was given (input channels, block size), so the
+   scratch memory is used as it is laid out. flacd_Decode and
+   flacd_DecodeSpan output one frame per call; the call that outputs the
+   first samples in the new format tells it in nFormatChange; pass the
+   STREAMINFO of the new stream in pDecConfigInfo from then on (sample
+   rate and sample size coded as "from STREAMINFO", fixed block size
+   frame numbers). flacd_DecodeStream, flacd_ReadRange and
+   flacd_DecodeMix write one format and keep rejecting a change.
+==========================================================================*/
+ACMW_INT32	flacd_SetFormatChange( const flacd_workMemoryInfo*	const pWorkMemInfo,
+								   const ACMW_UINT16			nFormatChangeMode )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	if ( nFormatChangeMode > FLACD_FORMATCFG_ACCEPT ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pStaticStructure->nFormatChangeMode = nFormatChangeMode;
+	FLAC__stream_decoder_set_format_change( &(pStaticStructure->pStreamDecoder),
+		( nFormatChangeMode == (ACMW_UINT16)FLACD_FORMATCFG_ACCEPT ) ? true : false );
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
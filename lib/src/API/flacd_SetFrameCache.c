@@ -0,0 +1,120 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetFrameCache.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_framecache.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetFrameCache
+
+ [Description]
+   Set the cache of decoded frames used by the next flacd_Decode calls.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetFrameCache(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_frameCacheConfigInfo *pCacheConfigInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *        pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_frameCacheConfigInfo *  pCacheConfigInfo
+           Pointer to Frame Cache Config Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, between any two flacd_Decode calls. A frame
+   found in the cache is output without decoding it again; a frame not
+   found is decoded and kept in the cache, replacing the least recently
+   used one when the cache is full. Frames are only taken from the cache
+   with the channel mask and the decoded output channels they were
+   decoded with, and only when all their bytes match the bytes kept.
+   Bypass keeps the contents of the cache for a later use.
+==========================================================================*/
+ACMW_INT32	flacd_SetFrameCache( const flacd_workMemoryInfo*			const pWorkMemInfo,
+								 const flacd_frameCacheConfigInfo*	const pCacheConfigInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32 nSlotSize;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pCacheConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	if ( pCacheConfigInfo->nCacheMode > FLACD_CACHECFG_BYPASS ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( pCacheConfigInfo->nCacheMode == FLACD_CACHECFG_OFF ) {
+		pStaticStructure->pFrameCache = NULL;
+		pStaticStructure->nFrameCacheMode = FLACD_CACHECFG_OFF;
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if ((pCacheConfigInfo->pCache == NULL) || ((((ACMW_UINT32)(pCacheConfigInfo->pCache)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( (ACMW_UINT32)pCacheConfigInfo->nMaxBlockSize > pStaticStructure->sScratchLayout.nBlockSize ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	nSlotSize = flacd_FrameCacheSlotSize( pStaticStructure, (ACMW_UINT32)pCacheConfigInfo->nMaxBlockSize, pCacheConfigInfo->nMaxFrameSize );
+	if ( pCacheConfigInfo->nCacheSize < ( (ACMW_UINT32)FLACD_FRAMECACHE_HEADER_SIZE + nSlotSize ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	flacd_FrameCacheAttach( (flacd_FrameCacheHeader*)pCacheConfigInfo->pCache, pCacheConfigInfo->nCacheSize, nSlotSize );
+	pStaticStructure->pFrameCache = pCacheConfigInfo->pCache;
+	pStaticStructure->nFrameCacheMode = pCacheConfigInfo->nCacheMode;
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,112 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetOverview.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetOverview
+
+ [Description]
+   Set the buckets of the waveform overview (minimum, maximum and sum of
+   squares per channel) computed in the output stage of the FLACD SW.IP.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetOverview(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_overviewConfigInfo *pOverviewConfigInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *      pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_overviewConfigInfo *  pOverviewConfigInfo
+           Pointer to Waveform Overview Config Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, between any two flacd_Decode calls. The
+   samples are counted tile by tile right after they are finished, while
+   the output stage still has them in the cache. Without PCM output
+   whole frames are counted, and flacd_Decode tells the samples counted
+   and no output size.
+==========================================================================*/
+ACMW_INT32	flacd_SetOverview( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							   const flacd_overviewConfigInfo*	const pOverviewConfigInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pOverviewConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	if ( pOverviewConfigInfo->nOverviewMode > FLACD_OVERVIEWCFG_NO_OUTPUT ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( pOverviewConfigInfo->nOverviewMode == FLACD_OVERVIEWCFG_OFF ) {
+		flacd_MemSet(&(pStaticStructure->sOverview), 0, sizeof(flacd_Overview));
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if (pOverviewConfigInfo->pBuckets == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	if ( ( pOverviewConfigInfo->nBucketSamples == (ACMW_UINT32)0U ) || ( pOverviewConfigInfo->nBuckets == (ACMW_UINT32)0U ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Copy Config Value */
+	pStaticStructure->sOverview.nMode = pOverviewConfigInfo->nOverviewMode;
+	pStaticStructure->sOverview.nBucketSamples = pOverviewConfigInfo->nBucketSamples;
+	pStaticStructure->sOverview.nBuckets = pOverviewConfigInfo->nBuckets;
+	pStaticStructure->sOverview.pBuckets = pOverviewConfigInfo->pBuckets;
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
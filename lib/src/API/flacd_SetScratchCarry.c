@@ -0,0 +1,88 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetScratchCarry.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetScratchCarry
+
+ [Description]
+   Set the carry buffer that takes the remaining samples of a frame when
+   the scratch block is returned to its pool. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetScratchCarry(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_carryConfigInfo *pCarryConfigInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *      pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_carryConfigInfo *     pCarryConfigInfo
+           Pointer to Scratch Carry Config Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, while no remaining samples are held in the
+   carry buffer. With the carry buffer, flacd_ReleaseScratch frees the
+   block after every call in which the rest of the frame fits in it, so
+   a pool needs no more blocks than the calls running at a time.
+==========================================================================*/
+ACMW_INT32	flacd_SetScratchCarry( const flacd_workMemoryInfo*		const pWorkMemInfo,
+								   const flacd_carryConfigInfo*		const pCarryConfigInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pCarryConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		((((ACMW_UINT32)(pCarryConfigInfo->pCarry)) & FLACD_ALIGNMENT4) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence : the carry buffer in use is not replaced */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		   ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) ||
+		 ( ( pStaticStructure->sPending.nRemainSamples != (ACMW_UINT32)0U ) && ( pStaticStructure->sPending.pScratch == NULL ) ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pStaticStructure->pCarry = pCarryConfigInfo->pCarry;
+	pStaticStructure->nCarrySize = ( pCarryConfigInfo->pCarry != NULL ) ? pCarryConfigInfo->nCarrySize : (ACMW_UINT32)0U;
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
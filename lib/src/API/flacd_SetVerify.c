@@ -0,0 +1,140 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SetVerify.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_verify.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SetVerify
+
+ [Description]
+   Set the verification of the decoded samples against the MD5 signature
+   of STREAMINFO, or the frame test. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SetVerify(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_verifyConfigInfo *pVerifyConfigInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *      pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_verifyConfigInfo *    pVerifyConfigInfo
+           Pointer to Verify Config Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init, before the first frame is decoded. The
+   signature is updated tile by tile in the output stage, one frame
+   after the other, so no frame is kept for it. While it is set all
+   input channels are decoded, because all of them are in the signature.
+   The result is got with flacd_GetVerifyStatus.
+   The frame test makes the decode APIs only parse the frames: the
+   residuals are stepped over with the CRC-16 running, and the
+   prediction, the channel decoding and the output are not done. No
+   output is written, and flacd_Decode and flacd_DecodeStream need no
+   output buffer; nDecodedSamples tells the samples of the frames
+   checked and the used output size is 0. A frame with a CRC-16 error gives
+   FLACD_RESULT_WARNING as in a full decode. The frame cache and the
+   waveform overview are not used.
+==========================================================================*/
+ACMW_INT32	flacd_SetVerify( const flacd_workMemoryInfo*		const pWorkMemInfo,
+							 const flacd_verifyConfigInfo*		const pVerifyConfigInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	flacd_Verify *pVerify;
+	FLAC__StreamDecoderState get_state;
+	ACMW_UINT32 i;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if (pVerifyConfigInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check Config Value */
+	if ( pVerifyConfigInfo->nVerifyMode > FLACD_VERIFYCFG_FRAMES ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_PARAMETER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	pVerify = &(pStaticStructure->sVerify);
+	if ( pVerifyConfigInfo->nVerifyMode == FLACD_VERIFYCFG_OFF ) {
+		flacd_MemSet(pVerify, 0, sizeof(flacd_Verify));
+		flacd_DecodeSetChannels( pStaticStructure );
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if ( pVerifyConfigInfo->nVerifyMode == FLACD_VERIFYCFG_FRAMES ) {
+		flacd_MemSet(pVerify, 0, sizeof(flacd_Verify));
+		pVerify->nMode = pVerifyConfigInfo->nVerifyMode;
+		pVerify->nResult = (ACMW_UINT16)FLACD_VERIFY_PENDING;
+		pVerify->pFrames = pVerifyConfigInfo->pFrames;
+		pVerify->nFrames = ( pVerifyConfigInfo->pFrames != NULL ) ? pVerifyConfigInfo->nFrames : (ACMW_UINT32)0U;
+
+		/* Parse every channel without a scratch row */
+		flacd_DecodeSetChannels( pStaticStructure );
+		return FLACD_RESULT_OK;
+	} /* end if */
+
+	if (pVerifyConfigInfo->pHeaderInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Copy Config Value */
+	pVerify->nMode = pVerifyConfigInfo->nVerifyMode;
+	pVerify->nTotalSamples = pVerifyConfigInfo->pHeaderInfo->nTotalSamples;
+	pVerify->bSignature = (ACMW_BOOL)0;
+	for ( i = 0; i < (ACMW_UINT32)FLACD_MD5_DIGEST_SIZE; i++ ) {
+		pVerify->nExpected[i] = pVerifyConfigInfo->pHeaderInfo->nMD5Signature[i];
+		if ( pVerify->nExpected[i] != (ACMW_UINT8)0U ) {
+			pVerify->bSignature = (ACMW_BOOL)1;
+		} /* end if */
+	} /* end for */
+	flacd_VerifyStart( pVerify );
+
+	/* Decode every input channel while verifying */
+	flacd_DecodeSetChannels( pStaticStructure );
+
+	return FLACD_RESULT_OK;
+}
+/*------------------------------------------------------------------------------*/
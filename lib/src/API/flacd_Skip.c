@@ -0,0 +1,225 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_Skip.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "FLAC/stream_decoder.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+
+#define SKIP_HEADER_SIZE			((ACMW_UINT32)16U)			/* largest frame header */
+#define SKIP_ANY_SAMPLE				((ACMW_UINT32)0xFFFFFFFFU)
+
+static ACMW_BOOL skip_find( flacd_StaticArea* const pStaticStructure, const flacd_skipConfigInfo* const pSkipConfigInfo,
+							const ACMW_UINT32 nFrom, const ACMW_UINT32 nExpect, flacd_SeekProbe* const pFound,
+							ACMW_UINT32* const pBlockSize, ACMW_UINT32* const pHeaderEnd );
+
+/*==========================================================================
+ [Function Name]
+   flacd_Skip
+
+ [Description]
+   Skip frames of the stream without decoding them.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_Skip(
+           flacd_workMemoryInfo *pWorkMemInfo,
+           flacd_decConfigInfo *pDecConfigInfo,
+           flacd_skipConfigInfo *pSkipConfigInfo,
+           flacd_skipStatusInfo *pSkipStatusInfo)
+
+ [Argument]
+   const flacd_workMemoryInfo *    pWorkMemInfo
+           Pointer to Work Memory Information Structure
+   const flacd_decConfigInfo *     pDecConfigInfo
+           Pointer to Decoder Configuration Information Structure
+   const flacd_skipConfigInfo *    pSkipConfigInfo
+           Pointer to Skip Configuration Information Structure
+   flacd_skipStatusInfo *          pSkipStatusInfo
+           Pointer to Skip Status Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : Error (+ Error Factor)
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Call after flacd_Init. Only the frame headers are read: after a
+   header the scan jumps nMinFrameSize bytes from the frame start, and
+   the frame ends at the next header whose sample number follows it.
+   So a frame is skipped only when the header of the next frame is in
+   the input, and the last frame of the stream is never skipped.
+   The samples of the current frame not output yet are dropped, and the
+   next flacd_Decode call is given the input from nInBuffUsedDataSize.
+   The scratch memory is used during the call.
+==========================================================================*/
+ACMW_INT32	flacd_Skip( const flacd_workMemoryInfo*		const pWorkMemInfo,
+						const flacd_decConfigInfo*		const pDecConfigInfo,
+						const flacd_skipConfigInfo*		const pSkipConfigInfo,
+						flacd_skipStatusInfo*			const pSkipStatusInfo )
+{
+	flacd_StaticArea *pStaticStructure;
+	FLAC__StreamDecoderState get_state;
+	flacd_SeekProbe sFrame, sNext;
+	ACMW_UINT32 nBlockSize, nNextBlockSize, nHeaderEnd, nFrom;
+
+	/* Argument Check */
+	if (pWorkMemInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pWorkMemInfo->pStatic == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pStatic)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pStaticStructure = (flacd_StaticArea*)pWorkMemInfo->pStatic;
+	/* Set ErrorCode */
+	pStaticStructure->nErrorFactor = FLACD_ERR_NONE;
+
+	if ((pDecConfigInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pSkipConfigInfo == NULL) ||
+		(pSkipStatusInfo == NULL) ||
+		(pSkipConfigInfo->pInBuffStart == NULL) ||
+		(pWorkMemInfo->pScratch == NULL) || ((((ACMW_UINT32)(pWorkMemInfo->pScratch)) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_POINTER;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Fill Status Info */
+	flacd_MemSet(pSkipStatusInfo, 0, sizeof(flacd_skipStatusInfo));
+
+	/* Check Sequence */
+	get_state = pStaticStructure->pStreamDecoderProtected.state;
+	if ( ( get_state != FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC ) &&
+		 ( get_state != FLAC__STREAM_DECODER_READ_FRAME ) ) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SEQUENCE;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Check DecConfig Value */
+	pStaticStructure->nErrorFactor = flacd_DecodeCheckConfig( pStaticStructure, pDecConfigInfo );
+	if ( pStaticStructure->nErrorFactor != FLACD_ERR_NONE ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+	if (pSkipConfigInfo->nInBuffSetDataSize < FLACD_MIN_INBUFF_SIZE) {
+		pStaticStructure->nErrorFactor = FLACD_ERR_SHORT_INPUT_DATA;
+		return FLACD_RESULT_NG;
+	} /* end if */
+	FLAC__stream_decoder_set_streaminfo( &(pStaticStructure->pStreamDecoder), pDecConfigInfo );
+	flacd_DecodeBindScratch( pStaticStructure, pWorkMemInfo->pScratch );
+
+	/* First frame of the input */
+	if ( skip_find( pStaticStructure, pSkipConfigInfo, (ACMW_UINT32)0U, SKIP_ANY_SAMPLE, &sFrame, &nBlockSize, &nHeaderEnd ) == (ACMW_BOOL)0 ) {
+		flacd_DecodeRestart( pStaticStructure, ( pStaticStructure->bSeekPending == (ACMW_BOOL)1 ) ? pStaticStructure->nSeekTarget : (ACMW_UINT32)0U );
+		if ( pSkipConfigInfo->nInBuffSetDataSize > SKIP_HEADER_SIZE ) {
+			pSkipStatusInfo->nInBuffUsedDataSize = pSkipConfigInfo->nInBuffSetDataSize - SKIP_HEADER_SIZE;
+		} /* end if */
+		pStaticStructure->nErrorFactor = FLACD_ERR_LOST_SYNC;
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Jump over each frame to the header that follows it */
+	while ( ( pSkipConfigInfo->nMaxFrames == (ACMW_UINT32)0U ) || ( pSkipStatusInfo->nSkippedFrames < pSkipConfigInfo->nMaxFrames ) ) {
+		nFrom = sFrame.nOffset + (ACMW_UINT32)pDecConfigInfo->nMinFrameSize;
+		if ( nFrom < nHeaderEnd ) {
+			nFrom = nHeaderEnd;
+		} /* end if */
+		if ( skip_find( pStaticStructure, pSkipConfigInfo, nFrom, sFrame.nSample + nBlockSize, &sNext, &nNextBlockSize, &nHeaderEnd ) == (ACMW_BOOL)0 ) {
+			break;
+		} /* end if */
+		pSkipStatusInfo->nSkippedFrames++;
+		pSkipStatusInfo->nSkippedSamples += nBlockSize;
+		sFrame = sNext;
+		nBlockSize = nNextBlockSize;
+	} /* end while */
+
+	pSkipStatusInfo->nInBuffUsedDataSize = sFrame.nOffset;
+	pSkipStatusInfo->nSamplePosition = sFrame.nSample;
+
+	/* Restart at the first frame not skipped */
+	flacd_DecodeRestart( pStaticStructure, sFrame.nSample );
+
+	return FLACD_RESULT_OK;
+}
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		skip_find
+*
+* ARGUMENT
+* 		flacd_StaticArea*				const pStaticStructure
+*		const flacd_skipConfigInfo*		const pSkipConfigInfo
+*		const ACMW_UINT32				nFrom
+*		const ACMW_UINT32				nExpect
+*		flacd_SeekProbe*				const pFound
+*		ACMW_UINT32*					const pBlockSize
+*		ACMW_UINT32*					const pHeaderEnd
+*
+* RETURN VALUE
+* 		ACMW_BOOL						1 : frame found / 0 : not found
+*
+* OVERVIEW
+* 		Find the first frame header in the input from nFrom whose sample
+* 		number is nExpect (SKIP_ANY_SAMPLE : any). Only the frame
+* 		headers are read.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL skip_find( flacd_StaticArea*				const pStaticStructure,
+							const flacd_skipConfigInfo*		const pSkipConfigInfo,
+							const ACMW_UINT32				nFrom,
+							const ACMW_UINT32				nExpect,
+							flacd_SeekProbe*				const pFound,
+							ACMW_UINT32*					const pBlockSize,
+							ACMW_UINT32*					const pHeaderEnd )
+{
+	flacd_ioBufferConfigInfo sBuffConfigInfo;
+	FLAC__bool got_a_header;
+	ACMW_UINT32 nStart, nSample;
+
+	if ( nFrom >= pSkipConfigInfo->nInBuffSetDataSize ) {
+		return (ACMW_BOOL)0;
+	} /* end if */
+
+	sBuffConfigInfo.pInBuffStart = pSkipConfigInfo->pInBuffStart + nFrom;
+	sBuffConfigInfo.nInBuffSetDataSize = pSkipConfigInfo->nInBuffSetDataSize - nFrom;
+	sBuffConfigInfo.pOutBuffStart = NULL;
+	sBuffConfigInfo.nOutBuffSize = (ACMW_UINT32)0U;
+	FLAC__bitreader_init( &(pStaticStructure->pBitReader), &sBuffConfigInfo );
+	FLAC__stream_decoder_flush( &(pStaticStructure->pStreamDecoder) );
+
+	while ( FLAC__stream_decoder_process_frame_sync( &(pStaticStructure->pStreamDecoder) ) == true ) {
+		nStart = nFrom + FLACD__bitreader_get_input_bytes_consumed( &(pStaticStructure->pBitReader) ) - FLACD_SYNC_CODE_BYTE;
+		if ( FLAC__stream_decoder_process_frame_header( &(pStaticStructure->pStreamDecoder), &got_a_header ) == false ) {
+			break;
+		} /* end if */
+		/* frames beyond the 32 bit sample positions are not supported (see flacd_Decode) */
+		if ( ( got_a_header == true ) &&
+			 ( FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) ) <= (FLAC__uint64)0xFFFFFFFFU ) ) {
+			nSample = (ACMW_UINT32)FLAC__stream_decoder_get_sample_number( &(pStaticStructure->pStreamDecoder) );
+			/* a sync pattern inside audio data gives another sample number */
+			if ( ( nExpect == SKIP_ANY_SAMPLE ) || ( nSample == nExpect ) ) {
+				pFound->nOffset = nStart;
+				pFound->nSample = nSample;
+				*pBlockSize = FLAC__stream_decoder_get_frame_blocksize( &(pStaticStructure->pStreamDecoder) );
+				*pHeaderEnd = nFrom + FLACD__bitreader_get_input_bytes_consumed( &(pStaticStructure->pBitReader) );
+				return (ACMW_BOOL)1;
+			} /* end if */
+		} /* end if */
+	} /* end while */
+	return (ACMW_BOOL)0;
+}
+/*------------------------------------------------------------------------------*/
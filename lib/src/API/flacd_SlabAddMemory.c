@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SlabAddMemory.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SlabAddMemory
+
+ [Description]
+   Add a slab to a slab pool and carve it into static memory slots.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SlabAddMemory(
+           flacd_slabPoolInfo *pSlabPoolInfo,
+           void *pMemory,
+           UINT32 nMemorySize)
+
+ [Argument]
+   flacd_slabPoolInfo *          pSlabPoolInfo
+           Pointer to Slab Pool Information Structure
+   void *                        pMemory
+           Slab memory (allocated by the caller, e.g. on huge pages)
+   UINT32                        nMemorySize
+           Size of the slab memory in bytes
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : No slot fits or FLACD_SLAB_MAX_SLABS are added
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   The slots start on a cache line. A slab holds at most 4096 slots; the
+   memory after them is not used. The slab memory is owned by the pool
+   until the caller stops using the pool.
+==========================================================================*/
+ACMW_INT32	flacd_SlabAddMemory( flacd_slabPoolInfo*	const pSlabPoolInfo,
+								 void*					const pMemory,
+								 const ACMW_UINT32		nMemorySize )
+{
+	ACMW_UINT32	nSlab, nSlots, nSkip, i;
+	flacd_SlabSlot *pSlot;
+
+	/* Argument Check */
+	if ((pSlabPoolInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pSlabPoolInfo->nSlotSize == (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	if ((pMemory == NULL) || ((((ACMW_UINT32)pMemory) & FLACD_ALIGNMENT_PTR) != (ACMW_UINT32)0U)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	/* Carve the slots from the first cache line boundary */
+	nSkip = ( FLACD_SLAB_SLOT_ALIGN - ( ((ACMW_UINT32)pMemory) & ( FLACD_SLAB_SLOT_ALIGN - (ACMW_UINT32)1U ) ) ) & ( FLACD_SLAB_SLOT_ALIGN - (ACMW_UINT32)1U );
+	nSlots = ( nMemorySize > nSkip ) ? ( ( nMemorySize - nSkip ) / pSlabPoolInfo->nSlotSize ) : (ACMW_UINT32)0U;
+	if ( nSlots > FLACD_SLAB_MAX_SLOTS ) {
+		nSlots = FLACD_SLAB_MAX_SLOTS;
+	} /* end if */
+	if ( ( nSlots == (ACMW_UINT32)0U ) || ( pSlabPoolInfo->nSlabs >= (ACMW_UINT32)FLACD_SLAB_MAX_SLABS ) ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	nSlab = pSlabPoolInfo->nSlabs;
+	pSlabPoolInfo->pSlab[nSlab] = (ACMW_UINT8*)pMemory + nSkip;
+	pSlabPoolInfo->nSlabSlots[nSlab] = nSlots;
+	pSlabPoolInfo->nSlabs++;
+
+	/* Link the slots in front of the free list, lowest address first */
+	for ( i = nSlots; i > (ACMW_UINT32)0U; i-- ) {
+		pSlot = flacd_SlabGetSlot( pSlabPoolInfo, ( nSlab << FLACD_SLAB_SLOT_BITS ) | ( i - (ACMW_UINT32)1U ) );
+		pSlot->nNext = pSlabPoolInfo->nFreeHead;
+		pSlot->nGeneration = (ACMW_UINT32)0U;
+		pSlot->nLastGeneration = (ACMW_UINT32)0U;
+		pSlabPoolInfo->nFreeHead = ( nSlab << FLACD_SLAB_SLOT_BITS ) | ( i - (ACMW_UINT32)1U );
+	} /* end for */
+	pSlabPoolInfo->nFreeSlots += nSlots;
+
+	return FLACD_RESULT_OK;
+}
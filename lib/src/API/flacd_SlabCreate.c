@@ -0,0 +1,75 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SlabCreate.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SlabCreate
+
+ [Description]
+   Take a static memory slot from a slab pool and give its handle.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SlabCreate(
+           flacd_slabPoolInfo *pSlabPoolInfo,
+           flacd_handle *pHandle)
+
+ [Argument]
+   flacd_slabPoolInfo *          pSlabPoolInfo
+           Pointer to Slab Pool Information Structure
+   flacd_handle *                pHandle
+           Handle of the slot (FLACD_INVALID_HANDLE on error)
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_NG      : No free slot
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   O(1). The slot is not cleared; flacd_Init prepares it as pStatic
+   (see flacd_SlabGetStatic).
+==========================================================================*/
+ACMW_INT32	flacd_SlabCreate( flacd_slabPoolInfo*	const pSlabPoolInfo,
+							  flacd_handle*			const pHandle )
+{
+	ACMW_UINT32	nIndex;
+	flacd_SlabSlot *pSlot;
+
+	/* Argument Check */
+	if ((pSlabPoolInfo == NULL) ||	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		(pHandle == NULL)) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+	*pHandle = FLACD_INVALID_HANDLE;
+
+	nIndex = pSlabPoolInfo->nFreeHead;
+	pSlot = flacd_SlabGetSlot( pSlabPoolInfo, nIndex );
+	if ( pSlot == NULL ) {
+		return FLACD_RESULT_NG;
+	} /* end if */
+
+	/* Pop the free list and give the next generation (1 - FLACD_SLAB_MAX_GENERATION) */
+	pSlabPoolInfo->nFreeHead = pSlot->nNext;
+	pSlabPoolInfo->nFreeSlots--;
+	pSlot->nNext = FLACD_SLAB_NO_SLOT;
+	pSlot->nGeneration = ( pSlot->nLastGeneration % FLACD_SLAB_MAX_GENERATION ) + (ACMW_UINT32)1U;
+	pSlot->nLastGeneration = pSlot->nGeneration;
+	*pHandle = (flacd_handle)( ( pSlot->nGeneration << FLACD_SLAB_INDEX_BITS ) | nIndex );
+
+	return FLACD_RESULT_OK;
+}
@@ -0,0 +1,70 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SlabDestroy.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SlabDestroy
+
+ [Description]
+   Return the static memory slot of a handle to its slab pool.
+   This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SlabDestroy(
+           flacd_slabPoolInfo *pSlabPoolInfo,
+           flacd_handle nHandle)
+
+ [Argument]
+   flacd_slabPoolInfo *          pSlabPoolInfo
+           Pointer to Slab Pool Information Structure
+   flacd_handle                  nHandle
+           Handle given by flacd_SlabCreate
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+                                : the handle is invalid or already destroyed.
+
+ [Note]
+   O(1). A slot is reused most recently freed first.
+==========================================================================*/
+ACMW_INT32	flacd_SlabDestroy( flacd_slabPoolInfo*	const pSlabPoolInfo,
+							   const flacd_handle	nHandle )
+{
+	const ACMW_UINT32 nIndex = (ACMW_UINT32)nHandle & ( ( (ACMW_UINT32)1U << FLACD_SLAB_INDEX_BITS ) - (ACMW_UINT32)1U );
+	flacd_SlabSlot *pSlot;
+
+	/* Argument Check */
+	if (pSlabPoolInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	pSlot = flacd_SlabGetSlot( pSlabPoolInfo, nIndex );
+	if ( ( pSlot == NULL ) || ( pSlot->nGeneration == (ACMW_UINT32)0U ) ||
+		 ( pSlot->nGeneration != ( (ACMW_UINT32)nHandle >> FLACD_SLAB_INDEX_BITS ) ) ) {
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	/* Push the free list */
+	pSlot->nGeneration = (ACMW_UINT32)0U;
+	pSlot->nNext = pSlabPoolInfo->nFreeHead;
+	pSlabPoolInfo->nFreeHead = nIndex;
+	pSlabPoolInfo->nFreeSlots++;
+
+	return FLACD_RESULT_OK;
+}
@@ -0,0 +1,62 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SlabGetStatic.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SlabGetStatic
+
+ [Description]
+   Get the static memory of a handle. This is a top level wrapper.
+
+ [Prototype]
+   void*  flacd_SlabGetStatic(
+           flacd_slabPoolInfo *pSlabPoolInfo,
+           flacd_handle nHandle)
+
+ [Argument]
+   const flacd_slabPoolInfo *    pSlabPoolInfo
+           Pointer to Slab Pool Information Structure
+   flacd_handle                  nHandle
+           Handle given by flacd_SlabCreate
+
+ [Return]
+   void*    Static memory to set to pStatic of flacd_workMemoryInfo
+            NULL : the handle is invalid or already destroyed.
+
+ [Note]
+   None
+==========================================================================*/
+void*	flacd_SlabGetStatic( const flacd_slabPoolInfo*	const pSlabPoolInfo,
+							 const flacd_handle			nHandle )
+{
+	const ACMW_UINT32 nIndex = (ACMW_UINT32)nHandle & ( ( (ACMW_UINT32)1U << FLACD_SLAB_INDEX_BITS ) - (ACMW_UINT32)1U );
+	flacd_SlabSlot *pSlot;
+	void *pStatic = NULL;
+
+	/* Argument Check */
+	if (pSlabPoolInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return NULL;
+	} /* end if */
+
+	pSlot = flacd_SlabGetSlot( pSlabPoolInfo, nIndex );
+	if ( ( pSlot != NULL ) && ( pSlot->nGeneration != (ACMW_UINT32)0U ) &&
+		 ( pSlot->nGeneration == ( (ACMW_UINT32)nHandle >> FLACD_SLAB_INDEX_BITS ) ) ) {
+		pStatic = (ACMW_UINT8*)pSlot - sizeof(flacd_StaticArea);
+	} /* end if */
+
+	return pStatic;
+}
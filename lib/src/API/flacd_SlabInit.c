@@ -0,0 +1,54 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_SlabInit.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Source file for API
+******************************************************************************/
+
+#include "flacd_common.h"
+#include "flacd_Lib.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+/*==========================================================================
+ [Function Name]
+   flacd_SlabInit
+
+ [Description]
+   Initialize an empty slab pool for the static memory of decoder
+   instances. This is a top level wrapper.
+
+ [Prototype]
+   INT32  flacd_SlabInit(
+           flacd_slabPoolInfo *pSlabPoolInfo)
+
+ [Argument]
+   flacd_slabPoolInfo *          pSlabPoolInfo
+           Pointer to Slab Pool Information Structure
+
+ [Return]
+   INT32 Error Code
+           FLACD_RESULT_OK      : Normal
+           FLACD_RESULT_FATAL   : Error (none Error Factor)
+
+ [Note]
+   Memory is added to the pool with flacd_SlabAddMemory.
+==========================================================================*/
+ACMW_INT32	flacd_SlabInit( flacd_slabPoolInfo* const pSlabPoolInfo )
+{
+	/* Argument Check */
+	if (pSlabPoolInfo == NULL) {	/* [2015.09.04] -> Alignment do not check for structure pointer */
+		return FLACD_RESULT_FATAL;
+	} /* end if */
+
+	flacd_MemSet(pSlabPoolInfo, 0, sizeof(flacd_slabPoolInfo));
+	pSlabPoolInfo->nSlotSize = flacd_SlabSlotSize();
+	pSlabPoolInfo->nFreeHead = FLACD_SLAB_NO_SLOT;
+
+	return FLACD_RESULT_OK;
+}
@@ -0,0 +1,393 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_framecache.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Decoded frame cache
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_api.h"
+#include "flacd_framecache.h"
+#include "flacd_metadata.h"
+#include "flacd_memory.h"
+
+#define FRAMECACHE_FOOTER_SIZE		((ACMW_UINT32)2U)
+#define FRAMECACHE_ALIGN(size)		( ( (size) + FLACD_ALIGNMENT8 ) & ~FLACD_ALIGNMENT8 )
+
+static flacd_FrameCacheEntry* get_slot( flacd_FrameCacheHeader* const pCache, const ACMW_UINT32 nSlot );
+static ACMW_UINT32 next_tick( flacd_FrameCacheHeader* const pCache );
+static ACMW_BOOL same_frame( const flacd_FrameCacheEntry* const pEntry, const ACMW_UINT8* const pFrame );
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_FrameCacheSlotSize
+*
+* ARGUMENT
+*		const flacd_StaticArea*	const pStaticStructure
+*		const ACMW_UINT32		nMaxBlockSize
+*		const ACMW_UINT32		nMaxFrameSize
+*
+* RETURN VALUE
+* 		ACMW_UINT32			Bytes per slot
+*
+* OVERVIEW
+* 		Get the size of a slot holding a compressed frame of up to
+* 		nMaxFrameSize bytes and its samples, nMaxBlockSize in each scratch
+* 		row of the instance. 0 : the largest block size of the instance,
+* 		the largest frame of such blocks.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_FrameCacheSlotSize( const flacd_StaticArea*	const pStaticStructure,
+									  const ACMW_UINT32			nMaxBlockSize,
+									  const ACMW_UINT32			nMaxFrameSize )
+{
+	const flacd_ScratchLayout* const pLayout = &(pStaticStructure->sScratchLayout);
+	const ACMW_UINT32 nBlockSize = ( nMaxBlockSize == (ACMW_UINT32)0U ) ? pLayout->nBlockSize : nMaxBlockSize;
+	ACMW_UINT32 nFrameSize = nMaxFrameSize;
+
+	if ( nFrameSize == (ACMW_UINT32)0U ) {
+		nFrameSize = flacd_InputBufferSize( nBlockSize, (ACMW_UINT32)FLAC__REFERENCE_CODEC_MAX_BITS_PER_SAMPLE,
+											(ACMW_UINT32)pStaticStructure->nInputChannel );
+	} /* end if */
+	return (ACMW_UINT32)sizeof(flacd_FrameCacheEntry) + FRAMECACHE_ALIGN( nFrameSize ) +
+		   ( nBlockSize * pLayout->nChannels * (ACMW_UINT32)sizeof(ACMW_INT32) );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_FrameCacheAttach
+*
+* ARGUMENT
+*		flacd_FrameCacheHeader*	const pCache
+*		const ACMW_UINT32		nCacheSize
+*		const ACMW_UINT32		nSlotSize
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Use the cache already in the memory when it has the same slots,
+* 		else set up an empty cache
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_FrameCacheAttach( flacd_FrameCacheHeader*	const pCache,
+							 const ACMW_UINT32			nCacheSize,
+							 const ACMW_UINT32			nSlotSize )
+{
+	const ACMW_UINT32 nSlots = ( nCacheSize - (ACMW_UINT32)sizeof(flacd_FrameCacheHeader) ) / nSlotSize;
+	ACMW_UINT32 i;
+
+	if ( ( pCache->nMagic == FLACD_FRAMECACHE_MAGIC ) && ( pCache->nSlotSize == nSlotSize ) && ( pCache->nSlots == nSlots ) ) {
+		return;
+	} /* end if */
+
+	flacd_MemSet( pCache, 0, (ACMW_INT32)sizeof(flacd_FrameCacheHeader) );
+	pCache->nMagic = FLACD_FRAMECACHE_MAGIC;
+	pCache->nSlotSize = nSlotSize;
+	pCache->nSlots = nSlots;
+	for ( i = 0; i < nSlots; i++ ) {
+		get_slot( pCache, i )->nTick = (ACMW_UINT32)0U;
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_FrameCacheLookup
+*
+* ARGUMENT
+*		const flacd_StaticArea*	const pStaticStructure
+*		const ACMW_UINT8*		const pFrame
+*		const ACMW_UINT32		nAvailSize
+*
+* RETURN VALUE
+* 		const flacd_FrameCacheEntry*	Entry of the frame (NULL : miss)
+*
+* OVERVIEW
+* 		Find the frame starting at pFrame in the cache. The CRC-16 in the
+* 		footer each entry would have in the input is compared first, so
+* 		that the frame bytes kept in the entry are only compared for the
+* 		likely entries. Counts the hit or miss and marks the entry as used.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+const flacd_FrameCacheEntry* flacd_FrameCacheLookup( const flacd_StaticArea*	const pStaticStructure,
+													 const ACMW_UINT8*			const pFrame,
+													 const ACMW_UINT32			nAvailSize )
+{
+	flacd_FrameCacheHeader* const pCache = (flacd_FrameCacheHeader*)pStaticStructure->pFrameCache;
+	const FLAC__StreamDecoderPrivate* const pPrivate = &(pStaticStructure->pStreamDecoderPrivate);
+	flacd_FrameCacheEntry* pEntry;
+	flacd_FrameCacheEntry* pFound = NULL;
+	ACMW_UINT32 i, nConstants, nMask;
+
+	for ( i = 0; ( i < pCache->nSlots ) && ( pFound == NULL ); i++ ) {
+		pEntry = get_slot( pCache, i );
+		if ( ( pEntry->nTick == (ACMW_UINT32)0U ) || ( pEntry->nFrameSize > nAvailSize ) ||
+			 ( flacd_MetaReadBE( &pFrame[pEntry->nFrameSize - FRAMECACHE_FOOTER_SIZE], FRAMECACHE_FOOTER_SIZE ) != (ACMW_UINT32)pEntry->nCrc16 ) ) {
+			continue;
+		} /* end if */
+		/* decoded with the same channels, and fits the scratch rows of the instance */
+		nConstants = (ACMW_UINT32)0U;
+		for ( nMask = pEntry->nConstantMask; nMask != (ACMW_UINT32)0U; nMask &= nMask - (ACMW_UINT32)1U ) {
+			nConstants++;
+		} /* end for */
+		if ( ( pEntry->nDecodeMask != pPrivate->channel_mask ) || ( (ACMW_UINT32)pEntry->nDecodeChannels != pPrivate->supported_output_channels ) ||
+			 ( pEntry->nBlockSize > pStaticStructure->sScratchLayout.nBlockSize ) || ( nConstants > pStaticStructure->sScratchLayout.nChannels ) ) {
+			continue;
+		} /* end if */
+		if ( same_frame( pEntry, pFrame ) == (ACMW_BOOL)1 ) {
+			pFound = pEntry;
+		} /* end if */
+	} /* end for */
+
+	if ( pFound != NULL ) {
+		pFound->nTick = next_tick( pCache );
+		pCache->nHits++;
+	} else {
+		pCache->nMisses++;
+	} /* end if */
+	return pFound;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_FrameCacheRow
+*
+* ARGUMENT
+*		const flacd_FrameCacheEntry*	const pEntry
+*		const ACMW_UINT32				nRow
+*
+* RETURN VALUE
+* 		const ACMW_INT32*		Samples of the row
+*
+* OVERVIEW
+* 		Get the nRow-th row of samples stored in an entry, after the
+* 		frame bytes
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+const ACMW_INT32* flacd_FrameCacheRow( const flacd_FrameCacheEntry*	const pEntry,
+									   const ACMW_UINT32				nRow )
+{
+	return (const ACMW_INT32*)( (const ACMW_UINT8*)pEntry + sizeof(flacd_FrameCacheEntry) + FRAMECACHE_ALIGN( pEntry->nFrameSize ) ) +
+		   ( nRow * pEntry->nBlockSize );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_FrameCacheStore
+*
+* ARGUMENT
+*		const flacd_StaticArea*	const pStaticStructure
+*		FLAC__int32* const *	pSrcBuff
+*		const ACMW_UINT32		nBlockSize
+*		const ACMW_UINT8*		const pFrame
+*		const ACMW_UINT32		nFrameSize
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Store the pending frame, all of it finished, in an empty slot or in
+* 		place of the least recently used entry. pFrame is the compressed
+* 		frame it was decoded from, kept with it. Constant channels are kept
+* 		as their value, channels that are not decoded are not kept. A
+* 		frame larger than a slot is not stored.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_FrameCacheStore( const flacd_StaticArea*	const pStaticStructure,
+							FLAC__int32*			const * const pSrcBuff,
+							const ACMW_UINT32		nBlockSize,
+							const ACMW_UINT8*		const pFrame,
+							const ACMW_UINT32		nFrameSize )
+{
+	flacd_FrameCacheHeader* const pCache = (flacd_FrameCacheHeader*)pStaticStructure->pFrameCache;
+	const flacd_PendingOutput* const pPending = &(pStaticStructure->sPending);
+	const FLAC__StreamDecoderPrivate* const pPrivate = &(pStaticStructure->pStreamDecoderPrivate);
+	flacd_FrameCacheEntry* pEntry = NULL;
+	flacd_FrameCacheEntry* pSlot;
+	ACMW_INT32* pRow;
+	ACMW_UINT32 i, nRows;
+
+	nRows = (ACMW_UINT32)0U;
+	for ( i = 0; i < (ACMW_UINT32)pPending->nFrameChannels; i++ ) {
+		if ( ( pSrcBuff[i] != NULL ) && ( ( ( pPending->nConstantMask >> i ) & (ACMW_UINT32)1U ) == (ACMW_UINT32)0U ) ) {
+			nRows++;
+		} /* end if */
+	} /* end for */
+	if ( ( (ACMW_UINT32)sizeof(flacd_FrameCacheEntry) + FRAMECACHE_ALIGN( nFrameSize ) + ( nRows * nBlockSize * (ACMW_UINT32)sizeof(ACMW_INT32) ) ) >
+		 pCache->nSlotSize ) {
+		return;
+	} /* end if */
+
+	/* an empty slot, else the least recently used one */
+	for ( i = 0; i < pCache->nSlots; i++ ) {
+		pSlot = get_slot( pCache, i );
+		if ( ( pEntry == NULL ) || ( pSlot->nTick < pEntry->nTick ) ) {
+			pEntry = pSlot;
+		} /* end if */
+		if ( pSlot->nTick == (ACMW_UINT32)0U ) {
+			break;
+		} /* end if */
+	} /* end for */
+	if ( pEntry == NULL ) {
+		return;
+	} /* end if */
+
+	if ( pEntry->nTick == (ACMW_UINT32)0U ) {
+		pCache->nEntries++;
+	} else {
+		pCache->nEvictions++;
+	} /* end if */
+
+	pEntry->nTick = next_tick( pCache );
+	pEntry->nFrameSize = nFrameSize;
+	pEntry->nCrc16 = (ACMW_UINT16)flacd_MetaReadBE( &pFrame[nFrameSize - FRAMECACHE_FOOTER_SIZE], FRAMECACHE_FOOTER_SIZE );
+	pEntry->nChannels = pPending->nFrameChannels;
+	pEntry->nBitsPerSample = pPending->nBitsPerSample;
+	pEntry->nDecodeChannels = (ACMW_UINT16)pPrivate->supported_output_channels;
+	pEntry->nDecodeMask = pPrivate->channel_mask;
+	pEntry->nFirstSample = pPending->nFirstSample;
+	pEntry->nBlockSize = nBlockSize;
+	pEntry->nSampleRate = pPending->nSampleRate;
+	pEntry->nRowMask = (ACMW_UINT32)0U;
+	pEntry->nConstantMask = pPending->nConstantMask;
+	flacd_MemCpy( (ACMW_UINT8*)pEntry + sizeof(flacd_FrameCacheEntry), pFrame, (ACMW_INT32)nFrameSize );
+
+	nRows = (ACMW_UINT32)0U;
+	for ( i = 0; i < FLAC__MAX_CHANNELS; i++ ) {
+		pEntry->nConstant[i] = pPending->nConstant[i];
+		if ( ( i >= (ACMW_UINT32)pPending->nFrameChannels ) || ( pSrcBuff[i] == NULL ) ||
+			 ( ( ( pPending->nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) ) {
+			continue;
+		} /* end if */
+		pRow = (ACMW_INT32*)flacd_FrameCacheRow( pEntry, nRows );
+		flacd_MemCpy( pRow, pSrcBuff[i], (ACMW_INT32)( pEntry->nBlockSize * (ACMW_UINT32)sizeof(ACMW_INT32) ) );
+		pEntry->nRowMask |= (ACMW_UINT32)1U << i;
+		nRows++;
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		get_slot
+*
+* ARGUMENT
+*		flacd_FrameCacheHeader*	const pCache
+*		const ACMW_UINT32		nSlot
+*
+* RETURN VALUE
+* 		flacd_FrameCacheEntry*	Entry at the head of the slot
+*
+* OVERVIEW
+* 		Get a slot of the cache
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static flacd_FrameCacheEntry* get_slot( flacd_FrameCacheHeader* const pCache, const ACMW_UINT32 nSlot )
+{
+	return (flacd_FrameCacheEntry*)( (ACMW_UINT8*)pCache + sizeof(flacd_FrameCacheHeader) + ( nSlot * pCache->nSlotSize ) );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		next_tick
+*
+* ARGUMENT
+*		flacd_FrameCacheHeader*	const pCache
+*
+* RETURN VALUE
+* 		ACMW_UINT32				Tick of a use
+*
+* OVERVIEW
+* 		Count a use of the cache. 0 is kept for empty slots.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_UINT32 next_tick( flacd_FrameCacheHeader* const pCache )
+{
+	pCache->nTick++;
+	if ( pCache->nTick == (ACMW_UINT32)0U ) {
+		pCache->nTick++;
+	} /* end if */
+	return pCache->nTick;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		same_frame
+*
+* ARGUMENT
+*		const flacd_FrameCacheEntry*	const pEntry
+*		const ACMW_UINT8*				const pFrame
+*
+* RETURN VALUE
+* 		ACMW_BOOL				1 : the same bytes, 0 : not
+*
+* OVERVIEW
+* 		Compare the frame bytes kept in an entry with the input
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_BOOL same_frame( const flacd_FrameCacheEntry* const pEntry, const ACMW_UINT8* const pFrame )
+{
+	const ACMW_UINT8* const pKept = (const ACMW_UINT8*)pEntry + sizeof(flacd_FrameCacheEntry);
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < pEntry->nFrameSize; i++ ) {
+		if ( pKept[i] != pFrame[i] ) {
+			return (ACMW_BOOL)0;
+		} /* end if */
+	} /* end for */
+	return (ACMW_BOOL)1;
+}
+/*------------------------------------------------------------------------------*/
+/*==========================================================================*/
+/* End of File                                                              */
+/*==========================================================================*/
@@ -0,0 +1,202 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_memory.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Work memory layout
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_api.h"
+#include "flacd_memory.h"
+
+#define MEMORY_CHANNEL_ALIGN	((ACMW_UINT32)16U)		/* keeps every channel aligned for vector access */
+#define MEMORY_ALIGN(size)		( ( (size) + ( MEMORY_CHANNEL_ALIGN - (ACMW_UINT32)1U ) ) & ~( MEMORY_CHANNEL_ALIGN - (ACMW_UINT32)1U ) )
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_SetScratchLayout
+*
+* ARGUMENT
+* 		flacd_ScratchLayout*	const pLayout
+*		const ACMW_UINT32		nMaxBlockSize
+*		const ACMW_UINT32		nChannels
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Lay out the scratch memory for the stream budget
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_SetScratchLayout( flacd_ScratchLayout*	const pLayout,
+							 const ACMW_UINT32		nMaxBlockSize,
+							 const ACMW_UINT32		nChannels )
+{
+	pLayout->nBlockSize = nMaxBlockSize;
+	pLayout->nChannels = nChannels;
+	pLayout->nChannelStride = MEMORY_ALIGN( nMaxBlockSize * (ACMW_UINT32)sizeof(ACMW_INT32) );
+	pLayout->nFrameOffset = pLayout->nChannelStride * nChannels;
+	pLayout->nScratchSize = pLayout->nFrameOffset + MEMORY_ALIGN( (ACMW_UINT32)sizeof(FLAC__Frame) );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_ScratchFrame
+*
+* ARGUMENT
+* 		const flacd_ScratchLayout*	const pLayout
+*		void*					const pScratch
+*
+* RETURN VALUE
+* 		void*					Frame being decoded (FLAC__Frame)
+*
+* OVERVIEW
+* 		Get the frame area in the scratch memory
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void* flacd_ScratchFrame( const flacd_ScratchLayout*	const pLayout,
+						  void*						const pScratch )
+{
+	return (ACMW_UINT8*)pScratch + pLayout->nFrameOffset;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_ScratchChannel
+*
+* ARGUMENT
+* 		const flacd_ScratchLayout*	const pLayout
+*		void*					const pScratch
+*		const ACMW_UINT32		nChannel
+*
+* RETURN VALUE
+* 		ACMW_INT32*				Sample array of the channel (NULL : out of the layout)
+*
+* OVERVIEW
+* 		Get the sample array of a channel in the scratch memory
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_INT32* flacd_ScratchChannel( const flacd_ScratchLayout*	const pLayout,
+								  void*						const pScratch,
+								  const ACMW_UINT32			nChannel )
+{
+	ACMW_INT32* pChannel = NULL;
+
+	if ( nChannel < pLayout->nChannels ) {
+		pChannel = (ACMW_INT32*)((ACMW_UINT8*)pScratch + ( pLayout->nChannelStride * nChannel ));
+	} /* end if */
+	return pChannel;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_SlabSlotSize
+*
+* ARGUMENT
+* 		void
+*
+* RETURN VALUE
+* 		ACMW_UINT32				Slot size in bytes
+*
+* OVERVIEW
+* 		Get the size of a slab slot (static memory and trailer, cache line aligned)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_SlabSlotSize( void )
+{
+	return ( (ACMW_UINT32)sizeof(flacd_StaticArea) + (ACMW_UINT32)sizeof(flacd_SlabSlot) + ( FLACD_SLAB_SLOT_ALIGN - (ACMW_UINT32)1U ) ) &
+		   ~( FLACD_SLAB_SLOT_ALIGN - (ACMW_UINT32)1U );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_SlabGetSlot
+*
+* ARGUMENT
+* 		const flacd_slabPoolInfo*	const pSlabPoolInfo
+*		const ACMW_UINT32		nIndex
+*
+* RETURN VALUE
+* 		flacd_SlabSlot*			Trailer of the slot (NULL : out of the pool)
+*
+* OVERVIEW
+* 		Get the trailer of a slot from its index (slab << FLACD_SLAB_SLOT_BITS | slot).
+* 		The static memory of the slot starts sizeof(flacd_StaticArea) bytes before.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+flacd_SlabSlot* flacd_SlabGetSlot( const flacd_slabPoolInfo*	const pSlabPoolInfo,
+								   const ACMW_UINT32			nIndex )
+{
+	const ACMW_UINT32 nSlab = nIndex >> FLACD_SLAB_SLOT_BITS;
+	const ACMW_UINT32 nSlot = nIndex & ( FLACD_SLAB_MAX_SLOTS - (ACMW_UINT32)1U );
+	flacd_SlabSlot* pSlot = NULL;
+
+	if ( ( nSlab < pSlabPoolInfo->nSlabs ) && ( nSlot < pSlabPoolInfo->nSlabSlots[nSlab] ) ) {
+		pSlot = (flacd_SlabSlot*)( pSlabPoolInfo->pSlab[nSlab] + ( pSlabPoolInfo->nSlotSize * nSlot ) + sizeof(flacd_StaticArea) );
+	} /* end if */
+	return pSlot;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_InputBufferSize
+*
+* ARGUMENT
+*		const ACMW_UINT32		nMaxBlockSize
+*		const ACMW_UINT32		nBitsPerSample
+*		const ACMW_UINT32		nChannels
+*
+* RETURN VALUE
+* 		ACMW_UINT32				Input buffer size in bytes
+*
+* OVERVIEW
+* 		Get the input buffer size that holds the largest frame of the stream
+* 		(verbatim subframes, one extra bit per sample for a side channel)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_InputBufferSize( const ACMW_UINT32	nMaxBlockSize,
+								   const ACMW_UINT32	nBitsPerSample,
+								   const ACMW_UINT32	nChannels )
+{
+	return ( ( ( nMaxBlockSize * ( nBitsPerSample + (ACMW_UINT32)1U ) * nChannels ) + (ACMW_UINT32)7U ) >> 3 ) + FLACD_INBUFF_HEADER_SIZE;
+}
+/*------------------------------------------------------------------------------*/
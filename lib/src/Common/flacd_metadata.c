@@ -0,0 +1,326 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_metadata.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Metadata parsing
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_api.h"
+#include "flacd_metadata.h"
+#include "private/crc.h"
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaReadBE
+*
+* ARGUMENT
+* 		const ACMW_UINT8*	const pData
+*		const ACMW_UINT32	nBytes
+*
+* RETURN VALUE
+* 		ACMW_UINT32			Value
+*
+* OVERVIEW
+* 		Read a big-endian value of 1 to 4 bytes
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_MetaReadBE( const ACMW_UINT8*	const pData,
+							  const ACMW_UINT32	nBytes )
+{
+	ACMW_UINT32 nValue = (ACMW_UINT32)0U;
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < nBytes; i++ ) {
+		nValue = ( nValue << 8 ) | (ACMW_UINT32)pData[i];
+	} /* end for */
+	return nValue;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaWriteBE
+*
+* ARGUMENT
+* 		ACMW_UINT8*			const pData
+*		const ACMW_UINT32	nValue
+*		const ACMW_UINT32	nBytes
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Write a big-endian value of 1 to 4 bytes
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_MetaWriteBE( ACMW_UINT8*			const pData,
+						const ACMW_UINT32	nValue,
+						const ACMW_UINT32	nBytes )
+{
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < nBytes; i++ ) {
+		pData[i] = (ACMW_UINT8)( nValue >> ( ( nBytes - (ACMW_UINT32)1U - i ) << 3 ) );
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaCrc16
+*
+* ARGUMENT
+* 		const ACMW_UINT8*	const pData
+*		const ACMW_UINT32	nSize
+*		const ACMW_UINT32	nCrc
+*
+* RETURN VALUE
+* 		ACMW_UINT32			CRC-16
+*
+* OVERVIEW
+* 		Continue the CRC-16 (FLAC frame polynomial) nCrc over nSize bytes
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_MetaCrc16( const ACMW_UINT8*	const pData,
+							 const ACMW_UINT32	nSize,
+							 const ACMW_UINT32	nCrc )
+{
+	ACMW_UINT32 nValue = nCrc;
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < nSize; i++ ) {
+		nValue = FLAC__CRC16_UPDATE( pData[i], nValue );
+	} /* end for */
+	return nValue;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaParseStreamInfo
+*
+* ARGUMENT
+* 		const ACMW_UINT8*			const pData
+*		flacd_headerStatusInfo*		const pHeaderStatusInfo
+*
+* RETURN VALUE
+* 		ACMW_BOOL					1 : valid / 0 : invalid
+*
+* OVERVIEW
+* 		Read the STREAMINFO block body (FLACD_META_STREAMINFO_SIZE bytes)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_MetaParseStreamInfo( const ACMW_UINT8*			const pData,
+									 flacd_headerStatusInfo*	const pHeaderStatusInfo )
+{
+	flacd_decConfigInfo * const pDecConfig = &pHeaderStatusInfo->sDecConfig;
+	ACMW_UINT32 nPacked;
+	ACMW_UINT32 i;
+
+	/* min/max blocksize(16/16) min/max framesize(24/24) */
+	pDecConfig->nMinBlockSize = (ACMW_UINT16)flacd_MetaReadBE( &pData[0], 2 );
+	pDecConfig->nMaxBlockSize = (ACMW_UINT16)flacd_MetaReadBE( &pData[2], 2 );
+	pDecConfig->nMinFrameSize = flacd_MetaReadBE( &pData[4], 3 );
+	pDecConfig->nMaxFrameSize = flacd_MetaReadBE( &pData[7], 3 );
+
+	/* sample rate(20) channels-1(3) bps-1(5) total samples(36) */
+	nPacked = flacd_MetaReadBE( &pData[10], 4 );
+	pDecConfig->nSampleRate = nPacked >> 12;
+	pDecConfig->nChannels = (ACMW_UINT16)( ( ( nPacked >> 9 ) & (ACMW_UINT32)0x7U ) + (ACMW_UINT32)1U );
+	pDecConfig->nBitsPerSample = (ACMW_UINT16)( ( ( nPacked >> 4 ) & (ACMW_UINT32)0x1FU ) + (ACMW_UINT32)1U );
+	pHeaderStatusInfo->nTotalSamples = flacd_MetaReadBE( &pData[14], 4 );
+
+	/* MD5 signature(128) */
+	for ( i = 0; i < (ACMW_UINT32)16U; i++ ) {
+		pHeaderStatusInfo->nMD5Signature[i] = pData[18U + i];
+	} /* end for */
+
+	/* sample positions are 32 bit : 2^32 samples or more are not supported */
+	return (ACMW_BOOL)( ( ( nPacked & (ACMW_UINT32)0xFU ) == (ACMW_UINT32)0U ) &&
+						( pDecConfig->nMinBlockSize >= (ACMW_UINT16)FLAC__MIN_BLOCK_SIZE ) &&
+						( pDecConfig->nMaxBlockSize >= pDecConfig->nMinBlockSize ) &&
+						( pDecConfig->nSampleRate != (ACMW_UINT32)0U ) &&
+						( pDecConfig->nBitsPerSample >= (ACMW_UINT16)FLAC__MIN_BITS_PER_SAMPLE ) );
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaFindSeekPoint
+*
+* ARGUMENT
+* 		const ACMW_UINT8*	const pSeekTable
+*		const ACMW_UINT32	nSeekPoints
+*		const ACMW_UINT32	nTargetSample
+*		ACMW_UINT32*		const pSample
+*		ACMW_UINT32*		const pOffset
+*
+* RETURN VALUE
+* 		ACMW_BOOL			1 : found / 0 : no point at or before nTargetSample
+*
+* OVERVIEW
+* 		Binary search the SEEKTABLE points for the last one at or before
+* 		nTargetSample. The points are in ascending order with the
+* 		placeholders last; points beyond 32 bits compare as later.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_MetaFindSeekPoint( const ACMW_UINT8*	const pSeekTable,
+								   const ACMW_UINT32	nSeekPoints,
+								   const ACMW_UINT32	nTargetSample,
+								   ACMW_UINT32*			const pSample,
+								   ACMW_UINT32*			const pOffset )
+{
+	const ACMW_UINT8 *pPoint;
+	ACMW_UINT32 nLow, nHigh, nMid;
+	ACMW_BOOL bFound = (ACMW_BOOL)0;
+
+	/* sample number(64) stream offset(64) frame samples(16) */
+	nLow = 0;
+	nHigh = nSeekPoints;
+	while ( nLow < nHigh ) {
+		nMid = nLow + ( ( nHigh - nLow ) >> 1 );
+		pPoint = &pSeekTable[nMid * FLACD_META_SEEKPOINT_SIZE];
+		if ( ( flacd_MetaReadBE( &pPoint[0], 4 ) != (ACMW_UINT32)0U ) || ( flacd_MetaReadBE( &pPoint[4], 4 ) > nTargetSample ) ||
+			 ( flacd_MetaReadBE( &pPoint[8], 4 ) != (ACMW_UINT32)0U ) ) {
+			nHigh = nMid;
+		} else {
+			*pSample = flacd_MetaReadBE( &pPoint[4], 4 );
+			*pOffset = flacd_MetaReadBE( &pPoint[12], 4 );
+			bFound = (ACMW_BOOL)1;
+			nLow = nMid + (ACMW_UINT32)1U;
+		} /* end if */
+	} /* end while */
+	return bFound;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaFindIndexEntry
+*
+* ARGUMENT
+* 		const ACMW_UINT8*	const pEntries
+*		const ACMW_UINT32	nEntries
+*		const ACMW_UINT32	nTargetSample
+*		ACMW_UINT32*		const pSample
+*		ACMW_UINT32*		const pOffset
+*
+* RETURN VALUE
+* 		ACMW_BOOL			1 : found / 0 : no entry at or before nTargetSample
+*
+* OVERVIEW
+* 		Binary search the frame index entries for the last one at or
+* 		before nTargetSample
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_MetaFindIndexEntry( const ACMW_UINT8*	const pEntries,
+									const ACMW_UINT32	nEntries,
+									const ACMW_UINT32	nTargetSample,
+									ACMW_UINT32*		const pSample,
+									ACMW_UINT32*		const pOffset )
+{
+	const ACMW_UINT8 *pEntry;
+	ACMW_UINT32 nLow, nHigh, nMid;
+	ACMW_BOOL bFound = (ACMW_BOOL)0;
+
+	nLow = 0;
+	nHigh = nEntries;
+	while ( nLow < nHigh ) {
+		nMid = nLow + ( ( nHigh - nLow ) >> 1 );
+		pEntry = &pEntries[nMid * (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE];
+		if ( flacd_MetaReadBE( &pEntry[0], 4 ) > nTargetSample ) {
+			nHigh = nMid;
+		} else {
+			*pSample = flacd_MetaReadBE( &pEntry[0], 4 );
+			*pOffset = flacd_MetaReadBE( &pEntry[4], 4 );
+			bFound = (ACMW_BOOL)1;
+			nLow = nMid + (ACMW_UINT32)1U;
+		} /* end if */
+	} /* end while */
+	return bFound;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_MetaFindIndexEnd
+*
+* ARGUMENT
+* 		const ACMW_UINT8*	const pEntries
+*		const ACMW_UINT32	nEntries
+*		const ACMW_UINT32	nEndSample
+*		ACMW_UINT32*		const pOffset
+*
+* RETURN VALUE
+* 		ACMW_BOOL			1 : found / 0 : no entry at or after nEndSample
+*
+* OVERVIEW
+* 		Binary search the frame index entries for the first one at or
+* 		after nEndSample, where the samples before nEndSample are over
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_BOOL flacd_MetaFindIndexEnd( const ACMW_UINT8*	const pEntries,
+								  const ACMW_UINT32	nEntries,
+								  const ACMW_UINT32	nEndSample,
+								  ACMW_UINT32*		const pOffset )
+{
+	const ACMW_UINT8 *pEntry;
+	ACMW_UINT32 nLow, nHigh, nMid;
+	ACMW_BOOL bFound = (ACMW_BOOL)0;
+
+	nLow = 0;
+	nHigh = nEntries;
+	while ( nLow < nHigh ) {
+		nMid = nLow + ( ( nHigh - nLow ) >> 1 );
+		pEntry = &pEntries[nMid * (ACMW_UINT32)FLACD_INDEX_ENTRY_SIZE];
+		if ( flacd_MetaReadBE( &pEntry[0], 4 ) < nEndSample ) {
+			nLow = nMid + (ACMW_UINT32)1U;
+		} else {
+			*pOffset = flacd_MetaReadBE( &pEntry[4], 4 );
+			bFound = (ACMW_BOOL)1;
+			nHigh = nMid;
+		} /* end if */
+	} /* end while */
+	return bFound;
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,847 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_output.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Output conversion (PCM16 / PCM24 / FLOAT32)
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_output.h"
+
+/* The NEON paths serve planar output (nStride == 1) only. Interleaved output,
+   PCM or FLOAT32, stored or accumulated, takes the scalar loops. */
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FLACD_OUTPUT_NEON
+#endif
+
+#define OUTPUT_PROCESS_UNIT			((ACMW_UINT32)4U)
+#define OUTPUT_PCM16_MAX			((ACMW_FLOAT32)32767.0f)
+#define OUTPUT_PCM16_MIN			((ACMW_FLOAT32)-32768.0f)
+#define OUTPUT_PCM32_MAX			((ACMW_FLOAT32)2147483520.0f)	/* largest float below 2^31 */
+#define OUTPUT_PCM32_MIN			((ACMW_FLOAT32)-2147483648.0f)
+#define OUTPUT_INT16_MAX			((ACMW_INT32)32767)
+#define OUTPUT_INT16_MIN			((ACMW_INT32)-32768)
+#define OUTPUT_INT32_MAX			((ACMW_INT32)0x7FFFFFFF)
+#define OUTPUT_INT32_MIN			((ACMW_INT32)(-0x7FFFFFFF - 1))
+
+static void output16pcm( ACMW_INT16*		const pDstBuff,
+						 const ACMW_UINT32	nStride,
+						 const ACMW_INT32*	const pSrcBuff,
+						 const ACMW_UINT32	block_length,
+						 const ACMW_INT32	nShiftBits );
+static void output24pcm( ACMW_INT32*		const pDstBuff,
+						 const ACMW_UINT32	nStride,
+						 const ACMW_INT32*	const pSrcBuff,
+						 const ACMW_UINT32	block_length,
+						 const ACMW_INT32	nShiftBits );
+static void outputf32( ACMW_FLOAT32*		const pDstBuff,
+					   const ACMW_UINT32	nStride,
+					   const ACMW_INT32*	const pSrcBuff,
+					   const ACMW_UINT32	block_length,
+					   const ACMW_FLOAT32	fScale );
+static void mix_store( const flacd_OutputFormat*	const pFormat,
+					   void*				const pDstBuff,
+					   const ACMW_UINT32	nStride,
+					   const ACMW_FLOAT32*	const pMixBuff,
+					   const ACMW_UINT32	block_length );
+static void accumulate_samples( const flacd_OutputFormat*	const pFormat,
+								void*				const pDstBuff,
+								const ACMW_UINT32	nStride,
+								const ACMW_INT32*	const pSrcBuff,
+								const ACMW_UINT32	block_length );
+static void accumulate_value( const flacd_OutputFormat*	const pFormat,
+							  void*					const pDstBuff,
+							  const ACMW_UINT32		nStride,
+							  const ACMW_INT32		nValue,
+							  const ACMW_UINT32		block_length );
+static ACMW_INT32 add_saturate( const ACMW_INT32 nAcc, const ACMW_INT32 nAdd, const ACMW_INT32 nMax, const ACMW_INT32 nMin );
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputSetFormat
+*
+* ARGUMENT
+* 		flacd_OutputFormat*	const pFormat
+*		const ACMW_UINT16	nFormat
+*		const ACMW_UINT32	nBitsPerSample
+*		const ACMW_FLOAT32	fGain
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Set conversion parameter for the bits per sample of the current frame
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OutputSetFormat( flacd_OutputFormat*	const pFormat,
+							const ACMW_UINT16	nFormat,
+							const ACMW_UINT32	nBitsPerSample,
+							const ACMW_FLOAT32	fGain )
+{
+	pFormat->nFormat = nFormat;
+	pFormat->nShiftBits = 0;
+	pFormat->fScale = (ACMW_FLOAT32)0.0f;
+	pFormat->bAccumulate = (ACMW_BOOL)0;
+	if ( nFormat == FLACD_OUTFMT_PCM16 ) {
+		pFormat->nShiftBits = (ACMW_INT32)16 - (ACMW_INT32)nBitsPerSample;
+		if ( pFormat->nShiftBits >= (ACMW_INT32)0 ) {
+			pFormat->fScale = (ACMW_FLOAT32)((ACMW_UINT32)1U << pFormat->nShiftBits);
+		} else {
+			pFormat->fScale = (ACMW_FLOAT32)1.0f / (ACMW_FLOAT32)((ACMW_UINT32)1U << (-pFormat->nShiftBits));
+		} /* end if */
+	} else if ( nFormat == FLACD_OUTFMT_PCM24 ) {
+		pFormat->nShiftBits = (ACMW_INT32)32 - (ACMW_INT32)nBitsPerSample;
+		pFormat->fScale = (ACMW_FLOAT32)((ACMW_UINT32)1U << pFormat->nShiftBits);
+	} else {
+		/* full scale of nBitsPerSample maps to [-1.0, 1.0) */
+		pFormat->fScale = fGain / (ACMW_FLOAT32)((ACMW_UINT32)1U << (nBitsPerSample - (ACMW_UINT32)1U));
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputSetAccumulate
+*
+* ARGUMENT
+* 		flacd_OutputFormat*	const pFormat
+*		const ACMW_FLOAT32	fGain
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Add the output to what the output buffer holds, with the gain
+* 		fGain, instead of storing it. Call after flacd_OutputSetFormat.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OutputSetAccumulate( flacd_OutputFormat*	const pFormat,
+								const ACMW_FLOAT32	fGain )
+{
+	pFormat->bAccumulate = (ACMW_BOOL)1;
+	pFormat->fScale *= fGain;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputSampleSize
+*
+* ARGUMENT
+*		const ACMW_UINT16	nFormat
+*
+* RETURN VALUE
+* 		ACMW_UINT32			Bytes per output sample
+*
+* OVERVIEW
+* 		Get output sample size
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT32 flacd_OutputSampleSize( const ACMW_UINT16 nFormat )
+{
+	ACMW_UINT32 nSize;
+	if ( nFormat == FLACD_OUTFMT_PCM16 ) {
+		nSize = (ACMW_UINT32)sizeof(ACMW_INT16);
+	} else if ( nFormat == FLACD_OUTFMT_PCM24 ) {
+		nSize = (ACMW_UINT32)sizeof(ACMW_INT32);
+	} else {
+		nSize = (ACMW_UINT32)sizeof(ACMW_FLOAT32);
+	} /* end if */
+	return nSize;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputSamples
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32*	const pSrcBuff
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output one channel. nStride is the distance between samples in
+* 		output samples (1 : planar). pSrcBuff == NULL outputs silence,
+* 		which adds nothing when accumulating.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OutputSamples( const flacd_OutputFormat*	const pFormat,
+						  void*					const pDstBuff,
+						  const ACMW_UINT32		nStride,
+						  const ACMW_INT32*		const pSrcBuff,
+						  const ACMW_UINT32		block_length )
+{
+	if ( pFormat->bAccumulate == (ACMW_BOOL)1 ) {
+		if ( pSrcBuff != NULL ) {
+			accumulate_samples( pFormat, pDstBuff, nStride, pSrcBuff, block_length );
+		} /* end if */
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) {
+		output16pcm( (ACMW_INT16*)pDstBuff, nStride, pSrcBuff, block_length, pFormat->nShiftBits );
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM24 ) {
+		output24pcm( (ACMW_INT32*)pDstBuff, nStride, pSrcBuff, block_length, pFormat->nShiftBits );
+	} else {
+		outputf32( (ACMW_FLOAT32*)pDstBuff, nStride, pSrcBuff, block_length, pFormat->fScale );
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputConstant
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32	nValue
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output one channel whose samples all have the decoded value nValue.
+* 		The value is converted once and the output is filled with it.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OutputConstant( const flacd_OutputFormat*	const pFormat,
+						   void*				const pDstBuff,
+						   const ACMW_UINT32	nStride,
+						   const ACMW_INT32		nValue,
+						   const ACMW_UINT32	block_length )
+{
+	ACMW_UINT32	i = 0;
+	ACMW_UINT32	j;
+
+	if ( pFormat->bAccumulate == (ACMW_BOOL)1 ) {
+		accumulate_value( pFormat, pDstBuff, nStride, nValue, block_length );
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) {
+		ACMW_INT16* const pDst = (ACMW_INT16*)pDstBuff;
+		const ACMW_INT16 nOut = ( pFormat->nShiftBits >= (ACMW_INT32)0 ) ? (ACMW_INT16)( nValue << pFormat->nShiftBits ) : (ACMW_INT16)( nValue >> (-pFormat->nShiftBits) );
+		if ( nStride == (ACMW_UINT32)1U ) {
+#ifdef FLACD_OUTPUT_NEON
+			const int16x8_t vOut = vdupq_n_s16( nOut );
+			for ( ; ( i + (OUTPUT_PROCESS_UNIT * 2U) ) <= block_length ; i += (OUTPUT_PROCESS_UNIT * 2U) ) {
+				vst1q_s16( &pDst[i], vOut );
+			} /* end for */
+#endif
+		} /* end if */
+		for ( j = i * nStride; i < block_length ; i++, j += nStride ) {
+			pDst[j] = nOut;
+		} /* end for */
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM24 ) {
+		ACMW_INT32* const pDst = (ACMW_INT32*)pDstBuff;
+		const ACMW_INT32 nOut = (ACMW_INT32)( nValue << pFormat->nShiftBits );
+		if ( nStride == (ACMW_UINT32)1U ) {
+#ifdef FLACD_OUTPUT_NEON
+			const int32x4_t vOut = vdupq_n_s32( nOut );
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				vst1q_s32( &pDst[i], vOut );
+			} /* end for */
+#endif
+		} /* end if */
+		for ( j = i * nStride; i < block_length ; i++, j += nStride ) {
+			pDst[j] = nOut;
+		} /* end for */
+	} else {
+		ACMW_FLOAT32* const pDst = (ACMW_FLOAT32*)pDstBuff;
+		const ACMW_FLOAT32 fOut = (ACMW_FLOAT32)nValue * pFormat->fScale;
+		if ( nStride == (ACMW_UINT32)1U ) {
+#ifdef FLACD_OUTPUT_NEON
+			const float32x4_t vOut = vdupq_n_f32( fOut );
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				vst1q_f32( &pDst[i], vOut );
+			} /* end for */
+#endif
+		} /* end if */
+		for ( j = i * nStride; i < block_length ; i++, j += nStride ) {
+			pDst[j] = fOut;
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OutputMix
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		ACMW_INT32* const *	ppSrcBuff
+*		const ACMW_FLOAT32*	const pCoef
+*		const ACMW_UINT32	nSrcChannels
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output one channel as a weighted sum of the source channels
+* 		(one row of the mixing matrix). Works on tiles so that the
+* 		accumulator stays in L1, and saturates on PCM output.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OutputMix( const flacd_OutputFormat*	const pFormat,
+					  void*					const pDstBuff,
+					  const ACMW_UINT32		nStride,
+					  ACMW_INT32*			const * const ppSrcBuff,
+					  const ACMW_FLOAT32*	const pCoef,
+					  const ACMW_UINT32		nSrcChannels,
+					  const ACMW_UINT32		block_length )
+{
+	ACMW_FLOAT32	fMix[FLACD_OUTPUT_TILE_SIZE];
+	ACMW_UINT32		nPos, nLen, ch, i;
+	ACMW_UINT8*		const pDst = (ACMW_UINT8*)pDstBuff;
+	const ACMW_UINT32	nSampleSize = flacd_OutputSampleSize(pFormat->nFormat);
+
+	for ( nPos = 0; nPos < block_length; nPos += nLen ) {
+		nLen = block_length - nPos;
+		if ( nLen > FLACD_OUTPUT_TILE_SIZE ) {
+			nLen = FLACD_OUTPUT_TILE_SIZE;
+		} /* end if */
+		for ( i = 0; i < nLen; i++ ) {
+			fMix[i] = (ACMW_FLOAT32)0.0f;
+		} /* end for */
+		for ( ch = 0; ch < nSrcChannels; ch++ ) {
+			const ACMW_FLOAT32 fCoef = pCoef[ch] * pFormat->fScale;
+			const ACMW_INT32* const pSrc = ( ppSrcBuff[ch] != NULL ) ? &ppSrcBuff[ch][nPos] : NULL;
+			if ( ( fCoef == (ACMW_FLOAT32)0.0f ) || ( pSrc == NULL ) ) {
+				continue;
+			} /* end if */
+			i = 0;
+#ifdef FLACD_OUTPUT_NEON
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= nLen ; i += OUTPUT_PROCESS_UNIT ) {
+				vst1q_f32( &fMix[i], vmlaq_n_f32( vld1q_f32( &fMix[i] ), vcvtq_f32_s32( vld1q_s32( &pSrc[i] ) ), fCoef ) );
+			} /* end for */
+#endif
+			for ( ; i < nLen; i++ ) {
+				fMix[i] += (ACMW_FLOAT32)pSrc[i] * fCoef;
+			} /* end for */
+		} /* end for */
+		mix_store( pFormat, (void*)(pDst + (nPos * nStride * nSampleSize)), nStride, fMix, nLen );
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		mix_store
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_FLOAT32*	const pMixBuff
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Store a mixed tile in the output format with saturation, or add
+* 		it to the output when accumulating
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void mix_store( const flacd_OutputFormat*	const pFormat,
+					   void*				const pDstBuff,
+					   const ACMW_UINT32	nStride,
+					   const ACMW_FLOAT32*	const pMixBuff,
+					   const ACMW_UINT32	block_length )
+{
+	ACMW_UINT32		i = 0;
+	ACMW_UINT32		j = 0;
+	ACMW_FLOAT32	fMax, fMin, fVal;
+
+	if ( pFormat->nFormat == FLACD_OUTFMT_FLOAT32 ) {
+		ACMW_FLOAT32* const pDst = (ACMW_FLOAT32*)pDstBuff;
+		for ( ; i < block_length ; i++, j += nStride ) {
+			pDst[j] = ( pFormat->bAccumulate == (ACMW_BOOL)1 ) ? ( pDst[j] + pMixBuff[i] ) : pMixBuff[i];
+		} /* end for */
+		return;
+	} /* end if */
+
+	fMax = ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) ? OUTPUT_PCM16_MAX : OUTPUT_PCM32_MAX;
+	fMin = ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) ? OUTPUT_PCM16_MIN : OUTPUT_PCM32_MIN;
+	if ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) {
+		ACMW_INT16* const pDst = (ACMW_INT16*)pDstBuff;
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const float32x4_t vMax = vdupq_n_f32( fMax );
+			const float32x4_t vMin = vdupq_n_f32( fMin );
+			for ( ; ( i + (OUTPUT_PROCESS_UNIT * 2U) ) <= block_length ; i += (OUTPUT_PROCESS_UNIT * 2U) ) {
+				const int32x4_t vLo = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vld1q_f32( &pMixBuff[i] ), vMax ), vMin ) );
+				const int32x4_t vHi = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vld1q_f32( &pMixBuff[i + OUTPUT_PROCESS_UNIT] ), vMax ), vMin ) );
+				int16x8_t vOut = vcombine_s16( vmovn_s32( vLo ), vmovn_s32( vHi ) );
+				if ( pFormat->bAccumulate == (ACMW_BOOL)1 ) {
+					vOut = vqaddq_s16( vld1q_s16( &pDst[i] ), vOut );
+				} /* end if */
+				vst1q_s16( &pDst[i], vOut );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			fVal = ( pMixBuff[i] > fMax ) ? fMax : ( ( pMixBuff[i] < fMin ) ? fMin : pMixBuff[i] );
+			pDst[j] = ( pFormat->bAccumulate == (ACMW_BOOL)1 ) ? (ACMW_INT16)add_saturate( (ACMW_INT32)pDst[j], (ACMW_INT32)fVal, OUTPUT_INT16_MAX, OUTPUT_INT16_MIN ) : (ACMW_INT16)fVal;
+		} /* end for */
+	} else {
+		ACMW_INT32* const pDst = (ACMW_INT32*)pDstBuff;
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const float32x4_t vMax = vdupq_n_f32( fMax );
+			const float32x4_t vMin = vdupq_n_f32( fMin );
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				int32x4_t vOut = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vld1q_f32( &pMixBuff[i] ), vMax ), vMin ) );
+				if ( pFormat->bAccumulate == (ACMW_BOOL)1 ) {
+					vOut = vqaddq_s32( vld1q_s32( &pDst[i] ), vOut );
+				} /* end if */
+				vst1q_s32( &pDst[i], vOut );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			fVal = ( pMixBuff[i] > fMax ) ? fMax : ( ( pMixBuff[i] < fMin ) ? fMin : pMixBuff[i] );
+			pDst[j] = ( pFormat->bAccumulate == (ACMW_BOOL)1 ) ? add_saturate( pDst[j], (ACMW_INT32)fVal, OUTPUT_INT32_MAX, OUTPUT_INT32_MIN ) : (ACMW_INT32)fVal;
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		accumulate_samples
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32*	const pSrcBuff
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Add one channel to the output. Each sample is scaled with the gain
+* 		and converted as it is loaded, and added to the output sample in
+* 		place; PCM output saturates.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void accumulate_samples( const flacd_OutputFormat*	const pFormat,
+								void*				const pDstBuff,
+								const ACMW_UINT32	nStride,
+								const ACMW_INT32*	const pSrcBuff,
+								const ACMW_UINT32	block_length )
+{
+	ACMW_UINT32		i = 0;
+	ACMW_UINT32		j = 0;
+	ACMW_INT32		nSum;
+	ACMW_FLOAT32	fVal;
+	const ACMW_FLOAT32	fScale = pFormat->fScale;
+
+	if ( pFormat->nFormat == FLACD_OUTFMT_FLOAT32 ) {
+		ACMW_FLOAT32* const pDst = (ACMW_FLOAT32*)pDstBuff;
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				vst1q_f32( &pDst[i], vmlaq_n_f32( vld1q_f32( &pDst[i] ), vcvtq_f32_s32( vld1q_s32( &pSrcBuff[i] ) ), fScale ) );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			pDst[j] += (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+		} /* end for */
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) {
+		ACMW_INT16* const pDst = (ACMW_INT16*)pDstBuff;
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const float32x4_t vMax = vdupq_n_f32( OUTPUT_PCM16_MAX );
+			const float32x4_t vMin = vdupq_n_f32( OUTPUT_PCM16_MIN );
+			for ( ; ( i + (OUTPUT_PROCESS_UNIT * 2U) ) <= block_length ; i += (OUTPUT_PROCESS_UNIT * 2U) ) {
+				const int32x4_t vLo = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vmulq_n_f32( vcvtq_f32_s32( vld1q_s32( &pSrcBuff[i] ) ), fScale ), vMax ), vMin ) );
+				const int32x4_t vHi = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vmulq_n_f32( vcvtq_f32_s32( vld1q_s32( &pSrcBuff[i + OUTPUT_PROCESS_UNIT] ) ), fScale ), vMax ), vMin ) );
+				vst1q_s16( &pDst[i], vqaddq_s16( vld1q_s16( &pDst[i] ), vcombine_s16( vmovn_s32( vLo ), vmovn_s32( vHi ) ) ) );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			/* the sum of two 16 bit samples cannot overflow */
+			fVal = (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+			fVal = ( fVal > OUTPUT_PCM16_MAX ) ? OUTPUT_PCM16_MAX : ( ( fVal < OUTPUT_PCM16_MIN ) ? OUTPUT_PCM16_MIN : fVal );
+			nSum = (ACMW_INT32)pDst[j] + (ACMW_INT32)fVal;
+			pDst[j] = (ACMW_INT16)( ( nSum > OUTPUT_INT16_MAX ) ? OUTPUT_INT16_MAX : ( ( nSum < OUTPUT_INT16_MIN ) ? OUTPUT_INT16_MIN : nSum ) );
+		} /* end for */
+	} else {
+		ACMW_INT32* const pDst = (ACMW_INT32*)pDstBuff;
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const float32x4_t vMax = vdupq_n_f32( OUTPUT_PCM32_MAX );
+			const float32x4_t vMin = vdupq_n_f32( OUTPUT_PCM32_MIN );
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				const int32x4_t vAdd = vcvtq_s32_f32( vmaxq_f32( vminq_f32( vmulq_n_f32( vcvtq_f32_s32( vld1q_s32( &pSrcBuff[i] ) ), fScale ), vMax ), vMin ) );
+				vst1q_s32( &pDst[i], vqaddq_s32( vld1q_s32( &pDst[i] ), vAdd ) );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			fVal = (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+			fVal = ( fVal > OUTPUT_PCM32_MAX ) ? OUTPUT_PCM32_MAX : ( ( fVal < OUTPUT_PCM32_MIN ) ? OUTPUT_PCM32_MIN : fVal );
+			pDst[j] = add_saturate( pDst[j], (ACMW_INT32)fVal, OUTPUT_INT32_MAX, OUTPUT_INT32_MIN );
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		accumulate_value
+*
+* ARGUMENT
+*		const flacd_OutputFormat*	const pFormat
+* 		void*				const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32	nValue
+*		const ACMW_UINT32	block_length
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Add one channel whose samples all have the decoded value nValue
+* 		to the output. The value is converted once.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void accumulate_value( const flacd_OutputFormat*	const pFormat,
+							  void*					const pDstBuff,
+							  const ACMW_UINT32		nStride,
+							  const ACMW_INT32		nValue,
+							  const ACMW_UINT32		block_length )
+{
+	ACMW_UINT32		i = 0;
+	ACMW_UINT32		j = 0;
+	ACMW_FLOAT32	fVal = (ACMW_FLOAT32)nValue * pFormat->fScale;
+
+	if ( nValue == 0 ) {
+		return;
+	} /* end if */
+
+	if ( pFormat->nFormat == FLACD_OUTFMT_FLOAT32 ) {
+		ACMW_FLOAT32* const pDst = (ACMW_FLOAT32*)pDstBuff;
+		for ( ; i < block_length ; i++, j += nStride ) {
+			pDst[j] += fVal;
+		} /* end for */
+	} else if ( pFormat->nFormat == FLACD_OUTFMT_PCM16 ) {
+		ACMW_INT16* const pDst = (ACMW_INT16*)pDstBuff;
+		fVal = ( fVal > OUTPUT_PCM16_MAX ) ? OUTPUT_PCM16_MAX : ( ( fVal < OUTPUT_PCM16_MIN ) ? OUTPUT_PCM16_MIN : fVal );
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const int16x8_t vAdd = vdupq_n_s16( (ACMW_INT16)fVal );
+			for ( ; ( i + (OUTPUT_PROCESS_UNIT * 2U) ) <= block_length ; i += (OUTPUT_PROCESS_UNIT * 2U) ) {
+				vst1q_s16( &pDst[i], vqaddq_s16( vld1q_s16( &pDst[i] ), vAdd ) );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			pDst[j] = (ACMW_INT16)add_saturate( (ACMW_INT32)pDst[j], (ACMW_INT32)fVal, OUTPUT_INT16_MAX, OUTPUT_INT16_MIN );
+		} /* end for */
+	} else {
+		ACMW_INT32* const pDst = (ACMW_INT32*)pDstBuff;
+		fVal = ( fVal > OUTPUT_PCM32_MAX ) ? OUTPUT_PCM32_MAX : ( ( fVal < OUTPUT_PCM32_MIN ) ? OUTPUT_PCM32_MIN : fVal );
+#ifdef FLACD_OUTPUT_NEON
+		if ( nStride == (ACMW_UINT32)1U ) {
+			const int32x4_t vAdd = vdupq_n_s32( (ACMW_INT32)fVal );
+			for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+				vst1q_s32( &pDst[i], vqaddq_s32( vld1q_s32( &pDst[i] ), vAdd ) );
+			} /* end for */
+			j = i;
+		} /* end if */
+#endif
+		for ( ; i < block_length ; i++, j += nStride ) {
+			pDst[j] = add_saturate( pDst[j], (ACMW_INT32)fVal, OUTPUT_INT32_MAX, OUTPUT_INT32_MIN );
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		add_saturate
+*
+* ARGUMENT
+*		const ACMW_INT32	nAcc
+*		const ACMW_INT32	nAdd
+*		const ACMW_INT32	nMax
+*		const ACMW_INT32	nMin
+*
+* RETURN VALUE
+* 		ACMW_INT32			nAcc + nAdd limited to [nMin, nMax]
+*
+* OVERVIEW
+* 		Saturating addition of two output samples in [nMin, nMax]
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static ACMW_INT32 add_saturate( const ACMW_INT32 nAcc, const ACMW_INT32 nAdd, const ACMW_INT32 nMax, const ACMW_INT32 nMin )
+{
+	ACMW_INT32 nSum;
+
+	if ( ( nAdd > 0 ) && ( nAcc > ( nMax - nAdd ) ) ) {
+		nSum = nMax;
+	} else if ( ( nAdd < 0 ) && ( nAcc < ( nMin - nAdd ) ) ) {
+		nSum = nMin;
+	} else {
+		nSum = nAcc + nAdd;
+	} /* end if */
+	return nSum;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output16pcm
+*
+* ARGUMENT
+* 		ACMW_INT16*			const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32*	const pSrcBuff
+*		const ACMW_UINT32	block_length
+*		const int32_t		nShiftBits
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output PCM Data(16bit)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void output16pcm( ACMW_INT16*		const pDstBuff,
+						 const ACMW_UINT32	nStride,
+						 const ACMW_INT32*	const pSrcBuff,
+						 const ACMW_UINT32	block_length,
+						 const ACMW_INT32	nShiftBits
+						 )
+{
+	ACMW_UINT32	i = 0;
+	ACMW_UINT32	j;
+	if (pSrcBuff == NULL) {
+		for ( j = 0; i < block_length ; i++, j += nStride ) {
+		  pDstBuff[j] = 0;
+		} /* end for */
+	} else if ( nStride != (ACMW_UINT32)1U ) {
+		if ( nShiftBits >= (ACMW_INT32)0 ) {
+			for ( j = 0; i < block_length ; i++, j += nStride ) {
+				pDstBuff[j] = (ACMW_INT16)( pSrcBuff[i] << nShiftBits );
+			} /* end for */
+		} else {
+			for ( j = 0; i < block_length ; i++, j += nStride ) {
+				pDstBuff[j] = (ACMW_INT16)( pSrcBuff[i] >> (-nShiftBits) );
+			} /* end for */
+		} /* end if */
+	} else {
+#ifdef FLACD_OUTPUT_NEON
+		/* vshlq_s32 shifts right for negative counts */
+		const int32x4_t vShift = vdupq_n_s32( nShiftBits );
+		for ( ; ( i + (OUTPUT_PROCESS_UNIT * 2U) ) <= block_length ; i += (OUTPUT_PROCESS_UNIT * 2U) ) {
+			const int32x4_t vLo = vshlq_s32( vld1q_s32( &pSrcBuff[i] ), vShift );
+			const int32x4_t vHi = vshlq_s32( vld1q_s32( &pSrcBuff[i + OUTPUT_PROCESS_UNIT] ), vShift );
+			vst1q_s16( &pDstBuff[i], vcombine_s16( vmovn_s32( vLo ), vmovn_s32( vHi ) ) );
+		} /* end for */
+#endif
+		if ( nShiftBits > (ACMW_INT32)0 ) {
+			for ( ; i < block_length ; i++ ) {
+				pDstBuff[i] = (ACMW_INT16)( pSrcBuff[i] << nShiftBits );
+			} /* end for */
+		} else if (nShiftBits < (ACMW_INT32)0) {
+			for ( ; i < block_length ; i++ ) {
+				pDstBuff[i] = (ACMW_INT16)( pSrcBuff[i] >> (-nShiftBits) );
+			} /* end for */
+		} else {
+			for ( ; i < block_length ; i++ ) {
+				pDstBuff[i] = (ACMW_INT16)pSrcBuff[i];
+			} /* end for */
+		} /* end if */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		output24pcm
+*
+* ARGUMENT
+* 		ACMW_INT32*			const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32*	const pSrcBuff
+*		const ACMW_UINT32	block_length
+*		const int32_t		nShiftBits
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output PCM Data(24bit)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void output24pcm( ACMW_INT32*		const pDstBuff,
+						 const ACMW_UINT32	nStride,
+						 const ACMW_INT32*	const pSrcBuff,
+						 const ACMW_UINT32	block_length,
+						 const ACMW_INT32	nShiftBits
+						 )
+{
+	ACMW_UINT32	i = 0;
+	ACMW_UINT32	j;
+	if (pSrcBuff == NULL) {
+		for ( j = 0; i < block_length ; i++, j += nStride ) {
+		  pDstBuff[j] = 0;
+		} /* end for */
+	} else if ( nStride != (ACMW_UINT32)1U ) {
+		for ( j = 0; i < block_length ; i++, j += nStride ) {
+			pDstBuff[j] = (ACMW_INT32)( pSrcBuff[i] << nShiftBits );
+		} /* end for */
+	} else {
+#ifdef FLACD_OUTPUT_NEON
+		const int32x4_t vShift = vdupq_n_s32( nShiftBits );
+		for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+			vst1q_s32( &pDstBuff[i], vshlq_s32( vld1q_s32( &pSrcBuff[i] ), vShift ) );
+		} /* end for */
+#endif
+		for ( ; i < block_length ; i++ ) {
+			pDstBuff[i] = (ACMW_INT32)( pSrcBuff[i] << nShiftBits );
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		outputf32
+*
+* ARGUMENT
+* 		ACMW_FLOAT32*		const pDstBuff
+*		const ACMW_UINT32	nStride
+*		const ACMW_INT32*	const pSrcBuff
+*		const ACMW_UINT32	block_length
+*		const ACMW_FLOAT32	fScale
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Output float Data (normalization and gain in one multiply)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void outputf32( ACMW_FLOAT32*		const pDstBuff,
+					   const ACMW_UINT32	nStride,
+					   const ACMW_INT32*	const pSrcBuff,
+					   const ACMW_UINT32	block_length,
+					   const ACMW_FLOAT32	fScale
+					   )
+{
+	ACMW_UINT32	i = 0;
+	ACMW_UINT32	j;
+	if (pSrcBuff == NULL) {
+		for ( j = 0; i < block_length ; i++, j += nStride ) {
+		  pDstBuff[j] = (ACMW_FLOAT32)0.0f;
+		} /* end for */
+	} else if ( nStride != (ACMW_UINT32)1U ) {
+		for ( j = 0; i < block_length ; i++, j += nStride ) {
+			pDstBuff[j] = (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+		} /* end for */
+	} else {
+#ifdef FLACD_OUTPUT_NEON
+		for ( ; ( i + OUTPUT_PROCESS_UNIT ) <= block_length ; i += OUTPUT_PROCESS_UNIT ) {
+			vst1q_f32( &pDstBuff[i], vmulq_n_f32( vcvtq_f32_s32( vld1q_s32( &pSrcBuff[i] ) ), fScale ) );
+		} /* end for */
+#endif
+		for ( ; i < block_length ; i++ ) {
+			pDstBuff[i] = (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+		} /* end for */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+/*==========================================================================*/
+/* End of File                                                              */
+/*==========================================================================*/
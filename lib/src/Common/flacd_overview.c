@@ -0,0 +1,255 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_overview.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : Waveform overview (minimum / maximum / sum of squares)
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_api.h"
+#include "flacd_overview.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FLACD_OVERVIEW_NEON
+#endif
+
+#define OVERVIEW_PROCESS_UNIT		((ACMW_UINT32)4U)
+#define OVERVIEW_INT32_MAX			((ACMW_INT32)0x7FFFFFFF)
+#define OVERVIEW_INT32_MIN			((ACMW_INT32)(-0x7FFFFFFF - 1))
+
+static void bucket_start( flacd_overviewBucket* const pBucket );
+static void bucket_row( flacd_overviewBucket*	const pBucket,
+						const ACMW_UINT32		nChannel,
+						const ACMW_INT32*		const pSrcBuff,
+						const ACMW_UINT32		nLength,
+						const ACMW_FLOAT32		fScale );
+static void bucket_value( flacd_overviewBucket*	const pBucket,
+						  const ACMW_UINT32		nChannel,
+						  const ACMW_INT32		nValue,
+						  const ACMW_UINT32		nLength,
+						  const ACMW_FLOAT32	fScale );
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_OverviewUpdate
+*
+* ARGUMENT
+* 		const flacd_Overview*		const pOverview
+*		const flacd_PendingOutput*	const pPending
+*		FLAC__int32* const *		pSrcBuff
+*		const ACMW_UINT32			nPosition
+*		const ACMW_UINT32			nLength
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Count nLength finished samples of the pending frame, from stream
+* 		position nPosition, in the overview buckets they fall in.
+* 		pSrcBuff[i] points to the first of them in channel i; channels of
+* 		constant subframes are taken from the pending frame, channels that
+* 		are not decoded count as silence. pSrcBuff == NULL is mute.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_OverviewUpdate( const flacd_Overview*		const pOverview,
+						   const flacd_PendingOutput*	const pPending,
+						   FLAC__int32*					const * const pSrcBuff,
+						   const ACMW_UINT32			nPosition,
+						   const ACMW_UINT32			nLength )
+{
+	flacd_overviewBucket*	pBucket;
+	ACMW_UINT32	i, nBucket, nLen;
+	ACMW_UINT32	nPos = nPosition;
+	ACMW_UINT32	nDone = (ACMW_UINT32)0U;
+	const ACMW_UINT32	nFrameChannels = (ACMW_UINT32)pPending->nFrameChannels;
+	const ACMW_FLOAT32	fScale = (ACMW_FLOAT32)1.0f / (ACMW_FLOAT32)( (ACMW_UINT32)1U << ( (ACMW_UINT32)pPending->nBitsPerSample - (ACMW_UINT32)1U ) );
+
+	while ( nDone < nLength ) {
+		nBucket = nPos / pOverview->nBucketSamples;
+		if ( nBucket >= pOverview->nBuckets ) {
+			break;
+		} /* end if */
+		/* up to the end of the bucket */
+		nLen = pOverview->nBucketSamples - ( nPos % pOverview->nBucketSamples );
+		if ( nLen > ( nLength - nDone ) ) {
+			nLen = nLength - nDone;
+		} /* end if */
+
+		pBucket = &pOverview->pBuckets[nBucket];
+		if ( pBucket->nSamples == (ACMW_UINT32)0U ) {
+			bucket_start( pBucket );
+		} /* end if */
+		for ( i = 0; i < (ACMW_UINT32)FLACD_OVERVIEW_MAX_CHANNELS; i++ ) {
+			if ( ( pSrcBuff == NULL ) || ( i >= nFrameChannels ) || ( pSrcBuff[i] == NULL ) ) {
+				bucket_value( pBucket, i, (ACMW_INT32)0, nLen, fScale );
+			} else if ( ( ( pPending->nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) {
+				bucket_value( pBucket, i, pPending->nConstant[i], nLen, fScale );
+			} else {
+				bucket_row( pBucket, i, pSrcBuff[i] + nDone, nLen, fScale );
+			} /* end if */
+		} /* end for */
+		pBucket->nSamples += nLen;
+
+		nPos += nLen;
+		nDone += nLen;
+	} /* end while */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bucket_start
+*
+* ARGUMENT
+* 		flacd_overviewBucket*	const pBucket
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Start an empty bucket
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void bucket_start( flacd_overviewBucket* const pBucket )
+{
+	ACMW_UINT32	i;
+
+	for ( i = 0; i < (ACMW_UINT32)FLACD_OVERVIEW_MAX_CHANNELS; i++ ) {
+		pBucket->nMin[i] = OVERVIEW_INT32_MAX;
+		pBucket->nMax[i] = OVERVIEW_INT32_MIN;
+		pBucket->fSumSquares[i] = (ACMW_FLOAT32)0.0f;
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bucket_row
+*
+* ARGUMENT
+* 		flacd_overviewBucket*	const pBucket
+*		const ACMW_UINT32		nChannel
+*		const ACMW_INT32*		const pSrcBuff
+*		const ACMW_UINT32		nLength
+*		const ACMW_FLOAT32		fScale
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Count nLength samples of one channel in a bucket. The squares are
+* 		summed for the row first and then added to the bucket.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void bucket_row( flacd_overviewBucket*	const pBucket,
+						const ACMW_UINT32		nChannel,
+						const ACMW_INT32*		const pSrcBuff,
+						const ACMW_UINT32		nLength,
+						const ACMW_FLOAT32		fScale )
+{
+	ACMW_UINT32	i = 0;
+	ACMW_INT32	nMin = pBucket->nMin[nChannel];
+	ACMW_INT32	nMax = pBucket->nMax[nChannel];
+	ACMW_FLOAT32	fSum = (ACMW_FLOAT32)0.0f;
+	ACMW_FLOAT32	fValue;
+
+#ifdef FLACD_OVERVIEW_NEON
+	if ( nLength >= OVERVIEW_PROCESS_UNIT ) {
+		int32x4_t	vMin = vdupq_n_s32( nMin );
+		int32x4_t	vMax = vdupq_n_s32( nMax );
+		float32x4_t	vSum = vdupq_n_f32( 0.0f );
+		for ( ; ( i + OVERVIEW_PROCESS_UNIT ) <= nLength ; i += OVERVIEW_PROCESS_UNIT ) {
+			const int32x4_t vIn = vld1q_s32( &pSrcBuff[i] );
+			const float32x4_t vValue = vmulq_n_f32( vcvtq_f32_s32( vIn ), fScale );
+			vMin = vminq_s32( vMin, vIn );
+			vMax = vmaxq_s32( vMax, vIn );
+			vSum = vmlaq_f32( vSum, vValue, vValue );
+		} /* end for */
+		nMin = vgetq_lane_s32( vMin, 0 );
+		nMax = vgetq_lane_s32( vMax, 0 );
+		nMin = ( vgetq_lane_s32( vMin, 1 ) < nMin ) ? vgetq_lane_s32( vMin, 1 ) : nMin;
+		nMax = ( vgetq_lane_s32( vMax, 1 ) > nMax ) ? vgetq_lane_s32( vMax, 1 ) : nMax;
+		nMin = ( vgetq_lane_s32( vMin, 2 ) < nMin ) ? vgetq_lane_s32( vMin, 2 ) : nMin;
+		nMax = ( vgetq_lane_s32( vMax, 2 ) > nMax ) ? vgetq_lane_s32( vMax, 2 ) : nMax;
+		nMin = ( vgetq_lane_s32( vMin, 3 ) < nMin ) ? vgetq_lane_s32( vMin, 3 ) : nMin;
+		nMax = ( vgetq_lane_s32( vMax, 3 ) > nMax ) ? vgetq_lane_s32( vMax, 3 ) : nMax;
+		fSum = ( vgetq_lane_f32( vSum, 0 ) + vgetq_lane_f32( vSum, 1 ) ) + ( vgetq_lane_f32( vSum, 2 ) + vgetq_lane_f32( vSum, 3 ) );
+	} /* end if */
+#endif
+	for ( ; i < nLength ; i++ ) {
+		if ( pSrcBuff[i] < nMin ) {
+			nMin = pSrcBuff[i];
+		} /* end if */
+		if ( pSrcBuff[i] > nMax ) {
+			nMax = pSrcBuff[i];
+		} /* end if */
+		fValue = (ACMW_FLOAT32)pSrcBuff[i] * fScale;
+		fSum += fValue * fValue;
+	} /* end for */
+
+	pBucket->nMin[nChannel] = nMin;
+	pBucket->nMax[nChannel] = nMax;
+	pBucket->fSumSquares[nChannel] += fSum;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		bucket_value
+*
+* ARGUMENT
+* 		flacd_overviewBucket*	const pBucket
+*		const ACMW_UINT32		nChannel
+*		const ACMW_INT32		nValue
+*		const ACMW_UINT32		nLength
+*		const ACMW_FLOAT32		fScale
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Count nLength samples of one channel that all have the value nValue
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void bucket_value( flacd_overviewBucket*	const pBucket,
+						  const ACMW_UINT32		nChannel,
+						  const ACMW_INT32		nValue,
+						  const ACMW_UINT32		nLength,
+						  const ACMW_FLOAT32	fScale )
+{
+	const ACMW_FLOAT32 fValue = (ACMW_FLOAT32)nValue * fScale;
+
+	if ( nValue < pBucket->nMin[nChannel] ) {
+		pBucket->nMin[nChannel] = nValue;
+	} /* end if */
+	if ( nValue > pBucket->nMax[nChannel] ) {
+		pBucket->nMax[nChannel] = nValue;
+	} /* end if */
+	pBucket->fSumSquares[nChannel] += ( fValue * fValue ) * (ACMW_FLOAT32)nLength;
+}
+/*------------------------------------------------------------------------------*/
@@ -0,0 +1,521 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_verify.c
+* $Rev: 2083 $
+* $Date:: 2014-05-09 08:52:44 +0900#$
+* Description : MD5 verification of the decoded samples (RFC 1321) and
+*               frame test
+******************************************************************************/
+#include "flacd_common.h"
+#include "flacd_api.h"
+#include "flacd_verify.h"
+
+#define VERIFY_PACK_SIZE			((ACMW_UINT32)256U)		/* bytes packed per MD5 update, a multiple of the block */
+#define VERIFY_LENGTH_POS			((ACMW_UINT32)56U)		/* position of the bit length in the last block */
+
+#define MD5_F(x, y, z)				( (z) ^ ( (x) & ( (y) ^ (z) ) ) )
+#define MD5_G(x, y, z)				( (y) ^ ( (z) & ( (x) ^ (y) ) ) )
+#define MD5_H(x, y, z)				( (x) ^ (y) ^ (z) )
+#define MD5_I(x, y, z)				( (y) ^ ( (x) | ~(z) ) )
+#define MD5_STEP(f, a, b, c, d, x, t, s)	{ \
+										(a) += f( (b), (c), (d) ) + (x) + (t); \
+										(a) = ( (a) << (s) ) | ( (a) >> ( 32U - (s) ) ); \
+										(a) += (b); \
+									}
+
+static void md5_init( flacd_Md5Context* const pMd5 );
+static void md5_update( flacd_Md5Context* const pMd5, const ACMW_UINT8* const pData, const ACMW_UINT32 nSize );
+static void md5_transform( ACMW_UINT32* const pState, const ACMW_UINT8* const pBlock );
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_VerifyStart
+*
+* ARGUMENT
+* 		flacd_Verify*	const pVerify
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Start the signature over from sample 0
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_VerifyStart( flacd_Verify* const pVerify )
+{
+	md5_init( &(pVerify->sMd5) );
+	pVerify->nNextSample = (ACMW_UINT32)0U;
+	pVerify->nResult = (ACMW_UINT16)FLACD_VERIFY_PENDING;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_VerifyUpdate
+*
+* ARGUMENT
+* 		flacd_Verify*				const pVerify
+*		const flacd_PendingOutput*	const pPending
+*		FLAC__int32* const *		pSrcBuff
+*		const ACMW_UINT32			nPosition
+*		const ACMW_UINT32			nLength
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Add nLength finished samples of the pending frame, from stream
+* 		position nPosition, to the signature, and compare it with the
+* 		STREAMINFO one at the last sample of the stream.
+* 		pSrcBuff[i] points to the first of them in channel i; channels of
+* 		constant subframes are taken from the pending frame.
+* 		pSrcBuff == NULL is mute. Samples that do not follow the ones
+* 		verified, or a channel that is not decoded, end the verification.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_VerifyUpdate( flacd_Verify*					const pVerify,
+						 const flacd_PendingOutput*		const pPending,
+						 FLAC__int32*					const * const pSrcBuff,
+						 const ACMW_UINT32				nPosition,
+						 const ACMW_UINT32				nLength )
+{
+	const ACMW_INT32*	pRow[FLAC__MAX_CHANNELS];
+	ACMW_INT32	nValue[FLAC__MAX_CHANNELS];
+	ACMW_UINT32	nStep[FLAC__MAX_CHANNELS];
+	ACMW_UINT8	nPack[VERIFY_PACK_SIZE];
+	ACMW_UINT8	nDigest[FLACD_MD5_DIGEST_SIZE];
+	ACMW_UINT32	i, j, k, b, nDone, nPeriods;
+	ACMW_UINT32	nSample;
+	ACMW_BOOL	bValid;
+	const ACMW_UINT32	nChannels = (ACMW_UINT32)pPending->nFrameChannels;
+	const ACMW_UINT32	nBytes = ( (ACMW_UINT32)pPending->nBitsPerSample + (ACMW_UINT32)7U ) / (ACMW_UINT32)8U;
+
+	if ( nPosition == (ACMW_UINT32)0U ) {
+		flacd_VerifyStart( pVerify );
+	} /* end if */
+	if ( pVerify->nResult != (ACMW_UINT16)FLACD_VERIFY_PENDING ) {
+		return;
+	} /* end if */
+
+	/* Rows of the channels (a constant is read with step 0) */
+	bValid = ( ( nPosition == pVerify->nNextSample ) && ( pPending->bChannelDropped == (ACMW_BOOL)0 ) ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+	for ( i = 0; i < nChannels; i++ ) {
+		nValue[i] = (ACMW_INT32)0;
+		pRow[i] = &nValue[i];
+		nStep[i] = (ACMW_UINT32)0U;
+		if ( pSrcBuff == NULL ) {
+			/* mute */
+		} else if ( pSrcBuff[i] == NULL ) {
+			bValid = (ACMW_BOOL)0;
+		} else if ( ( ( pPending->nConstantMask >> i ) & (ACMW_UINT32)1U ) != (ACMW_UINT32)0U ) {
+			nValue[i] = pPending->nConstant[i];
+		} else {
+			pRow[i] = pSrcBuff[i];
+			nStep[i] = (ACMW_UINT32)1U;
+		} /* end if */
+	} /* end for */
+	if ( bValid == (ACMW_BOOL)0 ) {
+		pVerify->nResult = (ACMW_UINT16)FLACD_VERIFY_INCOMPLETE;
+		return;
+	} /* end if */
+
+	/* Interleave the samples little-endian and hash them a pack at a time */
+	nPeriods = VERIFY_PACK_SIZE / ( nChannels * nBytes );
+	for ( nDone = 0; nDone < nLength; nDone += nPeriods ) {
+		if ( nPeriods > ( nLength - nDone ) ) {
+			nPeriods = nLength - nDone;
+		} /* end if */
+		k = 0;
+		for ( j = nDone; j < ( nDone + nPeriods ); j++ ) {
+			for ( i = 0; i < nChannels; i++ ) {
+				nSample = (ACMW_UINT32)pRow[i][j * nStep[i]];
+				for ( b = 0; b < nBytes; b++ ) {
+					nPack[k] = (ACMW_UINT8)( nSample >> ( b * FLACD_SHIFT_08 ) );
+					k++;
+				} /* end for */
+			} /* end for */
+		} /* end for */
+		md5_update( &(pVerify->sMd5), nPack, k );
+	} /* end for */
+	pVerify->nNextSample += nLength;
+
+	/* End of the stream : compare */
+	if ( ( pVerify->nTotalSamples != (ACMW_UINT32)0U ) && ( pVerify->nNextSample >= pVerify->nTotalSamples ) ) {
+		flacd_VerifyDigest( pVerify, nDigest );
+		pVerify->nResult = flacd_VerifyCompare( pVerify, nDigest );
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_VerifyDigest
+*
+* ARGUMENT
+* 		const flacd_Verify*	const pVerify
+*		ACMW_UINT8*			const pDigest
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Get the signature of the samples verified so far, without ending
+* 		the verification (the padding is added to a copy)
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_VerifyDigest( const flacd_Verify* const pVerify, ACMW_UINT8* const pDigest )
+{
+	flacd_Md5Context	sMd5;
+	ACMW_UINT8	nTail[FLACD_MD5_BLOCK_SIZE];
+	ACMW_UINT32	i, nUsed, nPad;
+	const ACMW_UINT32	nBitsLow = pVerify->sMd5.nBytes[0] << 3;
+	const ACMW_UINT32	nBitsHigh = ( pVerify->sMd5.nBytes[1] << 3 ) | ( pVerify->sMd5.nBytes[0] >> 29 );
+
+	sMd5 = pVerify->sMd5;
+
+	/* 0x80, zeros up to the length, the length in bits */
+	nUsed = sMd5.nBytes[0] & (ACMW_UINT32)( FLACD_MD5_BLOCK_SIZE - 1 );
+	nPad = ( nUsed < VERIFY_LENGTH_POS ) ? ( VERIFY_LENGTH_POS - nUsed ) : ( ( VERIFY_LENGTH_POS + (ACMW_UINT32)FLACD_MD5_BLOCK_SIZE ) - nUsed );
+	flacd_MemSet( nTail, 0, (ACMW_INT32)sizeof(nTail) );
+	nTail[0] = (ACMW_UINT8)0x80U;
+	md5_update( &sMd5, nTail, nPad );
+	for ( i = 0; i < (ACMW_UINT32)4U; i++ ) {
+		nTail[i] = (ACMW_UINT8)( nBitsLow >> ( i * FLACD_SHIFT_08 ) );
+		nTail[i + 4U] = (ACMW_UINT8)( nBitsHigh >> ( i * FLACD_SHIFT_08 ) );
+	} /* end for */
+	md5_update( &sMd5, nTail, (ACMW_UINT32)8U );
+
+	for ( i = 0; i < (ACMW_UINT32)FLACD_MD5_DIGEST_SIZE; i++ ) {
+		pDigest[i] = (ACMW_UINT8)( sMd5.nState[i >> 2] >> ( ( i & (ACMW_UINT32)3U ) * FLACD_SHIFT_08 ) );
+	} /* end for */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_VerifyCompare
+*
+* ARGUMENT
+* 		const flacd_Verify*	const pVerify
+*		const ACMW_UINT8*	const pDigest
+*
+* RETURN VALUE
+* 		ACMW_UINT16			FLACD_VERIFY_MATCH / MISMATCH / NO_SIGNATURE
+*
+* OVERVIEW
+* 		Compare a signature with the one of STREAMINFO
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+ACMW_UINT16 flacd_VerifyCompare( const flacd_Verify* const pVerify, const ACMW_UINT8* const pDigest )
+{
+	ACMW_UINT16	nResult = (ACMW_UINT16)FLACD_VERIFY_MATCH;
+	ACMW_UINT32	i;
+
+	if ( pVerify->bSignature == (ACMW_BOOL)0 ) {
+		nResult = (ACMW_UINT16)FLACD_VERIFY_NO_SIGNATURE;
+	} else {
+		for ( i = 0; i < (ACMW_UINT32)FLACD_MD5_DIGEST_SIZE; i++ ) {
+			if ( pDigest[i] != pVerify->nExpected[i] ) {
+				nResult = (ACMW_UINT16)FLACD_VERIFY_MISMATCH;
+			} /* end if */
+		} /* end for */
+	} /* end if */
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		flacd_VerifyFrame
+*
+* ARGUMENT
+* 		flacd_Verify*		const pVerify
+*		const ACMW_UINT32	nFirstSample
+*		const ACMW_UINT32	nBlockSize
+*		const ACMW_UINT16	nFrameResult
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Count one frame of the frame test and store its result while
+* 		there is room. A frame that fails before its CRC-16 has no
+* 		sample number and is put after the last frame checked; the
+* 		failures that follow it until the next frame are the search
+* 		for the next sync and are not counted. A frame that does not
+* 		start at the sample after the last frame checked, with no failure
+* 		counted for the frames between, fails for the frames skipped.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+void flacd_VerifyFrame( flacd_Verify*		const pVerify,
+						const ACMW_UINT32	nFirstSample,
+						const ACMW_UINT32	nBlockSize,
+						const ACMW_UINT16	nFrameResult )
+{
+	flacd_frameTestInfo*	pFrame;
+	ACMW_UINT32	nSample = nFirstSample;
+	ACMW_UINT32	nLength = nBlockSize;
+	ACMW_BOOL	bFailed = ( nFrameResult != (ACMW_UINT16)FLACD_FRAMETEST_PASS ) ? (ACMW_BOOL)1 : (ACMW_BOOL)0;
+
+	if ( ( nFrameResult == (ACMW_UINT16)FLACD_FRAMETEST_HEADER ) || ( nFrameResult == (ACMW_UINT16)FLACD_FRAMETEST_UNPARSEABLE ) ) {
+		if ( pVerify->bLostSync == (ACMW_BOOL)1 ) {
+			return;
+		} /* end if */
+		pVerify->bLostSync = (ACMW_BOOL)1;
+		nSample = pVerify->nNextSample;
+		nLength = (ACMW_UINT32)0U;
+	} else {
+		if ( ( nFirstSample != pVerify->nNextSample ) && ( pVerify->bLostSync == (ACMW_BOOL)0 ) ) {
+			bFailed = (ACMW_BOOL)1;
+		} /* end if */
+		pVerify->bLostSync = (ACMW_BOOL)0;
+		pVerify->nNextSample = nFirstSample + nBlockSize;
+		pVerify->nTestedSamples += nBlockSize;
+	} /* end if */
+
+	if ( ( pVerify->pFrames != NULL ) && ( pVerify->nTestedFrames < pVerify->nFrames ) ) {
+		pFrame = &pVerify->pFrames[pVerify->nTestedFrames];
+		pFrame->nFirstSample = nSample;
+		pFrame->nBlockSize = (ACMW_UINT16)nLength;
+		pFrame->nFrameResult = nFrameResult;
+	} /* end if */
+	pVerify->nTestedFrames++;
+	if ( bFailed == (ACMW_BOOL)1 ) {
+		pVerify->nFailedFrames++;
+		pVerify->nResult = (ACMW_UINT16)FLACD_VERIFY_MISMATCH;
+	} else if ( pVerify->nResult == (ACMW_UINT16)FLACD_VERIFY_PENDING ) {
+		pVerify->nResult = (ACMW_UINT16)FLACD_VERIFY_MATCH;
+	} else {
+		/* keep the result */
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		md5_init
+*
+* ARGUMENT
+* 		flacd_Md5Context*	const pMd5
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Set the initial MD5 state
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void md5_init( flacd_Md5Context* const pMd5 )
+{
+	pMd5->nState[0] = (ACMW_UINT32)0x67452301U;
+	pMd5->nState[1] = (ACMW_UINT32)0xEFCDAB89U;
+	pMd5->nState[2] = (ACMW_UINT32)0x98BADCFEU;
+	pMd5->nState[3] = (ACMW_UINT32)0x10325476U;
+	pMd5->nBytes[0] = (ACMW_UINT32)0U;
+	pMd5->nBytes[1] = (ACMW_UINT32)0U;
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		md5_update
+*
+* ARGUMENT
+* 		flacd_Md5Context*	const pMd5
+*		const ACMW_UINT8*	const pData
+*		const ACMW_UINT32	nSize
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Hash nSize bytes. Whole blocks are hashed straight from pData, only
+* 		a block split over two calls is gathered in the context.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void md5_update( flacd_Md5Context* const pMd5, const ACMW_UINT8* const pData, const ACMW_UINT32 nSize )
+{
+	ACMW_UINT32	nUsed = pMd5->nBytes[0] & (ACMW_UINT32)( FLACD_MD5_BLOCK_SIZE - 1 );
+	ACMW_UINT32	nDone = (ACMW_UINT32)0U;
+	ACMW_UINT32	nFill;
+
+	pMd5->nBytes[0] += nSize;
+	if ( pMd5->nBytes[0] < nSize ) {
+		pMd5->nBytes[1]++;
+	} /* end if */
+
+	if ( nUsed != (ACMW_UINT32)0U ) {
+		nFill = (ACMW_UINT32)FLACD_MD5_BLOCK_SIZE - nUsed;
+		if ( nFill > nSize ) {
+			nFill = nSize;
+		} /* end if */
+		flacd_MemCpy( &(pMd5->nBuffer[nUsed]), pData, (ACMW_INT32)nFill );
+		nDone = nFill;
+		if ( ( nUsed + nFill ) < (ACMW_UINT32)FLACD_MD5_BLOCK_SIZE ) {
+			return;
+		} /* end if */
+		md5_transform( pMd5->nState, pMd5->nBuffer );
+	} /* end if */
+	for ( ; ( nDone + (ACMW_UINT32)FLACD_MD5_BLOCK_SIZE ) <= nSize ; nDone += (ACMW_UINT32)FLACD_MD5_BLOCK_SIZE ) {
+		md5_transform( pMd5->nState, &pData[nDone] );
+	} /* end for */
+	if ( nDone < nSize ) {
+		flacd_MemCpy( pMd5->nBuffer, &pData[nDone], (ACMW_INT32)( nSize - nDone ) );
+	} /* end if */
+}
+/*------------------------------------------------------------------------------*/
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		md5_transform
+*
+* ARGUMENT
+* 		ACMW_UINT32*		const pState
+*		const ACMW_UINT8*	const pBlock
+*
+* RETURN VALUE
+* 		void
+*
+* OVERVIEW
+* 		Hash one 64 byte block. The 64 steps are unrolled so that the
+* 		constants, shifts and word indexes are immediates.
+*
+* DIVERSION ORIGIN
+* 		Original.
+*
+*/
+static void md5_transform( ACMW_UINT32* const pState, const ACMW_UINT8* const pBlock )
+{
+	ACMW_UINT32	x[16];
+	ACMW_UINT32	i;
+	ACMW_UINT32	a = pState[0];
+	ACMW_UINT32	b = pState[1];
+	ACMW_UINT32	c = pState[2];
+	ACMW_UINT32	d = pState[3];
+
+	for ( i = 0; i < (ACMW_UINT32)16U; i++ ) {
+		x[i] = (ACMW_UINT32)pBlock[i * 4U] |
+			   ( (ACMW_UINT32)pBlock[( i * 4U ) + 1U] << FLACD_SHIFT_08 ) |
+			   ( (ACMW_UINT32)pBlock[( i * 4U ) + 2U] << FLACD_SHIFT_16 ) |
+			   ( (ACMW_UINT32)pBlock[( i * 4U ) + 3U] << FLACD_SHIFT_24 );
+	} /* end for */
+
+	/* Round 1 */
+	MD5_STEP( MD5_F, a, b, c, d, x[ 0], 0xD76AA478U,  7 );
+	MD5_STEP( MD5_F, d, a, b, c, x[ 1], 0xE8C7B756U, 12 );
+	MD5_STEP( MD5_F, c, d, a, b, x[ 2], 0x242070DBU, 17 );
+	MD5_STEP( MD5_F, b, c, d, a, x[ 3], 0xC1BDCEEEU, 22 );
+	MD5_STEP( MD5_F, a, b, c, d, x[ 4], 0xF57C0FAFU,  7 );
+	MD5_STEP( MD5_F, d, a, b, c, x[ 5], 0x4787C62AU, 12 );
+	MD5_STEP( MD5_F, c, d, a, b, x[ 6], 0xA8304613U, 17 );
+	MD5_STEP( MD5_F, b, c, d, a, x[ 7], 0xFD469501U, 22 );
+	MD5_STEP( MD5_F, a, b, c, d, x[ 8], 0x698098D8U,  7 );
+	MD5_STEP( MD5_F, d, a, b, c, x[ 9], 0x8B44F7AFU, 12 );
+	MD5_STEP( MD5_F, c, d, a, b, x[10], 0xFFFF5BB1U, 17 );
+	MD5_STEP( MD5_F, b, c, d, a, x[11], 0x895CD7BEU, 22 );
+	MD5_STEP( MD5_F, a, b, c, d, x[12], 0x6B901122U,  7 );
+	MD5_STEP( MD5_F, d, a, b, c, x[13], 0xFD987193U, 12 );
+	MD5_STEP( MD5_F, c, d, a, b, x[14], 0xA679438EU, 17 );
+	MD5_STEP( MD5_F, b, c, d, a, x[15], 0x49B40821U, 22 );
+
+	/* Round 2 */
+	MD5_STEP( MD5_G, a, b, c, d, x[ 1], 0xF61E2562U,  5 );
+	MD5_STEP( MD5_G, d, a, b, c, x[ 6], 0xC040B340U,  9 );
+	MD5_STEP( MD5_G, c, d, a, b, x[11], 0x265E5A51U, 14 );
+	MD5_STEP( MD5_G, b, c, d, a, x[ 0], 0xE9B6C7AAU, 20 );
+	MD5_STEP( MD5_G, a, b, c, d, x[ 5], 0xD62F105DU,  5 );
+	MD5_STEP( MD5_G, d, a, b, c, x[10], 0x02441453U,  9 );
+	MD5_STEP( MD5_G, c, d, a, b, x[15], 0xD8A1E681U, 14 );
+	MD5_STEP( MD5_G, b, c, d, a, x[ 4], 0xE7D3FBC8U, 20 );
+	MD5_STEP( MD5_G, a, b, c, d, x[ 9], 0x21E1CDE6U,  5 );
+	MD5_STEP( MD5_G, d, a, b, c, x[14], 0xC33707D6U,  9 );
+	MD5_STEP( MD5_G, c, d, a, b, x[ 3], 0xF4D50D87U, 14 );
+	MD5_STEP( MD5_G, b, c, d, a, x[ 8], 0x455A14EDU, 20 );
+	MD5_STEP( MD5_G, a, b, c, d, x[13], 0xA9E3E905U,  5 );
+	MD5_STEP( MD5_G, d, a, b, c, x[ 2], 0xFCEFA3F8U,  9 );
+	MD5_STEP( MD5_G, c, d, a, b, x[ 7], 0x676F02D9U, 14 );
+	MD5_STEP( MD5_G, b, c, d, a, x[12], 0x8D2A4C8AU, 20 );
+
+	/* Round 3 */
+	MD5_STEP( MD5_H, a, b, c, d, x[ 5], 0xFFFA3942U,  4 );
+	MD5_STEP( MD5_H, d, a, b, c, x[ 8], 0x8771F681U, 11 );
+	MD5_STEP( MD5_H, c, d, a, b, x[11], 0x6D9D6122U, 16 );
+	MD5_STEP( MD5_H, b, c, d, a, x[14], 0xFDE5380CU, 23 );
+	MD5_STEP( MD5_H, a, b, c, d, x[ 1], 0xA4BEEA44U,  4 );
+	MD5_STEP( MD5_H, d, a, b, c, x[ 4], 0x4BDECFA9U, 11 );
+	MD5_STEP( MD5_H, c, d, a, b, x[ 7], 0xF6BB4B60U, 16 );
+	MD5_STEP( MD5_H, b, c, d, a, x[10], 0xBEBFBC70U, 23 );
+	MD5_STEP( MD5_H, a, b, c, d, x[13], 0x289B7EC6U,  4 );
+	MD5_STEP( MD5_H, d, a, b, c, x[ 0], 0xEAA127FAU, 11 );
+	MD5_STEP( MD5_H, c, d, a, b, x[ 3], 0xD4EF3085U, 16 );
+	MD5_STEP( MD5_H, b, c, d, a, x[ 6], 0x04881D05U, 23 );
+	MD5_STEP( MD5_H, a, b, c, d, x[ 9], 0xD9D4D039U,  4 );
+	MD5_STEP( MD5_H, d, a, b, c, x[12], 0xE6DB99E5U, 11 );
+	MD5_STEP( MD5_H, c, d, a, b, x[15], 0x1FA27CF8U, 16 );
+	MD5_STEP( MD5_H, b, c, d, a, x[ 2], 0xC4AC5665U, 23 );
+
+	/* Round 4 */
+	MD5_STEP( MD5_I, a, b, c, d, x[ 0], 0xF4292244U,  6 );
+	MD5_STEP( MD5_I, d, a, b, c, x[ 7], 0x432AFF97U, 10 );
+	MD5_STEP( MD5_I, c, d, a, b, x[14], 0xAB9423A7U, 15 );
+	MD5_STEP( MD5_I, b, c, d, a, x[ 5], 0xFC93A039U, 21 );
+	MD5_STEP( MD5_I, a, b, c, d, x[12], 0x655B59C3U,  6 );
+	MD5_STEP( MD5_I, d, a, b, c, x[ 3], 0x8F0CCC92U, 10 );
+	MD5_STEP( MD5_I, c, d, a, b, x[10], 0xFFEFF47DU, 15 );
+	MD5_STEP( MD5_I, b, c, d, a, x[ 1], 0x85845DD1U, 21 );
+	MD5_STEP( MD5_I, a, b, c, d, x[ 8], 0x6FA87E4FU,  6 );
+	MD5_STEP( MD5_I, d, a, b, c, x[15], 0xFE2CE6E0U, 10 );
+	MD5_STEP( MD5_I, c, d, a, b, x[ 6], 0xA3014314U, 15 );
+	MD5_STEP( MD5_I, b, c, d, a, x[13], 0x4E0811A1U, 21 );
+	MD5_STEP( MD5_I, a, b, c, d, x[ 4], 0xF7537E82U,  6 );
+	MD5_STEP( MD5_I, d, a, b, c, x[11], 0xBD3AF235U, 10 );
+	MD5_STEP( MD5_I, c, d, a, b, x[ 2], 0x2AD7D2BBU, 15 );
+	MD5_STEP( MD5_I, b, c, d, a, x[ 9], 0xEB86D391U, 21 );
+
+	pState[0] += a;
+	pState[1] += b;
+	pState[2] += c;
+	pState[3] += d;
+}
+/*------------------------------------------------------------------------------*/
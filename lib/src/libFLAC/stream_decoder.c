@@ -89,12 +89,38 @@ static FLAC__bool frame_sync_(FLAC__StreamDecoder *decoder);
 static FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FLAC__bool do_full_decode);
 static FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder);
 static FLAC__bool read_subframe_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, FLAC__bool do_full_decode);
-static FLAC__bool read_subframe_constant_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, FLAC__bool do_full_decode);
+static FLAC__bool read_subframe_constant_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps);
 static FLAC__bool read_subframe_fixed_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, const unsigned order, FLAC__bool do_full_decode);
 static FLAC__bool read_subframe_lpc_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, const unsigned order, FLAC__bool do_full_decode);
 static FLAC__bool read_subframe_verbatim_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, FLAC__bool do_full_decode);
+#if 1
+/* signal restoration run per tile while the residual is being read */
+typedef enum {
+	RESTORE_NONE,
+	RESTORE_FIXED,
+	RESTORE_LPC,
+	RESTORE_LPC_64BIT
+} restore_type_;
+
+typedef struct {
+	restore_type_ type;
+	unsigned order;
+	const FLAC__int32 *qlp_coeff;
+	int quantization_level;
+	FLAC__int32 *data;			/* output[channel] + order */
+	unsigned restored;			/* samples restored from data[0] */
+} restore_info_;
+
+static FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigned predictor_order, unsigned partition_order, FLAC__EntropyCodingMethod_PartitionedRiceContents *partitioned_rice_contents, FLAC__int32 *residual, FLAC__bool is_extended, restore_info_ *restore);
+static void restore_tile_(restore_info_ *restore, const FLAC__int32 *residual, unsigned end);
+#else
 static FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigned predictor_order, unsigned partition_order, FLAC__EntropyCodingMethod_PartitionedRiceContents *partitioned_rice_contents, FLAC__int32 *residual, FLAC__bool is_extended);
+#endif
 static FLAC__bool read_zero_padding_(FLAC__StreamDecoder *decoder);
+#if 1
+static FLAC__bool assign_rows_(FLAC__StreamDecoder *decoder);
+static void resolve_constants_(FLAC__StreamDecoder *decoder);
+#endif
 
 /***********************************************************************
  *
@@ -175,6 +201,9 @@ FLAC_API FLAC__StreamDecoder *FLAC__stream_decoder_new(const flacd_workMemoryInf
 		decoder->private_->output[i] = 0;
 		decoder->private_->residual[i] = 0;
 	}
+#if 1
+	decoder->private_->frame = 0;
+#endif
 
 #if 0
 	for(i = 0; i < FLAC__MAX_CHANNELS; i++)
@@ -202,9 +231,11 @@ static FLAC__StreamDecoderInitStatus init_stream_internal_(
 		return FLAC__STREAM_DECODER_INIT_STATUS_ALREADY_INITIALIZED;
 
 	/* first default to the non-asm routines */
+#if 0
 	decoder->private_->local_lpc_restore_signal = FLAC__lpc_restore_signal;
 	decoder->private_->local_lpc_restore_signal_64bit = FLAC__lpc_restore_signal_wide;
 	decoder->private_->local_lpc_restore_signal_16bit = FLAC__lpc_restore_signal;
+#endif
 #if 0	/* -> Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00004 start */
 	decoder->private_->local_lpc_restore_signal_16bit_order8 = FLAC__lpc_restore_signal;
 #endif	/* <- Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00004 end */
@@ -282,6 +313,10 @@ FLAC_API FLAC__bool FLAC__stream_decoder_flush(FLAC__StreamDecoder *decoder)
 	FLAC__ASSERT(0 != decoder->protected_);
 
 	decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
+#if 1
+	/* a byte looked ahead belongs to the previous input */
+	decoder->private_->cached = false;
+#endif
 
 	return true;
 }
@@ -355,8 +390,10 @@ FLAC__bool frame_sync_(FLAC__StreamDecoder *decoder)
 FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FLAC__bool do_full_decode)
 {
 	unsigned channel;
+#if 0
 	unsigned i;
 	FLAC__int32 mid, side;
+#endif
 	unsigned frame_crc; /* the one we calculate from the input stream */
 	FLAC__uint32 x;
 
@@ -377,27 +414,35 @@ FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FL
 		return false;
 	if(decoder->protected_->state == FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC) /* means we didn't sync on a valid header */
 		return true;
-	for(channel = 0; channel < decoder->private_->frame.header.channels; channel++) {
+#if 1
+	if(!assign_rows_(decoder)) {
+		decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_UNSUPPORTED_STREAM;
+		decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
+		return true;
+	}
+	decoder->private_->constant_mask = 0;
+#endif
+	for(channel = 0; channel < decoder->private_->frame->header.channels; channel++) {
 		/*
 		 * first figure the correct bits-per-sample of the subframe
 		 */
-		unsigned bps = decoder->private_->frame.header.bits_per_sample;
-		switch(decoder->private_->frame.header.channel_assignment) {
+		unsigned bps = decoder->private_->frame->header.bits_per_sample;
+		switch(decoder->private_->frame->header.channel_assignment) {
 			case FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT:
 				/* no adjustment needed */
 				break;
 			case FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE:
-				FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
+				FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
 				if(channel == 1)
 					bps++;
 				break;
 			case FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE:
-				FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
+				FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
 				if(channel == 0)
 					bps++;
 				break;
 			case FLAC__CHANNEL_ASSIGNMENT_MID_SIDE:
-				FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
+				FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
 				if(channel == 1)
 					bps++;
 				break;
@@ -408,7 +453,8 @@ FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FL
 		 * now read it
 		 */
 #if 1
-		if( channel > ( decoder->private_->supported_output_channels - 1 ) ) {
+		/* channels without a scratch row are only parsed */
+		if( decoder->private_->output[channel] == NULL ) {
 			do_full_decode = false;
 		}
 		else {
@@ -435,25 +481,31 @@ FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FL
 	if(!FLAC__bitreader_read_raw_uint32(decoder->private_->input, &x, FLAC__FRAME_FOOTER_CRC_LEN))
 		return false; /* read_callback_ sets the state for us */
 	if(frame_crc == x) {
+		/* Undoing the channel coding is deferred to FLAC__stream_decoder_finish_block(), tile by tile */
+#if 1
+		if(do_full_decode)
+			resolve_constants_(decoder);
+#endif
+#if 0
 		if(do_full_decode) {
 			/* Undo any special channel coding */
-			switch(decoder->private_->frame.header.channel_assignment) {
+			switch(decoder->private_->frame->header.channel_assignment) {
 				case FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT:
 					/* do nothing */
 					break;
 				case FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE:
-					FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
-					for(i = 0; i < decoder->private_->frame.header.blocksize; i++)
+					FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+					for(i = 0; i < decoder->private_->frame->header.blocksize; i++)
 						decoder->private_->output[1][i] = decoder->private_->output[0][i] - decoder->private_->output[1][i];
 					break;
 				case FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE:
-					FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
-					for(i = 0; i < decoder->private_->frame.header.blocksize; i++)
+					FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+					for(i = 0; i < decoder->private_->frame->header.blocksize; i++)
 						decoder->private_->output[0][i] += decoder->private_->output[1][i];
 					break;
 				case FLAC__CHANNEL_ASSIGNMENT_MID_SIDE:
-					FLAC__ASSERT(decoder->private_->frame.header.channels == 2);
-					for(i = 0; i < decoder->private_->frame.header.blocksize; i++) {
+					FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+					for(i = 0; i < decoder->private_->frame->header.blocksize; i++) {
 #if 1
 						mid = decoder->private_->output[0][i];
 						side = decoder->private_->output[1][i];
@@ -474,13 +526,18 @@ FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FL
 					break;
 			}
 		}
+#endif
 	}
 	else {
 		/* Bad frame, emit error and zero the output signal */
 		decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_FRAME_CRC_MISMATCH;
 		if(do_full_decode) {
-			for(channel = 0; channel < decoder->private_->frame.header.channels; channel++) {
-				flacd_MemSet(decoder->private_->output[channel], 0, (ACMW_INT32)(sizeof(FLAC__int32) * decoder->private_->frame.header.blocksize));
+			for(channel = 0; channel < decoder->private_->frame->header.channels; channel++) {
+#if 1
+				if(decoder->private_->output[channel] == NULL)
+					continue;
+#endif
+				flacd_MemSet(decoder->private_->output[channel], 0, (ACMW_INT32)(sizeof(FLAC__int32) * decoder->private_->frame->header.blocksize));
 			}
 		}
 	}
@@ -492,13 +549,13 @@ FLAC__bool read_frame_(FLAC__StreamDecoder *decoder, FLAC__bool *got_a_frame, FL
 		decoder->private_->fixed_block_size = decoder->private_->next_fixed_block_size;
 
 	/* put the latest values into the public section of the decoder instance */
-	decoder->protected_->channels = decoder->private_->frame.header.channels;
-	decoder->protected_->channel_assignment = decoder->private_->frame.header.channel_assignment;
-	decoder->protected_->bits_per_sample = decoder->private_->frame.header.bits_per_sample;
-	decoder->protected_->sample_rate = decoder->private_->frame.header.sample_rate;
-	decoder->protected_->blocksize = decoder->private_->frame.header.blocksize;
+	decoder->protected_->channels = decoder->private_->frame->header.channels;
+	decoder->protected_->channel_assignment = decoder->private_->frame->header.channel_assignment;
+	decoder->protected_->bits_per_sample = decoder->private_->frame->header.bits_per_sample;
+	decoder->protected_->sample_rate = decoder->private_->frame->header.sample_rate;
+	decoder->protected_->blocksize = decoder->private_->frame->header.blocksize;
 
-	FLAC__ASSERT(decoder->private_->frame.header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
+	FLAC__ASSERT(decoder->private_->frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
 
 	decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 	return true;
@@ -565,13 +622,13 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 			is_unparseable = true;
 			break;
 		case 1:
-			decoder->private_->frame.header.blocksize = 192;
+			decoder->private_->frame->header.blocksize = 192;
 			break;
 		case 2:
 		case 3:
 		case 4:
 		case 5:
-			decoder->private_->frame.header.blocksize = 576 << (x-2);
+			decoder->private_->frame->header.blocksize = 576 << (x-2);
 			break;
 		case 6:
 		case 7:
@@ -585,7 +642,7 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 		case 13:
 		case 14:
 		case 15:
-			decoder->private_->frame.header.blocksize = 256 << (x-8);
+			decoder->private_->frame->header.blocksize = 256 << (x-8);
 			break;
 		default:
 			FLAC__ASSERT(0);
@@ -595,42 +652,42 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 	switch(x = raw_header[2] & 0x0f) {
 		case 0:
 			if(decoder->private_->has_stream_info)
-				decoder->private_->frame.header.sample_rate = decoder->private_->stream_info.data.stream_info.sample_rate;
+				decoder->private_->frame->header.sample_rate = decoder->private_->stream_info.sample_rate;
 			else
 				is_unparseable = true;
 			break;
 		case 1:
-			decoder->private_->frame.header.sample_rate = 88200;
+			decoder->private_->frame->header.sample_rate = 88200;
 			break;
 		case 2:
-			decoder->private_->frame.header.sample_rate = 176400;
+			decoder->private_->frame->header.sample_rate = 176400;
 			break;
 		case 3:
-			decoder->private_->frame.header.sample_rate = 192000;
+			decoder->private_->frame->header.sample_rate = 192000;
 			break;
 		case 4:
-			decoder->private_->frame.header.sample_rate = 8000;
+			decoder->private_->frame->header.sample_rate = 8000;
 			break;
 		case 5:
-			decoder->private_->frame.header.sample_rate = 16000;
+			decoder->private_->frame->header.sample_rate = 16000;
 			break;
 		case 6:
-			decoder->private_->frame.header.sample_rate = 22050;
+			decoder->private_->frame->header.sample_rate = 22050;
 			break;
 		case 7:
-			decoder->private_->frame.header.sample_rate = 24000;
+			decoder->private_->frame->header.sample_rate = 24000;
 			break;
 		case 8:
-			decoder->private_->frame.header.sample_rate = 32000;
+			decoder->private_->frame->header.sample_rate = 32000;
 			break;
 		case 9:
-			decoder->private_->frame.header.sample_rate = 44100;
+			decoder->private_->frame->header.sample_rate = 44100;
 			break;
 		case 10:
-			decoder->private_->frame.header.sample_rate = 48000;
+			decoder->private_->frame->header.sample_rate = 48000;
 			break;
 		case 11:
-			decoder->private_->frame.header.sample_rate = 96000;
+			decoder->private_->frame->header.sample_rate = 96000;
 			break;
 		case 12:
 		case 13:
@@ -647,16 +704,16 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 
 	x = (unsigned)(raw_header[3] >> 4);
 	if(x & 8) {
-		decoder->private_->frame.header.channels = 2;
+		decoder->private_->frame->header.channels = 2;
 		switch(x & 7) {
 			case 0:
-				decoder->private_->frame.header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE;
+				decoder->private_->frame->header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE;
 				break;
 			case 1:
-				decoder->private_->frame.header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE;
+				decoder->private_->frame->header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE;
 				break;
 			case 2:
-				decoder->private_->frame.header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_MID_SIDE;
+				decoder->private_->frame->header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_MID_SIDE;
 				break;
 			default:
 				is_unparseable = true;
@@ -664,31 +721,31 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 		}
 	}
 	else {
-		decoder->private_->frame.header.channels = (unsigned)x + 1;
-		decoder->private_->frame.header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT;
+		decoder->private_->frame->header.channels = (unsigned)x + 1;
+		decoder->private_->frame->header.channel_assignment = FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT;
 	}
 
 	switch(x = (unsigned)(raw_header[3] & 0x0e) >> 1) {
 		case 0:
 			if(decoder->private_->has_stream_info)
-				decoder->private_->frame.header.bits_per_sample = decoder->private_->stream_info.data.stream_info.bits_per_sample;
+				decoder->private_->frame->header.bits_per_sample = decoder->private_->stream_info.bits_per_sample;
 			else
 				is_unparseable = true;
 			break;
 		case 1:
-			decoder->private_->frame.header.bits_per_sample = 8;
+			decoder->private_->frame->header.bits_per_sample = 8;
 			break;
 		case 2:
-			decoder->private_->frame.header.bits_per_sample = 12;
+			decoder->private_->frame->header.bits_per_sample = 12;
 			break;
 		case 4:
-			decoder->private_->frame.header.bits_per_sample = 16;
+			decoder->private_->frame->header.bits_per_sample = 16;
 			break;
 		case 5:
-			decoder->private_->frame.header.bits_per_sample = 20;
+			decoder->private_->frame->header.bits_per_sample = 20;
 			break;
 		case 6:
-			decoder->private_->frame.header.bits_per_sample = 24;
+			decoder->private_->frame->header.bits_per_sample = 24;
 			break;
 		case 3:
 		case 7:
@@ -707,7 +764,7 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 	if(
 		raw_header[1] & 0x01 ||
 		/*@@@ this clause is a concession to the old way of doing variable blocksize; the only known implementation is flake and can probably be removed without inconveniencing anyone */
-		(decoder->private_->has_stream_info && decoder->private_->stream_info.data.stream_info.min_blocksize != decoder->private_->stream_info.data.stream_info.max_blocksize)
+		(decoder->private_->has_stream_info && decoder->private_->stream_info.min_blocksize != decoder->private_->stream_info.max_blocksize)
 	) { /* variable blocksize */
 		if(!FLAC__bitreader_read_utf8_uint64(decoder->private_->input, &xx, raw_header, &raw_header_len))
 			return false; /* read_callback_ sets the state for us */
@@ -718,8 +775,8 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 			decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 			return true;
 		}
-		decoder->private_->frame.header.number_type = FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER;
-		decoder->private_->frame.header.number.sample_number = xx;
+		decoder->private_->frame->header.number_type = FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER;
+		decoder->private_->frame->header.number.sample_number = xx;
 	}
 	else { /* fixed blocksize */
 		if(!FLAC__bitreader_read_utf8_uint32(decoder->private_->input, &x, raw_header, &raw_header_len))
@@ -731,8 +788,8 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 			decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 			return true;
 		}
-		decoder->private_->frame.header.number_type = FLAC__FRAME_NUMBER_TYPE_FRAME_NUMBER;
-		decoder->private_->frame.header.number.frame_number = x;
+		decoder->private_->frame->header.number_type = FLAC__FRAME_NUMBER_TYPE_FRAME_NUMBER;
+		decoder->private_->frame->header.number.frame_number = x;
 	}
 
 	if(blocksize_hint) {
@@ -746,7 +803,7 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 			raw_header[raw_header_len++] = (FLAC__byte)_x;
 			x = (x << 8) | _x;
 		}
-		decoder->private_->frame.header.blocksize = x+1;
+		decoder->private_->frame->header.blocksize = x+1;
 	}
 
 	if(sample_rate_hint) {
@@ -761,11 +818,11 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 			x = (x << 8) | _x;
 		}
 		if(sample_rate_hint == 12)
-			decoder->private_->frame.header.sample_rate = x*1000;
+			decoder->private_->frame->header.sample_rate = x*1000;
 		else if(sample_rate_hint == 13)
-			decoder->private_->frame.header.sample_rate = x;
+			decoder->private_->frame->header.sample_rate = x;
 		else
-			decoder->private_->frame.header.sample_rate = x*10;
+			decoder->private_->frame->header.sample_rate = x*10;
 	}
 
 	/* read the CRC-8 byte */
@@ -781,26 +838,26 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 
 	/* calculate the sample number from the frame number if needed */
 	decoder->private_->next_fixed_block_size = 0;
-	if(decoder->private_->frame.header.number_type == FLAC__FRAME_NUMBER_TYPE_FRAME_NUMBER) {
-		x = decoder->private_->frame.header.number.frame_number;
-		decoder->private_->frame.header.number_type = FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER;
+	if(decoder->private_->frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_FRAME_NUMBER) {
+		x = decoder->private_->frame->header.number.frame_number;
+		decoder->private_->frame->header.number_type = FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER;
 		if(decoder->private_->fixed_block_size)
-			decoder->private_->frame.header.number.sample_number = (FLAC__uint64)decoder->private_->fixed_block_size * (FLAC__uint64)x;
+			decoder->private_->frame->header.number.sample_number = (FLAC__uint64)decoder->private_->fixed_block_size * (FLAC__uint64)x;
 		else if(decoder->private_->has_stream_info) {
-			if(decoder->private_->stream_info.data.stream_info.min_blocksize == decoder->private_->stream_info.data.stream_info.max_blocksize) {
-				decoder->private_->frame.header.number.sample_number = (FLAC__uint64)decoder->private_->stream_info.data.stream_info.min_blocksize * (FLAC__uint64)x;
-				decoder->private_->next_fixed_block_size = decoder->private_->stream_info.data.stream_info.max_blocksize;
+			if(decoder->private_->stream_info.min_blocksize == decoder->private_->stream_info.max_blocksize) {
+				decoder->private_->frame->header.number.sample_number = (FLAC__uint64)decoder->private_->stream_info.min_blocksize * (FLAC__uint64)x;
+				decoder->private_->next_fixed_block_size = decoder->private_->stream_info.max_blocksize;
 			}
 			else
 				is_unparseable = true;
 		}
 		else if(x == 0) {
-			decoder->private_->frame.header.number.sample_number = 0;
-			decoder->private_->next_fixed_block_size = decoder->private_->frame.header.blocksize;
+			decoder->private_->frame->header.number.sample_number = 0;
+			decoder->private_->next_fixed_block_size = decoder->private_->frame->header.blocksize;
 		}
 		else {
 			/* can only get here if the stream has invalid frame numbering and no STREAMINFO, so assume it's not the last (possibly short) frame */
-			decoder->private_->frame.header.number.sample_number = (FLAC__uint64)decoder->private_->frame.header.blocksize * (FLAC__uint64)x;
+			decoder->private_->frame->header.number.sample_number = (FLAC__uint64)decoder->private_->frame->header.blocksize * (FLAC__uint64)x;
 		}
 	}
 
@@ -812,22 +869,23 @@ FLAC__bool read_frame_header_(FLAC__StreamDecoder *decoder)
 #if 1
 	{
 		FLAC__uint32 nMinBlocksize;
-		nMinBlocksize = ( decoder->private_->stream_info.data.stream_info.min_blocksize == decoder->private_->stream_info.data.stream_info.max_blocksize ) ? 1 : FLAC__MIN_BLOCK_SIZE;
-		if ( ( (FLAC__uint32)decoder->private_->frame.header.sample_rate > FLACD_MAX_SAMPLE_RATE ) ||
-			( (FLAC__uint32)decoder->private_->frame.header.sample_rate < FLACD_MIN_SAMPLE_RATE ) ||
-			( decoder->private_->frame.header.blocksize > FLAC__SPEC_MAX_BLOCK_SIZE ) ||	/* RCG3AFLDL4001ZDO P-00016 */
-			( (FLAC__uint32)decoder->private_->frame.header.blocksize < nMinBlocksize ) ||
-			( (FLAC__uint32)decoder->private_->frame.header.channels >  decoder->private_->supported_input_channels ) ) {
+		nMinBlocksize = ( decoder->private_->stream_info.min_blocksize == decoder->private_->stream_info.max_blocksize ) ? 1 : FLAC__MIN_BLOCK_SIZE;
+		if ( ( (FLAC__uint32)decoder->private_->frame->header.sample_rate > FLACD_MAX_SAMPLE_RATE ) ||
+			( (FLAC__uint32)decoder->private_->frame->header.sample_rate < FLACD_MIN_SAMPLE_RATE ) ||
+			( decoder->private_->frame->header.blocksize > decoder->private_->supported_max_blocksize ) ||	/* RCG3AFLDL4001ZDO P-00016 */
+			( (FLAC__uint32)decoder->private_->frame->header.blocksize < nMinBlocksize ) ||
+			( (FLAC__uint32)decoder->private_->frame->header.channels >  decoder->private_->supported_input_channels ) ) {
 				decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 				decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_UNSUPPORTED_STREAM;
 		}
-		if ( ( decoder->protected_->channels != 0U ) &&
+		if ( ( decoder->private_->accept_format_change == false ) &&
+			( decoder->protected_->channels != 0U ) &&
 			( decoder->protected_->bits_per_sample != 0U ) &&
 			( decoder->protected_->sample_rate != 0U ) &&
 			( decoder->protected_->blocksize != 0U ) ) {
-			if ( ( decoder->protected_->channels != decoder->private_->frame.header.channels ) ||
-				( decoder->protected_->bits_per_sample != decoder->private_->frame.header.bits_per_sample ) ||
-				( decoder->protected_->sample_rate != decoder->private_->frame.header.sample_rate ) ) {
+			if ( ( decoder->protected_->channels != decoder->private_->frame->header.channels ) ||
+				( decoder->protected_->bits_per_sample != decoder->private_->frame->header.bits_per_sample ) ||
+				( decoder->protected_->sample_rate != decoder->private_->frame->header.sample_rate ) ) {
 					decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 					decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_CHANGE_HEADER;
 			}
@@ -841,7 +899,9 @@ FLAC__bool read_subframe_(FLAC__StreamDecoder *decoder, unsigned channel, unsign
 {
 	FLAC__uint32 x;
 	FLAC__bool wasted_bits;
+#if 0
 	unsigned i;
+#endif
 
 	if(!FLAC__bitreader_read_raw_uint32(decoder->private_->input, &x, 8)) /* MAGIC NUMBER */
 		return false; /* read_callback_ sets the state for us */
@@ -853,11 +913,11 @@ FLAC__bool read_subframe_(FLAC__StreamDecoder *decoder, unsigned channel, unsign
 		unsigned u;
 		if(!FLAC__bitreader_read_unary_unsigned(decoder->private_->input, &u))
 			return false; /* read_callback_ sets the state for us */
-		decoder->private_->frame.subframes[channel].wasted_bits = u+1;
-		bps -= decoder->private_->frame.subframes[channel].wasted_bits;
+		decoder->private_->frame->subframes[channel].wasted_bits = u+1;
+		bps -= decoder->private_->frame->subframes[channel].wasted_bits;
 	}
 	else
-		decoder->private_->frame.subframes[channel].wasted_bits = 0;
+		decoder->private_->frame->subframes[channel].wasted_bits = 0;
 
 	/*
 	 * Lots of magic numbers here
@@ -868,7 +928,7 @@ FLAC__bool read_subframe_(FLAC__StreamDecoder *decoder, unsigned channel, unsign
 		return true;
 	}
 	else if(x == 0) {
-		if(!read_subframe_constant_(decoder, channel, bps, do_full_decode))
+		if(!read_subframe_constant_(decoder, channel, bps))
 			return false;
 	}
 	else if(x == 2) {
@@ -898,48 +958,52 @@ FLAC__bool read_subframe_(FLAC__StreamDecoder *decoder, unsigned channel, unsign
 			return true;
 	}
 
+	/* the wasted bits are restored by FLAC__stream_decoder_finish_block(), tile by tile */
+#if 0
 	if(wasted_bits && do_full_decode) {
-		x = decoder->private_->frame.subframes[channel].wasted_bits;
-		for(i = 0; i < decoder->private_->frame.header.blocksize; i++)
+		x = decoder->private_->frame->subframes[channel].wasted_bits;
+		for(i = 0; i < decoder->private_->frame->header.blocksize; i++)
 			decoder->private_->output[channel][i] <<= x;
 	}
+#endif
 
 	return true;
 }
 
-FLAC__bool read_subframe_constant_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, FLAC__bool do_full_decode)
+FLAC__bool read_subframe_constant_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps)
 {
-	FLAC__Subframe_Constant *subframe = &decoder->private_->frame.subframes[channel].data.constant;
+	FLAC__Subframe_Constant *subframe = &decoder->private_->frame->subframes[channel].data.constant;
 	FLAC__int32 x;
-	unsigned i;
-	FLAC__int32 *output = decoder->private_->output[channel];
 
-	decoder->private_->frame.subframes[channel].type = FLAC__SUBFRAME_TYPE_CONSTANT;
+	decoder->private_->frame->subframes[channel].type = FLAC__SUBFRAME_TYPE_CONSTANT;
 
 	if(!FLAC__bitreader_read_raw_int32(decoder->private_->input, &x, bps))
 		return false; /* read_callback_ sets the state for us */
 
 	subframe->value = x;
 
-	/* decode the subframe */
-	if(do_full_decode) {
-		for(i = 0; i < decoder->private_->frame.header.blocksize; i++)
-			output[i] = x;
-	}
+	/* the value is kept symbolically; resolve_constants_() fills the row only when it is needed */
 
 	return true;
 }
 
 FLAC__bool read_subframe_fixed_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, const unsigned order, FLAC__bool do_full_decode)
 {
-	FLAC__Subframe_Fixed *subframe = &decoder->private_->frame.subframes[channel].data.fixed;
+	FLAC__Subframe_Fixed *subframe = &decoder->private_->frame->subframes[channel].data.fixed;
 	FLAC__int32 i32;
 	FLAC__uint32 u32;
 	unsigned u;
+#if 1
+	restore_info_ restore;
+#endif
 
-	decoder->private_->frame.subframes[channel].type = FLAC__SUBFRAME_TYPE_FIXED;
+	decoder->private_->frame->subframes[channel].type = FLAC__SUBFRAME_TYPE_FIXED;
 
+#if 1
+	subframe->residual = (decoder->private_->residual[channel] != NULL) ? decoder->private_->residual[channel] + order : NULL;
+#else
 	subframe->residual = decoder->private_->residual[channel] + order;
+#endif
 	subframe->order = order;
 
 	/* read warm-up samples */
@@ -959,7 +1023,11 @@ FLAC__bool read_subframe_fixed_(FLAC__StreamDecoder *decoder, unsigned channel,
 			if(!FLAC__bitreader_read_raw_uint32(decoder->private_->input, &u32, FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE_ORDER_LEN))
 				return false; /* read_callback_ sets the state for us */
 			subframe->entropy_coding_method.data.partitioned_rice.order = u32;
+#if 0
 			subframe->entropy_coding_method.data.partitioned_rice.contents = &decoder->private_->partitioned_rice_contents[channel];
+#else
+			subframe->entropy_coding_method.data.partitioned_rice.contents = NULL;
+#endif
 			break;
 		default:
 			decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_UNPARSEABLE_STREAM;
@@ -967,36 +1035,59 @@ FLAC__bool read_subframe_fixed_(FLAC__StreamDecoder *decoder, unsigned channel,
 			return true;
 	}
 
+#if 1
+	/* decode the subframe while reading the residual */
+	restore.type = RESTORE_NONE;
+	if(do_full_decode) {
+		flacd_MemCpy(decoder->private_->output[channel], subframe->warmup, (ACMW_INT32)(sizeof(FLAC__int32) * order));
+		restore.type = RESTORE_FIXED;
+		restore.order = order;
+		restore.qlp_coeff = NULL;
+		restore.quantization_level = 0;
+		restore.data = decoder->private_->output[channel] + order;
+		restore.restored = 0;
+	}
+#endif
+
 	/* read residual */
 	switch(subframe->entropy_coding_method.type) {
 		case FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE:
 		case FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2:
-			if(!read_residual_partitioned_rice_(decoder, order, subframe->entropy_coding_method.data.partitioned_rice.order, &decoder->private_->partitioned_rice_contents[channel], decoder->private_->residual[channel] + order, /*is_extended=*/subframe->entropy_coding_method.type == FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2))
+			if(!read_residual_partitioned_rice_(decoder, order, subframe->entropy_coding_method.data.partitioned_rice.order, NULL, (FLAC__int32*)subframe->residual, /*is_extended=*/subframe->entropy_coding_method.type == FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2, &restore))
 				return false;
 			break;
 		default:
 			FLAC__ASSERT(0);
 	}
 
+#if 0
 	/* decode the subframe */
 	if(do_full_decode) {
 		flacd_MemCpy(decoder->private_->output[channel], subframe->warmup, (ACMW_INT32)(sizeof(FLAC__int32) * order));
-		FLAC__fixed_restore_signal(decoder->private_->residual[channel] + order, decoder->private_->frame.header.blocksize-order, order, decoder->private_->output[channel]+order);
+		FLAC__fixed_restore_signal(decoder->private_->residual[channel] + order, decoder->private_->frame->header.blocksize-order, order, decoder->private_->output[channel]+order);
 	}
+#endif
 
 	return true;
 }
 
 FLAC__bool read_subframe_lpc_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, const unsigned order, FLAC__bool do_full_decode)
 {
-	FLAC__Subframe_LPC *subframe = &decoder->private_->frame.subframes[channel].data.lpc;
+	FLAC__Subframe_LPC *subframe = &decoder->private_->frame->subframes[channel].data.lpc;
 	FLAC__int32 i32;
 	FLAC__uint32 u32;
 	unsigned u;
+#if 1
+	restore_info_ restore;
+#endif
 
-	decoder->private_->frame.subframes[channel].type = FLAC__SUBFRAME_TYPE_LPC;
+	decoder->private_->frame->subframes[channel].type = FLAC__SUBFRAME_TYPE_LPC;
 
+#if 1
+	subframe->residual = (decoder->private_->residual[channel] != NULL) ? decoder->private_->residual[channel] + order : NULL;	/* order - renesas */
+#else
 	subframe->residual = decoder->private_->residual[channel] + order;	/* order - renesas */
+#endif
 	subframe->order = order;
 
 	/* read warm-up samples */
@@ -1038,7 +1129,11 @@ FLAC__bool read_subframe_lpc_(FLAC__StreamDecoder *decoder, unsigned channel, un
 			if(!FLAC__bitreader_read_raw_uint32(decoder->private_->input, &u32, FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE_ORDER_LEN))
 				return false; /* read_callback_ sets the state for us */
 			subframe->entropy_coding_method.data.partitioned_rice.order = u32;
+#if 0
 			subframe->entropy_coding_method.data.partitioned_rice.contents = &decoder->private_->partitioned_rice_contents[channel];
+#else
+			subframe->entropy_coding_method.data.partitioned_rice.contents = NULL;
+#endif
 			break;
 		default:
 			decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_UNPARSEABLE_STREAM;
@@ -1046,17 +1141,35 @@ FLAC__bool read_subframe_lpc_(FLAC__StreamDecoder *decoder, unsigned channel, un
 			return true;
 	}
 
+#if 1
+	/* decode the subframe while reading the residual */
+	restore.type = RESTORE_NONE;
+	if(do_full_decode) {
+		flacd_MemCpy(decoder->private_->output[channel], subframe->warmup, (ACMW_INT32)(sizeof(FLAC__int32) * order));
+		if(bps + subframe->qlp_coeff_precision + FLAC__bitmath_ilog2(order) <= 32)
+			restore.type = RESTORE_LPC;
+		else
+			restore.type = RESTORE_LPC_64BIT;
+		restore.order = order;
+		restore.qlp_coeff = subframe->qlp_coeff;
+		restore.quantization_level = subframe->quantization_level;
+		restore.data = decoder->private_->output[channel] + order;
+		restore.restored = 0;
+	}
+#endif
+
 	/* read residual */
 	switch(subframe->entropy_coding_method.type) {
 		case FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE:
 		case FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2:
-			if(!read_residual_partitioned_rice_(decoder, order, subframe->entropy_coding_method.data.partitioned_rice.order, &decoder->private_->partitioned_rice_contents[channel], decoder->private_->residual[channel] + order, /*is_extended=*/subframe->entropy_coding_method.type == FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2))
+			if(!read_residual_partitioned_rice_(decoder, order, subframe->entropy_coding_method.data.partitioned_rice.order, NULL, (FLAC__int32*)subframe->residual, /*is_extended=*/subframe->entropy_coding_method.type == FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2, &restore))
 				return false;
 			break;
 		default:
 			FLAC__ASSERT(0);
 	}
 
+#if 0
 	/* decode the subframe */
 	if(do_full_decode) {
 		flacd_MemCpy(decoder->private_->output[channel], subframe->warmup, (ACMW_INT32)(sizeof(FLAC__int32) * order));
@@ -1065,52 +1178,60 @@ FLAC__bool read_subframe_lpc_(FLAC__StreamDecoder *decoder, unsigned channel, un
 		*/
 		if(bps + subframe->qlp_coeff_precision + FLAC__bitmath_ilog2(order) <= 32)
 			if(bps <= 16 && subframe->qlp_coeff_precision <= 16)	/* Reference Program : FLAC 1.3.1 (25-Nov-2014) ... delete */ /* RCG3AFLDL4001ZDO P-00004 */
-				decoder->private_->local_lpc_restore_signal_16bit(decoder->private_->residual[channel] + order, decoder->private_->frame.header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
+				decoder->private_->local_lpc_restore_signal_16bit(decoder->private_->residual[channel] + order, decoder->private_->frame->header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
 			else
-				decoder->private_->local_lpc_restore_signal(decoder->private_->residual[channel] + order, decoder->private_->frame.header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
+				decoder->private_->local_lpc_restore_signal(decoder->private_->residual[channel] + order, decoder->private_->frame->header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
 		else
-			decoder->private_->local_lpc_restore_signal_64bit(decoder->private_->residual[channel] + order, decoder->private_->frame.header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
+			decoder->private_->local_lpc_restore_signal_64bit(decoder->private_->residual[channel] + order, decoder->private_->frame->header.blocksize-order, subframe->qlp_coeff, order, subframe->quantization_level, decoder->private_->output[channel]+order);
 	}
+#endif
 
 	return true;
 }
 
 FLAC__bool read_subframe_verbatim_(FLAC__StreamDecoder *decoder, unsigned channel, unsigned bps, FLAC__bool do_full_decode)
 {
-	FLAC__Subframe_Verbatim *subframe = &decoder->private_->frame.subframes[channel].data.verbatim;
+	FLAC__Subframe_Verbatim *subframe = &decoder->private_->frame->subframes[channel].data.verbatim;
 	FLAC__int32 x, *residual = decoder->private_->residual[channel];
 	unsigned i;
 
-	decoder->private_->frame.subframes[channel].type = FLAC__SUBFRAME_TYPE_VERBATIM;
+	decoder->private_->frame->subframes[channel].type = FLAC__SUBFRAME_TYPE_VERBATIM;
 
 	subframe->data = residual;
 
-	for(i = 0; i < decoder->private_->frame.header.blocksize; i++) {
+	for(i = 0; i < decoder->private_->frame->header.blocksize; i++) {
 		if(!FLAC__bitreader_read_raw_int32(decoder->private_->input, &x, bps))
 			return false; /* read_callback_ sets the state for us */
+#if 1
+		if(residual != NULL)
+#endif
 		residual[i] = x;
 	}
 
 	/* decode the subframe */
 	if(do_full_decode)
-		flacd_MemCpy(decoder->private_->output[channel], subframe->data, (ACMW_INT32)(sizeof(FLAC__int32) * decoder->private_->frame.header.blocksize));
+		flacd_MemCpy(decoder->private_->output[channel], subframe->data, (ACMW_INT32)(sizeof(FLAC__int32) * decoder->private_->frame->header.blocksize));
 
 	return true;
 }
 
+#if 1
+FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigned predictor_order, unsigned partition_order, FLAC__EntropyCodingMethod_PartitionedRiceContents *partitioned_rice_contents, FLAC__int32 *residual, FLAC__bool is_extended, restore_info_ *restore)
+#else
 FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigned predictor_order, unsigned partition_order, FLAC__EntropyCodingMethod_PartitionedRiceContents *partitioned_rice_contents, FLAC__int32 *residual, FLAC__bool is_extended)
+#endif
 {
 	FLAC__uint32 rice_parameter;
 	int i;
 	unsigned partition, sample, u;
 	const unsigned partitions = 1u << partition_order;
-	const unsigned partition_samples = partition_order > 0? decoder->private_->frame.header.blocksize >> partition_order : decoder->private_->frame.header.blocksize - predictor_order;
+	const unsigned partition_samples = partition_order > 0? decoder->private_->frame->header.blocksize >> partition_order : decoder->private_->frame->header.blocksize - predictor_order;
 	const unsigned plen = is_extended? FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2_PARAMETER_LEN : FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE_PARAMETER_LEN;
 	const unsigned pesc = is_extended? FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE2_ESCAPE_PARAMETER : FLAC__ENTROPY_CODING_METHOD_PARTITIONED_RICE_ESCAPE_PARAMETER;
 
 	/* sanity checks */
 	if(partition_order == 0) {
-		if(decoder->private_->frame.header.blocksize < predictor_order) {
+		if(decoder->private_->frame->header.blocksize < predictor_order) {
 			decoder->protected_->error_state = FLAC__STREAM_DECODER_ERROR_STATUS_LOST_SYNC;
 			decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
 			/* We have received a potentially malicious bit stream. All we can do is error out to avoid a heap overflow. */
@@ -1145,6 +1266,14 @@ FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigne
 			partitioned_rice_contents->raw_bits[partition] = 0;
 #endif
 			u = (partition_order == 0 || partition > 0)? partition_samples : partition_samples - predictor_order;
+#if 1
+			/* a channel that is not decoded is only skipped */
+			if(residual == NULL) {
+				if(!FLAC__bitreader_skip_rice_signed_block(decoder->private_->input, u, rice_parameter))
+					return false; /* read_callback_ sets the state for us */
+			}
+			else
+#endif
 			/* Reference Program : FLAC 1.3.1 (25-Nov-2014) ... change */ /* RCG3AFLDL4001ZDO P-00007 */
 			if(!FLAC__bitreader_read_rice_signed_block(decoder->private_->input, residual + sample, u, rice_parameter))
 				return false; /* read_callback_ sets the state for us */
@@ -1159,14 +1288,138 @@ FLAC__bool read_residual_partitioned_rice_(FLAC__StreamDecoder *decoder, unsigne
 			for(u = (partition_order == 0 || partition > 0)? 0 : predictor_order; u < partition_samples; u++, sample++) {
 				if(!FLAC__bitreader_read_raw_int32(decoder->private_->input, &i, rice_parameter))
 					return false; /* read_callback_ sets the state for us */
+#if 1
+				if(residual != NULL)
+#endif
 				residual[sample] = i;
 			}
 		}
+#if 1
+		/* restore the signal once a tile of residual is ready, while it is still in the cache */
+		if((restore->type != RESTORE_NONE) && ((sample - restore->restored >= FLACD_TILE_SIZE) || (partition + 1 == partitions)))
+			restore_tile_(restore, residual, sample);
+#endif
+	}
+
+	return true;
+}
+
+#if 1
+void restore_tile_(restore_info_ *restore, const FLAC__int32 *residual, unsigned end)
+{
+	const unsigned start = restore->restored;
+	const unsigned len = end - start;
+
+	switch(restore->type) {
+		case RESTORE_FIXED:
+			FLAC__fixed_restore_signal(residual + start, len, restore->order, restore->data + start);
+			break;
+		case RESTORE_LPC:
+			FLAC__lpc_restore_signal(residual + start, len, restore->qlp_coeff, restore->order, restore->quantization_level, restore->data + start);
+			break;
+		case RESTORE_LPC_64BIT:
+			FLAC__lpc_restore_signal_wide(residual + start, len, restore->qlp_coeff, restore->order, restore->quantization_level, restore->data + start);
+			break;
+		case RESTORE_NONE:
+		default:
+			break;
 	}
+	restore->restored = end;
+}
 
+/*
+ * Give the scratch rows to the channels of the frame that are decoded:
+ * the channels below supported_output_channels that are in channel_mask.
+ * The other channels get no row and are only parsed. Both channels of a
+ * decorrelated stereo pair are needed to undo the channel coding.
+ */
+FLAC__bool assign_rows_(FLAC__StreamDecoder *decoder)
+{
+	const unsigned channels = decoder->private_->frame->header.channels;
+	const FLAC__uint32 mask = (decoder->private_->channel_mask != 0) ? decoder->private_->channel_mask : 0xffffffff;
+	FLAC__bool decode[FLAC__MAX_CHANNELS];
+	unsigned channel, row = 0;
+
+	for(channel = 0; channel < FLAC__MAX_CHANNELS; channel++)
+		decode[channel] = (channel < channels) && (channel < decoder->private_->supported_output_channels) && ((mask >> channel) & 1);
+	if((decoder->private_->frame->header.channel_assignment != FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT) && (decode[0] || decode[1]))
+		decode[0] = decode[1] = true;
+
+	for(channel = 0; channel < FLAC__MAX_CHANNELS; channel++) {
+		FLAC__int32 *data = NULL;
+		if(decode[channel]) {
+			if(row >= FLAC__MAX_CHANNELS || decoder->private_->row[row] == NULL)
+				return false;
+			data = decoder->private_->row[row++];
+		}
+		decoder->private_->residual[channel] = data;
+		decoder->private_->output[channel] = data;
+	}
 	return true;
 }
 
+/*
+ * Keep the decoded constant subframes as one finished value each, so that
+ * FLAC__stream_decoder_finish_block() and the output stage do not walk
+ * blocksize copies of it. A constant channel of a stereo pair whose other
+ * channel is not constant is filled into its row, because the channel
+ * coding is undone sample by sample.
+ */
+void resolve_constants_(FLAC__StreamDecoder *decoder)
+{
+	const FLAC__Frame *frame = decoder->private_->frame;
+	FLAC__int32 *value = decoder->private_->constant_value;
+	FLAC__uint32 mask = 0;
+	FLAC__int32 mid, side;
+	unsigned channel, i;
+
+	for(channel = 0; channel < frame->header.channels; channel++) {
+		if((decoder->private_->output[channel] != NULL) && (frame->subframes[channel].type == FLAC__SUBFRAME_TYPE_CONSTANT)) {
+			value[channel] = frame->subframes[channel].data.constant.value;
+			mask |= (FLAC__uint32)1 << channel;
+		}
+	}
+
+	if((frame->header.channel_assignment != FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT) && ((mask & 3) != 0)) {
+		if((mask & 3) == 3) {
+			value[0] <<= frame->subframes[0].wasted_bits;
+			value[1] <<= frame->subframes[1].wasted_bits;
+			switch(frame->header.channel_assignment) {
+				case FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE:
+					value[1] = value[0] - value[1];
+					break;
+				case FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE:
+					value[0] += value[1];
+					break;
+				case FLAC__CHANNEL_ASSIGNMENT_MID_SIDE:
+					mid = value[0];
+					side = value[1];
+					mid <<= 1;
+					mid |= (side & 1); /* i.e. if 'side' is odd... */
+					value[0] = (mid + side) >> 1;
+					value[1] = (mid - side) >> 1;
+					break;
+				default:
+					FLAC__ASSERT(0);
+					break;
+			}
+			decoder->private_->constant_mask = mask;
+			return;
+		}
+		channel = ((mask & 1) != 0) ? 0 : 1;
+		for(i = 0; i < frame->header.blocksize; i++)
+			decoder->private_->output[channel][i] = value[channel];
+		mask &= ~(FLAC__uint32)3;
+	}
+
+	for(channel = 0; channel < frame->header.channels; channel++) {
+		if((mask >> channel) & 1)
+			value[channel] <<= frame->subframes[channel].wasted_bits;
+	}
+	decoder->private_->constant_mask = mask;
+}
+#endif
+
 FLAC__bool read_zero_padding_(FLAC__StreamDecoder *decoder)
 {
 	if(!FLAC__bitreader_is_consumed_byte_aligned(decoder->private_->input)) {
@@ -1193,20 +1446,38 @@ FLAC_API void FLAC__stream_decoder_set_supported_channels(FLAC__StreamDecoder* c
 	return ;
 }
 
+FLAC_API void FLAC__stream_decoder_set_supported_blocksize(FLAC__StreamDecoder* const decoder, unsigned const max_blocksize)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	
+	decoder->private_->supported_max_blocksize = max_blocksize;
+
+	return ;
+}
+
 FLAC_API void FLAC__stream_decoder_set_streaminfo(FLAC__StreamDecoder* const decoder, const flacd_decConfigInfo* const pDecConfigInfo )
 {
 	FLAC__ASSERT(0 != decoder);
 	FLAC__ASSERT(0 != decoder->private_);
 	
 	if ( pDecConfigInfo != NULL ) {
-		decoder->private_->stream_info.data.stream_info.min_blocksize = pDecConfigInfo->nMinBlockSize;
-		decoder->private_->stream_info.data.stream_info.max_blocksize = pDecConfigInfo->nMaxBlockSize;
-		decoder->private_->stream_info.data.stream_info.min_framesize = pDecConfigInfo->nMinFrameSize;
-		decoder->private_->stream_info.data.stream_info.max_framesize = pDecConfigInfo->nMaxFrameSize;
-		decoder->private_->stream_info.data.stream_info.sample_rate = pDecConfigInfo->nSampleRate;
-		decoder->private_->stream_info.data.stream_info.channels = pDecConfigInfo->nChannels;
-		decoder->private_->stream_info.data.stream_info.bits_per_sample = pDecConfigInfo->nBitsPerSample;
+		decoder->private_->stream_info.min_blocksize = pDecConfigInfo->nMinBlockSize;
+		decoder->private_->stream_info.max_blocksize = pDecConfigInfo->nMaxBlockSize;
+#if 0
+		decoder->private_->stream_info.min_framesize = pDecConfigInfo->nMinFrameSize;
+		decoder->private_->stream_info.max_framesize = pDecConfigInfo->nMaxFrameSize;
+#endif
+		decoder->private_->stream_info.sample_rate = pDecConfigInfo->nSampleRate;
+#if 0
+		decoder->private_->stream_info.channels = pDecConfigInfo->nChannels;
+#endif
+		decoder->private_->stream_info.bits_per_sample = pDecConfigInfo->nBitsPerSample;
 		decoder->private_->has_stream_info = true;
+		/* a stream of another fixed block size (format change) numbers its frames by it */
+		if ( ( decoder->private_->fixed_block_size != 0U ) && ( pDecConfigInfo->nMinBlockSize == pDecConfigInfo->nMaxBlockSize ) ) {
+			decoder->private_->fixed_block_size = pDecConfigInfo->nMaxBlockSize;
+		}
 	}
 	return ;
 }
@@ -1249,11 +1520,21 @@ FLAC_API void FLAC__stream_decoder_allocate_residual(FLAC__StreamDecoder* const
 		} else {
 			decoder->private_->residual[i] = (FLAC__int32*)NULL;
 		}
+		decoder->private_->row[i] = decoder->private_->residual[i];
 	}
 
 	return ;
 }
 
+FLAC_API void FLAC__stream_decoder_allocate_frame(FLAC__StreamDecoder* const decoder, FLAC__Frame* const pFrame)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	decoder->private_->frame = pFrame;
+
+	return ;
+}
+
 FLAC_API void FLAC__stream_decoder_allocate_output(FLAC__StreamDecoder* const decoder, FLAC__int32** const pOutput)
 {
 	unsigned i;
@@ -1317,5 +1598,141 @@ FLAC_API FLAC__bool FLAC__stream_decoder_process_read_frame(FLAC__StreamDecoder*
 			return false;
 	}
 }
+
+/*
+ * Restore the wasted bits and undo the channel coding of samples
+ * [offset, offset + length) of the last frame read. Each sample must be
+ * finished exactly once, after a frame with a good CRC.
+ */
+FLAC_API void FLAC__stream_decoder_finish_block(FLAC__StreamDecoder* const decoder, unsigned const offset, unsigned const length)
+{
+	unsigned channel, i;
+	unsigned channels;
+	unsigned x;
+	FLAC__int32 mid, side;
+	FLAC__int32 *out0, *out1;
+
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+
+	/* only the fully decoded channels */
+	channels = decoder->private_->frame->header.channels;
+	if(channels > decoder->private_->supported_output_channels)
+		channels = decoder->private_->supported_output_channels;
+
+	for(channel = 0; channel < channels; channel++) {
+		x = decoder->private_->frame->subframes[channel].wasted_bits;
+#if 1
+		if((decoder->private_->output[channel] == NULL) || ((decoder->private_->constant_mask >> channel) & 1))
+			continue;
+#endif
+		if(x != 0) {
+			out0 = decoder->private_->output[channel] + offset;
+			for(i = 0; i < length; i++)
+				out0[i] <<= x;
+		}
+	}
+
+#if 1
+	/* a stereo pair is decoded together or not at all, and is constant together or not at all */
+	if((decoder->private_->output[0] == NULL) || ((decoder->private_->constant_mask & 1) != 0))
+		return;
+#endif
+	out0 = decoder->private_->output[0] + offset;
+	out1 = decoder->private_->output[1] + offset;
+	switch(decoder->private_->frame->header.channel_assignment) {
+		case FLAC__CHANNEL_ASSIGNMENT_INDEPENDENT:
+			/* do nothing */
+			break;
+		case FLAC__CHANNEL_ASSIGNMENT_LEFT_SIDE:
+			FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+			for(i = 0; i < length; i++)
+				out1[i] = out0[i] - out1[i];
+			break;
+		case FLAC__CHANNEL_ASSIGNMENT_RIGHT_SIDE:
+			FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+			for(i = 0; i < length; i++)
+				out0[i] += out1[i];
+			break;
+		case FLAC__CHANNEL_ASSIGNMENT_MID_SIDE:
+			FLAC__ASSERT(decoder->private_->frame->header.channels == 2);
+			for(i = 0; i < length; i++) {
+				mid = out0[i];
+				side = out1[i];
+				mid <<= 1;
+				mid |= (side & 1); /* i.e. if 'side' is odd... */
+				out0[i] = (mid + side) >> 1;
+				out1[i] = (mid - side) >> 1;
+			}
+			break;
+		default:
+			FLAC__ASSERT(0);
+			break;
+	}
+}
+
+FLAC_API FLAC__bool FLAC__stream_decoder_process_frame_header(FLAC__StreamDecoder* const decoder, FLAC__bool* const got_a_header)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->protected_);
+
+	*got_a_header = false;
+	if(decoder->protected_->state != FLAC__STREAM_DECODER_READ_FRAME)
+		return true;
+	if(!read_frame_header_(decoder))
+		return false;
+	if(decoder->protected_->state == FLAC__STREAM_DECODER_READ_FRAME) {
+		/* the subframes are not read; look for the next frame */
+		*got_a_header = true;
+		decoder->protected_->state = FLAC__STREAM_DECODER_SEARCH_FOR_FRAME_SYNC;
+	}
+	return true;
+}
+
+FLAC_API FLAC__uint64 FLAC__stream_decoder_get_sample_number(const FLAC__StreamDecoder* const decoder)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	FLAC__ASSERT(decoder->private_->frame->header.number_type == FLAC__FRAME_NUMBER_TYPE_SAMPLE_NUMBER);
+	return decoder->private_->frame->header.number.sample_number;
+}
+
+FLAC_API unsigned FLAC__stream_decoder_get_frame_blocksize(const FLAC__StreamDecoder* const decoder)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	return decoder->private_->frame->header.blocksize;
+}
+
+FLAC_API void FLAC__stream_decoder_set_channel_mask(FLAC__StreamDecoder* const decoder, FLAC__uint32 const mask)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	decoder->private_->channel_mask = mask;
+}
+
+FLAC_API void FLAC__stream_decoder_set_format_change(FLAC__StreamDecoder* const decoder, FLAC__bool const accept)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	decoder->private_->accept_format_change = accept;
+}
+
+FLAC_API FLAC__int32 *FLAC__stream_decoder_get_channel_data(const FLAC__StreamDecoder* const decoder, unsigned const channel)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	return (channel < FLAC__MAX_CHANNELS) ? decoder->private_->output[channel] : NULL;
+}
+
+FLAC_API FLAC__bool FLAC__stream_decoder_get_channel_constant(const FLAC__StreamDecoder* const decoder, unsigned const channel, FLAC__int32* const value)
+{
+	FLAC__ASSERT(0 != decoder);
+	FLAC__ASSERT(0 != decoder->private_);
+	if((channel >= FLAC__MAX_CHANNELS) || (((decoder->private_->constant_mask >> channel) & 1) == 0))
+		return false;
+	*value = decoder->private_->constant_value[channel];
+	return true;
+}
 #endif
 
@@ -0,0 +1,131 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_test.h
+* Description  : Header file for the test program
+******************************************************************************/
+#ifndef FLACD_TEST_H
+#define FLACD_TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flacd_Lib.h"
+
+/*==========================================================================*/
+/*      Check Macro                                                         */
+/*==========================================================================*/
+#define TEST_CHECK(cond)	do { \
+	if ( !(cond) ) { \
+		printf( "  %s:%d: check failed: %s\n", __FILE__, __LINE__, #cond ); \
+		return 1; \
+	} \
+} while ( 0 )
+
+/*==========================================================================*/
+/*      Define Struct test_streamConfig                                     */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Test Stream Config Structure                                           */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   The stream is made by the encoder of the test program. Frames use      */
+/*   CONSTANT, VERBATIM, FIXED and LPC subframes in turn and, for 2         */
+/*   channels, each stereo decorrelation in turn. nConstMask channels hold  */
+/*   one value of their own, nSilentMask channels are 0. bVariable gives    */
+/*   the frames varying block sizes up to nBlockSize. nSeekPoints > 0 adds  */
+/*   a SEEKTABLE. bNoHeader leaves out the "fLaC" marker and metadata.      */
+/*   nFirstFrame is the number of the first frame of a fixed block size     */
+/*   stream, to make the frames of a part of a longer stream.               */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT32	nChannels;
+	ACMW_UINT32	nBitsPerSample;
+	ACMW_UINT32	nSampleRate;
+	ACMW_UINT32	nBlockSize;
+	ACMW_UINT32	nSamples;
+	ACMW_UINT32	nConstMask;
+	ACMW_UINT32	nSilentMask;
+	ACMW_UINT32	bVariable;
+	ACMW_UINT32	nSeekPoints;
+	ACMW_UINT32	bNoHeader;
+	ACMW_UINT32	nSeed;
+	ACMW_UINT32	nFirstFrame;
+} test_streamConfig;
+
+/*==========================================================================*/
+/*      Define Struct test_stream                                           */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Test Stream Structure                                                  */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   pSamples holds the samples of each channel one after the other         */
+/*   (nSamples per channel). Frame n starts at byte pFrameOffset[n] of      */
+/*   pData and at sample pFrameSample[n].                                   */
+/*==========================================================================*/
+typedef struct {
+	ACMW_UINT8	*pData;
+	ACMW_UINT32	nSize;
+	ACMW_UINT32	nAudioOffset;
+	ACMW_INT32	*pSamples;
+	ACMW_UINT32	nSamples;
+	ACMW_UINT32	nChannels;
+	ACMW_UINT32	nBitsPerSample;
+	ACMW_UINT32	*pFrameOffset;
+	ACMW_UINT32	*pFrameSample;
+	ACMW_UINT32	nFrames;
+	flacd_decConfigInfo	sDecConfig;
+} test_stream;
+
+/*==========================================================================*/
+/*      Define Struct test_decoder                                          */
+/*==========================================================================*/
+/* [Description]                                                            */
+/*   Test Decoder Instance Structure                                        */
+/*                                                                          */
+/* [Note]                                                                   */
+/*   One instance with its memory and nOutChannels output buffers of        */
+/*   nOutBuffSize bytes (one buffer for interleaved output).                */
+/*==========================================================================*/
+#define TEST_MAX_CHANNELS		6
+
+typedef struct {
+	flacd_initConfigInfo	sInitConfig;
+	flacd_getMemorySizeStatusInfo	sMemStatus;
+	flacd_workMemoryInfo	sWorkMem;
+	void		*pOutBuff[TEST_MAX_CHANNELS];
+	ACMW_UINT32	nOutBuffSize;
+	ACMW_UINT32	nOutChannels;
+	ACMW_UINT32	nSampleBytes;
+} test_decoder;
+
+/*==========================================================================*/
+/*      Function Prototype                                                  */
+/*==========================================================================*/
+/* flacd_test_stream.c */
+int test_StreamMake(const test_streamConfig* const pConfig, test_stream* const pStream);
+void test_StreamFree(test_stream* const pStream);
+ACMW_INT32 test_StreamSample(const test_stream* const pStream, const ACMW_UINT32 nChannel, const ACMW_UINT32 nSample);
+void test_Md5(const ACMW_UINT8* const pData, const ACMW_UINT32 nSize, ACMW_UINT8* const pDigest);
+
+/* flacd_test_main.c */
+int test_DecoderOpen(test_decoder* const pDecoder,
+					 const flacd_getMemorySizeConfigInfo* const pMemConfig,
+					 const flacd_initConfigInfo* const pInitConfig);
+void test_DecoderClose(test_decoder* const pDecoder);
+ACMW_INT32 test_DecodeAll(test_decoder* const pDecoder, const test_stream* const pStream,
+						  const ACMW_UINT32 nChunkSamples, void** const ppOut, ACMW_UINT32* const pDecoded);
+void** test_OutAlloc(const test_decoder* const pDecoder, const ACMW_UINT32 nSamples);
+void test_OutFree(void** const ppOut);
+int test_CheckOutput(const test_decoder* const pDecoder, const test_stream* const pStream, void* const * const ppOut,
+					 const ACMW_UINT32 nFirst, const ACMW_UINT32 nSamples, const ACMW_FLOAT32 fGain);
+ACMW_INT32 test_PcmValue(const test_stream* const pStream, const ACMW_INT32 nSample, const ACMW_UINT32 nOutBits);
+
+#endif	/* FLACD_TEST_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
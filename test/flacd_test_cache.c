@@ -0,0 +1,183 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_cache.c
+* Description : Tests of the decoded frame cache (flacd_SetFrameCache)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define CACHE_SLOTS		16U
+
+/* CRC-16 of the frame footer (polynomial x^16 + x^15 + x^2 + 1) continued from nCrc, 0 at the frame start */
+static ACMW_UINT32 cache_Crc16( ACMW_UINT32 nCrc, const ACMW_UINT8* const pData, const ACMW_UINT32 nSize )
+{
+	ACMW_UINT32 i, b;
+
+	for ( i = 0; i < nSize; i++ ) {
+		nCrc ^= (ACMW_UINT32)pData[i] << 8;
+		for ( b = 0; b < 8U; b++ ) {
+			nCrc = ( ( nCrc & 0x8000U ) != 0U ) ? ( ( nCrc << 1 ) ^ 0x8005U ) : ( nCrc << 1 );
+		}
+		nCrc &= 0xFFFFU;
+	}
+	return nCrc;
+}
+
+static void cache_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nChannels )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = nChannels;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 44100U;
+	pConfig->nBlockSize = 4096U;
+	pConfig->nSamples = 20000U;
+}
+
+/* open an instance for blocks of up to 4096 samples and set the cache in pCache */
+static int cache_Open( test_decoder* const pDecoder, const test_stream* const pStream, void* const pCache,
+					   const ACMW_UINT32 nCacheSize, const ACMW_UINT32 nMaxFrameSize )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	flacd_frameCacheConfigInfo sCacheConfig;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nMaxBlockSize = sInit.nMaxBlockSize = 4096U;
+	TEST_CHECK( test_DecoderOpen( pDecoder, &sMemConfig, &sInit ) == 0 );
+	memset( &sCacheConfig, 0, sizeof(sCacheConfig) );
+	sCacheConfig.pCache = pCache;
+	sCacheConfig.nCacheSize = nCacheSize;
+	sCacheConfig.nCacheMode = 1U;
+	sCacheConfig.nMaxBlockSize = pStream->sDecConfig.nMaxBlockSize;
+	sCacheConfig.nMaxFrameSize = nMaxFrameSize;
+	TEST_CHECK( flacd_SetFrameCache( &pDecoder->sWorkMem, &sCacheConfig ) == FLACD_RESULT_OK );
+	return 0;
+}
+
+/* decode the stream through the cache and compare the output */
+static int cache_Decode( const test_stream* const pStream, void* const pCache, const ACMW_UINT32 nCacheSize,
+						 const ACMW_UINT32 nMaxFrameSize, flacd_frameCacheStatusInfo* const pStatus )
+{
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nDecoded;
+
+	TEST_CHECK( cache_Open( &sDecoder, pStream, pCache, nCacheSize, nMaxFrameSize ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, pStream->nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, pStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == pStream->nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, pStream, ppOut, 0U, nDecoded, 1.0f ) == 0 );
+	TEST_CHECK( flacd_GetFrameCacheStatus( &sDecoder.sWorkMem, pStatus ) == FLACD_RESULT_OK );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+int test_FrameCacheHit( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_frameCacheStatusInfo sStatus;
+	flacd_frameCacheConfigInfo sCacheConfig;
+	ACMW_UINT32 nSlotSize, nLargest, nCacheSize;
+	void *pCache;
+
+	cache_StreamConfig( &sStreamConfig, 2U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+
+	/* slots sized from the stream : the frame bytes and a row per decoded channel */
+	nSlotSize = FLACD_FRAMECACHE_ENTRY_SIZE + ( ( sStream.sDecConfig.nMaxFrameSize + 7U ) & ~7U ) + ( 4096U * 2U * 4U );
+	nCacheSize = FLACD_FRAMECACHE_HEADER_SIZE + ( nSlotSize * CACHE_SLOTS );
+	pCache = calloc( nCacheSize, 1U );
+	TEST_CHECK( cache_Open( &sDecoder, &sStream, pCache, nCacheSize, sStream.sDecConfig.nMaxFrameSize ) == 0 );
+	TEST_CHECK( flacd_GetFrameCacheStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nSlotSize == nSlotSize );
+	TEST_CHECK( sStatus.nSlots == CACHE_SLOTS );
+	/* without a cache : a slot for the largest frame of the instance */
+	memset( &sCacheConfig, 0, sizeof(sCacheConfig) );
+	TEST_CHECK( flacd_SetFrameCache( &sDecoder.sWorkMem, &sCacheConfig ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetFrameCacheStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	nLargest = sStatus.nSlotSize;
+	TEST_CHECK( nLargest > nSlotSize );
+	/* no memory, or blocks larger than the instance decodes */
+	sCacheConfig.nCacheMode = 1U;
+	TEST_CHECK( flacd_SetFrameCache( &sDecoder.sWorkMem, &sCacheConfig ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	sCacheConfig.pCache = pCache;
+	sCacheConfig.nCacheSize = nCacheSize;
+	sCacheConfig.nMaxBlockSize = 4097U;
+	TEST_CHECK( flacd_SetFrameCache( &sDecoder.sWorkMem, &sCacheConfig ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	test_DecoderClose( &sDecoder );
+
+	/* the first pass stores every frame, the repeat takes every frame from the cache */
+	TEST_CHECK( cache_Decode( &sStream, pCache, nCacheSize, sStream.sDecConfig.nMaxFrameSize, &sStatus ) == 0 );
+	TEST_CHECK( ( sStatus.nEntries == sStream.nFrames ) && ( sStatus.nMisses == sStream.nFrames ) && ( sStatus.nHits == 0U ) );
+	TEST_CHECK( cache_Decode( &sStream, pCache, nCacheSize, sStream.sDecConfig.nMaxFrameSize, &sStatus ) == 0 );
+	TEST_CHECK( ( sStatus.nHits == sStream.nFrames ) && ( sStatus.nMisses == sStream.nFrames ) && ( sStatus.nEvictions == 0U ) );
+	free( pCache );
+
+	/* frames larger than the slots are decoded but not kept */
+	nSlotSize = FLACD_FRAMECACHE_ENTRY_SIZE + ( ( sStream.sDecConfig.nMinFrameSize + 7U ) & ~7U ) + ( 4096U * 2U * 4U );
+	nCacheSize = FLACD_FRAMECACHE_HEADER_SIZE + ( nSlotSize * CACHE_SLOTS );
+	pCache = calloc( nCacheSize, 1U );
+	TEST_CHECK( cache_Decode( &sStream, pCache, nCacheSize, sStream.sDecConfig.nMinFrameSize, &sStatus ) == 0 );
+	TEST_CHECK( ( sStatus.nEntries >= 1U ) && ( sStatus.nEntries < sStream.nFrames ) );
+	free( pCache );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_FrameCacheCollision( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream, sForged;
+	flacd_frameCacheStatusInfo sStatus;
+	ACMW_UINT32 nCacheSize, nEnd, nCrc, nHead, nValue, i;
+	ACMW_UINT8 *pFrame;
+	void *pCache;
+
+	/* a mono stream : frame 3 is VERBATIM, so any change of its sample bytes still decodes */
+	cache_StreamConfig( &sStreamConfig, 1U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sForged ) == 0 );
+	TEST_CHECK( sStream.nFrames > 3U );
+
+	/* change the low byte of the second last sample of frame 3 and make up the CRC-16 with the last sample */
+	pFrame = sForged.pData + sForged.pFrameOffset[3];
+	nEnd = sForged.pFrameOffset[4] - sForged.pFrameOffset[3] - 2U;
+	nCrc = cache_Crc16( 0U, pFrame, nEnd );
+	pFrame[nEnd - 3U] ^= 0x01U;
+	nHead = cache_Crc16( 0U, pFrame, nEnd - 2U );
+	for ( nValue = 0U; nValue < 0x10000U; nValue++ ) {
+		pFrame[nEnd - 2U] = (ACMW_UINT8)( nValue >> 8 );
+		pFrame[nEnd - 1U] = (ACMW_UINT8)nValue;
+		if ( cache_Crc16( nHead, pFrame + nEnd - 2U, 2U ) == nCrc ) {
+			break;
+		}
+	}
+	TEST_CHECK( nValue < 0x10000U );
+	TEST_CHECK( memcmp( pFrame + nEnd, sStream.pData + sStream.pFrameOffset[3] + nEnd, 2U ) == 0 );
+	i = sForged.pFrameSample[4] - 2U;
+	sForged.pSamples[i] ^= 0x01;
+	sForged.pSamples[i + 1U] = (ACMW_INT32)(ACMW_INT16)nValue;
+
+	/* the same size and CRC-16 but other bytes : decoded, not taken from the cache */
+	nCacheSize = FLACD_FRAMECACHE_HEADER_SIZE +
+				 ( ( FLACD_FRAMECACHE_ENTRY_SIZE + ( ( sStream.sDecConfig.nMaxFrameSize + 7U ) & ~7U ) + ( 4096U * 2U * 4U ) ) * CACHE_SLOTS );
+	pCache = calloc( nCacheSize, 1U );
+	TEST_CHECK( cache_Decode( &sStream, pCache, nCacheSize, sStream.sDecConfig.nMaxFrameSize, &sStatus ) == 0 );
+	TEST_CHECK( cache_Decode( &sForged, pCache, nCacheSize, sStream.sDecConfig.nMaxFrameSize, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nHits == ( sStream.nFrames - 1U ) );
+	TEST_CHECK( sStatus.nEntries == ( sStream.nFrames + 1U ) );
+	free( pCache );
+	test_StreamFree( &sForged );
+	test_StreamFree( &sStream );
+	return 0;
+}
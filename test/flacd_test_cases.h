@@ -0,0 +1,134 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/******************************************************************************
+* File Name    : flacd_test_cases.h
+* Description  : Test cases of the test program
+******************************************************************************/
+#ifndef FLACD_TEST_CASES_H
+#define FLACD_TEST_CASES_H
+
+/* flacd_test_output.c */
+int test_OutputPcm16(void);
+int test_OutputPcm24(void);
+int test_OutputFloat32(void);
+int test_OutputInterleaved(void);
+int test_OutputSixChannels(void);
+int test_OutputGain(void);
+int test_Version(void);
+int test_OutputChannelMask(void);
+int test_OutputConstant(void);
+
+/* flacd_test_mix.c */
+int test_MixRemap(void);
+int test_MixPreset(void);
+int test_MixMatrix(void);
+
+/* flacd_test_ring.c */
+int test_RingOutput(void);
+int test_RingParameter(void);
+
+/* flacd_test_drain.c */
+int test_DrainFrame(void);
+int test_TileBoundary(void);
+
+/* flacd_test_memory.c */
+int test_MemoryExactSize(void);
+int test_MemoryLargerStream(void);
+int test_ScratchPool(void);
+int test_StaticSize(void);
+int test_SlabHandles(void);
+
+/* flacd_test_session.c */
+int test_SessionDecode(void);
+int test_SessionSequence(void);
+
+/* flacd_test_header.c */
+int test_HeaderParse(void);
+int test_HeaderReject(void);
+
+/* flacd_test_seek.c */
+int test_SeekTable(void);
+int test_SeekLongStream(void);
+int test_SeekBisect(void);
+int test_SeekIndex(void);
+int test_SkipFrames(void);
+int test_ReadRange(void);
+
+/* flacd_test_cache.c */
+int test_FrameCacheHit(void);
+int test_FrameCacheCollision(void);
+
+/* flacd_test_oneshot.c */
+int test_DecodeStream(void);
+int test_DecodeStreamFrames(void);
+
+/* test/flacd_test_overview.c */
+int test_OverviewBuckets(void);
+int test_OverviewParameter(void);
+
+/* flacd_test_verify.c */
+int test_VerifyMd5(void);
+int test_VerifyIncomplete(void);
+int test_VerifyFrames(void);
+
+/* flacd_test_mixdown.c */
+int test_DecodeMixVoices(void);
+int test_DecodeMixParameter(void);
+
+/* flacd_test_format.c */
+int test_FormatChange(void);
+int test_FormatChangeReject(void);
+
+#define TEST_CASE_LIST \
+	TEST_CASE(test_OutputPcm16), \
+	TEST_CASE(test_OutputPcm24), \
+	TEST_CASE(test_OutputFloat32), \
+	TEST_CASE(test_OutputInterleaved), \
+	TEST_CASE(test_OutputSixChannels), \
+	TEST_CASE(test_OutputGain), \
+	TEST_CASE(test_Version), \
+	TEST_CASE(test_MixRemap), \
+	TEST_CASE(test_MixPreset), \
+	TEST_CASE(test_MixMatrix), \
+	TEST_CASE(test_RingOutput), \
+	TEST_CASE(test_RingParameter), \
+	TEST_CASE(test_DrainFrame), \
+	TEST_CASE(test_TileBoundary), \
+	TEST_CASE(test_MemoryExactSize), \
+	TEST_CASE(test_MemoryLargerStream), \
+	TEST_CASE(test_ScratchPool), \
+	TEST_CASE(test_StaticSize), \
+	TEST_CASE(test_SlabHandles), \
+	TEST_CASE(test_SessionDecode), \
+	TEST_CASE(test_SessionSequence), \
+	TEST_CASE(test_HeaderParse), \
+	TEST_CASE(test_HeaderReject), \
+	TEST_CASE(test_SeekTable), \
+	TEST_CASE(test_SeekLongStream), \
+	TEST_CASE(test_SeekBisect), \
+	TEST_CASE(test_SeekIndex), \
+	TEST_CASE(test_SkipFrames), \
+	TEST_CASE(test_OutputChannelMask), \
+	TEST_CASE(test_OutputConstant), \
+	TEST_CASE(test_FrameCacheHit), \
+	TEST_CASE(test_FrameCacheCollision), \
+	TEST_CASE(test_DecodeStream), \
+	TEST_CASE(test_DecodeStreamFrames), \
+	TEST_CASE(test_ReadRange), \
+	TEST_CASE(test_OverviewBuckets), \
+	TEST_CASE(test_OverviewParameter), \
+	TEST_CASE(test_VerifyMd5), \
+	TEST_CASE(test_VerifyIncomplete), \
+	TEST_CASE(test_VerifyFrames), \
+	TEST_CASE(test_DecodeMixVoices), \
+	TEST_CASE(test_DecodeMixParameter), \
+	TEST_CASE(test_FormatChange), \
+	TEST_CASE(test_FormatChangeReject)
+
+#endif	/* FLACD_TEST_CASES_H */
+/*==========================================================================*/
+/*      End of File                                                         */
+/*==========================================================================*/
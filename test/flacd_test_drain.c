@@ -0,0 +1,130 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_drain.c
+* Description : Tests of frames output over several calls and in tiles
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+static void drain_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nBlockSize )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = 2U;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 96000U;
+	pConfig->nBlockSize = nBlockSize;
+	pConfig->nSamples = 50000U;
+}
+
+/* decode with output buffers of nChunk samples and check that a frame is drained without reading input */
+static int drain_Check( const test_stream* const pStream, const ACMW_UINT32 nChunk )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nPos = pStream->nAudioOffset, nRemain = 0U, nDone = 0U;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, pStream->nSamples );
+	while ( ( nPos < pStream->nSize ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+		ACMW_UINT32 c;
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sBuffConfig.pInBuffStart = pStream->pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = pStream->nSize - nPos;
+		sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+		sBuffConfig.nOutBuffSize = nChunk * sDecoder.nSampleBytes;
+		sBuffStatus.pOutBuffLast = pLast;
+		TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &pStream->sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		if ( nRemain != 0U ) {
+			TEST_CHECK( sBuffStatus.nInBuffUsedDataSize == 0U );
+			TEST_CHECK( sDecStatus.nDecodedSamples == ( ( nRemain < nChunk ) ? nRemain : nChunk ) );
+		} else {
+			TEST_CHECK( sBuffStatus.nInBuffUsedDataSize != 0U );
+		}
+		TEST_CHECK( sDecStatus.nDecodedSamples <= nChunk );
+		TEST_CHECK( sDecStatus.nSamplePosition == nDone );
+		for ( c = 0; c < 2U; c++ ) {
+			memcpy( (ACMW_UINT8*)ppOut[c] + ( (size_t)nDone * sDecoder.nSampleBytes ), sDecoder.pOutBuff[c],
+					(size_t)sDecStatus.nDecodedSamples * sDecoder.nSampleBytes );
+		}
+		nDone += sDecStatus.nDecodedSamples;
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	TEST_CHECK( nDone == pStream->nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, pStream, ppOut, 0U, nDone, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+int test_DrainFrame( void )
+{
+	static const ACMW_UINT32 nChunk[4] = { 1U, 100U, 4095U, 16384U };
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	ACMW_UINT32 i;
+
+	drain_StreamConfig( &sStreamConfig, 16384U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	for ( i = 0; i < 4U; i++ ) {
+		TEST_CHECK( drain_Check( &sStream, nChunk[i] ) == 0 );
+	}
+	test_StreamFree( &sStream );
+
+	/* frames of varying sizes, some smaller than the output buffer */
+	sStreamConfig.nBlockSize = 4608U;
+	sStreamConfig.bVariable = 1U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	TEST_CHECK( drain_Check( &sStream, 1000U ) == 0 );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* block sizes around the tile size, with every stereo decorrelation */
+int test_TileBoundary( void )
+{
+	static const ACMW_UINT32 nBlockSize[5] = { 1023U, 1024U, 1025U, 2049U, 16384U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 i, nLayout, nDecoded;
+
+	for ( i = 0; i < 5U; i++ ) {
+		drain_StreamConfig( &sStreamConfig, nBlockSize[i] );
+		sStreamConfig.nBitsPerSample = 24U;
+		sStreamConfig.nSamples = nBlockSize[i] * 8U;
+		TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+		for ( nLayout = 0; nLayout < 2U; nLayout++ ) {
+			memset( &sMemConfig, 0, sizeof(sMemConfig) );
+			memset( &sInit, 0, sizeof(sInit) );
+			sMemConfig.nOutBitsPerSample = sInit.nOutBitsPerSample = 24U;
+			sMemConfig.nOutLayout = sInit.nOutLayout = nLayout;
+			TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+			ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+			TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+			TEST_CHECK( nDecoded == sStream.nSamples );
+			TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nDecoded, 1.0f ) == 0 );
+			test_OutFree( ppOut );
+			test_DecoderClose( &sDecoder );
+		}
+		test_StreamFree( &sStream );
+	}
+	return 0;
+}
@@ -0,0 +1,209 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_format.c
+* Description : Tests of the format change between frames (flacd_SetFormatChange)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define FORMAT_STREAMS		3U
+
+/* the frames of three streams one after the other : stereo 16 bit, mono 24 bit, stereo 24 bit at a rate from STREAMINFO
+   in larger fixed blocks */
+static int format_StreamMake( test_stream* const pStreams, ACMW_UINT8** const ppData, ACMW_UINT32* const pSize )
+{
+	static const ACMW_UINT32 nChannels[FORMAT_STREAMS] = { 2U, 1U, 2U };
+	static const ACMW_UINT32 nBps[FORMAT_STREAMS] = { 16U, 24U, 24U };
+	static const ACMW_UINT32 nRate[FORMAT_STREAMS] = { 44100U, 48000U, 22050U };
+	test_streamConfig sStreamConfig;
+	ACMW_UINT32 s;
+
+	*pSize = 0U;
+	for ( s = 0; s < FORMAT_STREAMS; s++ ) {
+		memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+		sStreamConfig.nChannels = nChannels[s];
+		sStreamConfig.nBitsPerSample = nBps[s];
+		sStreamConfig.nSampleRate = nRate[s];
+		sStreamConfig.nBlockSize = ( s == ( FORMAT_STREAMS - 1U ) ) ? 2048U : 1152U;
+		sStreamConfig.nSamples = 5000U - ( s * 600U );
+		sStreamConfig.bNoHeader = 1U;
+		sStreamConfig.nSeed = s;
+		TEST_CHECK( test_StreamMake( &sStreamConfig, &pStreams[s] ) == 0 );
+		*pSize += pStreams[s].nSize;
+	}
+	*ppData = (ACMW_UINT8*)malloc( *pSize );
+	TEST_CHECK( *ppData != NULL );
+	*pSize = 0U;
+	for ( s = 0; s < FORMAT_STREAMS; s++ ) {
+		memcpy( *ppData + *pSize, pStreams[s].pData, pStreams[s].nSize );
+		*pSize += pStreams[s].nSize;
+	}
+	return 0;
+}
+
+static void format_StreamFree( test_stream* const pStreams, ACMW_UINT8* const pData )
+{
+	ACMW_UINT32 s;
+
+	for ( s = 0; s < FORMAT_STREAMS; s++ ) {
+		test_StreamFree( &pStreams[s] );
+	}
+	free( pData );
+}
+
+/* up to 6 channels, 24 bit output in 32 bits */
+static int format_Open( test_decoder* const pDecoder )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	sMemConfig.nOutBitsPerSample = sInit.nOutBitsPerSample = 24U;
+	return test_DecoderOpen( pDecoder, &sMemConfig, &sInit );
+}
+
+/* decode the streams in calls of up to nChunkSamples (0 : a frame) with the STREAMINFO of the stream being read,
+   and check the output, the status and the change bits of each call */
+static int format_Decode( test_decoder* const pDecoder, const test_stream* const pStreams, ACMW_UINT8* const pData,
+						  const ACMW_UINT32 nSize, const ACMW_UINT32 nChunkSamples )
+{
+	ACMW_UINT32 nPos = 0U, nRemain = 0U, nStream = 0U, nEnd = pStreams[0].nSize, nSample = 0U, nOutStream = 0U;
+	ACMW_UINT32 nLastStream = 0U, c, i;
+
+	while ( ( nPos < nSize ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		const test_stream *pStream;
+		ACMW_UINT16 nChange;
+		void *pLast[TEST_MAX_CHANNELS];
+
+		/* the frame read next is from the next stream */
+		if ( ( nRemain == 0U ) && ( nPos >= nEnd ) ) {
+			nStream++;
+			nEnd += pStreams[nStream].nSize;
+		}
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		memset( &sDecStatus, 0, sizeof(sDecStatus) );
+		sBuffConfig.pInBuffStart = pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = nSize - nPos;
+		sBuffConfig.pOutBuffStart = pDecoder->pOutBuff;
+		sBuffConfig.nOutBuffSize = ( nChunkSamples != 0U ) ? ( nChunkSamples * 4U ) : pDecoder->nOutBuffSize;
+		sBuffStatus.pOutBuffLast = pLast;
+		TEST_CHECK( flacd_Decode( &pDecoder->sWorkMem, &pStreams[nStream].sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		if ( sDecStatus.nDecodedSamples != 0U ) {
+			if ( nOutStream != nStream ) {
+				nOutStream = nStream;
+				nSample = 0U;
+			}
+			pStream = &pStreams[nOutStream];
+			nChange = 0U;
+			if ( nOutStream != nLastStream ) {
+				nChange |= ( pStream->sDecConfig.nSampleRate != pStreams[nLastStream].sDecConfig.nSampleRate ) ? FLACD_FORMAT_SAMPLE_RATE : 0U;
+				nChange |= ( pStream->nChannels != pStreams[nLastStream].nChannels ) ? FLACD_FORMAT_CHANNELS : 0U;
+				nChange |= ( pStream->nBitsPerSample != pStreams[nLastStream].nBitsPerSample ) ? FLACD_FORMAT_BITS_PER_SAMPLE : 0U;
+				TEST_CHECK( nChange != 0U );
+				nLastStream = nOutStream;
+			}
+			TEST_CHECK( sDecStatus.nFormatChange == nChange );
+			TEST_CHECK( sDecStatus.nSampleRate == pStream->sDecConfig.nSampleRate );
+			TEST_CHECK( ( sDecStatus.nChannels == pStream->nChannels ) && ( sDecStatus.nBitsPerSample == pStream->nBitsPerSample ) );
+			TEST_CHECK( sDecStatus.nSamplePosition == nSample );
+			for ( c = 0; c < pStream->nChannels; c++ ) {
+				for ( i = 0; i < sDecStatus.nDecodedSamples; i++ ) {
+					TEST_CHECK( ( (const ACMW_INT32*)pDecoder->pOutBuff[c] )[i] ==
+								test_PcmValue( pStream, test_StreamSample( pStream, c, nSample + i ), 1U ) );
+				}
+			}
+			nSample += sDecStatus.nDecodedSamples;
+		}
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	TEST_CHECK( ( nOutStream == ( FORMAT_STREAMS - 1U ) ) && ( nSample == pStreams[nOutStream].nSamples ) );
+	return 0;
+}
+
+int test_FormatChange( void )
+{
+	test_stream sStreams[FORMAT_STREAMS];
+	test_decoder sDecoder;
+	ACMW_UINT8 *pData;
+	ACMW_UINT32 nSize;
+
+	TEST_CHECK( format_StreamMake( sStreams, &pData, &nSize ) == 0 );
+	TEST_CHECK( format_Open( &sDecoder ) == 0 );
+	TEST_CHECK( flacd_SetFormatChange( &sDecoder.sWorkMem, 1U ) == FLACD_RESULT_OK );
+	/* a frame per call, then the change within the output of calls smaller than a frame */
+	TEST_CHECK( format_Decode( &sDecoder, sStreams, pData, nSize, 0U ) == 0 );
+	test_DecoderClose( &sDecoder );
+	TEST_CHECK( format_Open( &sDecoder ) == 0 );
+	TEST_CHECK( flacd_SetFormatChange( &sDecoder.sWorkMem, 1U ) == FLACD_RESULT_OK );
+	TEST_CHECK( format_Decode( &sDecoder, sStreams, pData, nSize, 333U ) == 0 );
+	test_DecoderClose( &sDecoder );
+	format_StreamFree( sStreams, pData );
+	return 0;
+}
+
+int test_FormatChangeReject( void )
+{
+	test_stream sStreams[FORMAT_STREAMS];
+	test_decoder sDecoder;
+	flacd_streamConfigInfo sConfig;
+	flacd_streamStatusInfo sStatus;
+	flacd_ioBufferConfigInfo sBuffConfig;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	ACMW_UINT8 *pData;
+	ACMW_UINT32 nSize, nDecoded;
+	void *pLast[TEST_MAX_CHANNELS];
+	void **ppOut;
+
+	TEST_CHECK( format_StreamMake( sStreams, &pData, &nSize ) == 0 );
+	TEST_CHECK( format_Open( &sDecoder ) == 0 );
+	TEST_CHECK( flacd_SetFormatChange( NULL, 1U ) == FLACD_RESULT_FATAL );
+	TEST_CHECK( flacd_SetFormatChange( &sDecoder.sWorkMem, 2U ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+
+	/* the default : the first stream decodes, its end is the first frame of the next */
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStreams[0], 0U, NULL, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == sStreams[0].nSamples );
+	memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+	memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+	sBuffConfig.pInBuffStart = sStreams[1].pData;
+	sBuffConfig.nInBuffSetDataSize = sStreams[1].nSize;
+	sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+	sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+	sBuffStatus.pOutBuffLast = pLast;
+	TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStreams[1].sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_CHANGE_FRAME_HEADER );
+	TEST_CHECK( sDecStatus.nDecodedSamples == 0U );
+	test_DecoderClose( &sDecoder );
+
+	/* a whole stream decode writes one format : the change stops it also when accepted */
+	TEST_CHECK( format_Open( &sDecoder ) == 0 );
+	TEST_CHECK( flacd_SetFormatChange( &sDecoder.sWorkMem, 1U ) == FLACD_RESULT_OK );
+	ppOut = test_OutAlloc( &sDecoder, sStreams[0].nSamples + sStreams[1].nSamples );
+	memset( &sConfig, 0, sizeof(sConfig) );
+	sConfig.pDecConfigInfo = &sStreams[0].sDecConfig;
+	sConfig.pInBuffStart = pData;
+	sConfig.nInBuffSetDataSize = nSize;
+	sConfig.pOutBuffStart = ppOut;
+	sConfig.nOutBuffSize = ( sStreams[0].nSamples + sStreams[1].nSamples ) * 4U;
+	TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_CHANGE_FRAME_HEADER );
+	TEST_CHECK( sStatus.nDecodedSamples == sStreams[0].nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStreams[0], ppOut, 0U, sStreams[0].nSamples, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	format_StreamFree( sStreams, pData );
+	return 0;
+}
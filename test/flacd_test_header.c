@@ -0,0 +1,175 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_header.c
+* Description : Tests of the stream header parser (flacd_ParseHeader)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define HEADER_ID3_SIZE			30U
+#define HEADER_PADDING_SIZE		100U
+
+/* the stream behind an ID3v2 tag, with a PADDING block after STREAMINFO ; returns the new size */
+static ACMW_UINT32 header_Wrap( const test_stream* const pStream, ACMW_UINT8* const pOut )
+{
+	ACMW_UINT32 nPos = 0U;
+
+	memset( pOut, 0, HEADER_ID3_SIZE );
+	memcpy( pOut, "ID3", 3U );
+	pOut[3] = 4U;
+	pOut[9] = (ACMW_UINT8)( HEADER_ID3_SIZE - 10U );
+	nPos += HEADER_ID3_SIZE;
+	/* "fLaC" and STREAMINFO, no longer the last block */
+	memcpy( pOut + nPos, pStream->pData, 4U + 4U + 34U );
+	pOut[nPos + 4U] &= 0x7FU;
+	nPos += 4U + 4U + 34U;
+	pOut[nPos] = 0x81U;
+	pOut[nPos + 1U] = 0U;
+	pOut[nPos + 2U] = 0U;
+	pOut[nPos + 3U] = (ACMW_UINT8)HEADER_PADDING_SIZE;
+	memset( pOut + nPos + 4U, 0xA5, HEADER_PADDING_SIZE );
+	nPos += 4U + HEADER_PADDING_SIZE;
+	memcpy( pOut + nPos, pStream->pData + pStream->nAudioOffset, pStream->nSize - pStream->nAudioOffset );
+	return nPos + ( pStream->nSize - pStream->nAudioOffset );
+}
+
+static int header_CheckInfo( const flacd_headerStatusInfo* const pHeader, const test_stream* const pStream, const ACMW_UINT32 nAudioOffset )
+{
+	TEST_CHECK( memcmp( &pHeader->sDecConfig, &pStream->sDecConfig, sizeof(flacd_decConfigInfo) ) == 0 );
+	TEST_CHECK( pHeader->nTotalSamples == pStream->nSamples );
+	TEST_CHECK( memcmp( pHeader->nMD5Signature, pStream->pData + 4U + 4U + 18U, 16U ) == 0 );
+	TEST_CHECK( pHeader->nAudioOffset == nAudioOffset );
+	return 0;
+}
+
+int test_HeaderParse( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_decoder sDecoder;
+	test_stream sWrapped;
+	ACMW_UINT8 *pWrapped;
+	ACMW_UINT32 nWrappedSize, nCalls = 0U, nRead = 0U;
+	ACMW_INT32 nRet;
+	void **ppOut;
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 24U;
+	sStreamConfig.nSampleRate = 96000U;
+	sStreamConfig.nBlockSize = 2048U;
+	sStreamConfig.nSamples = 10000U;
+	sStreamConfig.nSeekPoints = 4U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+
+	/* whole header in one call */
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = sStream.pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_OK );
+	TEST_CHECK( header_CheckInfo( &sHeader, &sStream, sStream.nAudioOffset ) == 0 );
+	TEST_CHECK( sHeader.nSeekPoints == 4U );
+	TEST_CHECK( sHeader.nSeekTableOffset == 4U + 4U + 34U + 4U );
+
+	/* ID3v2 tag and PADDING, fed with only the bytes asked for : the padding is never read */
+	pWrapped = (ACMW_UINT8*)malloc( sStream.nSize + HEADER_ID3_SIZE + 4U + HEADER_PADDING_SIZE );
+	sStreamConfig.nSeekPoints = 0U;
+	test_StreamFree( &sStream );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	nWrappedSize = header_Wrap( &sStream, pWrapped );
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = pWrapped;
+	sHeaderConfig.nInBuffSetDataSize = 1U;
+	do {
+		nRet = flacd_ParseHeader( &sHeaderConfig, &sHeader );
+		nCalls++;
+		if ( nRet == FLACD_RESULT_WARNING ) {
+			TEST_CHECK( ( sHeader.nNeedSize != 0U ) && ( ( sHeader.nNextOffset + sHeader.nNeedSize ) <= nWrappedSize ) );
+			TEST_CHECK( ( sHeader.nNextOffset + sHeader.nNeedSize <= HEADER_ID3_SIZE + 4U + 38U + 4U ) ||
+						( sHeader.nNextOffset >= HEADER_ID3_SIZE + 4U + 38U + 4U + HEADER_PADDING_SIZE ) );
+			sHeaderConfig.pInBuffStart = pWrapped + sHeader.nNextOffset;
+			sHeaderConfig.nInBuffSetDataSize = sHeader.nNeedSize;
+			sHeaderConfig.nInBuffOffset = sHeader.nNextOffset;
+			nRead += sHeader.nNeedSize;
+		}
+	} while ( ( nRet == FLACD_RESULT_WARNING ) && ( nCalls < 16U ) );
+	TEST_CHECK( nRet == FLACD_RESULT_OK );
+	TEST_CHECK( header_CheckInfo( &sHeader, &sStream, HEADER_ID3_SIZE + 4U + 38U + 4U + HEADER_PADDING_SIZE ) == 0 );
+	TEST_CHECK( nRead < 100U );
+
+	/* the parsed configuration decodes the frames after nAudioOffset */
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nOutBitsPerSample = sInit.nOutBitsPerSample = 24U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	sWrapped = sStream;
+	sWrapped.pData = pWrapped;
+	sWrapped.nSize = nWrappedSize;
+	sWrapped.nAudioOffset = sHeader.nAudioOffset;
+	sWrapped.sDecConfig = sHeader.sDecConfig;
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sWrapped, 0U, ppOut, &nRead ) == FLACD_RESULT_OK );
+	TEST_CHECK( nRead == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nRead, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	free( pWrapped );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_HeaderReject( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	ACMW_UINT8 *pData;
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 1U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 44100U;
+	sStreamConfig.nBlockSize = 1024U;
+	sStreamConfig.nSamples = 3000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	pData = (ACMW_UINT8*)malloc( sStream.nSize );
+	sHeaderConfig.pInBuffStart = pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+
+	/* no marker */
+	memcpy( pData, sStream.pData, sStream.nSize );
+	pData[0] = 'F';
+	memset( &sHeader, 0, sizeof(sHeader) );
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_NG );
+	/* first block not STREAMINFO, STREAMINFO of a wrong length */
+	memcpy( pData, sStream.pData, sStream.nSize );
+	pData[4] = 0x81U;
+	memset( &sHeader, 0, sizeof(sHeader) );
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_NG );
+	memcpy( pData, sStream.pData, sStream.nSize );
+	pData[7] = 33U;
+	memset( &sHeader, 0, sizeof(sHeader) );
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_NG );
+	/* a truncated header asks for more, missing arguments are fatal */
+	memcpy( pData, sStream.pData, sStream.nSize );
+	sHeaderConfig.nInBuffSetDataSize = 20U;
+	memset( &sHeader, 0, sizeof(sHeader) );
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_WARNING );
+	TEST_CHECK( ( sHeader.nNextOffset == 4U ) && ( sHeader.nNeedSize == 38U ) );
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, NULL ) == FLACD_RESULT_FATAL );
+	TEST_CHECK( flacd_ParseHeader( NULL, &sHeader ) == FLACD_RESULT_FATAL );
+	free( pData );
+	test_StreamFree( &sStream );
+	return 0;
+}
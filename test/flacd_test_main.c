@@ -0,0 +1,229 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_main.c
+* Description : Test program of the FLACD SW.IP
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+typedef struct {
+	const char	*pName;
+	int			(*pTest)(void);
+} test_case;
+
+#define TEST_CASE(name)		{ #name, name }
+
+static const test_case sTestCases[] = {
+	TEST_CASE_LIST
+};
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		test_DecoderOpen
+*
+* OVERVIEW
+* 		Get the memory sizes, allocate the instance and its output buffers
+* 		and initialize it. Returns 0 on success.
+*
+*/
+int test_DecoderOpen( test_decoder*							const pDecoder,
+					  const flacd_getMemorySizeConfigInfo*	const pMemConfig,
+					  const flacd_initConfigInfo*			const pInitConfig )
+{
+	static const ACMW_UINT32 nOutChannels[3] = { 2U, 3U, 6U };
+	ACMW_UINT32 c;
+
+	memset( pDecoder, 0, sizeof(*pDecoder) );
+	if ( flacd_GetMemorySize( pMemConfig, &pDecoder->sMemStatus ) != FLACD_RESULT_OK ) {
+		printf( "  flacd_GetMemorySize failed\n" );
+		return 1;
+	}
+	pDecoder->sInitConfig = *pInitConfig;
+	pDecoder->nOutChannels = nOutChannels[( pInitConfig->nOutputChannel < 3U ) ? pInitConfig->nOutputChannel : 0U];
+	pDecoder->nSampleBytes = ( ( pInitConfig->nOutSampleFormat != 0U ) || ( pInitConfig->nOutBitsPerSample != 0U ) ) ? 4U : 2U;
+	pDecoder->nOutBuffSize = pDecoder->sMemStatus.nOutputBufferSize;
+	pDecoder->sWorkMem.pStatic = calloc( pDecoder->sMemStatus.nStaticSize + 8U, 1U );
+	pDecoder->sWorkMem.pScratch = calloc( pDecoder->sMemStatus.nScratchSize + 8U, 1U );
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		pDecoder->pOutBuff[c] = calloc( pDecoder->nOutBuffSize + 8U, 1U );
+	}
+	if ( flacd_Init( &pDecoder->sWorkMem, pInitConfig ) != FLACD_RESULT_OK ) {
+		printf( "  flacd_Init failed (error factor 0x%x)\n", flacd_GetErrorFactor( &pDecoder->sWorkMem ) );
+		return 1;
+	}
+	return 0;
+}
+/*------------------------------------------------------------------------------*/
+
+void test_DecoderClose( test_decoder* const pDecoder )
+{
+	ACMW_UINT32 c;
+
+	free( pDecoder->sWorkMem.pStatic );
+	free( pDecoder->sWorkMem.pScratch );
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		free( pDecoder->pOutBuff[c] );
+	}
+	memset( pDecoder, 0, sizeof(*pDecoder) );
+}
+
+/* output buffers for nSamples samples of every output channel in the layout of the instance */
+void** test_OutAlloc( const test_decoder* const pDecoder, const ACMW_UINT32 nSamples )
+{
+	void** const ppOut = (void**)calloc( TEST_MAX_CHANNELS + 1U, sizeof(void*) );
+	ACMW_UINT32 c;
+
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		ppOut[c] = calloc( ( (size_t)nSamples * pDecoder->nSampleBytes * TEST_MAX_CHANNELS ) + 8U, 1U );
+	}
+	return ppOut;
+}
+
+void test_OutFree( void** const ppOut )
+{
+	ACMW_UINT32 c;
+
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		free( ppOut[c] );
+	}
+	free( ppOut );
+}
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		test_DecodeAll
+*
+* OVERVIEW
+* 		Decode the frames of the stream with flacd_Decode and append the
+* 		output of each call to ppOut (see test_OutAlloc). nChunkSamples
+* 		limits the output buffer size of each call (0 : the size given by
+* 		flacd_GetMemorySize). Returns the first result other than OK.
+*
+*/
+ACMW_INT32 test_DecodeAll( test_decoder*		const pDecoder,
+						   const test_stream*	const pStream,
+						   const ACMW_UINT32	nChunkSamples,
+						   void**				const ppOut,
+						   ACMW_UINT32*			const pDecoded )
+{
+	const ACMW_UINT32 bInterleaved = ( pDecoder->sInitConfig.nOutLayout != 0U ) ? 1U : 0U;
+	const ACMW_UINT32 nFrameBytes = pDecoder->nSampleBytes * ( ( bInterleaved != 0U ) ? pDecoder->nOutChannels : 1U );
+	ACMW_UINT32 nPos = pStream->nAudioOffset, nRemain = 0U, nDone = 0U, c;
+	ACMW_INT32 nResult = FLACD_RESULT_OK;
+
+	while ( ( nPos < pStream->nSize ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+		ACMW_INT32 nRet;
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		memset( &sDecStatus, 0, sizeof(sDecStatus) );
+		sBuffConfig.pInBuffStart = pStream->pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = pStream->nSize - nPos;
+		sBuffConfig.pOutBuffStart = pDecoder->pOutBuff;
+		sBuffConfig.nOutBuffSize = ( nChunkSamples != 0U ) ? ( nChunkSamples * nFrameBytes ) : pDecoder->nOutBuffSize;
+		sBuffStatus.pOutBuffLast = pLast;
+		nRet = flacd_Decode( &pDecoder->sWorkMem, &pStream->sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus );
+		if ( ( nRet != FLACD_RESULT_OK ) && ( nResult == FLACD_RESULT_OK ) ) {
+			nResult = nRet;
+		}
+		if ( ( nRet != FLACD_RESULT_OK ) && ( nRet != FLACD_RESULT_WARNING ) && ( sBuffStatus.nInBuffUsedDataSize == 0U ) ) {
+			break;
+		}
+		if ( ( ppOut != NULL ) && ( sDecStatus.nDecodedSamples != 0U ) ) {
+			for ( c = 0; c < ( ( bInterleaved != 0U ) ? 1U : pDecoder->nOutChannels ); c++ ) {
+				memcpy( (ACMW_UINT8*)ppOut[c] + ( (size_t)nDone * nFrameBytes ), pDecoder->pOutBuff[c],
+						(size_t)sDecStatus.nDecodedSamples * nFrameBytes );
+			}
+		}
+		nDone += sDecStatus.nDecodedSamples;
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	*pDecoded = nDone;
+	return nResult;
+}
+/*------------------------------------------------------------------------------*/
+
+/* decoded sample as PCM output of nOutBits (0 : 16 bit, else 24 bit left justified in 32 bits) */
+ACMW_INT32 test_PcmValue( const test_stream* const pStream, const ACMW_INT32 nSample, const ACMW_UINT32 nOutBits )
+{
+	const ACMW_INT32 nBps = (ACMW_INT32)pStream->nBitsPerSample;
+
+	if ( nOutBits == 0U ) {
+		return ( nBps > 16 ) ? ( nSample >> ( nBps - 16 ) ) : (ACMW_INT32)( (ACMW_UINT32)nSample << ( 16 - nBps ) );
+	}
+	return (ACMW_INT32)( (ACMW_UINT32)nSample << ( 32 - nBps ) );
+}
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		test_CheckOutput
+*
+* OVERVIEW
+* 		Compare nSamples samples of the output (see test_OutAlloc) with
+* 		the stream from sample nFirst, in the output format of the instance.
+* 		fGain is the gain of float32 output. Returns 0 when they match.
+*
+*/
+int test_CheckOutput( const test_decoder*	const pDecoder,
+					  const test_stream*	const pStream,
+					  void*					const * const ppOut,
+					  const ACMW_UINT32		nFirst,
+					  const ACMW_UINT32		nSamples,
+					  const ACMW_FLOAT32	fGain )
+{
+	const flacd_initConfigInfo* const pInit = &pDecoder->sInitConfig;
+	const ACMW_UINT32 nStride = ( pInit->nOutLayout != 0U ) ? pDecoder->nOutChannels : 1U;
+	const ACMW_FLOAT32 fScale = fGain / (ACMW_FLOAT32)( 1U << ( pStream->nBitsPerSample - 1U ) );
+	const ACMW_UINT32 nChannels = ( pStream->nChannels < pDecoder->nOutChannels ) ? pStream->nChannels : pDecoder->nOutChannels;
+	ACMW_UINT32 c, i;
+
+	for ( c = 0; c < nChannels; c++ ) {
+		const ACMW_UINT8* const pBase = ( nStride == 1U ) ? (const ACMW_UINT8*)ppOut[c] : ( (const ACMW_UINT8*)ppOut[0] + ( c * pDecoder->nSampleBytes ) );
+		for ( i = 0; i < nSamples; i++ ) {
+			const ACMW_INT32 nRef = test_StreamSample( pStream, c, nFirst + i );
+			int bMatch;
+			if ( pInit->nOutSampleFormat != 0U ) {
+				bMatch = ( ( (const ACMW_FLOAT32*)pBase )[i * nStride] == ( (ACMW_FLOAT32)nRef * fScale ) );
+			} else if ( pInit->nOutBitsPerSample == 0U ) {
+				bMatch = ( ( (const ACMW_INT16*)pBase )[i * nStride] == (ACMW_INT16)test_PcmValue( pStream, nRef, 0U ) );
+			} else {
+				bMatch = ( ( (const ACMW_INT32*)pBase )[i * nStride] == test_PcmValue( pStream, nRef, 24U ) );
+			}
+			if ( !bMatch ) {
+				printf( "  output mismatch: channel %u sample %u\n", c, nFirst + i );
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
+/*------------------------------------------------------------------------------*/
+
+int main( void )
+{
+	const ACMW_UINT32 nCases = (ACMW_UINT32)( sizeof(sTestCases) / sizeof(sTestCases[0]) );
+	ACMW_UINT32 i, nFailed = 0U;
+
+	for ( i = 0; i < nCases; i++ ) {
+		const int nRet = sTestCases[i].pTest();
+		printf( "%s %s\n", ( nRet == 0 ) ? "PASS" : "FAIL", sTestCases[i].pName );
+		nFailed += ( nRet == 0 ) ? 0U : 1U;
+	}
+	printf( "%u of %u tests failed\n", nFailed, nCases );
+	return ( nFailed == 0U ) ? 0 : 1;
+}
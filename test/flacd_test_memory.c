@@ -0,0 +1,381 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_memory.c
+* Description : Tests of the memory sizes, the scratch pool and the slab pool
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define MEMORY_GUARD_SIZE		64U
+#define MEMORY_GUARD_BYTE		0xA5U
+
+static int memory_GuardIntact( const ACMW_UINT8* const pGuard )
+{
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < MEMORY_GUARD_SIZE; i++ ) {
+		if ( pGuard[i] != MEMORY_GUARD_BYTE ) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* decode with scratch memory of exactly the size asked for, giving at most nInputBufferSize bytes per call */
+static int memory_DecodeExact( const test_streamConfig* const pStreamConfig )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_stream sStream;
+	test_decoder sDecoder;
+	ACMW_UINT8 *pScratch;
+	void **ppOut;
+	ACMW_UINT32 nPos, nDone = 0U, nRemain = 0U;
+
+	TEST_CHECK( test_StreamMake( pStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = ( pStreamConfig->nChannels > 2U ) ? 1U : 0U;
+	sMemConfig.nMaxBlockSize = sInit.nMaxBlockSize = (ACMW_UINT16)pStreamConfig->nBlockSize;
+	sMemConfig.nChannels = sInit.nChannels = (ACMW_UINT16)pStreamConfig->nChannels;
+	sMemConfig.nBitsPerSample = (ACMW_UINT16)pStreamConfig->nBitsPerSample;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	pScratch = (ACMW_UINT8*)malloc( sDecoder.sMemStatus.nScratchSize + MEMORY_GUARD_SIZE );
+	memset( pScratch, MEMORY_GUARD_BYTE, sDecoder.sMemStatus.nScratchSize + MEMORY_GUARD_SIZE );
+	free( sDecoder.sWorkMem.pScratch );
+	sDecoder.sWorkMem.pScratch = pScratch;
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	/* the test encoder does not fall back to VERBATIM: its frames must still fit */
+	TEST_CHECK( sStream.sDecConfig.nMaxFrameSize <= sDecoder.sMemStatus.nInputBufferSize );
+
+	nPos = sStream.nAudioOffset;
+	while ( ( nPos < sStream.nSize ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+		ACMW_UINT32 c;
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sBuffConfig.pInBuffStart = sStream.pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = sStream.nSize - nPos;
+		if ( sBuffConfig.nInBuffSetDataSize > sDecoder.sMemStatus.nInputBufferSize ) {
+			sBuffConfig.nInBuffSetDataSize = sDecoder.sMemStatus.nInputBufferSize;
+		}
+		sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+		sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+		sBuffStatus.pOutBuffLast = pLast;
+		TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		for ( c = 0; c < sDecoder.nOutChannels; c++ ) {
+			memcpy( (ACMW_UINT8*)ppOut[c] + ( (size_t)nDone * sDecoder.nSampleBytes ), sDecoder.pOutBuff[c],
+					(size_t)sDecStatus.nDecodedSamples * sDecoder.nSampleBytes );
+		}
+		nDone += sDecStatus.nDecodedSamples;
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	TEST_CHECK( nDone == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nDone, 1.0f ) == 0 );
+	TEST_CHECK( memory_GuardIntact( pScratch + sDecoder.sMemStatus.nScratchSize ) != 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_MemoryExactSize( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_getMemorySizeStatusInfo sWorst, sExact;
+	test_streamConfig sStreamConfig;
+
+	/* sizes for a 2 channel 16 bit stream of 1152 sample blocks are smaller than the worst case */
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sWorst ) == FLACD_RESULT_OK );
+	sMemConfig.nMaxBlockSize = 1152U;
+	sMemConfig.nBitsPerSample = 16U;
+	sMemConfig.nChannels = 2U;
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sExact ) == FLACD_RESULT_OK );
+	TEST_CHECK( sExact.nScratchSize < sWorst.nScratchSize );
+	TEST_CHECK( sExact.nInputBufferSize < sWorst.nInputBufferSize );
+	TEST_CHECK( sExact.nOutputBufferSize == ( 1152U * sizeof(ACMW_INT16) ) );
+	sMemConfig.nMaxBlockSize = 16385U;
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sExact ) == FLACD_RESULT_FATAL );
+
+	/* a guard after the scratch memory, input in windows of nInputBufferSize */
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 44100U;
+	sStreamConfig.nBlockSize = 1152U;
+	sStreamConfig.nSamples = 20000U;
+	TEST_CHECK( memory_DecodeExact( &sStreamConfig ) == 0 );
+	sStreamConfig.nChannels = 6U;
+	sStreamConfig.nBlockSize = 4608U;
+	TEST_CHECK( memory_DecodeExact( &sStreamConfig ) == 0 );
+	return 0;
+}
+
+int test_MemoryLargerStream( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	ACMW_UINT32 nDecoded;
+
+	/* a stream with larger blocks or more channels than the instance was sized for is rejected */
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 44100U;
+	sStreamConfig.nBlockSize = 4096U;
+	sStreamConfig.nSamples = 10000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nMaxBlockSize = sInit.nMaxBlockSize = 1152U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, NULL, &nDecoded ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_NOT_SUPPORTED_DATA );
+	TEST_CHECK( nDecoded == 0U );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+#define POOL_INSTANCES		4U
+#define POOL_CHUNK			1000U
+
+typedef struct {
+	test_stream		sStream;
+	test_decoder	sDecoder;
+	void			**ppOut;
+	ACMW_UINT32		nPos;
+	ACMW_UINT32		nDone;
+	ACMW_UINT32		nRemain;
+	void			*pCarry;
+} pool_instance;
+
+/* decode the instances one call at a time in turn through a pool of nBlocks scratch blocks */
+static int pool_Run( const ACMW_UINT32 nBlocks, const ACMW_UINT32 bCarry, ACMW_UINT32* const pPinned )
+{
+	static const ACMW_UINT32 nChannels[POOL_INSTANCES] = { 2U, 6U, 2U, 4U };
+	static const ACMW_UINT32 nBlockSize[POOL_INSTANCES] = { 4096U, 1152U, 4608U, 4096U };
+	pool_instance sInst[POOL_INSTANCES];
+	flacd_scratchPoolInfo sPool;
+	ACMW_UINT32 nActive = 1U, nBlockBytes = 0U, k, c;
+
+	*pPinned = 0U;
+	for ( k = 0; k < POOL_INSTANCES; k++ ) {
+		flacd_getMemorySizeConfigInfo sMemConfig;
+		flacd_initConfigInfo sInit;
+		test_streamConfig sStreamConfig;
+
+		memset( &sInst[k], 0, sizeof(sInst[k]) );
+		memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+		sStreamConfig.nChannels = nChannels[k];
+		sStreamConfig.nBitsPerSample = 16U;
+		sStreamConfig.nSampleRate = 48000U;
+		sStreamConfig.nBlockSize = nBlockSize[k];
+		sStreamConfig.nSamples = 15000U + ( k * 1000U );
+		sStreamConfig.bVariable = ( k == 2U ) ? 1U : 0U;
+		sStreamConfig.nSeed = k;
+		TEST_CHECK( test_StreamMake( &sStreamConfig, &sInst[k].sStream ) == 0 );
+		memset( &sMemConfig, 0, sizeof(sMemConfig) );
+		memset( &sInit, 0, sizeof(sInit) );
+		sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+		sMemConfig.nMaxBlockSize = sInit.nMaxBlockSize = (ACMW_UINT16)nBlockSize[k];
+		sMemConfig.nChannels = sInit.nChannels = (ACMW_UINT16)nChannels[k];
+		TEST_CHECK( test_DecoderOpen( &sInst[k].sDecoder, &sMemConfig, &sInit ) == 0 );
+		nBlockBytes = ( sInst[k].sDecoder.sMemStatus.nScratchSize > nBlockBytes ) ? sInst[k].sDecoder.sMemStatus.nScratchSize : nBlockBytes;
+		free( sInst[k].sDecoder.sWorkMem.pScratch );
+		sInst[k].sDecoder.sWorkMem.pScratch = NULL;
+		sInst[k].ppOut = test_OutAlloc( &sInst[k].sDecoder, sInst[k].sStream.nSamples );
+		sInst[k].nPos = sInst[k].sStream.nAudioOffset;
+		if ( bCarry != 0U ) {
+			flacd_carryConfigInfo sCarry;
+			sCarry.nCarrySize = nBlockSize[k] * nChannels[k] * (ACMW_UINT32)sizeof(ACMW_INT32);
+			sCarry.pCarry = sInst[k].pCarry = malloc( sCarry.nCarrySize );
+			TEST_CHECK( flacd_SetScratchCarry( &sInst[k].sDecoder.sWorkMem, &sCarry ) == FLACD_RESULT_OK );
+		}
+	}
+	sPool.nBlockSize = ( nBlockBytes + 7U ) & ~7U;
+	sPool.nBlocks = nBlocks;
+	sPool.pMemory = malloc( (size_t)sPool.nBlockSize * nBlocks );
+	sPool.pOwner = (const void**)calloc( nBlocks, sizeof(void*) );
+
+	while ( nActive != 0U ) {
+		nActive = 0U;
+		for ( k = 0; k < POOL_INSTANCES; k++ ) {
+			pool_instance* const pInst = &sInst[k];
+			flacd_workMemoryInfo* const pWorkMem = &pInst->sDecoder.sWorkMem;
+			flacd_ioBufferConfigInfo sBuffConfig;
+			flacd_ioBufferStatusInfo sBuffStatus;
+			flacd_decStatusInfo sDecStatus;
+			void *pLast[TEST_MAX_CHANNELS];
+			void *pBlock;
+			ACMW_INT32 nRet;
+			ACMW_UINT32 b, bPinned = 0U;
+
+			if ( ( pInst->nPos >= pInst->sStream.nSize ) && ( pInst->nRemain == 0U ) ) {
+				continue;
+			}
+			nActive++;
+			if ( flacd_AcquireScratch( pWorkMem, &sPool ) != FLACD_RESULT_OK ) {
+				/* without a carry buffer the blocks may all be pinned: the holders are served in turn */
+				TEST_CHECK( ( flacd_GetErrorFactor( pWorkMem ) == FLACD_ERR_SCRATCH_PINNED ) ||
+							( flacd_GetErrorFactor( pWorkMem ) == FLACD_ERR_SCRATCH_EXHAUSTED ) );
+				TEST_CHECK( bCarry == 0U );
+				continue;
+			}
+			memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+			memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+			sBuffConfig.pInBuffStart = pInst->sStream.pData + pInst->nPos;
+			sBuffConfig.nInBuffSetDataSize = pInst->sStream.nSize - pInst->nPos;
+			sBuffConfig.pOutBuffStart = pInst->sDecoder.pOutBuff;
+			sBuffConfig.nOutBuffSize = POOL_CHUNK * pInst->sDecoder.nSampleBytes;
+			sBuffStatus.pOutBuffLast = pLast;
+			TEST_CHECK( flacd_Decode( pWorkMem, &pInst->sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+			for ( c = 0; c < pInst->sDecoder.nOutChannels; c++ ) {
+				memcpy( (ACMW_UINT8*)pInst->ppOut[c] + ( (size_t)pInst->nDone * pInst->sDecoder.nSampleBytes ), pInst->sDecoder.pOutBuff[c],
+						(size_t)sDecStatus.nDecodedSamples * pInst->sDecoder.nSampleBytes );
+			}
+			pInst->nDone += sDecStatus.nDecodedSamples;
+			pInst->nRemain = sDecStatus.nRemainSamples;
+			pInst->nPos += sBuffStatus.nInBuffUsedDataSize;
+
+			pBlock = pWorkMem->pScratch;
+			nRet = flacd_ReleaseScratch( pWorkMem, &sPool );
+			for ( b = 0; b < nBlocks; b++ ) {
+				bPinned |= ( sPool.pOwner[b] == pWorkMem->pStatic ) ? 1U : 0U;
+			}
+			if ( bPinned != 0U ) {
+				TEST_CHECK( nRet == FLACD_RESULT_WARNING );
+				TEST_CHECK( flacd_GetErrorFactor( pWorkMem ) == FLACD_ERR_SCRATCH_PINNED );
+				TEST_CHECK( pInst->nRemain != 0U );
+				( *pPinned )++;
+			} else {
+				TEST_CHECK( nRet == FLACD_RESULT_OK );
+				/* a freed block is reused by the others: the rest of the frame must not be read from it */
+				memset( pBlock, 0x55, sPool.nBlockSize );
+			}
+		}
+	}
+
+	for ( k = 0; k < POOL_INSTANCES; k++ ) {
+		TEST_CHECK( sInst[k].nDone == sInst[k].sStream.nSamples );
+		TEST_CHECK( test_CheckOutput( &sInst[k].sDecoder, &sInst[k].sStream, sInst[k].ppOut, 0U, sInst[k].nDone, 1.0f ) == 0 );
+		test_OutFree( sInst[k].ppOut );
+		sInst[k].sDecoder.sWorkMem.pScratch = NULL;
+		test_DecoderClose( &sInst[k].sDecoder );
+		test_StreamFree( &sInst[k].sStream );
+		free( sInst[k].pCarry );
+	}
+	free( sPool.pMemory );
+	free( (void*)sPool.pOwner );
+	return 0;
+}
+
+int test_ScratchPool( void )
+{
+	ACMW_UINT32 nPinned;
+
+	/* without carry buffers the blocks stay pinned while a frame is drained */
+	TEST_CHECK( pool_Run( 2U, 0U, &nPinned ) == 0 );
+	TEST_CHECK( nPinned != 0U );
+	/* with them one block serves every instance */
+	TEST_CHECK( pool_Run( 1U, 1U, &nPinned ) == 0 );
+	TEST_CHECK( nPinned == 0U );
+	return 0;
+}
+
+/* the per-frame decoder state is in the scratch memory: the static area stays small */
+int test_StaticSize( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_getMemorySizeStatusInfo sStatus;
+	const ACMW_UINT32 nLimit = ( sizeof(void*) == 8U ) ? 1280U : 1024U;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	sMemConfig.nInputChannel = 1U;
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sStatus ) == FLACD_RESULT_OK );
+	printf( "  static area %u bytes\n", sStatus.nStaticSize );
+	TEST_CHECK( sStatus.nStaticSize <= nLimit );
+	return 0;
+}
+
+int test_SlabHandles( void )
+{
+	flacd_slabPoolInfo sPool;
+	flacd_handle nHandle, nStale, nOther, *pHandles;
+	ACMW_UINT8 *pBig, *pSmall;
+	ACMW_UINT32 nBigSize, nTotal, i;
+
+	TEST_CHECK( flacd_SlabInit( &sPool ) == FLACD_RESULT_OK );
+	/* a slab holds at most 4096 slots, the rest of its memory is not used */
+	nBigSize = ( 4100U * sPool.nSlotSize ) + 64U;
+	pBig = (ACMW_UINT8*)malloc( nBigSize );
+	pSmall = (ACMW_UINT8*)malloc( ( 3U * sPool.nSlotSize ) + 64U );
+	TEST_CHECK( flacd_SlabAddMemory( &sPool, pBig, nBigSize ) == FLACD_RESULT_OK );
+	TEST_CHECK( sPool.nFreeSlots == 4096U );
+	TEST_CHECK( flacd_SlabAddMemory( &sPool, pSmall, ( 3U * sPool.nSlotSize ) + 64U ) == FLACD_RESULT_OK );
+	nTotal = sPool.nFreeSlots;
+	TEST_CHECK( nTotal == 4099U );
+
+	/* every slot once: distinct, cache line aligned, inside its slab */
+	pHandles = (flacd_handle*)malloc( nTotal * sizeof(flacd_handle) );
+	for ( i = 0; i < nTotal; i++ ) {
+		ACMW_UINT8* pStatic;
+		TEST_CHECK( flacd_SlabCreate( &sPool, &pHandles[i] ) == FLACD_RESULT_OK );
+		pStatic = (ACMW_UINT8*)flacd_SlabGetStatic( &sPool, pHandles[i] );
+		TEST_CHECK( ( ( (size_t)pStatic ) & 63U ) == 0U );
+		TEST_CHECK( ( ( pStatic >= pBig ) && ( ( pStatic + sPool.nSlotSize ) <= ( pBig + nBigSize ) ) ) ||
+					( ( pStatic >= pSmall ) && ( ( pStatic + sPool.nSlotSize ) <= ( pSmall + ( 3U * sPool.nSlotSize ) + 64U ) ) ) );
+		TEST_CHECK( ( i == 0U ) || ( pStatic != flacd_SlabGetStatic( &sPool, pHandles[i - 1U] ) ) );
+	}
+	TEST_CHECK( flacd_SlabCreate( &sPool, &nHandle ) == FLACD_RESULT_NG );
+	TEST_CHECK( nHandle == FLACD_INVALID_HANDLE );
+	for ( i = 0; i < nTotal; i++ ) {
+		TEST_CHECK( flacd_SlabDestroy( &sPool, pHandles[i] ) == FLACD_RESULT_OK );
+	}
+	TEST_CHECK( flacd_SlabDestroy( &sPool, pHandles[0] ) == FLACD_RESULT_FATAL );
+	TEST_CHECK( sPool.nFreeSlots == nTotal );
+
+	/* a slot reused again and again: the old handle stays stale for 65535 generations */
+	TEST_CHECK( flacd_SlabCreate( &sPool, &nStale ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_SlabDestroy( &sPool, nStale ) == FLACD_RESULT_OK );
+	for ( i = 1U; i < 65535U; i++ ) {
+		TEST_CHECK( flacd_SlabCreate( &sPool, &nOther ) == FLACD_RESULT_OK );
+		TEST_CHECK( flacd_SlabGetStatic( &sPool, nOther ) == flacd_SlabGetStatic( &sPool, nOther ) );
+		if ( ( nOther == nStale ) || ( flacd_SlabGetStatic( &sPool, nStale ) != NULL ) ) {
+			printf( "  stale handle valid again after %u reuses\n", i );
+			return 1;
+		}
+		TEST_CHECK( flacd_SlabDestroy( &sPool, nStale ) == FLACD_RESULT_FATAL );
+		TEST_CHECK( flacd_SlabDestroy( &sPool, nOther ) == FLACD_RESULT_OK );
+	}
+
+	/* a slot is static memory for flacd_Init */
+	{
+		flacd_workMemoryInfo sWorkMem;
+		flacd_initConfigInfo sInit;
+		TEST_CHECK( flacd_SlabCreate( &sPool, &nHandle ) == FLACD_RESULT_OK );
+		sWorkMem.pStatic = flacd_SlabGetStatic( &sPool, nHandle );
+		sWorkMem.pScratch = NULL;
+		memset( &sInit, 0, sizeof(sInit) );
+		sInit.nInputChannel = 1U;
+		TEST_CHECK( flacd_Init( &sWorkMem, &sInit ) == FLACD_RESULT_OK );
+		TEST_CHECK( flacd_SlabDestroy( &sPool, nHandle ) == FLACD_RESULT_OK );
+	}
+	free( pHandles );
+	free( pBig );
+	free( pSmall );
+	return 0;
+}
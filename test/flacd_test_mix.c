@@ -0,0 +1,175 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_mix.c
+* Description : Tests of the channel mix (flacd_SetChannelMix)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define MIX_COEF_3DB		0.70710678f
+
+/* decode a 6 channel stream with the mix set and compare each output channel with fMatrix applied to the samples */
+static int mix_Check( const flacd_channelMixConfigInfo* const pMix, const ACMW_FLOAT32 fMatrix[6][6],
+					  const ACMW_UINT32 nOutFormat, const ACMW_UINT32 nLayout )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nDecoded, i, j, k;
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 6U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 48000U;
+	sStreamConfig.nBlockSize = 1152U;
+	sStreamConfig.nSamples = 10000U;
+	sStreamConfig.nConstMask = 0x08U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	sMemConfig.nOutBitsPerSample = sInit.nOutBitsPerSample = ( nOutFormat == 1U ) ? 24U : 0U;
+	sMemConfig.nOutSampleFormat = sInit.nOutSampleFormat = ( nOutFormat == 2U ) ? 1U : 0U;
+	sMemConfig.nOutLayout = sInit.nOutLayout = nLayout;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	TEST_CHECK( flacd_SetChannelMix( &sDecoder.sWorkMem, pMix ) == FLACD_RESULT_OK );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == sStream.nSamples );
+
+	for ( j = 0; j < 6U; j++ ) {
+		const ACMW_UINT32 nStride = ( nLayout != 0U ) ? 6U : 1U;
+		const ACMW_UINT8* const pBase = ( nLayout != 0U ) ? ( (const ACMW_UINT8*)ppOut[0] + ( j * sDecoder.nSampleBytes ) ) : (const ACMW_UINT8*)ppOut[j];
+		for ( i = 0; i < nDecoded; i++ ) {
+			/* the output is accumulated in float32: allow a few units of its mantissa over the sum of the terms */
+			double fRef = 0.0, fAbs = 0.0, fOut, fTolerance;
+			for ( k = 0; k < 6U; k++ ) {
+				const double fTerm = (double)fMatrix[j][k] * (double)test_StreamSample( &sStream, k, i );
+				fRef += fTerm;
+				fAbs += ( fTerm < 0.0 ) ? -fTerm : fTerm;
+			}
+			if ( nOutFormat == 2U ) {
+				fRef /= 32768.0;
+				fOut = ( (const ACMW_FLOAT32*)pBase )[i * nStride];
+				fTolerance = ( fAbs / 32768.0 ) * 1e-6;
+			} else if ( nOutFormat == 1U ) {
+				fRef *= 65536.0;
+				fOut = ( (const ACMW_INT32*)pBase )[i * nStride];
+				fTolerance = 256.0 + ( fAbs * 65536.0 * 1e-6 );
+			} else {
+				fOut = ( (const ACMW_INT16*)pBase )[i * nStride];
+				fTolerance = 1.0 + ( fAbs * 1e-6 );
+			}
+			fRef = ( fRef > 2147483647.0 ) ? 2147483647.0 : fRef;
+			fRef = ( fRef < -2147483648.0 ) ? -2147483648.0 : fRef;
+			fRef = ( ( nOutFormat == 0U ) && ( fRef > 32767.0 ) ) ? 32767.0 : fRef;
+			fRef = ( ( nOutFormat == 0U ) && ( fRef < -32768.0 ) ) ? -32768.0 : fRef;
+			if ( ( ( fOut - fRef ) > fTolerance ) || ( ( fRef - fOut ) > fTolerance ) ) {
+				printf( "  mix mismatch: output %u sample %u: %.1f != %.1f\n", j, i, fOut, fRef );
+				return 1;
+			}
+		}
+	}
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_MixRemap( void )
+{
+	static const ACMW_INT16 nRemap[6] = { 5, 4, 3, -1, 1, 0 };
+	flacd_channelMixConfigInfo sMix;
+	ACMW_FLOAT32 fMatrix[6][6];
+	ACMW_UINT32 j, nFormat;
+
+	memset( &sMix, 0, sizeof(sMix) );
+	memset( fMatrix, 0, sizeof(fMatrix) );
+	sMix.nMixMode = 2U;
+	sMix.nOutChannels = 6U;
+	for ( j = 0; j < 6U; j++ ) {
+		sMix.nRemap[j] = nRemap[j];
+		if ( nRemap[j] >= 0 ) {
+			fMatrix[j][nRemap[j]] = 1.0f;
+		}
+	}
+	for ( nFormat = 0; nFormat < 3U; nFormat++ ) {
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 0U ) == 0 );
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 1U ) == 0 );
+	}
+	return 0;
+}
+
+int test_MixPreset( void )
+{
+	const ACMW_FLOAT32 fNorm = 1.0f / ( 1.0f + MIX_COEF_3DB + MIX_COEF_3DB );
+	flacd_channelMixConfigInfo sMix;
+	ACMW_FLOAT32 fMatrix[6][6];
+	ACMW_UINT32 nFormat;
+
+	memset( &sMix, 0, sizeof(sMix) );
+	memset( fMatrix, 0, sizeof(fMatrix) );
+	sMix.nMixMode = 3U;
+	fMatrix[0][0] = fNorm;
+	fMatrix[0][2] = fNorm * MIX_COEF_3DB;
+	fMatrix[0][4] = fNorm * MIX_COEF_3DB;
+	fMatrix[1][1] = fNorm;
+	fMatrix[1][2] = fNorm * MIX_COEF_3DB;
+	fMatrix[1][5] = fNorm * MIX_COEF_3DB;
+	for ( nFormat = 0; nFormat < 3U; nFormat++ ) {
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 0U ) == 0 );
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 1U ) == 0 );
+	}
+	return 0;
+}
+
+int test_MixMatrix( void )
+{
+	flacd_channelMixConfigInfo sMix;
+	ACMW_FLOAT32 fMatrix[6][6];
+	ACMW_UINT32 i, j, nFormat;
+
+	memset( &sMix, 0, sizeof(sMix) );
+	memset( fMatrix, 0, sizeof(fMatrix) );
+	sMix.nMixMode = 1U;
+	sMix.nInChannels = 6U;
+	sMix.nOutChannels = 3U;
+	/* gains above 1 make the PCM output saturate */
+	for ( j = 0; j < 3U; j++ ) {
+		for ( i = 0; i < 6U; i++ ) {
+			sMix.fMatrix[j][i] = fMatrix[j][i] = (ACMW_FLOAT32)( j + 1U ) * 0.9f * ( ( ( ( i + j ) % 3U ) == 0U ) ? 1.0f : -0.5f );
+		}
+	}
+	for ( nFormat = 0; nFormat < 3U; nFormat++ ) {
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 0U ) == 0 );
+		TEST_CHECK( mix_Check( &sMix, (const ACMW_FLOAT32 (*)[6])fMatrix, nFormat, 1U ) == 0 );
+	}
+
+	/* NaN coefficients and more output channels than initialized are rejected */
+	sMix.nOutChannels = 7U;
+	{
+		test_decoder sDecoder;
+		flacd_getMemorySizeConfigInfo sMemConfig;
+		flacd_initConfigInfo sInit;
+		memset( &sMemConfig, 0, sizeof(sMemConfig) );
+		memset( &sInit, 0, sizeof(sInit) );
+		sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+		sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+		TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+		TEST_CHECK( flacd_SetChannelMix( &sDecoder.sWorkMem, &sMix ) == FLACD_RESULT_NG );
+		sMix.nOutChannels = 3U;
+		sMix.fMatrix[1][1] = fMatrix[0][0] - fMatrix[0][0] + ( 0.0f / ( fMatrix[0][1] - fMatrix[0][1] ) );
+		TEST_CHECK( flacd_SetChannelMix( &sDecoder.sWorkMem, &sMix ) == FLACD_RESULT_NG );
+		TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+		test_DecoderClose( &sDecoder );
+	}
+	return 0;
+}
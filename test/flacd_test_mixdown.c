@@ -0,0 +1,240 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_mixdown.c
+* Description : Tests of the decode of several voices into one output (flacd_DecodeMix)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define MIXDOWN_VOICES			2U
+#define MIXDOWN_CHUNK_SAMPLES	1000U
+
+/* two stereo streams with other signals and frame boundaries, the second shorter */
+static int mixdown_StreamMake( test_stream* const pStreams )
+{
+	test_streamConfig sStreamConfig;
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 48000U;
+	sStreamConfig.nBlockSize = 4096U;
+	sStreamConfig.nSamples = 12000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &pStreams[0] ) == 0 );
+	sStreamConfig.nBlockSize = 1152U;
+	sStreamConfig.nSamples = 9000U;
+	sStreamConfig.bVariable = 1U;
+	sStreamConfig.nSeed = 5U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &pStreams[1] ) == 0 );
+	return 0;
+}
+
+static int mixdown_Open( test_decoder* const pDecoder, const ACMW_UINT32 nOutFormat, const ACMW_UINT32 nLayout )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nOutBitsPerSample = sInit.nOutBitsPerSample = ( nOutFormat == 1U ) ? 24U : 0U;
+	sMemConfig.nOutSampleFormat = sInit.nOutSampleFormat = ( nOutFormat == 2U ) ? 1U : 0U;
+	sMemConfig.nOutLayout = sInit.nOutLayout = nLayout;
+	return test_DecoderOpen( pDecoder, &sMemConfig, &sInit );
+}
+
+/* output sample of one voice : the PCM value with the gain, truncated and saturated as the output stage does */
+static ACMW_INT32 mixdown_Pcm16( const test_stream* const pStream, const ACMW_UINT32 nChannel, const ACMW_UINT32 nSample,
+								 const ACMW_FLOAT32 fGain )
+{
+	ACMW_FLOAT32 fVal = (ACMW_FLOAT32)test_PcmValue( pStream, test_StreamSample( pStream, nChannel, nSample ), 0U ) * fGain;
+
+	fVal = ( fVal > 32767.0f ) ? 32767.0f : ( ( fVal < -32768.0f ) ? -32768.0f : fVal );
+	return (ACMW_INT32)fVal;
+}
+
+/* mix the voices in calls of MIXDOWN_CHUNK_SAMPLES until the longest ends and compare each call with the voices added in turn */
+static int mixdown_Check( const test_stream* const pStreams, const ACMW_FLOAT32* const pGains,
+						  const ACMW_UINT32 nOutFormat, const ACMW_UINT32 nLayout, ACMW_UINT32* const pSaturated )
+{
+	test_decoder sDecoders[MIXDOWN_VOICES];
+	flacd_voiceConfigInfo sVoices[MIXDOWN_VOICES];
+	flacd_voiceStatusInfo sVoiceStatus[MIXDOWN_VOICES];
+	flacd_mixConfigInfo sMix;
+	flacd_mixStatusInfo sStatus;
+	ACMW_UINT32 nIn[MIXDOWN_VOICES] = { 0U, 0U }, nPos[MIXDOWN_VOICES] = { 0U, 0U };
+	ACMW_UINT32 nFrameBytes, v, c, i, nIndex;
+	ACMW_INT32 nResult;
+	void **ppOut;
+
+	for ( v = 0; v < MIXDOWN_VOICES; v++ ) {
+		TEST_CHECK( mixdown_Open( &sDecoders[v], nOutFormat, nLayout ) == 0 );
+		sVoices[v].pWorkMemInfo = &sDecoders[v].sWorkMem;
+		sVoices[v].pDecConfigInfo = &pStreams[v].sDecConfig;
+		sVoices[v].fGain = pGains[v];
+	}
+	nFrameBytes = sDecoders[0].nSampleBytes * ( ( nLayout != 0U ) ? 2U : 1U );
+	ppOut = test_OutAlloc( &sDecoders[0], MIXDOWN_CHUNK_SAMPLES );
+	memset( &sMix, 0, sizeof(sMix) );
+	sMix.pVoices = sVoices;
+	sMix.nVoices = MIXDOWN_VOICES;
+	sMix.pOutBuffStart = ppOut;
+	sMix.nOutBuffSize = MIXDOWN_CHUNK_SAMPLES * nFrameBytes;
+	sStatus.pVoices = sVoiceStatus;
+	*pSaturated = 0U;
+
+	while ( nPos[0] < pStreams[0].nSamples ) {
+		for ( v = 0; v < MIXDOWN_VOICES; v++ ) {
+			sVoices[v].pInBuffStart = pStreams[v].pData + pStreams[v].nAudioOffset + nIn[v];
+			sVoices[v].nInBuffSetDataSize = pStreams[v].nSize - pStreams[v].nAudioOffset - nIn[v];
+		}
+		nResult = flacd_DecodeMix( &sMix, &sStatus );
+		TEST_CHECK( sStatus.nMixedSamples == MIXDOWN_CHUNK_SAMPLES );
+		TEST_CHECK( sStatus.nOutBuffUsedDataSize == sMix.nOutBuffSize );
+		/* the shorter voice ends first and adds nothing more, the other voice goes on */
+		TEST_CHECK( ( nResult == FLACD_RESULT_OK ) && ( sVoiceStatus[0].nResult == FLACD_RESULT_OK ) );
+		TEST_CHECK( ( nPos[1] < pStreams[1].nSamples ) || ( sVoiceStatus[1].nDecodedSamples == 0U ) );
+		TEST_CHECK( sVoiceStatus[0].nDecodedSamples == ( ( ( pStreams[0].nSamples - nPos[0] ) < MIXDOWN_CHUNK_SAMPLES ) ?
+														  ( pStreams[0].nSamples - nPos[0] ) : MIXDOWN_CHUNK_SAMPLES ) );
+		for ( i = 0; i < MIXDOWN_CHUNK_SAMPLES; i++ ) {
+			for ( c = 0; c < 2U; c++ ) {
+				ACMW_INT32 nSum = 0;
+				ACMW_FLOAT32 fSum = 0.0f, fOut;
+
+				for ( v = 0; v < MIXDOWN_VOICES; v++ ) {
+					if ( i < sVoiceStatus[v].nDecodedSamples ) {
+						const ACMW_INT32 nValue = test_StreamSample( &pStreams[v], c, nPos[v] + i );
+						nSum += mixdown_Pcm16( &pStreams[v], c, nPos[v] + i, pGains[v] );
+						if ( ( nSum > 32767 ) || ( nSum < -32768 ) ) {
+							nSum = ( nSum > 0 ) ? 32767 : -32768;
+							( *pSaturated )++;
+						}
+						fSum += (ACMW_FLOAT32)nValue * ( ( 1.0f / 32768.0f ) * pGains[v] );
+					}
+				}
+				nIndex = ( nLayout != 0U ) ? ( ( i * 2U ) + c ) : i;
+				if ( nOutFormat == 2U ) {
+					fOut = ( (const ACMW_FLOAT32*)ppOut[( nLayout != 0U ) ? 0U : c] )[nIndex];
+					TEST_CHECK( ( ( fOut - fSum ) < 1.0e-6f ) && ( ( fSum - fOut ) < 1.0e-6f ) );
+				} else {
+					TEST_CHECK( ( (const ACMW_INT16*)ppOut[( nLayout != 0U ) ? 0U : c] )[nIndex] == nSum );
+				}
+			}
+		}
+		for ( v = 0; v < MIXDOWN_VOICES; v++ ) {
+			nIn[v] += sVoiceStatus[v].nInBuffUsedDataSize;
+			nPos[v] += sVoiceStatus[v].nDecodedSamples;
+		}
+	}
+	TEST_CHECK( ( nPos[0] == pStreams[0].nSamples ) && ( nPos[1] == pStreams[1].nSamples ) );
+	test_OutFree( ppOut );
+	for ( v = 0; v < MIXDOWN_VOICES; v++ ) {
+		test_DecoderClose( &sDecoders[v] );
+	}
+	return 0;
+}
+
+int test_DecodeMixVoices( void )
+{
+	static const ACMW_FLOAT32 fHalf[MIXDOWN_VOICES] = { 0.5f, 0.25f };
+	static const ACMW_FLOAT32 fLoud[MIXDOWN_VOICES] = { 3.0f, -2.5f };
+	test_stream sStreams[MIXDOWN_VOICES];
+	ACMW_UINT32 nLayout, nSaturated;
+
+	TEST_CHECK( mixdown_StreamMake( sStreams ) == 0 );
+	for ( nLayout = 0U; nLayout < 2U; nLayout++ ) {
+		TEST_CHECK( mixdown_Check( sStreams, fHalf, 0U, nLayout, &nSaturated ) == 0 );
+		TEST_CHECK( nSaturated == 0U );
+		TEST_CHECK( mixdown_Check( sStreams, fHalf, 2U, nLayout, &nSaturated ) == 0 );
+		/* PCM output saturates at each addition */
+		TEST_CHECK( mixdown_Check( sStreams, fLoud, 0U, nLayout, &nSaturated ) == 0 );
+		TEST_CHECK( nSaturated != 0U );
+	}
+	test_StreamFree( &sStreams[0] );
+	test_StreamFree( &sStreams[1] );
+	return 0;
+}
+
+int test_DecodeMixParameter( void )
+{
+	test_stream sStreams[MIXDOWN_VOICES];
+	test_decoder sDecoder, sOther;
+	flacd_voiceConfigInfo sVoices[MIXDOWN_VOICES];
+	flacd_voiceStatusInfo sVoiceStatus[MIXDOWN_VOICES];
+	flacd_mixConfigInfo sMix;
+	flacd_mixStatusInfo sStatus;
+	ACMW_UINT32 i;
+	void **ppOut;
+
+	TEST_CHECK( mixdown_StreamMake( sStreams ) == 0 );
+	TEST_CHECK( mixdown_Open( &sDecoder, 0U, 0U ) == 0 );
+	TEST_CHECK( mixdown_Open( &sOther, 1U, 0U ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, MIXDOWN_CHUNK_SAMPLES );
+	memset( sVoices, 0, sizeof(sVoices) );
+	for ( i = 0; i < MIXDOWN_VOICES; i++ ) {
+		sVoices[i].pDecConfigInfo = &sStreams[i].sDecConfig;
+		sVoices[i].pInBuffStart = sStreams[i].pData + sStreams[i].nAudioOffset;
+		sVoices[i].nInBuffSetDataSize = sStreams[i].nSize - sStreams[i].nAudioOffset;
+		sVoices[i].fGain = 1.0f;
+	}
+	sVoices[0].pWorkMemInfo = &sDecoder.sWorkMem;
+	memset( &sMix, 0, sizeof(sMix) );
+	sMix.pVoices = sVoices;
+	sMix.nVoices = 1U;
+	sMix.nOutBuffSize = MIXDOWN_CHUNK_SAMPLES * 2U;
+	sStatus.pVoices = sVoiceStatus;
+
+	/* the configuration and the output */
+	TEST_CHECK( flacd_DecodeMix( NULL, &sStatus ) == FLACD_RESULT_FATAL );
+	TEST_CHECK( flacd_DecodeMix( &sMix, NULL ) == FLACD_RESULT_FATAL );
+	sMix.nVoices = 0U;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_FATAL );
+	sMix.nVoices = 1U;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	sMix.pOutBuffStart = ppOut;
+	sMix.nOutBuffSize = 1U;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sMix.nOutBuffSize = MIXDOWN_CHUNK_SAMPLES * 2U;
+	sMix.nOutMode = 2U;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+
+	/* added to what the output holds */
+	for ( i = 0; i < MIXDOWN_CHUNK_SAMPLES; i++ ) {
+		( (ACMW_INT16*)ppOut[0] )[i] = 1000;
+		( (ACMW_INT16*)ppOut[1] )[i] = -1000;
+	}
+	sMix.nOutMode = 1U;
+	sVoices[0].fGain = 0.5f;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sVoiceStatus[0].nDecodedSamples == MIXDOWN_CHUNK_SAMPLES );
+	for ( i = 0; i < MIXDOWN_CHUNK_SAMPLES; i++ ) {
+		TEST_CHECK( ( (const ACMW_INT16*)ppOut[0] )[i] == ( 1000 + mixdown_Pcm16( &sStreams[0], 0U, i, 0.5f ) ) );
+		TEST_CHECK( ( (const ACMW_INT16*)ppOut[1] )[i] == ( -1000 + mixdown_Pcm16( &sStreams[0], 1U, i, 0.5f ) ) );
+	}
+	sVoices[0].pInBuffStart += sVoiceStatus[0].nInBuffUsedDataSize;
+	sVoices[0].nInBuffSetDataSize -= sVoiceStatus[0].nInBuffUsedDataSize;
+
+	/* a voice with another output format is not added, the others are */
+	sVoices[1].pWorkMemInfo = &sOther.sWorkMem;
+	sMix.nVoices = 2U;
+	sMix.nOutMode = 0U;
+	TEST_CHECK( flacd_DecodeMix( &sMix, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( ( sVoiceStatus[0].nResult == FLACD_RESULT_OK ) && ( sVoiceStatus[0].nDecodedSamples == MIXDOWN_CHUNK_SAMPLES ) );
+	TEST_CHECK( ( sVoiceStatus[1].nResult == FLACD_RESULT_NG ) && ( sVoiceStatus[1].nDecodedSamples == 0U ) );
+	TEST_CHECK( flacd_GetErrorFactor( &sOther.sWorkMem ) == FLACD_ERR_PARAMETER );
+	for ( i = 0; i < MIXDOWN_CHUNK_SAMPLES; i++ ) {
+		TEST_CHECK( ( (const ACMW_INT16*)ppOut[0] )[i] == mixdown_Pcm16( &sStreams[0], 0U, MIXDOWN_CHUNK_SAMPLES + i, 0.5f ) );
+	}
+	test_OutFree( ppOut );
+	test_DecoderClose( &sOther );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStreams[0] );
+	test_StreamFree( &sStreams[1] );
+	return 0;
+}
@@ -0,0 +1,142 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_oneshot.c
+* Description : Tests of the whole stream decode (flacd_DecodeStream)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+static void oneshot_StreamConfig( test_streamConfig* const pConfig )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = 2U;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 48000U;
+	pConfig->nBlockSize = 1152U;
+	pConfig->nSamples = 25000U;
+	pConfig->bVariable = 1U;
+}
+
+static int oneshot_Open( test_decoder* const pDecoder, const ACMW_UINT32 nOutLayout )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nOutLayout = sInit.nOutLayout = nOutLayout;
+	return test_DecoderOpen( pDecoder, &sMemConfig, &sInit );
+}
+
+int test_DecodeStream( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_streamConfigInfo sConfig;
+	flacd_streamStatusInfo sStatus;
+	ACMW_UINT32 nLayout;
+	void **ppOut;
+
+	oneshot_StreamConfig( &sStreamConfig );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	for ( nLayout = 0U; nLayout < 2U; nLayout++ ) {
+		const ACMW_UINT32 nFrameBytes = ( nLayout != 0U ) ? 4U : 2U;
+
+		TEST_CHECK( oneshot_Open( &sDecoder, nLayout ) == 0 );
+		ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+		memset( &sConfig, 0, sizeof(sConfig) );
+		sConfig.pInBuffStart = sStream.pData;
+		sConfig.nInBuffSetDataSize = sStream.nSize;
+
+		/* no output buffer : the size needed from STREAMINFO */
+		TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_OK );
+		TEST_CHECK( sStatus.nTotalSamples == sStream.nSamples );
+		TEST_CHECK( sStatus.nOutBuffNeedSize == ( sStream.nSamples * nFrameBytes ) );
+		TEST_CHECK( sStatus.nDecodedSamples == 0U );
+
+		/* one sample short */
+		sConfig.pOutBuffStart = ppOut;
+		sConfig.nOutBuffSize = sStatus.nOutBuffNeedSize - nFrameBytes;
+		TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_NG );
+		TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+
+		/* all of it in one call, also again on the same instance */
+		sConfig.nOutBuffSize = sStatus.nOutBuffNeedSize;
+		TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_OK );
+		TEST_CHECK( sStatus.nDecodedSamples == sStream.nSamples );
+		TEST_CHECK( sStatus.nOutBuffUsedDataSize == sStatus.nOutBuffNeedSize );
+		TEST_CHECK( sStatus.nInBuffUsedDataSize == sStream.nSize );
+		TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, sStream.nSamples, 1.0f ) == 0 );
+		memset( ppOut[0], 0, (size_t)sStatus.nOutBuffNeedSize );
+		TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_OK );
+		TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, sStream.nSamples, 1.0f ) == 0 );
+		test_OutFree( ppOut );
+		test_DecoderClose( &sDecoder );
+	}
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_DecodeStreamFrames( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_streamConfigInfo sConfig;
+	flacd_streamStatusInfo sStatus;
+	ACMW_UINT32 nBad, i;
+	void **ppOut;
+	void *pAfter[TEST_MAX_CHANNELS];
+
+	/* frames without metadata need the stream configuration */
+	oneshot_StreamConfig( &sStreamConfig );
+	sStreamConfig.bNoHeader = 1U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	TEST_CHECK( oneshot_Open( &sDecoder, 0U ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	memset( &sConfig, 0, sizeof(sConfig) );
+	sConfig.pInBuffStart = sStream.pData;
+	sConfig.nInBuffSetDataSize = sStream.nSize;
+	sConfig.pOutBuffStart = ppOut;
+	sConfig.nOutBuffSize = sStream.nSamples * 2U;
+	TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+
+	/* the total is unknown : decoded until the end of the input */
+	sConfig.pDecConfigInfo = &sStream.sDecConfig;
+	TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( sStatus.nTotalSamples == 0U ) && ( sStatus.nOutBuffNeedSize == 0U ) );
+	TEST_CHECK( sStatus.nDecodedSamples == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, sStream.nSamples, 1.0f ) == 0 );
+
+	/* ... or until the output is full, with the last frame whole */
+	sConfig.nOutBuffSize = sStream.pFrameSample[3] * 2U;
+	TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nDecodedSamples == sStream.pFrameSample[3] );
+	TEST_CHECK( sStatus.nInBuffUsedDataSize == sStream.pFrameOffset[3] );
+
+	/* a frame with a CRC error is output as silence and the call warns */
+	nBad = 2U;
+	sStream.pData[sStream.pFrameOffset[nBad + 1U] - 1U] ^= 0x01U;
+	sConfig.nOutBuffSize = sStream.nSamples * 2U;
+	TEST_CHECK( flacd_DecodeStream( &sDecoder.sWorkMem, &sConfig, &sStatus ) == FLACD_RESULT_WARNING );
+	TEST_CHECK( sStatus.nDecodedSamples == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, sStream.pFrameSample[nBad], 1.0f ) == 0 );
+	for ( i = sStream.pFrameSample[nBad]; i < sStream.pFrameSample[nBad + 1U]; i++ ) {
+		TEST_CHECK( ( ( (const ACMW_INT16*)ppOut[0] )[i] == 0 ) && ( ( (const ACMW_INT16*)ppOut[1] )[i] == 0 ) );
+	}
+	for ( i = 0; i < TEST_MAX_CHANNELS; i++ ) {
+		pAfter[i] = (ACMW_INT16*)ppOut[i] + sStream.pFrameSample[nBad + 1U];
+	}
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, pAfter, sStream.pFrameSample[nBad + 1U],
+								  sStream.nSamples - sStream.pFrameSample[nBad + 1U], 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
@@ -0,0 +1,323 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_output.c
+* Description : Tests of the output formats and layouts
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+/* decode a whole stream in one output format and compare it with the samples encoded */
+static int output_Check( const test_streamConfig* const pStreamConfig, const flacd_initConfigInfo* const pInitConfig,
+						 const ACMW_FLOAT32 fGain )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nDecoded;
+
+	TEST_CHECK( test_StreamMake( pStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	sMemConfig.nInputChannel = pInitConfig->nInputChannel;
+	sMemConfig.nOutputChannel = pInitConfig->nOutputChannel;
+	sMemConfig.nOutBitsPerSample = pInitConfig->nOutBitsPerSample;
+	sMemConfig.nOutSampleFormat = pInitConfig->nOutSampleFormat;
+	sMemConfig.nOutLayout = pInitConfig->nOutLayout;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, pInitConfig ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nDecoded, fGain ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+static void output_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nChannels, const ACMW_UINT32 nBps )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = nChannels;
+	pConfig->nBitsPerSample = nBps;
+	pConfig->nSampleRate = 44100U;
+	pConfig->nBlockSize = 4096U;
+	pConfig->nSamples = 20000U;
+}
+
+int test_OutputPcm16( void )
+{
+	static const ACMW_UINT32 nBps[3] = { 8U, 16U, 24U };
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+	ACMW_UINT32 i;
+
+	memset( &sInit, 0, sizeof(sInit) );
+	for ( i = 0; i < 3U; i++ ) {
+		output_StreamConfig( &sStreamConfig, 2U, nBps[i] );
+		TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	}
+	return 0;
+}
+
+int test_OutputPcm24( void )
+{
+	static const ACMW_UINT32 nBps[3] = { 12U, 16U, 24U };
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+	ACMW_UINT32 i;
+
+	memset( &sInit, 0, sizeof(sInit) );
+	sInit.nOutBitsPerSample = 24U;
+	for ( i = 0; i < 3U; i++ ) {
+		output_StreamConfig( &sStreamConfig, 2U, nBps[i] );
+		TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	}
+	return 0;
+}
+
+int test_OutputFloat32( void )
+{
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+
+	memset( &sInit, 0, sizeof(sInit) );
+	sInit.nOutSampleFormat = 1U;
+	output_StreamConfig( &sStreamConfig, 2U, 16U );
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	output_StreamConfig( &sStreamConfig, 2U, 24U );
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	return 0;
+}
+
+int test_OutputInterleaved( void )
+{
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+
+	output_StreamConfig( &sStreamConfig, 2U, 16U );
+	memset( &sInit, 0, sizeof(sInit) );
+	sInit.nOutLayout = 1U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	sInit.nOutBitsPerSample = 24U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	sInit.nOutBitsPerSample = 0U;
+	sInit.nOutSampleFormat = 1U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	return 0;
+}
+
+int test_OutputSixChannels( void )
+{
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+
+	output_StreamConfig( &sStreamConfig, 6U, 16U );
+	sStreamConfig.nConstMask = 0x08U;
+	memset( &sInit, 0, sizeof(sInit) );
+	sInit.nInputChannel = 1U;
+	sInit.nOutputChannel = 2U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	sInit.nOutLayout = 1U;
+	sInit.nOutSampleFormat = 1U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	return 0;
+}
+
+int test_OutputGain( void )
+{
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+	test_decoder sDecoder;
+	flacd_getMemorySizeConfigInfo sMemConfig;
+
+	output_StreamConfig( &sStreamConfig, 2U, 16U );
+	memset( &sInit, 0, sizeof(sInit) );
+	sInit.nOutSampleFormat = 1U;
+	/* a cleared structure gives unity gain whatever fOutGain holds */
+	sInit.fOutGain = 0.25f;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	sInit.nOutGainMode = 1U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 0.25f ) == 0 );
+	sInit.nOutLayout = 1U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 0.25f ) == 0 );
+	/* 0.0 mutes */
+	sInit.fOutGain = 0.0f;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 0.0f ) == 0 );
+
+	/* negative gain and unknown modes are rejected */
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	sMemConfig.nOutSampleFormat = 1U;
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sDecoder.sMemStatus ) == FLACD_RESULT_OK );
+	sDecoder.sWorkMem.pStatic = calloc( sDecoder.sMemStatus.nStaticSize + 8U, 1U );
+	sDecoder.sWorkMem.pScratch = NULL;
+	sInit.fOutGain = -1.0f;
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sInit.fOutGain = 1.0f;
+	sInit.nOutGainMode = 2U;
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	free( sDecoder.sWorkMem.pStatic );
+	return 0;
+}
+
+int test_Version( void )
+{
+	TEST_CHECK( flacd_GetVersion() == 0x00000300U );
+	return 0;
+}
+
+int test_OutputChannelMask( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_getMemorySizeStatusInfo sAllStatus;
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+	test_stream sStream;
+	test_decoder sDecoder, sFront;
+	flacd_ioBufferConfigInfo sBuffConfig;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	void *pLast[TEST_MAX_CHANNELS];
+	void **ppOut;
+	ACMW_UINT32 nDecoded, c, i;
+
+	output_StreamConfig( &sStreamConfig, 6U, 16U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	sMemConfig.nChannels = sInit.nChannels = 6U;
+	TEST_CHECK( flacd_GetMemorySize( &sMemConfig, &sAllStatus ) == FLACD_RESULT_OK );
+	/* scratch memory for two decoded channels only */
+	sMemConfig.nDecodeChannels = sInit.nDecodeChannels = 2U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	TEST_CHECK( sDecoder.sMemStatus.nScratchSize < sAllStatus.nScratchSize );
+
+	/* all channels need more than two */
+	memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+	memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+	sBuffConfig.pInBuffStart = sStream.pData + sStream.nAudioOffset;
+	sBuffConfig.nInBuffSetDataSize = sStream.nSize - sStream.nAudioOffset;
+	sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+	sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+	sBuffStatus.pOutBuffLast = pLast;
+	TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_NOT_SUPPORTED_DATA );
+	/* masks of more channels than that, or of channels not in the input */
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0x07U ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0x41U ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+
+	/* the front pair : channels 0 and 1 exact, the others silent */
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0x03U ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sDecStatus.nSilentChannels == 0x3CU );
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0x03U ) == FLACD_RESULT_OK );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == sStream.nSamples );
+	sFront = sDecoder;
+	sFront.nOutChannels = 2U;
+	TEST_CHECK( test_CheckOutput( &sFront, &sStream, ppOut, 0U, nDecoded, 1.0f ) == 0 );
+	for ( c = 2U; c < 6U; c++ ) {
+		for ( i = 0; i < nDecoded; i++ ) {
+			TEST_CHECK( ( (const ACMW_INT16*)ppOut[c] )[i] == 0 );
+		}
+	}
+	/* 0 selects all channels again */
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0U ) == FLACD_RESULT_OK );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+
+	/* the right channel of stereo frames in every decorrelation : a side channel needs the other one */
+	output_StreamConfig( &sStreamConfig, 2U, 16U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	TEST_CHECK( flacd_SetChannelMask( &sDecoder.sWorkMem, 0x02U ) == FLACD_RESULT_OK );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( test_DecodeAll( &sDecoder, &sStream, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == sStream.nSamples );
+	for ( i = 0; i < nDecoded; i++ ) {
+		TEST_CHECK( ( (const ACMW_INT16*)ppOut[1] )[i] == (ACMW_INT16)test_StreamSample( &sStream, 1U, i ) );
+	}
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* constant subframes are output from their value : stereo in every decorrelation and independent channels */
+int test_OutputConstant( void )
+{
+	static const ACMW_UINT32 nStereoMask[3] = { 0x01U, 0x02U, 0x03U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	test_streamConfig sStreamConfig;
+	flacd_initConfigInfo sInit;
+	test_stream sStream;
+	test_decoder sDecoder;
+	ACMW_UINT32 nPos, nCalls = 0U, i;
+
+	memset( &sInit, 0, sizeof(sInit) );
+	for ( i = 0; i < 3U; i++ ) {
+		output_StreamConfig( &sStreamConfig, 2U, 16U );
+		sStreamConfig.nConstMask = nStereoMask[i];
+		TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+		output_StreamConfig( &sStreamConfig, 2U, 24U );
+		sStreamConfig.nSilentMask = nStereoMask[i];
+		TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+	}
+	sInit.nOutLayout = 1U;
+	sInit.nOutSampleFormat = 1U;
+	output_StreamConfig( &sStreamConfig, 2U, 16U );
+	sStreamConfig.nConstMask = 0x03U;
+	TEST_CHECK( output_Check( &sStreamConfig, &sInit, 1.0f ) == 0 );
+
+	/* channels of constant zero are reported silent in each call, other constant channels are not */
+	output_StreamConfig( &sStreamConfig, 6U, 16U );
+	sStreamConfig.nConstMask = 0x0CU;
+	sStreamConfig.nSilentMask = 0x30U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	for ( nPos = sStream.nAudioOffset; nPos < sStream.nSize; nCalls++ ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sBuffConfig.pInBuffStart = sStream.pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = sStream.nSize - nPos;
+		sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+		sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+		sBuffStatus.pOutBuffLast = pLast;
+		TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		TEST_CHECK( sDecStatus.nDecodedSamples != 0U );
+		TEST_CHECK( sDecStatus.nSilentChannels == 0x30U );
+		for ( i = 0; i < sDecStatus.nDecodedSamples; i++ ) {
+			TEST_CHECK( ( (const ACMW_INT16*)sDecoder.pOutBuff[2] )[i] == (ACMW_INT16)test_StreamSample( &sStream, 2U, 0U ) );
+			TEST_CHECK( ( (const ACMW_INT16*)sDecoder.pOutBuff[5] )[i] == 0 );
+		}
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	TEST_CHECK( nCalls == sStream.nFrames );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
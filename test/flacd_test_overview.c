@@ -0,0 +1,182 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_overview.c
+* Description : Tests of the waveform overview (flacd_SetOverview)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+#define OVERVIEW_BUCKETS		32U
+
+static void overview_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nChannels )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = nChannels;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 48000U;
+	pConfig->nBlockSize = 1152U;
+	pConfig->nSamples = 30000U;
+}
+
+/* decode the stream with the overview set, nMode 2 without output buffers */
+static int overview_Decode( const test_stream* const pStream, flacd_overviewBucket* const pBuckets,
+							const ACMW_UINT32 nBuckets, const ACMW_UINT32 nBucketSamples, const ACMW_UINT32 nMode,
+							ACMW_INT32* const pResult )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	flacd_overviewConfigInfo sOverview;
+	test_decoder sDecoder;
+	void **ppOut = NULL;
+	ACMW_UINT32 nDecoded;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	memset( pBuckets, 0, sizeof(*pBuckets) * nBuckets );
+	memset( &sOverview, 0, sizeof(sOverview) );
+	sOverview.pBuckets = pBuckets;
+	sOverview.nBuckets = nBuckets;
+	sOverview.nBucketSamples = nBucketSamples;
+	sOverview.nOverviewMode = (ACMW_UINT16)nMode;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_OK );
+	if ( nMode == 2U ) {
+		/* no room in the output buffers : the whole frame is still counted */
+		sDecoder.nOutBuffSize = 0U;
+	} else {
+		ppOut = test_OutAlloc( &sDecoder, pStream->nSamples );
+	}
+	*pResult = test_DecodeAll( &sDecoder, pStream, 0U, ppOut, &nDecoded );
+	TEST_CHECK( nDecoded == pStream->nSamples );
+	if ( ppOut != NULL ) {
+		test_OutFree( ppOut );
+	}
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+/* compare a bucket with the samples nFirst to nFirst + nSamples - 1 of the stream, frame nMute (if any) as silence */
+static int overview_CheckBucket( const test_stream* const pStream, const flacd_overviewBucket* const pBucket,
+								 const ACMW_UINT32 nFirst, const ACMW_UINT32 nSamples, const ACMW_UINT32 nMute )
+{
+	const double dScale = 1.0 / (double)( 1U << ( pStream->nBitsPerSample - 1U ) );
+	ACMW_UINT32 c, i;
+
+	TEST_CHECK( pBucket->nSamples == nSamples );
+	for ( c = 0; c < FLACD_OVERVIEW_MAX_CHANNELS; c++ ) {
+		ACMW_INT32 nMin = 0x7FFFFFFF, nMax = -0x7FFFFFFF - 1, nValue;
+		double dSum = 0.0, dDiff;
+
+		for ( i = nFirst; i < ( nFirst + nSamples ); i++ ) {
+			nValue = 0;
+			if ( ( c < pStream->nChannels ) &&
+				 ( ( nMute >= pStream->nFrames ) || ( i < pStream->pFrameSample[nMute] ) || ( i >= pStream->pFrameSample[nMute + 1U] ) ) ) {
+				nValue = test_StreamSample( pStream, c, i );
+			}
+			nMin = ( nValue < nMin ) ? nValue : nMin;
+			nMax = ( nValue > nMax ) ? nValue : nMax;
+			dSum += ( (double)nValue * dScale ) * ( (double)nValue * dScale );
+		}
+		TEST_CHECK( ( pBucket->nMin[c] == nMin ) && ( pBucket->nMax[c] == nMax ) );
+		dDiff = (double)pBucket->fSumSquares[c] - dSum;
+		TEST_CHECK( ( dDiff <= ( dSum * 1.0e-4 ) + 1.0e-6 ) && ( -dDiff <= ( dSum * 1.0e-4 ) + 1.0e-6 ) );
+	}
+	return 0;
+}
+
+int test_OverviewBuckets( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	flacd_overviewBucket sBuckets[OVERVIEW_BUCKETS], sNoOutput[OVERVIEW_BUCKETS];
+	ACMW_INT32 nResult;
+	ACMW_UINT32 nBucketSamples, i;
+
+	/* 3 channels, one of them CONSTANT in every frame : buckets across the frame and tile boundaries */
+	overview_StreamConfig( &sStreamConfig, 3U );
+	sStreamConfig.nConstMask = 0x4U;
+	sStreamConfig.bVariable = 1U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	nBucketSamples = 1000U;
+	TEST_CHECK( overview_Decode( &sStream, sBuckets, OVERVIEW_BUCKETS, nBucketSamples, 1U, &nResult ) == 0 );
+	TEST_CHECK( nResult == FLACD_RESULT_OK );
+	for ( i = 0; i < ( sStream.nSamples / nBucketSamples ); i++ ) {
+		TEST_CHECK( overview_CheckBucket( &sStream, &sBuckets[i], i * nBucketSamples, nBucketSamples, sStream.nFrames ) == 0 );
+	}
+	/* positions after the last bucket are not counted */
+	TEST_CHECK( sBuckets[i].nSamples == 0U );
+
+	/* without PCM output : the same buckets */
+	TEST_CHECK( overview_Decode( &sStream, sNoOutput, OVERVIEW_BUCKETS, nBucketSamples, 2U, &nResult ) == 0 );
+	TEST_CHECK( nResult == FLACD_RESULT_OK );
+	TEST_CHECK( memcmp( sBuckets, sNoOutput, sizeof(sBuckets) ) == 0 );
+
+	/* fewer buckets than the stream fills, the last one partly */
+	nBucketSamples = 7777U;
+	TEST_CHECK( overview_Decode( &sStream, sBuckets, 3U, nBucketSamples, 1U, &nResult ) == 0 );
+	for ( i = 0; i < 3U; i++ ) {
+		TEST_CHECK( overview_CheckBucket( &sStream, &sBuckets[i], i * nBucketSamples, nBucketSamples, sStream.nFrames ) == 0 );
+	}
+	nBucketSamples = 12000U;
+	TEST_CHECK( overview_Decode( &sStream, sBuckets, 3U, nBucketSamples, 1U, &nResult ) == 0 );
+	TEST_CHECK( overview_CheckBucket( &sStream, &sBuckets[2], 24000U, sStream.nSamples - 24000U, sStream.nFrames ) == 0 );
+	test_StreamFree( &sStream );
+
+	/* a frame with a CRC error counts as silence, a bucket per frame */
+	overview_StreamConfig( &sStreamConfig, 2U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	sStream.pData[sStream.pFrameOffset[4] - 1U] ^= 0x01U;
+	TEST_CHECK( overview_Decode( &sStream, sBuckets, OVERVIEW_BUCKETS, sStreamConfig.nBlockSize, 1U, &nResult ) == 0 );
+	TEST_CHECK( nResult == FLACD_RESULT_WARNING );
+	for ( i = 0; i < ( sStream.nFrames - 1U ); i++ ) {
+		TEST_CHECK( overview_CheckBucket( &sStream, &sBuckets[i], sStream.pFrameSample[i], sStreamConfig.nBlockSize, 3U ) == 0 );
+	}
+	TEST_CHECK( ( sBuckets[3].nMin[0] == 0 ) && ( sBuckets[3].nMax[1] == 0 ) && ( sBuckets[3].fSumSquares[0] == 0.0f ) );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_OverviewParameter( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	flacd_overviewConfigInfo sOverview;
+	flacd_overviewBucket sBuckets[OVERVIEW_BUCKETS];
+	test_decoder sDecoder;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	TEST_CHECK( flacd_SetOverview( NULL, &sOverview ) == FLACD_RESULT_FATAL );
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, NULL ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+
+	memset( &sOverview, 0, sizeof(sOverview) );
+	sOverview.nOverviewMode = 3U;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sOverview.nOverviewMode = 1U;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	sOverview.pBuckets = sBuckets;
+	sOverview.nBuckets = OVERVIEW_BUCKETS;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sOverview.nBucketSamples = 4096U;
+	sOverview.nBuckets = 0U;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sOverview.nBuckets = OVERVIEW_BUCKETS;
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_OK );
+	/* off needs no buckets */
+	memset( &sOverview, 0, sizeof(sOverview) );
+	TEST_CHECK( flacd_SetOverview( &sDecoder.sWorkMem, &sOverview ) == FLACD_RESULT_OK );
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
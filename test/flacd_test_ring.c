@@ -0,0 +1,170 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_ring.c
+* Description : Tests of the ring buffer output (flacd_DecodeRing)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+/* decode the stream into a ring of nRingFrames frames with nStride and copy each block out to ppOut */
+static int ring_Decode( test_decoder* const pDecoder, const test_stream* const pStream, const ACMW_UINT32 nRingFrames,
+						const ACMW_UINT32 nStride, void** const ppOut, ACMW_UINT32* const pDecoded )
+{
+	const ACMW_UINT32 bInterleaved = ( pDecoder->sInitConfig.nOutLayout != 0U ) ? 1U : 0U;
+	const ACMW_UINT32 nBytes = pDecoder->nSampleBytes;
+	const ACMW_UINT32 nStep = ( nStride != 0U ) ? nStride : ( ( bInterleaved != 0U ) ? pDecoder->nOutChannels : 1U );
+	void *pRingBuff[TEST_MAX_CHANNELS];
+	flacd_outputRingInfo sRing;
+	ACMW_UINT32 nPos = pStream->nAudioOffset, nRemain = 0U, nDone = 0U, c, i;
+
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		pRingBuff[c] = calloc( ( (size_t)nRingFrames * nStep * nBytes ) + 8U, 1U );
+	}
+	memset( &sRing, 0, sizeof(sRing) );
+	sRing.nStride = nStride;
+	sRing.nRingFrames = nRingFrames;
+	while ( ( nPos < pStream->nSize ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sBuffConfig.pInBuffStart = pStream->pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = pStream->nSize - nPos;
+		sBuffConfig.pOutBuffStart = pRingBuff;
+		sBuffStatus.pOutBuffLast = pLast;
+		/* the consumer empties the ring after each call: the rest of the ring up to its end and the wrap are writable */
+		sRing.nAvailFrames = nRingFrames;
+		TEST_CHECK( flacd_DecodeRing( &pDecoder->sWorkMem, &pStream->sDecConfig, &sBuffConfig, &sRing, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		for ( i = 0; i < sDecStatus.nDecodedSamples; i++ ) {
+			const ACMW_UINT32 nFrame = ( sRing.nWritePos + i ) % nRingFrames;
+			for ( c = 0; c < pDecoder->nOutChannels; c++ ) {
+				const ACMW_UINT8* const pSrc = ( bInterleaved != 0U ) ? ( (const ACMW_UINT8*)pRingBuff[0] + ( ( ( nFrame * nStep ) + c ) * nBytes ) )
+																	  : ( (const ACMW_UINT8*)pRingBuff[c] + ( nFrame * nStep * nBytes ) );
+				ACMW_UINT8* const pDst = ( bInterleaved != 0U ) ? ( (ACMW_UINT8*)ppOut[0] + ( ( ( ( nDone + i ) * pDecoder->nOutChannels ) + c ) * nBytes ) )
+																: ( (ACMW_UINT8*)ppOut[c] + ( ( nDone + i ) * nBytes ) );
+				memcpy( pDst, pSrc, nBytes );
+			}
+		}
+		sRing.nWritePos = ( sRing.nWritePos + sDecStatus.nDecodedSamples ) % nRingFrames;
+		TEST_CHECK( ( bInterleaved != 0U ) ||
+					( pLast[0] == (void*)( (ACMW_UINT8*)pRingBuff[0] + ( sRing.nWritePos * nStep * nBytes ) ) ) );
+		nDone += sDecStatus.nDecodedSamples;
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	for ( c = 0; c < TEST_MAX_CHANNELS; c++ ) {
+		free( pRingBuff[c] );
+	}
+	*pDecoded = nDone;
+	return 0;
+}
+
+static int ring_Check( const flacd_initConfigInfo* const pInit, const ACMW_UINT32 nRingFrames, const ACMW_UINT32 nStride )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nDecoded;
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 44100U;
+	sStreamConfig.nBlockSize = 1152U;
+	sStreamConfig.nSamples = 12345U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	sMemConfig.nOutBitsPerSample = pInit->nOutBitsPerSample;
+	sMemConfig.nOutSampleFormat = pInit->nOutSampleFormat;
+	sMemConfig.nOutLayout = pInit->nOutLayout;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, pInit ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	TEST_CHECK( ring_Decode( &sDecoder, &sStream, nRingFrames, nStride, ppOut, &nDecoded ) == 0 );
+	TEST_CHECK( nDecoded == sStream.nSamples );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nDecoded, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_RingOutput( void )
+{
+	flacd_initConfigInfo sInit;
+
+	memset( &sInit, 0, sizeof(sInit) );
+	/* rings shorter and longer than a block, wrapping inside a block */
+	TEST_CHECK( ring_Check( &sInit, 1000U, 0U ) == 0 );
+	TEST_CHECK( ring_Check( &sInit, 3000U, 0U ) == 0 );
+	/* channel areas with a stride, as an interleaved device buffer seen per channel */
+	TEST_CHECK( ring_Check( &sInit, 1000U, 3U ) == 0 );
+	sInit.nOutLayout = 1U;
+	TEST_CHECK( ring_Check( &sInit, 777U, 0U ) == 0 );
+	TEST_CHECK( ring_Check( &sInit, 777U, 4U ) == 0 );
+	sInit.nOutSampleFormat = 1U;
+	TEST_CHECK( ring_Check( &sInit, 1000U, 0U ) == 0 );
+	return 0;
+}
+
+int test_RingParameter( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_ioBufferConfigInfo sBuffConfig;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	flacd_outputRingInfo sRing;
+	void *pLast[TEST_MAX_CHANNELS];
+
+	memset( &sStreamConfig, 0, sizeof(sStreamConfig) );
+	sStreamConfig.nChannels = 2U;
+	sStreamConfig.nBitsPerSample = 16U;
+	sStreamConfig.nSampleRate = 44100U;
+	sStreamConfig.nBlockSize = 1152U;
+	sStreamConfig.nSamples = 5000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nOutLayout = sInit.nOutLayout = 1U;
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+
+	memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+	memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+	sBuffConfig.pInBuffStart = sStream.pData + sStream.nAudioOffset;
+	sBuffConfig.nInBuffSetDataSize = sStream.nSize - sStream.nAudioOffset;
+	sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+	sBuffStatus.pOutBuffLast = pLast;
+	TEST_CHECK( flacd_DecodeRing( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, NULL, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	/* an interleaved stride smaller than the output channels, a write position out of the ring */
+	memset( &sRing, 0, sizeof(sRing) );
+	sRing.nStride = 1U;
+	sRing.nAvailFrames = 100U;
+	TEST_CHECK( flacd_DecodeRing( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sRing, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sRing.nStride = 0U;
+	sRing.nRingFrames = 100U;
+	sRing.nWritePos = 100U;
+	TEST_CHECK( flacd_DecodeRing( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sRing, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	/* flacd_Decode still writes to the linear buffers */
+	sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+	TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sDecStatus.nDecodedSamples == 1152U );
+	TEST_CHECK( pLast[0] == (void*)( (ACMW_UINT8*)sDecoder.pOutBuff[0] + ( 1152U * 2U * sizeof(ACMW_INT16) ) ) );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
@@ -0,0 +1,547 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_seek.c
+* Description : Tests of the seek APIs
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+/* decode from nOffset to the end and check the output starts at nTarget */
+static int seek_CheckFrom( test_decoder* const pDecoder, const test_stream* const pStream, const ACMW_UINT32 nOffset,
+						   const ACMW_UINT32 nTarget )
+{
+	test_stream sFrom = *pStream;
+	void **ppOut;
+	ACMW_UINT32 nDecoded;
+
+	sFrom.nAudioOffset = nOffset;
+	ppOut = test_OutAlloc( pDecoder, pStream->nSamples );
+	TEST_CHECK( test_DecodeAll( pDecoder, &sFrom, 0U, ppOut, &nDecoded ) == FLACD_RESULT_OK );
+	TEST_CHECK( nDecoded == ( pStream->nSamples - nTarget ) );
+	TEST_CHECK( test_CheckOutput( pDecoder, pStream, ppOut, nTarget, nDecoded, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	return 0;
+}
+
+static void seek_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nSeekPoints )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = 2U;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 44100U;
+	pConfig->nBlockSize = 4096U;
+	pConfig->nSamples = 100000U;
+	pConfig->bVariable = 1U;
+	pConfig->nSeekPoints = nSeekPoints;
+}
+
+int test_SeekTable( void )
+{
+	static const ACMW_UINT32 nTargets[6] = { 0U, 1U, 4095U, 50000U, 77777U, 99999U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_seekConfigInfo sSeekConfig;
+	flacd_seekStatusInfo sSeekStatus;
+	ACMW_UINT32 nPoints, i, f;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	/* with a SEEKTABLE, and from the first frame without one */
+	for ( nPoints = 0U; nPoints <= 10U; nPoints += 10U ) {
+		seek_StreamConfig( &sStreamConfig, nPoints );
+		TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+		memset( &sHeader, 0, sizeof(sHeader) );
+		sHeaderConfig.pInBuffStart = sStream.pData;
+		sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+		sHeaderConfig.nInBuffOffset = 0U;
+		TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_OK );
+		for ( i = 0; i < 6U; i++ ) {
+			sSeekConfig.nTargetSample = nTargets[i];
+			sSeekConfig.pSeekTable = ( sHeader.nSeekPoints != 0U ) ? ( sStream.pData + sHeader.nSeekTableOffset ) : NULL;
+			sSeekConfig.nSeekPoints = sHeader.nSeekPoints;
+			sSeekConfig.nAudioOffset = sHeader.nAudioOffset;
+			TEST_CHECK( flacd_Seek( &sDecoder.sWorkMem, &sSeekConfig, &sSeekStatus ) == FLACD_RESULT_OK );
+			/* the nearest point at or before the target */
+			TEST_CHECK( sSeekStatus.nSeekSample <= nTargets[i] );
+			for ( f = 0; ( f < sStream.nFrames ) && ( sStream.pFrameOffset[f] != sSeekStatus.nInBuffOffset ); f++ ) {
+			}
+			TEST_CHECK( ( f < sStream.nFrames ) && ( sStream.pFrameSample[f] == sSeekStatus.nSeekSample ) );
+			TEST_CHECK( ( nPoints == 0U ) ? ( f == 0U ) : ( ( nTargets[i] - sSeekStatus.nSeekSample ) <= ( sStream.nSamples / nPoints ) + 4096U ) );
+			TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sSeekStatus.nInBuffOffset, nTargets[i] ) == 0 );
+		}
+		test_StreamFree( &sStream );
+	}
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+int test_SeekLongStream( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_ioBufferConfigInfo sBuffConfig;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	void *pLast[TEST_MAX_CHANNELS];
+	ACMW_UINT32 nPos, f;
+
+	/* STREAMINFO of 2^32 samples or more */
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.nSamples = 10000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	sStream.pData[4U + 4U + 13U] |= 0x01U;
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = sStream.pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_NG );
+	test_StreamFree( &sStream );
+
+	/* the last frames before 2^32 samples : the frame that ends beyond is not output */
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.bVariable = 0U;
+	sStreamConfig.bNoHeader = 1U;
+	sStreamConfig.nSamples = 3U * 4096U;
+	sStreamConfig.nFirstFrame = ( 1U << 20 ) - 2U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	nPos = 0U;
+	for ( f = 0; f < 2U; f++ ) {
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sBuffConfig.pInBuffStart = sStream.pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = sStream.nSize - nPos;
+		sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+		sBuffConfig.nOutBuffSize = sDecoder.nOutBuffSize;
+		sBuffStatus.pOutBuffLast = pLast;
+		if ( f == 0U ) {
+			TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+			TEST_CHECK( sDecStatus.nSamplePosition == 0xFFFFE000U );
+			TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, sDecoder.pOutBuff, 0U, 4096U, 1.0f ) == 0 );
+		} else {
+			TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+			TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_NOT_SUPPORTED_DATA );
+			TEST_CHECK( sDecStatus.nDecodedSamples == 0U );
+			TEST_CHECK( sDecStatus.nRemainSamples == 0U );
+		}
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	TEST_CHECK( nPos == sStream.pFrameOffset[2] );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* bisection seek to nTarget, giving each call the bytes asked for ; returns the number of probes read (-1 : error) */
+static int seek_Bisect( test_decoder* const pDecoder, const test_stream* const pStream, const flacd_headerStatusInfo* const pHeader,
+						const ACMW_UINT32 nTarget, flacd_seekStatusInfo* const pSeekStatus )
+{
+	flacd_bisectConfigInfo sBisectConfig;
+	ACMW_INT32 nRet;
+	int nProbes = 0;
+
+	sBisectConfig.nTargetSample = nTarget;
+	sBisectConfig.pHeaderInfo = pHeader;
+	sBisectConfig.nStreamSize = pStream->nSize;
+	sBisectConfig.pInBuffStart = NULL;
+	sBisectConfig.nInBuffSetDataSize = 0U;
+	while ( ( nRet = flacd_SeekBisect( &pDecoder->sWorkMem, &sBisectConfig, pSeekStatus ) ) == FLACD_RESULT_WARNING ) {
+		if ( ( nProbes > 64 ) || ( pSeekStatus->nInBuffOffset >= pStream->nSize ) ) {
+			return -1;
+		}
+		sBisectConfig.pInBuffStart = pStream->pData + pSeekStatus->nInBuffOffset;
+		sBisectConfig.nInBuffSetDataSize = ( ( pSeekStatus->nInBuffOffset + pSeekStatus->nNeedSize ) > pStream->nSize ) ?
+										   ( pStream->nSize - pSeekStatus->nInBuffOffset ) : pSeekStatus->nNeedSize;
+		nProbes++;
+	}
+	return ( nRet == FLACD_RESULT_OK ) ? nProbes : -1;
+}
+
+int test_SeekBisect( void )
+{
+	static const ACMW_UINT32 nTargets[7] = { 0U, 100U, 20000U, 123456U, 250000U, 299999U, 123457U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_seekStatusInfo sSeekStatus;
+	ACMW_UINT32 i, f;
+	int nProbes, nFirstProbes = 0;
+
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.nSamples = 300000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = sStream.pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_OK );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+
+	for ( i = 0; i < 7U; i++ ) {
+		nProbes = seek_Bisect( &sDecoder, &sStream, &sHeader, nTargets[i], &sSeekStatus );
+		TEST_CHECK( nProbes >= 0 );
+		/* the frame holding the target */
+		for ( f = 0; ( f < sStream.nFrames ) && ( sStream.pFrameOffset[f] != sSeekStatus.nInBuffOffset ); f++ ) {
+		}
+		TEST_CHECK( ( f < sStream.nFrames ) && ( sStream.pFrameSample[f] == sSeekStatus.nSeekSample ) );
+		TEST_CHECK( ( sSeekStatus.nSeekSample <= nTargets[i] ) && ( ( f + 1U == sStream.nFrames ) || ( sStream.pFrameSample[f + 1U] > nTargets[i] ) ) );
+		TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sSeekStatus.nInBuffOffset, nTargets[i] ) == 0 );
+		nFirstProbes = ( i == 3U ) ? nProbes : nFirstProbes;
+	}
+	/* the frames found before bracket a target next to an earlier one */
+	TEST_CHECK( nFirstProbes > 0 );
+	TEST_CHECK( nProbes < nFirstProbes );
+
+	/* a target beyond the stream */
+	TEST_CHECK( seek_Bisect( &sDecoder, &sStream, &sHeader, 300000U, &sSeekStatus ) < 0 );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* build the frame index of the stream, nChunk bytes of input per call ; returns the last result */
+static ACMW_INT32 seek_IndexBuild( test_decoder* const pDecoder, const test_stream* const pStream, const flacd_headerStatusInfo* const pHeader,
+							const ACMW_UINT32 nChunk, const ACMW_UINT32 nInterval, ACMW_UINT8* const pIndex, const ACMW_UINT32 nIndexSize,
+							flacd_indexBuildStatusInfo* const pBuildStatus )
+{
+	flacd_indexBuildConfigInfo sBuildConfig;
+	ACMW_INT32 nRet;
+	ACMW_UINT32 nCalls = 0U;
+
+	memset( pBuildStatus, 0, sizeof(*pBuildStatus) );
+	do {
+		const ACMW_UINT32 nFrom = ( nCalls == 0U ) ? pHeader->nAudioOffset : pBuildStatus->nNextOffset;
+		sBuildConfig.pInBuffStart = pStream->pData + nFrom;
+		sBuildConfig.nInBuffSetDataSize = ( ( nFrom + nChunk ) > pStream->nSize ) ? ( pStream->nSize - nFrom ) : nChunk;
+		sBuildConfig.nInBuffOffset = nFrom;
+		sBuildConfig.pHeaderInfo = pHeader;
+		sBuildConfig.nStreamSize = pStream->nSize;
+		sBuildConfig.nInterval = nInterval;
+		sBuildConfig.pIndex = pIndex;
+		sBuildConfig.nIndexSize = nIndexSize;
+		nRet = flacd_IndexBuild( &pDecoder->sWorkMem, &sBuildConfig, pBuildStatus );
+		nCalls++;
+	} while ( ( nRet == FLACD_RESULT_WARNING ) && ( nCalls < 10000U ) );
+	return nRet;
+}
+
+static ACMW_UINT32 seek_ReadBE( const ACMW_UINT8* const pData )
+{
+	return ( (ACMW_UINT32)pData[0] << 24 ) | ( (ACMW_UINT32)pData[1] << 16 ) | ( (ACMW_UINT32)pData[2] << 8 ) | (ACMW_UINT32)pData[3];
+}
+
+int test_SeekIndex( void )
+{
+	static const ACMW_UINT32 nTargets[5] = { 0U, 7U, 65536U, 150001U, 199999U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_indexBuildStatusInfo sBuildStatus;
+	flacd_indexSeekConfigInfo sIndexSeek;
+	flacd_seekStatusInfo sSeekStatus;
+	ACMW_UINT8 *pIndex;
+	ACMW_UINT32 nIndexSize, nFrames, i, f;
+
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.nSamples = 200000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = sStream.pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_OK );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	nFrames = sStream.nFrames;
+	nIndexSize = FLACD_INDEX_HEADER_SIZE + ( FLACD_INDEX_ENTRY_SIZE * nFrames );
+	pIndex = (ACMW_UINT8*)malloc( nIndexSize );
+
+	/* an entry every 20000 samples, input in chunks smaller than a frame */
+	TEST_CHECK( seek_IndexBuild( &sDecoder, &sStream, &sHeader, 1000U, 20000U, pIndex, nIndexSize, &sBuildStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( sBuildStatus.nEntries > 5U ) && ( sBuildStatus.nEntries <= 11U ) );
+	/* every frame : the entries are the frames of the stream */
+	TEST_CHECK( seek_IndexBuild( &sDecoder, &sStream, &sHeader, 5000U, 0U, pIndex, nIndexSize, &sBuildStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sBuildStatus.nEntries == nFrames );
+	TEST_CHECK( sBuildStatus.nIndexUsedSize == nIndexSize );
+	for ( f = 0; f < nFrames; f++ ) {
+		TEST_CHECK( seek_ReadBE( pIndex + FLACD_INDEX_HEADER_SIZE + ( f * FLACD_INDEX_ENTRY_SIZE ) ) == sStream.pFrameSample[f] );
+		TEST_CHECK( seek_ReadBE( pIndex + FLACD_INDEX_HEADER_SIZE + ( f * FLACD_INDEX_ENTRY_SIZE ) + 4U ) == sStream.pFrameOffset[f] );
+	}
+	/* too small an index */
+	TEST_CHECK( seek_IndexBuild( &sDecoder, &sStream, &sHeader, 5000U, 0U, pIndex, nIndexSize - FLACD_INDEX_ENTRY_SIZE, &sBuildStatus ) == FLACD_RESULT_NG );
+
+	/* the index belongs to this stream only */
+	TEST_CHECK( seek_IndexBuild( &sDecoder, &sStream, &sHeader, sStream.nSize, 0U, pIndex, nIndexSize, &sBuildStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_IndexCheck( pIndex, nIndexSize, &sHeader, sStream.nSize, (ACMW_BOOL)1 ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_IndexCheck( pIndex, nIndexSize, &sHeader, sStream.nSize - 1U, (ACMW_BOOL)0 ) == FLACD_RESULT_NG );
+	sHeader.nMD5Signature[3] ^= 0x10U;
+	TEST_CHECK( flacd_IndexCheck( pIndex, nIndexSize, &sHeader, sStream.nSize, (ACMW_BOOL)0 ) == FLACD_RESULT_NG );
+	sHeader.nMD5Signature[3] ^= 0x10U;
+	pIndex[nIndexSize - 1U] ^= 0x01U;
+	TEST_CHECK( flacd_IndexCheck( pIndex, nIndexSize, &sHeader, sStream.nSize, (ACMW_BOOL)1 ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_IndexCheck( pIndex, nIndexSize, &sHeader, sStream.nSize, (ACMW_BOOL)0 ) == FLACD_RESULT_OK );
+	pIndex[nIndexSize - 1U] ^= 0x01U;
+
+	/* a new instance seeks through the stored index alone */
+	test_DecoderClose( &sDecoder );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	for ( i = 0; i < 5U; i++ ) {
+		sIndexSeek.nTargetSample = nTargets[i];
+		sIndexSeek.pIndex = pIndex;
+		sIndexSeek.nIndexSize = nIndexSize;
+		TEST_CHECK( flacd_SeekIndex( &sDecoder.sWorkMem, &sIndexSeek, &sSeekStatus ) == FLACD_RESULT_OK );
+		for ( f = 0; ( f < nFrames ) && ( sStream.pFrameOffset[f] != sSeekStatus.nInBuffOffset ); f++ ) {
+		}
+		TEST_CHECK( ( f < nFrames ) && ( sStream.pFrameSample[f] == sSeekStatus.nSeekSample ) );
+		TEST_CHECK( ( sSeekStatus.nSeekSample <= nTargets[i] ) && ( ( f + 1U == nFrames ) || ( sStream.pFrameSample[f + 1U] > nTargets[i] ) ) );
+		TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sSeekStatus.nInBuffOffset, nTargets[i] ) == 0 );
+	}
+	free( pIndex );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_SkipFrames( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_skipConfigInfo sSkipConfig;
+	flacd_skipStatusInfo sSkipStatus;
+	flacd_ioBufferConfigInfo sBuffConfig;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	void *pLast[TEST_MAX_CHANNELS];
+	ACMW_UINT32 nFrames;
+
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.nSamples = 60000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	nFrames = sStream.nFrames;
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+
+	/* three frames from the first one */
+	sSkipConfig.pInBuffStart = sStream.pData + sStream.nAudioOffset;
+	sSkipConfig.nInBuffSetDataSize = sStream.nSize - sStream.nAudioOffset;
+	sSkipConfig.nMaxFrames = 3U;
+	TEST_CHECK( flacd_Skip( &sDecoder.sWorkMem, &sStream.sDecConfig, &sSkipConfig, &sSkipStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sSkipStatus.nSkippedFrames == 3U );
+	TEST_CHECK( sSkipStatus.nSkippedSamples == sStream.pFrameSample[3] );
+	TEST_CHECK( sSkipStatus.nSamplePosition == sStream.pFrameSample[3] );
+	TEST_CHECK( ( sStream.nAudioOffset + sSkipStatus.nInBuffUsedDataSize ) == sStream.pFrameOffset[3] );
+	TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sStream.pFrameOffset[3], sStream.pFrameSample[3] ) == 0 );
+
+	/* in the middle of a frame being output : the rest of it is dropped */
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_OK );
+	memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+	memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+	sBuffConfig.pInBuffStart = sStream.pData + sStream.pFrameOffset[1];
+	sBuffConfig.nInBuffSetDataSize = sStream.nSize - sStream.pFrameOffset[1];
+	sBuffConfig.pOutBuffStart = sDecoder.pOutBuff;
+	sBuffConfig.nOutBuffSize = 100U * sizeof(ACMW_INT16);
+	sBuffStatus.pOutBuffLast = pLast;
+	TEST_CHECK( flacd_Decode( &sDecoder.sWorkMem, &sStream.sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sDecStatus.nRemainSamples != 0U );
+	sSkipConfig.pInBuffStart = sStream.pData + sStream.pFrameOffset[2];
+	sSkipConfig.nInBuffSetDataSize = sStream.nSize - sStream.pFrameOffset[2];
+	sSkipConfig.nMaxFrames = 1U;
+	TEST_CHECK( flacd_Skip( &sDecoder.sWorkMem, &sStream.sDecConfig, &sSkipConfig, &sSkipStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( sSkipStatus.nSkippedFrames == 1U ) && ( sSkipStatus.nSamplePosition == sStream.pFrameSample[3] ) );
+	TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sStream.pFrameOffset[3], sStream.pFrameSample[3] ) == 0 );
+
+	/* as many as the input holds : the last frame is not skipped */
+	sSkipConfig.pInBuffStart = sStream.pData + sStream.nAudioOffset;
+	sSkipConfig.nInBuffSetDataSize = sStream.nSize - sStream.nAudioOffset;
+	sSkipConfig.nMaxFrames = 0U;
+	TEST_CHECK( flacd_Skip( &sDecoder.sWorkMem, &sStream.sDecConfig, &sSkipConfig, &sSkipStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sSkipStatus.nSkippedFrames == ( nFrames - 1U ) );
+	TEST_CHECK( sSkipStatus.nSamplePosition == sStream.pFrameSample[nFrames - 1U] );
+	TEST_CHECK( seek_CheckFrom( &sDecoder, &sStream, sStream.pFrameOffset[nFrames - 1U], sStream.pFrameSample[nFrames - 1U] ) == 0 );
+
+	/* no frame in the input */
+	sSkipConfig.pInBuffStart = sStream.pData;
+	sSkipConfig.nInBuffSetDataSize = sStream.nAudioOffset;
+	TEST_CHECK( flacd_Skip( &sDecoder.sWorkMem, &sStream.sDecConfig, &sSkipConfig, &sSkipStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_LOST_SYNC );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* read [nStart, nEnd) from the bytes the call asks for only, and compare the output */
+static int seek_ReadRange( test_decoder* const pDecoder, const test_stream* const pStream, const ACMW_UINT8* const pIndex,
+						   const ACMW_UINT32 nIndexSize, const ACMW_UINT32 nStart, const ACMW_UINT32 nEnd )
+{
+	flacd_rangeConfigInfo sRange;
+	flacd_rangeStatusInfo sRangeStatus;
+	ACMW_UINT8 *pPart;
+	void **ppOut;
+	ACMW_UINT32 f;
+
+	memset( &sRange, 0, sizeof(sRange) );
+	sRange.nStartSample = nStart;
+	sRange.nEndSample = nEnd;
+	sRange.pIndex = pIndex;
+	sRange.nIndexSize = nIndexSize;
+	sRange.pDecConfigInfo = &pStream->sDecConfig;
+	TEST_CHECK( flacd_ReadRange( &pDecoder->sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	/* from the start of the frame holding nStart at the latest, to the end of the frame holding nEnd - 1 at least */
+	for ( f = 0; ( ( f + 1U ) < pStream->nFrames ) && ( pStream->pFrameSample[f + 1U] <= nStart ); f++ ) {
+	}
+	TEST_CHECK( sRangeStatus.nNeedOffset <= pStream->pFrameOffset[f] );
+	for ( ; ( f < pStream->nFrames ) && ( pStream->pFrameSample[f] < nEnd ); f++ ) {
+	}
+	TEST_CHECK( ( sRangeStatus.nNeedOffset + sRangeStatus.nNeedSize ) >= ( ( f < pStream->nFrames ) ? pStream->pFrameOffset[f] : pStream->nSize ) );
+
+	pPart = (ACMW_UINT8*)malloc( sRangeStatus.nNeedSize );
+	memcpy( pPart, pStream->pData + sRangeStatus.nNeedOffset, sRangeStatus.nNeedSize );
+	ppOut = test_OutAlloc( pDecoder, nEnd - nStart );
+	sRange.pInBuffStart = pPart;
+	sRange.nInBuffSetDataSize = sRangeStatus.nNeedSize;
+	sRange.nInBuffOffset = sRangeStatus.nNeedOffset;
+	sRange.pOutBuffStart = ppOut;
+	sRange.nOutBuffSize = ( nEnd - nStart ) * pDecoder->nSampleBytes;
+	TEST_CHECK( flacd_ReadRange( &pDecoder->sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sRangeStatus.nDecodedSamples == ( nEnd - nStart ) );
+	TEST_CHECK( sRangeStatus.nOutBuffUsedDataSize == sRange.nOutBuffSize );
+	TEST_CHECK( test_CheckOutput( pDecoder, pStream, ppOut, nStart, nEnd - nStart, 1.0f ) == 0 );
+	test_OutFree( ppOut );
+	free( pPart );
+	return 0;
+}
+
+int test_ReadRange( void )
+{
+	static const ACMW_UINT32 nRanges[6][2] = {
+		{ 0U, 100U }, { 7U, 4103U }, { 19999U, 20001U }, { 65536U, 90000U }, { 150001U, 200000U }, { 123456U, 123457U }
+	};
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerConfigInfo sHeaderConfig;
+	flacd_headerStatusInfo sHeader;
+	flacd_indexBuildStatusInfo sBuildStatus;
+	flacd_rangeConfigInfo sRange;
+	flacd_rangeStatusInfo sRangeStatus;
+	flacd_frameCacheConfigInfo sCacheConfig;
+	flacd_frameCacheStatusInfo sCacheStatus;
+	ACMW_UINT8 *pIndex;
+	void **ppOut;
+	void *pCache;
+	ACMW_UINT32 nIndexSize, nCacheSize, i;
+
+	seek_StreamConfig( &sStreamConfig, 0U );
+	sStreamConfig.nSamples = 200000U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sHeader, 0, sizeof(sHeader) );
+	sHeaderConfig.pInBuffStart = sStream.pData;
+	sHeaderConfig.nInBuffSetDataSize = sStream.nSize;
+	sHeaderConfig.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, &sHeader ) == FLACD_RESULT_OK );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	/* a sparse index : an entry every 20000 samples */
+	nIndexSize = FLACD_INDEX_HEADER_SIZE + ( FLACD_INDEX_ENTRY_SIZE * sStream.nFrames );
+	pIndex = (ACMW_UINT8*)malloc( nIndexSize );
+	TEST_CHECK( seek_IndexBuild( &sDecoder, &sStream, &sHeader, sStream.nSize, 20000U, pIndex, nIndexSize, &sBuildStatus ) == FLACD_RESULT_OK );
+	nIndexSize = sBuildStatus.nIndexUsedSize;
+
+	for ( i = 0; i < 6U; i++ ) {
+		TEST_CHECK( seek_ReadRange( &sDecoder, &sStream, pIndex, nIndexSize, nRanges[i][0], nRanges[i][1] ) == 0 );
+	}
+
+	/* empty or reversed ranges, past the end, an output too small, input after the first frame */
+	memset( &sRange, 0, sizeof(sRange) );
+	sRange.pIndex = pIndex;
+	sRange.nIndexSize = nIndexSize;
+	sRange.pDecConfigInfo = &sStream.sDecConfig;
+	sRange.nStartSample = 500U;
+	sRange.nEndSample = 500U;
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sRange.nEndSample = sStream.nSamples + 1U;
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sRange.nEndSample = 30000U;
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	ppOut = test_OutAlloc( &sDecoder, sRange.nEndSample - sRange.nStartSample );
+	sRange.pInBuffStart = sStream.pData;
+	sRange.nInBuffSetDataSize = sStream.nSize;
+	sRange.pOutBuffStart = ppOut;
+	sRange.nOutBuffSize = ( sRange.nEndSample - sRange.nStartSample - 1U ) * 2U;
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sRange.nOutBuffSize += 2U;
+	sRange.pInBuffStart = sStream.pData + sStream.pFrameOffset[1];
+	sRange.nInBuffOffset = sStream.pFrameOffset[1];
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	/* the whole stream given */
+	sRange.pInBuffStart = sStream.pData;
+	sRange.nInBuffOffset = 0U;
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, sRange.nStartSample, sRange.nEndSample - sRange.nStartSample, 1.0f ) == 0 );
+
+	/* with a frame cache the frames read before are not decoded again */
+	nCacheSize = FLACD_FRAMECACHE_HEADER_SIZE +
+				 ( ( FLACD_FRAMECACHE_ENTRY_SIZE + ( ( sStream.sDecConfig.nMaxFrameSize + 7U ) & ~7U ) + ( 4096U * 2U * 4U ) ) * 64U );
+	pCache = calloc( nCacheSize, 1U );
+	memset( &sCacheConfig, 0, sizeof(sCacheConfig) );
+	sCacheConfig.pCache = pCache;
+	sCacheConfig.nCacheSize = nCacheSize;
+	sCacheConfig.nCacheMode = 1U;
+	sCacheConfig.nMaxBlockSize = sStream.sDecConfig.nMaxBlockSize;
+	sCacheConfig.nMaxFrameSize = sStream.sDecConfig.nMaxFrameSize;
+	TEST_CHECK( flacd_SetFrameCache( &sDecoder.sWorkMem, &sCacheConfig ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetFrameCacheStatus( &sDecoder.sWorkMem, &sCacheStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( sCacheStatus.nHits == 0U ) && ( sCacheStatus.nEntries == sCacheStatus.nMisses ) && ( sCacheStatus.nEvictions == 0U ) );
+	memset( ppOut[0], 0, (size_t)sRange.nOutBuffSize );
+	TEST_CHECK( flacd_ReadRange( &sDecoder.sWorkMem, &sRange, &sRangeStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetFrameCacheStatus( &sDecoder.sWorkMem, &sCacheStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sCacheStatus.nHits == sCacheStatus.nEntries );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, sRange.nStartSample, sRange.nEndSample - sRange.nStartSample, 1.0f ) == 0 );
+	free( pCache );
+	test_OutFree( ppOut );
+	free( pIndex );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
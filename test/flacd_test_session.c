@@ -0,0 +1,136 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_session.c
+* Description : Tests of the decode session (flacd_OpenSession, flacd_DecodeSpan)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+/* decode the stream with flacd_DecodeSpan, nChunkSamples per call, and append the output to ppOut */
+static int session_Decode( test_decoder* const pDecoder, const test_stream* const pStream, const ACMW_UINT32 nChunkSamples,
+						   void** const ppOut, ACMW_UINT32* const pDecoded )
+{
+	const ACMW_UINT32 nBytes = pDecoder->nSampleBytes;
+	ACMW_UINT32 nPos = pStream->nAudioOffset, nRemain = 0U, nDone = 0U, c;
+
+	while ( ( nPos < pStream->nSize ) || ( nRemain != 0U ) ) {
+		flacd_spanInfo sSpan;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		sSpan.pInBuff = pStream->pData + nPos;
+		sSpan.nInSize = pStream->nSize - nPos;
+		sSpan.pOutBuff = pDecoder->pOutBuff;
+		sSpan.nOutSize = nChunkSamples * nBytes;
+		sBuffStatus.pOutBuffLast = pLast;
+		TEST_CHECK( flacd_DecodeSpan( &pDecoder->sWorkMem, &sSpan, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+		TEST_CHECK( sDecStatus.nSamplePosition == nDone );
+		for ( c = 0; c < pDecoder->nOutChannels; c++ ) {
+			memcpy( (ACMW_UINT8*)ppOut[c] + ( (size_t)nDone * nBytes ), pDecoder->pOutBuff[c], (size_t)sDecStatus.nDecodedSamples * nBytes );
+		}
+		nDone += sDecStatus.nDecodedSamples;
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	*pDecoded = nDone;
+	return 0;
+}
+
+static void session_StreamConfig( test_streamConfig* const pConfig )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = 2U;
+	pConfig->nBitsPerSample = 16U;
+	pConfig->nSampleRate = 48000U;
+	pConfig->nBlockSize = 4096U;
+	pConfig->nSamples = 30000U;
+}
+
+int test_SessionDecode( void )
+{
+	static const ACMW_UINT32 nChunk[3] = { 4096U, 1000U, 4096U * 3U };
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	void **ppOut;
+	ACMW_UINT32 nDecoded, i;
+
+	session_StreamConfig( &sStreamConfig );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	ppOut = test_OutAlloc( &sDecoder, sStream.nSamples );
+	/* whole blocks, part of a block (drained over several calls) and several blocks of room per call */
+	for ( i = 0; i < 3U; i++ ) {
+		TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_OK );
+		TEST_CHECK( flacd_OpenSession( &sDecoder.sWorkMem, &sStream.sDecConfig, NULL ) == FLACD_RESULT_OK );
+		TEST_CHECK( session_Decode( &sDecoder, &sStream, ( nChunk[i] < 4096U ) ? nChunk[i] : ( sDecoder.nOutBuffSize / 2U ), ppOut, &nDecoded ) == 0 );
+		TEST_CHECK( nDecoded == sStream.nSamples );
+		TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, ppOut, 0U, nDecoded, 1.0f ) == 0 );
+	}
+	test_OutFree( ppOut );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_SessionSequence( void )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_decConfigInfo sBadConfig;
+	flacd_spanInfo sSpan;
+	flacd_ioBufferStatusInfo sBuffStatus;
+	flacd_decStatusInfo sDecStatus;
+	void *pLast[TEST_MAX_CHANNELS];
+
+	session_StreamConfig( &sStreamConfig );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	TEST_CHECK( test_DecoderOpen( &sDecoder, &sMemConfig, &sInit ) == 0 );
+	memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+	sSpan.pInBuff = sStream.pData + sStream.nAudioOffset;
+	sSpan.nInSize = sStream.nSize - sStream.nAudioOffset;
+	sSpan.pOutBuff = sDecoder.pOutBuff;
+	sSpan.nOutSize = sDecoder.nOutBuffSize;
+	sBuffStatus.pOutBuffLast = pLast;
+
+	/* no session yet */
+	TEST_CHECK( flacd_DecodeSpan( &sDecoder.sWorkMem, &sSpan, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_SEQUENCE );
+	TEST_CHECK( sBuffStatus.nInBuffUsedDataSize == 0U );
+	/* a configuration the instance cannot decode is rejected once, at open, and leaves no session */
+	TEST_CHECK( flacd_OpenSession( &sDecoder.sWorkMem, NULL, NULL ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	sBadConfig = sStream.sDecConfig;
+	sBadConfig.nChannels = 6U;
+	TEST_CHECK( flacd_OpenSession( &sDecoder.sWorkMem, &sBadConfig, NULL ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) != FLACD_ERR_NONE );
+	TEST_CHECK( flacd_DecodeSpan( &sDecoder.sWorkMem, &sSpan, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_SEQUENCE );
+
+	TEST_CHECK( flacd_OpenSession( &sDecoder.sWorkMem, &sStream.sDecConfig, NULL ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_DecodeSpan( &sDecoder.sWorkMem, &sSpan, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sDecStatus.nDecodedSamples == 4096U );
+	TEST_CHECK( test_CheckOutput( &sDecoder, &sStream, sDecoder.pOutBuff, 0U, 4096U, 1.0f ) == 0 );
+	/* flacd_Init closes the session */
+	TEST_CHECK( flacd_Init( &sDecoder.sWorkMem, &sInit ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_DecodeSpan( &sDecoder.sWorkMem, &sSpan, &sDecStatus, &sBuffStatus ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_SEQUENCE );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
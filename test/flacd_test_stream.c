@@ -0,0 +1,549 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_stream.c
+* Description : Test stream encoder of the test program
+******************************************************************************/
+#include "flacd_test.h"
+
+#define STREAM_LPC_ORDER		8
+#define STREAM_LPC_SHIFT		2
+#define STREAM_LPC_PRECISION	15
+#define STREAM_RICE_ESCAPE		15
+#define STREAM_MIN_BLOCK_SIZE	16
+
+typedef struct {
+	ACMW_UINT8	*pData;
+	ACMW_UINT32	nBits;
+} stream_BitWriter;
+
+static ACMW_UINT32 stream_Random( ACMW_UINT32* const pSeed )
+{
+	*pSeed = ( *pSeed * 1103515245U ) + 12345U;
+	return ( *pSeed >> 8 ) & 0xFFFFU;
+}
+
+static void stream_Put( stream_BitWriter* const pBw, const ACMW_UINT32 nValue, const ACMW_UINT32 nBits )
+{
+	ACMW_UINT32 i;
+
+	for ( i = nBits; i > 0U; i-- ) {
+		if ( ( ( nValue >> ( i - 1U ) ) & 1U ) != 0U ) {
+			pBw->pData[pBw->nBits >> 3] |= (ACMW_UINT8)( 0x80U >> ( pBw->nBits & 7U ) );
+		}
+		pBw->nBits++;
+	}
+}
+
+static void stream_PutSigned( stream_BitWriter* const pBw, const ACMW_INT32 nValue, const ACMW_UINT32 nBits )
+{
+	stream_Put( pBw, (ACMW_UINT32)nValue & ( ( nBits < 32U ) ? ( ( 1U << nBits ) - 1U ) : 0xFFFFFFFFU ), nBits );
+}
+
+static void stream_PutUnary( stream_BitWriter* const pBw, const ACMW_UINT32 nZeros )
+{
+	pBw->nBits += nZeros;
+	stream_Put( pBw, 1U, 1U );
+}
+
+static void stream_Align( stream_BitWriter* const pBw )
+{
+	pBw->nBits = ( pBw->nBits + 7U ) & ~7U;
+}
+
+static ACMW_UINT8 stream_Crc8( const ACMW_UINT8* const pData, const ACMW_UINT32 nSize )
+{
+	ACMW_UINT32 i, j, nCrc = 0U;
+
+	for ( i = 0; i < nSize; i++ ) {
+		nCrc ^= pData[i];
+		for ( j = 0; j < 8U; j++ ) {
+			nCrc = ( ( nCrc & 0x80U ) != 0U ) ? ( ( ( nCrc << 1 ) ^ 0x07U ) & 0xFFU ) : ( ( nCrc << 1 ) & 0xFFU );
+		}
+	}
+	return (ACMW_UINT8)nCrc;
+}
+
+static ACMW_UINT32 stream_Crc16( const ACMW_UINT8* const pData, const ACMW_UINT32 nSize )
+{
+	ACMW_UINT32 i, j, nCrc = 0U;
+
+	for ( i = 0; i < nSize; i++ ) {
+		nCrc ^= (ACMW_UINT32)pData[i] << 8;
+		for ( j = 0; j < 8U; j++ ) {
+			nCrc = ( ( nCrc & 0x8000U ) != 0U ) ? ( ( ( nCrc << 1 ) ^ 0x8005U ) & 0xFFFFU ) : ( ( nCrc << 1 ) & 0xFFFFU );
+		}
+	}
+	return nCrc;
+}
+
+/* frame or sample number, coded as FLAC codes it (UTF-8 like) */
+static void stream_PutNumber( stream_BitWriter* const pBw, const ACMW_UINT32 nValue )
+{
+	ACMW_UINT32 nBytes, i;
+
+	if ( nValue < 0x80U ) {
+		stream_Put( pBw, nValue, 8U );
+		return;
+	}
+	nBytes = ( nValue < 0x800U ) ? 2U : ( nValue < 0x10000U ) ? 3U : ( nValue < 0x200000U ) ? 4U : ( nValue < 0x4000000U ) ? 5U : 6U;
+	stream_Put( pBw, ( ( 0xFF00U >> nBytes ) & 0xFFU ) | ( nValue >> ( 6U * ( nBytes - 1U ) ) ), 8U );
+	for ( i = nBytes - 1U; i > 0U; i-- ) {
+		stream_Put( pBw, 0x80U | ( ( nValue >> ( 6U * ( i - 1U ) ) ) & 0x3FU ), 8U );
+	}
+}
+
+static ACMW_UINT32 stream_RiceBits( const ACMW_INT32* const pRes, const ACMW_UINT32 nCount, const ACMW_UINT32 k )
+{
+	ACMW_UINT32 i, nBits = 0U;
+
+	for ( i = 0; i < nCount; i++ ) {
+		const ACMW_UINT32 u = ( pRes[i] >= 0 ) ? ( (ACMW_UINT32)pRes[i] << 1 ) : ( ( (ACMW_UINT32)(-pRes[i]) << 1 ) - 1U );
+		nBits += ( u >> k ) + 1U + k;
+	}
+	return nBits;
+}
+
+/* residual of nBlockSize - nOrder samples in 1 or 4 Rice partitions, escaped when no parameter fits */
+static void stream_PutResidual( stream_BitWriter* const pBw, const ACMW_INT32* const pRes, const ACMW_UINT32 nBlockSize, const ACMW_UINT32 nOrder )
+{
+	const ACMW_UINT32 nPartOrder = ( ( ( nBlockSize & 3U ) == 0U ) && ( ( nBlockSize >> 2 ) > nOrder ) ) ? 2U : 0U;
+	const ACMW_UINT32 nParts = 1U << nPartOrder;
+	ACMW_UINT32 p, i, k, nStart = 0U;
+
+	stream_Put( pBw, 0U, 2U );
+	stream_Put( pBw, nPartOrder, 4U );
+	for ( p = 0; p < nParts; p++ ) {
+		const ACMW_UINT32 nCount = ( nBlockSize >> nPartOrder ) - ( ( p == 0U ) ? nOrder : 0U );
+		const ACMW_INT32* const pPart = pRes + nStart;
+		ACMW_UINT32 nBest = 0U, nBestBits = 0xFFFFFFFFU;
+		for ( k = 0; k < STREAM_RICE_ESCAPE; k++ ) {
+			const ACMW_UINT32 nBits = stream_RiceBits( pPart, nCount, k );
+			if ( nBits < nBestBits ) {
+				nBest = k;
+				nBestBits = nBits;
+			}
+		}
+		if ( nBestBits > ( nCount * 32U ) ) {
+			stream_Put( pBw, STREAM_RICE_ESCAPE, 4U );
+			stream_Put( pBw, 31U, 5U );
+			for ( i = 0; i < nCount; i++ ) {
+				stream_PutSigned( pBw, pPart[i], 31U );
+			}
+		} else {
+			stream_Put( pBw, nBest, 4U );
+			for ( i = 0; i < nCount; i++ ) {
+				const ACMW_UINT32 u = ( pPart[i] >= 0 ) ? ( (ACMW_UINT32)pPart[i] << 1 ) : ( ( (ACMW_UINT32)(-pPart[i]) << 1 ) - 1U );
+				stream_PutUnary( pBw, u >> nBest );
+				stream_Put( pBw, u & ( ( 1U << nBest ) - 1U ), nBest );
+			}
+		}
+		nStart += nCount;
+	}
+}
+
+static void stream_PutSubframe( stream_BitWriter* const pBw, const ACMW_INT32* const pX, const ACMW_UINT32 nBlockSize,
+								const ACMW_UINT32 nBps, const ACMW_UINT32 nKind, ACMW_INT32* const pRes )
+{
+	static const ACMW_INT32 nFixed[5][4] = { { 0, 0, 0, 0 }, { 1, 0, 0, 0 }, { 2, -1, 0, 0 }, { 3, -3, 1, 0 }, { 4, -6, 4, -1 } };
+	ACMW_UINT32 i, j, nOrder;
+	ACMW_INT32 nPred;
+
+	for ( i = 1; ( i < nBlockSize ) && ( pX[i] == pX[0] ); i++ ) {
+	}
+	if ( i == nBlockSize ) {
+		/* CONSTANT */
+		stream_Put( pBw, 0x00U, 8U );
+		stream_PutSigned( pBw, pX[0], nBps );
+	} else if ( ( nKind == 3U ) || ( nBlockSize <= STREAM_LPC_ORDER ) ) {
+		/* VERBATIM */
+		stream_Put( pBw, 0x02U, 8U );
+		for ( i = 0; i < nBlockSize; i++ ) {
+			stream_PutSigned( pBw, pX[i], nBps );
+		}
+	} else if ( nKind == 1U ) {
+		/* LPC, the third order fixed predictor with 5 zero coefficients */
+		stream_Put( pBw, ( 0x20U | ( STREAM_LPC_ORDER - 1U ) ) << 1, 8U );
+		for ( i = 0; i < STREAM_LPC_ORDER; i++ ) {
+			stream_PutSigned( pBw, pX[i], nBps );
+		}
+		stream_Put( pBw, STREAM_LPC_PRECISION - 1U, 4U );
+		stream_PutSigned( pBw, STREAM_LPC_SHIFT, 5U );
+		for ( j = 0; j < STREAM_LPC_ORDER; j++ ) {
+			stream_PutSigned( pBw, ( j < 3U ) ? ( nFixed[3][j] * ( 1 << STREAM_LPC_SHIFT ) ) : 0, STREAM_LPC_PRECISION );
+		}
+		for ( i = STREAM_LPC_ORDER; i < nBlockSize; i++ ) {
+			long long nSum = 0;
+			for ( j = 0; j < 3U; j++ ) {
+				nSum += (long long)( nFixed[3][j] * ( 1 << STREAM_LPC_SHIFT ) ) * pX[i - 1U - j];
+			}
+			pRes[i - STREAM_LPC_ORDER] = pX[i] - (ACMW_INT32)( nSum >> STREAM_LPC_SHIFT );
+		}
+		stream_PutResidual( pBw, pRes, nBlockSize, STREAM_LPC_ORDER );
+	} else {
+		/* FIXED, the order with the smallest residual */
+		ACMW_UINT32 nBest = 0U;
+		unsigned long long nBestSum = ~0ULL;
+		for ( nOrder = 0; nOrder <= 4U; nOrder++ ) {
+			unsigned long long nSum = 0;
+			for ( i = nOrder; i < nBlockSize; i++ ) {
+				nPred = 0;
+				for ( j = 0; j < nOrder; j++ ) {
+					nPred += nFixed[nOrder][j] * pX[i - 1U - j];
+				}
+				nSum += (unsigned long long)( ( pX[i] >= nPred ) ? ( pX[i] - nPred ) : ( nPred - pX[i] ) );
+			}
+			if ( nSum < nBestSum ) {
+				nBest = nOrder;
+				nBestSum = nSum;
+			}
+		}
+		stream_Put( pBw, ( 0x08U | nBest ) << 1, 8U );
+		for ( i = 0; i < nBest; i++ ) {
+			stream_PutSigned( pBw, pX[i], nBps );
+		}
+		for ( i = nBest; i < nBlockSize; i++ ) {
+			nPred = 0;
+			for ( j = 0; j < nBest; j++ ) {
+				nPred += nFixed[nBest][j] * pX[i - 1U - j];
+			}
+			pRes[i - nBest] = pX[i] - nPred;
+		}
+		stream_PutResidual( pBw, pRes, nBlockSize, nBest );
+	}
+}
+
+static ACMW_UINT32 stream_BlockSizeCode( const ACMW_UINT32 nBlockSize )
+{
+	switch ( nBlockSize ) {
+		case 192U :		return 1U;
+		case 576U :		return 2U;
+		case 1152U :	return 3U;
+		case 4608U :	return 5U;
+		case 256U :		return 8U;
+		case 1024U :	return 10U;
+		case 4096U :	return 12U;
+		default :		return ( nBlockSize <= 256U ) ? 6U : 7U;
+	}
+}
+
+static ACMW_UINT32 stream_SampleRateCode( const ACMW_UINT32 nSampleRate )
+{
+	switch ( nSampleRate ) {
+		case 44100U :	return 9U;
+		case 48000U :	return 10U;
+		case 96000U :	return 11U;
+		default :		return 0U;	/* from STREAMINFO */
+	}
+}
+
+static ACMW_UINT32 stream_BpsCode( const ACMW_UINT32 nBps )
+{
+	switch ( nBps ) {
+		case 8U :	return 1U;
+		case 12U :	return 2U;
+		case 16U :	return 4U;
+		case 20U :	return 5U;
+		case 24U :	return 6U;
+		default :	return 0U;	/* from STREAMINFO */
+	}
+}
+
+static ACMW_UINT32 stream_PutFrame( ACMW_UINT8* const pOut, const test_streamConfig* const pConfig, const test_stream* const pStream,
+									const ACMW_UINT32 nFrame, const ACMW_UINT32 nStart, const ACMW_UINT32 nBlockSize, ACMW_INT32* const pWork )
+{
+	stream_BitWriter sBw;
+	ACMW_INT32* const pSide = pWork;
+	ACMW_INT32* const pMid = pWork + nBlockSize;
+	ACMW_INT32* const pRes = pWork + ( 2U * nBlockSize );
+	const ACMW_UINT32 nBps = pConfig->nBitsPerSample;
+	const ACMW_UINT32 nBsCode = stream_BlockSizeCode( nBlockSize );
+	const ACMW_UINT32 nAssign = ( pConfig->nChannels == 2U ) ? ( nFrame & 3U ) : 0U;
+	ACMW_UINT32 nHeaderBytes, nCrc, c, i;
+
+	sBw.pData = pOut;
+	sBw.nBits = 0U;
+	stream_Put( &sBw, ( pConfig->bVariable != 0U ) ? 0xFFF9U : 0xFFF8U, 16U );
+	stream_Put( &sBw, nBsCode, 4U );
+	stream_Put( &sBw, stream_SampleRateCode( pConfig->nSampleRate ), 4U );
+	stream_Put( &sBw, ( nAssign == 0U ) ? ( pConfig->nChannels - 1U ) : ( 7U + nAssign ), 4U );
+	stream_Put( &sBw, stream_BpsCode( nBps ), 3U );
+	stream_Put( &sBw, 0U, 1U );
+	stream_PutNumber( &sBw, ( pConfig->bVariable != 0U ) ? nStart : ( pConfig->nFirstFrame + nFrame ) );
+	if ( nBsCode == 6U ) {
+		stream_Put( &sBw, nBlockSize - 1U, 8U );
+	} else if ( nBsCode == 7U ) {
+		stream_Put( &sBw, nBlockSize - 1U, 16U );
+	}
+	nHeaderBytes = sBw.nBits >> 3;
+	stream_Put( &sBw, stream_Crc8( pOut, nHeaderBytes ), 8U );
+
+	if ( nAssign != 0U ) {
+		const ACMW_INT32* const pL = pStream->pSamples + nStart;
+		const ACMW_INT32* const pR = pStream->pSamples + pStream->nSamples + nStart;
+		for ( i = 0; i < nBlockSize; i++ ) {
+			pSide[i] = pL[i] - pR[i];
+			pMid[i] = ( pL[i] + pR[i] ) >> 1;
+		}
+		/* 1 : left / side, 2 : side / right, 3 : mid / side */
+		stream_PutSubframe( &sBw, ( nAssign == 1U ) ? pL : ( nAssign == 2U ) ? pSide : pMid, nBlockSize,
+							( nAssign == 2U ) ? ( nBps + 1U ) : nBps, nFrame % 4U, pRes );
+		stream_PutSubframe( &sBw, ( nAssign == 2U ) ? pR : pSide, nBlockSize,
+							( nAssign == 2U ) ? nBps : ( nBps + 1U ), ( nFrame + 1U ) % 4U, pRes );
+	} else {
+		for ( c = 0; c < pConfig->nChannels; c++ ) {
+			stream_PutSubframe( &sBw, pStream->pSamples + ( c * pStream->nSamples ) + nStart, nBlockSize, nBps, ( nFrame + c ) % 4U, pRes );
+		}
+	}
+	stream_Align( &sBw );
+	nCrc = stream_Crc16( pOut, sBw.nBits >> 3 );
+	stream_Put( &sBw, nCrc, 16U );
+	return sBw.nBits >> 3;
+}
+
+static void stream_Signal( const test_streamConfig* const pConfig, test_stream* const pStream )
+{
+	const ACMW_INT32 nAmp = ( 1 << ( pConfig->nBitsPerSample - 1U ) ) - 1;
+	ACMW_UINT32 nSeed = pConfig->nSeed + 1U;
+	ACMW_UINT32 c, i;
+
+	for ( c = 0; c < pConfig->nChannels; c++ ) {
+		ACMW_INT32* const pX = pStream->pSamples + ( c * pConfig->nSamples );
+		const ACMW_UINT32 nPeriod = 64U + ( 40U * c ) + ( stream_Random( &nSeed ) & 63U );
+		for ( i = 0; i < pConfig->nSamples; i++ ) {
+			/* triangle wave at 60% of full scale and noise at 1/64 */
+			const ACMW_INT32 nPhase = (ACMW_INT32)( ( i * 4U ) % ( nPeriod * 4U ) ) - (ACMW_INT32)( 2U * nPeriod );
+			const ACMW_INT32 nTri = (ACMW_INT32)( ( (long long)( ( nPhase < 0 ) ? -nPhase : nPhase ) - (long long)nPeriod ) * ( nAmp / 5 * 3 ) / (long long)nPeriod );
+			const ACMW_INT32 nNoise = (ACMW_INT32)( ( (long long)stream_Random( &nSeed ) - 32768 ) * ( nAmp / 64 ) / 32768 );
+			if ( ( ( pConfig->nSilentMask >> c ) & 1U ) != 0U ) {
+				pX[i] = 0;
+			} else if ( ( ( pConfig->nConstMask >> c ) & 1U ) != 0U ) {
+				pX[i] = nAmp / (ACMW_INT32)( 3U + c );
+			} else {
+				pX[i] = nTri + nNoise;
+			}
+		}
+	}
+}
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		test_StreamMake
+*
+* OVERVIEW
+* 		Make a FLAC stream of pConfig and keep its samples and frame
+* 		positions. Returns 0 on success.
+*
+*/
+int test_StreamMake( const test_streamConfig* const pConfig, test_stream* const pStream )
+{
+	const ACMW_UINT32 nMaxFrames = ( pConfig->nSamples / STREAM_MIN_BLOCK_SIZE ) + 2U;
+	const ACMW_UINT32 nCapacity = ( pConfig->nSamples * pConfig->nChannels * 5U ) + ( nMaxFrames * 32U ) + ( pConfig->nSeekPoints * 18U ) + 256U;
+	ACMW_UINT32 nSeed = pConfig->nSeed + 7U;
+	ACMW_UINT32 nPos = 0U, nOffset, nMinFrame = 0xFFFFFFFFU, nMaxFrame = 0U, nMinBlock = pConfig->nBlockSize, f, i, c;
+	ACMW_UINT8 *pInterleaved, *p;
+	ACMW_INT32 *pWork;
+	ACMW_UINT8 nMd5[16];
+	const ACMW_UINT32 nBytes = ( pConfig->nBitsPerSample + 7U ) / 8U;
+
+	memset( pStream, 0, sizeof(*pStream) );
+	pStream->pData = (ACMW_UINT8*)calloc( nCapacity, 1U );
+	pStream->pSamples = (ACMW_INT32*)malloc( sizeof(ACMW_INT32) * ( pConfig->nSamples * pConfig->nChannels + 1U ) );
+	pStream->pFrameOffset = (ACMW_UINT32*)malloc( sizeof(ACMW_UINT32) * nMaxFrames );
+	pStream->pFrameSample = (ACMW_UINT32*)malloc( sizeof(ACMW_UINT32) * nMaxFrames );
+	pWork = (ACMW_INT32*)malloc( sizeof(ACMW_INT32) * 3U * pConfig->nBlockSize );
+	pInterleaved = (ACMW_UINT8*)malloc( ( pConfig->nSamples * pConfig->nChannels * nBytes ) + 1U );
+	if ( ( pStream->pData == NULL ) || ( pStream->pSamples == NULL ) || ( pStream->pFrameOffset == NULL ) ||
+		 ( pStream->pFrameSample == NULL ) || ( pWork == NULL ) || ( pInterleaved == NULL ) ) {
+		return 1;
+	}
+	pStream->nSamples = pConfig->nSamples;
+	pStream->nChannels = pConfig->nChannels;
+	pStream->nBitsPerSample = pConfig->nBitsPerSample;
+	stream_Signal( pConfig, pStream );
+
+	/* metadata : STREAMINFO, SEEKTABLE and the frames after them */
+	nOffset = ( pConfig->bNoHeader != 0U ) ? 0U : ( 4U + 4U + 34U + ( ( pConfig->nSeekPoints != 0U ) ? ( 4U + ( 18U * pConfig->nSeekPoints ) ) : 0U ) );
+	pStream->nAudioOffset = nOffset;
+	for ( f = 0; nPos < pConfig->nSamples; f++ ) {
+		ACMW_UINT32 nBlockSize = pConfig->nBlockSize, nSize;
+		if ( pConfig->bVariable != 0U ) {
+			nBlockSize = pConfig->nBlockSize >> ( stream_Random( &nSeed ) % 3U );
+			nBlockSize = ( nBlockSize < STREAM_MIN_BLOCK_SIZE ) ? STREAM_MIN_BLOCK_SIZE : nBlockSize;
+		}
+		if ( nBlockSize > ( pConfig->nSamples - nPos ) ) {
+			nBlockSize = pConfig->nSamples - nPos;
+		} else if ( nBlockSize < nMinBlock ) {
+			nMinBlock = nBlockSize;
+		}
+		pStream->pFrameOffset[f] = nOffset;
+		pStream->pFrameSample[f] = nPos;
+		nSize = stream_PutFrame( pStream->pData + nOffset, pConfig, pStream, f, nPos, nBlockSize, pWork );
+		nMinFrame = ( nSize < nMinFrame ) ? nSize : nMinFrame;
+		nMaxFrame = ( nSize > nMaxFrame ) ? nSize : nMaxFrame;
+		nOffset += nSize;
+		nPos += nBlockSize;
+	}
+	pStream->nFrames = f;
+	pStream->nSize = nOffset;
+
+	for ( i = 0, p = pInterleaved; i < pConfig->nSamples; i++ ) {
+		for ( c = 0; c < pConfig->nChannels; c++ ) {
+			const ACMW_UINT32 nValue = (ACMW_UINT32)pStream->pSamples[( c * pConfig->nSamples ) + i];
+			for ( f = 0; f < nBytes; f++ ) {
+				*p++ = (ACMW_UINT8)( nValue >> ( 8U * f ) );
+			}
+		}
+	}
+	test_Md5( pInterleaved, (ACMW_UINT32)( p - pInterleaved ), nMd5 );
+
+	pStream->sDecConfig.nMinBlockSize = (ACMW_UINT16)nMinBlock;
+	pStream->sDecConfig.nMaxBlockSize = (ACMW_UINT16)pConfig->nBlockSize;
+	pStream->sDecConfig.nMinFrameSize = nMinFrame;
+	pStream->sDecConfig.nMaxFrameSize = nMaxFrame;
+	pStream->sDecConfig.nSampleRate = pConfig->nSampleRate;
+	pStream->sDecConfig.nChannels = (ACMW_UINT16)pConfig->nChannels;
+	pStream->sDecConfig.nBitsPerSample = (ACMW_UINT16)pConfig->nBitsPerSample;
+
+	if ( pConfig->bNoHeader == 0U ) {
+		stream_BitWriter sBw;
+		sBw.pData = pStream->pData;
+		sBw.nBits = 0U;
+		stream_Put( &sBw, 0x664C6143U, 32U );	/* "fLaC" */
+		stream_Put( &sBw, ( pConfig->nSeekPoints != 0U ) ? 0x00U : 0x80U, 8U );
+		stream_Put( &sBw, 34U, 24U );
+		stream_Put( &sBw, nMinBlock, 16U );
+		stream_Put( &sBw, pConfig->nBlockSize, 16U );
+		stream_Put( &sBw, nMinFrame, 24U );
+		stream_Put( &sBw, nMaxFrame, 24U );
+		stream_Put( &sBw, pConfig->nSampleRate, 20U );
+		stream_Put( &sBw, pConfig->nChannels - 1U, 3U );
+		stream_Put( &sBw, pConfig->nBitsPerSample - 1U, 5U );
+		stream_Put( &sBw, 0U, 4U );
+		stream_Put( &sBw, pConfig->nSamples, 32U );
+		for ( i = 0; i < 16U; i++ ) {
+			stream_Put( &sBw, nMd5[i], 8U );
+		}
+		if ( pConfig->nSeekPoints != 0U ) {
+			stream_Put( &sBw, 0x83U, 8U );
+			stream_Put( &sBw, 18U * pConfig->nSeekPoints, 24U );
+			for ( i = 0; i < pConfig->nSeekPoints; i++ ) {
+				f = ( i * pStream->nFrames ) / pConfig->nSeekPoints;
+				stream_Put( &sBw, 0U, 32U );
+				stream_Put( &sBw, pStream->pFrameSample[f], 32U );
+				stream_Put( &sBw, 0U, 32U );
+				stream_Put( &sBw, pStream->pFrameOffset[f] - pStream->nAudioOffset, 32U );
+				stream_Put( &sBw, ( ( f + 1U < pStream->nFrames ) ? pStream->pFrameSample[f + 1U] : pConfig->nSamples ) - pStream->pFrameSample[f], 16U );
+			}
+		}
+	}
+	free( pWork );
+	free( pInterleaved );
+	return 0;
+}
+/*------------------------------------------------------------------------------*/
+
+void test_StreamFree( test_stream* const pStream )
+{
+	free( pStream->pData );
+	free( pStream->pSamples );
+	free( pStream->pFrameOffset );
+	free( pStream->pFrameSample );
+	memset( pStream, 0, sizeof(*pStream) );
+}
+
+ACMW_INT32 test_StreamSample( const test_stream* const pStream, const ACMW_UINT32 nChannel, const ACMW_UINT32 nSample )
+{
+	return pStream->pSamples[( nChannel * pStream->nSamples ) + nSample];
+}
+
+/*==============================================================================*/
+/*
+*
+* FUNCTION NAME
+* 		test_Md5
+*
+* OVERVIEW
+* 		MD5 digest (RFC 1321) of nSize bytes, as STREAMINFO signs the
+* 		samples.
+*
+*/
+#define MD5_ROTATE(x, n)		( ( (x) << (n) ) | ( (x) >> ( 32U - (n) ) ) )
+
+static void md5_Block( ACMW_UINT32* const pState, const ACMW_UINT8* const pBlock )
+{
+	static const ACMW_UINT32 nK[64] = {
+		0xd76aa478U, 0xe8c7b756U, 0x242070dbU, 0xc1bdceeeU, 0xf57c0fafU, 0x4787c62aU, 0xa8304613U, 0xfd469501U,
+		0x698098d8U, 0x8b44f7afU, 0xffff5bb1U, 0x895cd7beU, 0x6b901122U, 0xfd987193U, 0xa679438eU, 0x49b40821U,
+		0xf61e2562U, 0xc040b340U, 0x265e5a51U, 0xe9b6c7aaU, 0xd62f105dU, 0x02441453U, 0xd8a1e681U, 0xe7d3fbc8U,
+		0x21e1cde6U, 0xc33707d6U, 0xf4d50d87U, 0x455a14edU, 0xa9e3e905U, 0xfcefa3f8U, 0x676f02d9U, 0x8d2a4c8aU,
+		0xfffa3942U, 0x8771f681U, 0x6d9d6122U, 0xfde5380cU, 0xa4beea44U, 0x4bdecfa9U, 0xf6bb4b60U, 0xbebfbc70U,
+		0x289b7ec6U, 0xeaa127faU, 0xd4ef3085U, 0x04881d05U, 0xd9d4d039U, 0xe6db99e5U, 0x1fa27cf8U, 0xc4ac5665U,
+		0xf4292244U, 0x432aff97U, 0xab9423a7U, 0xfc93a039U, 0x655b59c3U, 0x8f0ccc92U, 0xffeff47dU, 0x85845dd1U,
+		0x6fa87e4fU, 0xfe2ce6e0U, 0xa3014314U, 0x4e0811a1U, 0xf7537e82U, 0xbd3af235U, 0x2ad7d2bbU, 0xeb86d391U };
+	static const ACMW_UINT32 nR[16] = { 7U, 12U, 17U, 22U, 5U, 9U, 14U, 20U, 4U, 11U, 16U, 23U, 6U, 10U, 15U, 21U };
+	ACMW_UINT32 nW[16], a = pState[0], b = pState[1], c = pState[2], d = pState[3], i;
+
+	for ( i = 0; i < 16U; i++ ) {
+		nW[i] = (ACMW_UINT32)pBlock[4U * i] | ( (ACMW_UINT32)pBlock[( 4U * i ) + 1U] << 8 ) |
+				( (ACMW_UINT32)pBlock[( 4U * i ) + 2U] << 16 ) | ( (ACMW_UINT32)pBlock[( 4U * i ) + 3U] << 24 );
+	}
+	for ( i = 0; i < 64U; i++ ) {
+		ACMW_UINT32 f, g, t;
+		if ( i < 16U ) {
+			f = ( b & c ) | ( ~b & d );
+			g = i;
+		} else if ( i < 32U ) {
+			f = ( d & b ) | ( ~d & c );
+			g = ( ( 5U * i ) + 1U ) & 15U;
+		} else if ( i < 48U ) {
+			f = b ^ c ^ d;
+			g = ( ( 3U * i ) + 5U ) & 15U;
+		} else {
+			f = c ^ ( b | ~d );
+			g = ( 7U * i ) & 15U;
+		}
+		t = d;
+		d = c;
+		c = b;
+		b = b + MD5_ROTATE( a + f + nK[i] + nW[g], nR[( ( i >> 4 ) << 2 ) + ( i & 3U )] );
+		a = t;
+	}
+	pState[0] += a;
+	pState[1] += b;
+	pState[2] += c;
+	pState[3] += d;
+}
+
+void test_Md5( const ACMW_UINT8* const pData, const ACMW_UINT32 nSize, ACMW_UINT8* const pDigest )
+{
+	ACMW_UINT32 nState[4] = { 0x67452301U, 0xefcdab89U, 0x98badcfeU, 0x10325476U };
+	ACMW_UINT8 nTail[128];
+	const ACMW_UINT32 nFull = nSize & ~63U;
+	const ACMW_UINT32 nRest = nSize - nFull;
+	const ACMW_UINT32 nTailSize = ( nRest < 56U ) ? 64U : 128U;
+	const unsigned long long nBits = (unsigned long long)nSize * 8U;
+	ACMW_UINT32 i;
+
+	for ( i = 0; i < nFull; i += 64U ) {
+		md5_Block( nState, pData + i );
+	}
+	memset( nTail, 0, sizeof(nTail) );
+	memcpy( nTail, pData + nFull, nRest );
+	nTail[nRest] = 0x80U;
+	for ( i = 0; i < 8U; i++ ) {
+		nTail[nTailSize - 8U + i] = (ACMW_UINT8)( nBits >> ( 8U * i ) );
+	}
+	for ( i = 0; i < nTailSize; i += 64U ) {
+		md5_Block( nState, nTail + i );
+	}
+	for ( i = 0; i < 16U; i++ ) {
+		pDigest[i] = (ACMW_UINT8)( nState[i >> 2] >> ( 8U * ( i & 3U ) ) );
+	}
+}
+/*------------------------------------------------------------------------------*/
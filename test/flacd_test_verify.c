@@ -0,0 +1,322 @@
+/*------------------------------------------------------------------------------*/
+/* FLAC Decode Software                                                         */
+/* Copyright(C) 2012-2016 Renesas Electronics Corporation.                      */
+/*------------------------------------------------------------------------------*/
+
+/*******************************************************************************
+* File Name   : flacd_test_verify.c
+* Description : Tests of the decode verification (flacd_SetVerify)
+******************************************************************************/
+#include "flacd_test.h"
+#include "flacd_test_cases.h"
+
+/* output buffer size of each flacd_Decode call, in samples : tiles and calls end inside the frames */
+#define VERIFY_CHUNK_SAMPLES	300U
+
+static void verify_StreamConfig( test_streamConfig* const pConfig, const ACMW_UINT32 nChannels, const ACMW_UINT32 nBitsPerSample )
+{
+	memset( pConfig, 0, sizeof(*pConfig) );
+	pConfig->nChannels = nChannels;
+	pConfig->nBitsPerSample = nBitsPerSample;
+	pConfig->nSampleRate = 48000U;
+	pConfig->nBlockSize = 1152U;
+	pConfig->nSamples = 20000U;
+	pConfig->bVariable = 1U;
+}
+
+static int verify_Open( test_decoder* const pDecoder )
+{
+	flacd_getMemorySizeConfigInfo sMemConfig;
+	flacd_initConfigInfo sInit;
+
+	memset( &sMemConfig, 0, sizeof(sMemConfig) );
+	memset( &sInit, 0, sizeof(sInit) );
+	sMemConfig.nInputChannel = sInit.nInputChannel = 1U;
+	sMemConfig.nOutputChannel = sInit.nOutputChannel = 2U;
+	return test_DecoderOpen( pDecoder, &sMemConfig, &sInit );
+}
+
+static int verify_Header( const test_stream* const pStream, flacd_headerStatusInfo* const pHeader )
+{
+	flacd_headerConfigInfo sHeaderConfig;
+
+	memset( &sHeaderConfig, 0, sizeof(sHeaderConfig) );
+	memset( pHeader, 0, sizeof(*pHeader) );
+	sHeaderConfig.pInBuffStart = pStream->pData;
+	sHeaderConfig.nInBuffSetDataSize = pStream->nSize;
+	TEST_CHECK( flacd_ParseHeader( &sHeaderConfig, pHeader ) == FLACD_RESULT_OK );
+	return 0;
+}
+
+static int verify_Set( test_decoder* const pDecoder, const flacd_headerStatusInfo* const pHeader )
+{
+	flacd_verifyConfigInfo sVerify;
+
+	memset( &sVerify, 0, sizeof(sVerify) );
+	sVerify.nVerifyMode = 1U;
+	sVerify.pHeaderInfo = pHeader;
+	TEST_CHECK( flacd_SetVerify( &pDecoder->sWorkMem, &sVerify ) == FLACD_RESULT_OK );
+	return 0;
+}
+
+/* decode frames nFrom to nTo - 1 in calls of VERIFY_CHUNK_SAMPLES ; returns the first result other than OK */
+static ACMW_INT32 verify_Decode( test_decoder* const pDecoder, const test_stream* const pStream,
+								 const ACMW_UINT32 nFrom, const ACMW_UINT32 nTo )
+{
+	const ACMW_UINT32 nEnd = ( nTo < pStream->nFrames ) ? pStream->pFrameOffset[nTo] : pStream->nSize;
+	ACMW_UINT32 nPos = pStream->pFrameOffset[nFrom], nRemain = 0U;
+	ACMW_INT32 nResult = FLACD_RESULT_OK, nRet;
+
+	while ( ( nPos < nEnd ) || ( nRemain != 0U ) ) {
+		flacd_ioBufferConfigInfo sBuffConfig;
+		flacd_ioBufferStatusInfo sBuffStatus;
+		flacd_decStatusInfo sDecStatus;
+		void *pLast[TEST_MAX_CHANNELS];
+
+		memset( &sBuffConfig, 0, sizeof(sBuffConfig) );
+		memset( &sBuffStatus, 0, sizeof(sBuffStatus) );
+		memset( &sDecStatus, 0, sizeof(sDecStatus) );
+		sBuffConfig.pInBuffStart = pStream->pData + nPos;
+		sBuffConfig.nInBuffSetDataSize = nEnd - nPos;
+		sBuffConfig.pOutBuffStart = pDecoder->pOutBuff;
+		sBuffConfig.nOutBuffSize = VERIFY_CHUNK_SAMPLES * pDecoder->nSampleBytes;
+		sBuffStatus.pOutBuffLast = pLast;
+		nRet = flacd_Decode( &pDecoder->sWorkMem, &pStream->sDecConfig, &sBuffConfig, &sDecStatus, &sBuffStatus );
+		if ( ( nRet != FLACD_RESULT_OK ) && ( nResult == FLACD_RESULT_OK ) ) {
+			nResult = nRet;
+		}
+		if ( ( nRet != FLACD_RESULT_OK ) && ( nRet != FLACD_RESULT_WARNING ) && ( sBuffStatus.nInBuffUsedDataSize == 0U ) ) {
+			break;
+		}
+		nRemain = sDecStatus.nRemainSamples;
+		nPos += sBuffStatus.nInBuffUsedDataSize;
+	}
+	return nResult;
+}
+
+/* decode the whole stream with the MD5 verification and return its result */
+static int verify_Stream( const test_stream* const pStream, const flacd_headerStatusInfo* const pHeader,
+						  flacd_verifyStatusInfo* const pStatus )
+{
+	test_decoder sDecoder;
+
+	TEST_CHECK( verify_Open( &sDecoder ) == 0 );
+	TEST_CHECK( verify_Set( &sDecoder, pHeader ) == 0 );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, pStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( pStatus->nVerifyResult == FLACD_VERIFY_PENDING ) && ( pStatus->nVerifiedSamples == 0U ) );
+	(void)verify_Decode( &sDecoder, pStream, 0U, pStream->nFrames );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, pStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( pStatus->nTestedFrames == 0U ) && ( pStatus->nFailedFrames == 0U ) );
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+int test_VerifyMd5( void )
+{
+	static const ACMW_UINT32 nFormats[3][3] = {
+		/* channels, bits per sample, constant channels */
+		{ 2U, 16U, 0x0U },
+		{ 6U, 24U, 0x6U },
+		{ 1U, 12U, 0x0U },
+	};
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	flacd_headerStatusInfo sHeader;
+	flacd_verifyStatusInfo sStatus;
+	ACMW_UINT32 i;
+
+	/* the signature of STREAMINFO, with 2 to 4 bytes per sample and CONSTANT subframes */
+	for ( i = 0; i < 3U; i++ ) {
+		verify_StreamConfig( &sStreamConfig, nFormats[i][0], nFormats[i][1] );
+		sStreamConfig.nConstMask = nFormats[i][2];
+		TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+		TEST_CHECK( verify_Header( &sStream, &sHeader ) == 0 );
+		TEST_CHECK( verify_Stream( &sStream, &sHeader, &sStatus ) == 0 );
+		TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MATCH );
+		TEST_CHECK( sStatus.nVerifiedSamples == sStream.nSamples );
+		TEST_CHECK( memcmp( sStatus.nMD5Signature, sHeader.nMD5Signature, 16U ) == 0 );
+		test_StreamFree( &sStream );
+	}
+
+	/* a frame with a CRC error is verified as the silence it is output as */
+	verify_StreamConfig( &sStreamConfig, 2U, 16U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	TEST_CHECK( verify_Header( &sStream, &sHeader ) == 0 );
+	sStream.pData[sStream.pFrameOffset[6] - 1U] ^= 0x01U;
+	TEST_CHECK( verify_Stream( &sStream, &sHeader, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MISMATCH );
+	TEST_CHECK( sStatus.nVerifiedSamples == sStream.nSamples );
+	sStream.pData[sStream.pFrameOffset[6] - 1U] ^= 0x01U;
+
+	/* no signature in STREAMINFO */
+	memset( sHeader.nMD5Signature, 0, sizeof(sHeader.nMD5Signature) );
+	TEST_CHECK( verify_Stream( &sStream, &sHeader, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_NO_SIGNATURE );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+int test_VerifyIncomplete( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	test_decoder sDecoder;
+	flacd_headerStatusInfo sHeader;
+	flacd_verifyStatusInfo sStatus;
+	flacd_verifyConfigInfo sVerify;
+
+	verify_StreamConfig( &sStreamConfig, 2U, 16U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	TEST_CHECK( verify_Header( &sStream, &sHeader ) == 0 );
+	TEST_CHECK( verify_Open( &sDecoder ) == 0 );
+
+	/* configuration */
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_OFF );
+	TEST_CHECK( flacd_SetVerify( &sDecoder.sWorkMem, NULL ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, NULL ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+	memset( &sVerify, 0, sizeof(sVerify) );
+	sVerify.nVerifyMode = 3U;
+	TEST_CHECK( flacd_SetVerify( &sDecoder.sWorkMem, &sVerify ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_PARAMETER );
+	sVerify.nVerifyMode = 1U;
+	TEST_CHECK( flacd_SetVerify( &sDecoder.sWorkMem, &sVerify ) == FLACD_RESULT_NG );
+	TEST_CHECK( flacd_GetErrorFactor( &sDecoder.sWorkMem ) == FLACD_ERR_POINTER );
+
+	/* a jump in the samples : unverifiable until sample 0 is decoded again */
+	TEST_CHECK( verify_Set( &sDecoder, &sHeader ) == 0 );
+	TEST_CHECK( verify_Decode( &sDecoder, &sStream, 0U, 3U ) == FLACD_RESULT_OK );
+	TEST_CHECK( verify_Decode( &sDecoder, &sStream, 5U, sStream.nFrames ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_INCOMPLETE );
+	TEST_CHECK( sStatus.nVerifiedSamples == sStream.pFrameSample[3] );
+	TEST_CHECK( verify_Decode( &sDecoder, &sStream, 0U, sStream.nFrames ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MATCH );
+
+	/* total unknown : compared at each call, with the samples decoded so far */
+	sHeader.nTotalSamples = 0U;
+	TEST_CHECK( verify_Set( &sDecoder, &sHeader ) == 0 );
+	TEST_CHECK( verify_Decode( &sDecoder, &sStream, 0U, 3U ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( ( sStatus.nVerifyResult == FLACD_VERIFY_MISMATCH ) && ( sStatus.nVerifiedSamples == sStream.pFrameSample[3] ) );
+	TEST_CHECK( verify_Decode( &sDecoder, &sStream, 3U, sStream.nFrames ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MATCH );
+
+	/* off */
+	memset( &sVerify, 0, sizeof(sVerify) );
+	TEST_CHECK( flacd_SetVerify( &sDecoder.sWorkMem, &sVerify ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, &sStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_OFF );
+	test_DecoderClose( &sDecoder );
+	test_StreamFree( &sStream );
+	return 0;
+}
+
+/* frame test of frames nFrom to nTo - 1 after frames 0 to nGap - 1 (nGap 0 : none), the frames stored in pFrames */
+static int verify_Frames( const test_stream* const pStream, const ACMW_UINT32 nGap, const ACMW_UINT32 nFrom,
+						  flacd_frameTestInfo* const pFrames, const ACMW_UINT32 nFrames, flacd_verifyStatusInfo* const pStatus )
+{
+	test_decoder sDecoder;
+	flacd_verifyConfigInfo sVerify;
+
+	TEST_CHECK( verify_Open( &sDecoder ) == 0 );
+	memset( &sVerify, 0, sizeof(sVerify) );
+	sVerify.nVerifyMode = 2U;
+	sVerify.pFrames = pFrames;
+	sVerify.nFrames = nFrames;
+	TEST_CHECK( flacd_SetVerify( &sDecoder.sWorkMem, &sVerify ) == FLACD_RESULT_OK );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, pStatus ) == FLACD_RESULT_OK );
+	TEST_CHECK( pStatus->nVerifyResult == FLACD_VERIFY_PENDING );
+	if ( nGap != 0U ) {
+		(void)verify_Decode( &sDecoder, pStream, 0U, nGap );
+	}
+	(void)verify_Decode( &sDecoder, pStream, nFrom, pStream->nFrames );
+	TEST_CHECK( flacd_GetVerifyStatus( &sDecoder.sWorkMem, pStatus ) == FLACD_RESULT_OK );
+	test_DecoderClose( &sDecoder );
+	return 0;
+}
+
+int test_VerifyFrames( void )
+{
+	test_streamConfig sStreamConfig;
+	test_stream sStream;
+	flacd_verifyStatusInfo sStatus;
+	flacd_frameTestInfo *pFrames;
+	ACMW_UINT32 nBad, i;
+	ACMW_UINT8 nSaved;
+
+	verify_StreamConfig( &sStreamConfig, 2U, 16U );
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	pFrames = (flacd_frameTestInfo*)calloc( sStream.nFrames + 1U, sizeof(flacd_frameTestInfo) );
+	TEST_CHECK( pFrames != NULL );
+
+	/* every frame passes, stored with its position */
+	TEST_CHECK( verify_Frames( &sStream, 0U, 0U, pFrames, sStream.nFrames, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MATCH );
+	TEST_CHECK( ( sStatus.nTestedFrames == sStream.nFrames ) && ( sStatus.nFailedFrames == 0U ) );
+	TEST_CHECK( sStatus.nVerifiedSamples == sStream.nSamples );
+	for ( i = 0; i < sStream.nFrames; i++ ) {
+		const ACMW_UINT32 nEnd = ( ( i + 1U ) < sStream.nFrames ) ? sStream.pFrameSample[i + 1U] : sStream.nSamples;
+		TEST_CHECK( ( pFrames[i].nFirstSample == sStream.pFrameSample[i] ) && ( pFrames[i].nFrameResult == FLACD_FRAMETEST_PASS ) );
+		TEST_CHECK( pFrames[i].nBlockSize == ( nEnd - sStream.pFrameSample[i] ) );
+	}
+	/* counts only */
+	TEST_CHECK( verify_Frames( &sStream, 0U, 0U, NULL, 0U, &sStatus ) == 0 );
+	TEST_CHECK( ( sStatus.nVerifyResult == FLACD_VERIFY_MATCH ) && ( sStatus.nTestedFrames == sStream.nFrames ) );
+
+	/* a CRC-16 error */
+	nBad = 4U;
+	sStream.pData[sStream.pFrameOffset[nBad + 1U] - 1U] ^= 0x01U;
+	TEST_CHECK( verify_Frames( &sStream, 0U, 0U, pFrames, sStream.nFrames, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MISMATCH );
+	TEST_CHECK( ( sStatus.nTestedFrames == sStream.nFrames ) && ( sStatus.nFailedFrames == 1U ) );
+	TEST_CHECK( ( pFrames[nBad].nFrameResult == FLACD_FRAMETEST_CRC ) && ( pFrames[nBad].nFirstSample == sStream.pFrameSample[nBad] ) );
+	sStream.pData[sStream.pFrameOffset[nBad + 1U] - 1U] ^= 0x01U;
+
+	/* a damaged sync code : the frame is never found, and never passes */
+	nSaved = sStream.pData[sStream.pFrameOffset[nBad]];
+	sStream.pData[sStream.pFrameOffset[nBad]] = 0x00U;
+	TEST_CHECK( verify_Frames( &sStream, 0U, 0U, pFrames, sStream.nFrames, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult != FLACD_VERIFY_MATCH );
+	TEST_CHECK( ( sStatus.nTestedFrames == ( sStream.nFrames - 1U ) ) && ( sStatus.nFailedFrames == 1U ) );
+	TEST_CHECK( pFrames[nBad].nFirstSample == sStream.pFrameSample[nBad + 1U] );
+	TEST_CHECK( sStatus.nVerifiedSamples == ( sStream.nSamples - ( sStream.pFrameSample[nBad + 1U] - sStream.pFrameSample[nBad] ) ) );
+	sStream.pData[sStream.pFrameOffset[nBad]] = nSaved;
+
+	/* frames left out of the input */
+	TEST_CHECK( verify_Frames( &sStream, 3U, 5U, pFrames, sStream.nFrames, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MISMATCH );
+	TEST_CHECK( ( sStatus.nTestedFrames == ( sStream.nFrames - 2U ) ) && ( sStatus.nFailedFrames == 1U ) );
+	TEST_CHECK( ( pFrames[3].nFirstSample == sStream.pFrameSample[5] ) && ( pFrames[3].nFrameResult == FLACD_FRAMETEST_PASS ) );
+	free( pFrames );
+	test_StreamFree( &sStream );
+
+	/* a FIXED subframe with Rice partitions shorter than its order : the frame cannot be parsed */
+	verify_StreamConfig( &sStreamConfig, 1U, 16U );
+	sStreamConfig.bVariable = 0U;
+	TEST_CHECK( test_StreamMake( &sStreamConfig, &sStream ) == 0 );
+	pFrames = (flacd_frameTestInfo*)calloc( sStream.nFrames + 1U, sizeof(flacd_frameTestInfo) );
+	TEST_CHECK( pFrames != NULL );
+	/* a 6 byte frame header, the subframe header, the warm-up samples and the residual coding method */
+	for ( nBad = 1U; nBad < ( sStream.nFrames - 1U ); nBad++ ) {
+		nSaved = sStream.pData[sStream.pFrameOffset[nBad] + 6U];
+		if ( ( ( nSaved & 0xF0U ) == 0x10U ) && ( ( ( nSaved >> 1 ) & 0x07U ) != 0U ) ) {
+			break;
+		}
+	}
+	TEST_CHECK( nBad < ( sStream.nFrames - 1U ) );
+	sStream.pData[sStream.pFrameOffset[nBad] + 7U + ( 2U * ( ( nSaved >> 1 ) & 0x07U ) )] |= 0x3CU;
+	TEST_CHECK( verify_Frames( &sStream, 0U, 0U, pFrames, sStream.nFrames, &sStatus ) == 0 );
+	TEST_CHECK( sStatus.nVerifyResult == FLACD_VERIFY_MISMATCH );
+	TEST_CHECK( ( sStatus.nTestedFrames == sStream.nFrames ) && ( sStatus.nFailedFrames == 1U ) );
+	TEST_CHECK( ( pFrames[nBad].nFrameResult == FLACD_FRAMETEST_UNPARSEABLE ) && ( pFrames[nBad].nBlockSize == 0U ) );
+	TEST_CHECK( pFrames[nBad].nFirstSample == sStream.pFrameSample[nBad] );
+	TEST_CHECK( ( pFrames[nBad + 1U].nFirstSample == sStream.pFrameSample[nBad + 1U] ) && ( pFrames[nBad + 1U].nFrameResult == FLACD_FRAMETEST_PASS ) );
+	free( pFrames );
+	test_StreamFree( &sStream );
+	return 0;
+}